@@ -15,6 +15,8 @@ set(onnxruntime_common_src_patterns
     "${ONNXRUNTIME_ROOT}/core/platform/env.cc"
     "${ONNXRUNTIME_ROOT}/core/platform/env_time.h"
     "${ONNXRUNTIME_ROOT}/core/platform/env_time.cc"
+    "${ONNXRUNTIME_ROOT}/core/platform/threadpool.h"
+    "${ONNXRUNTIME_ROOT}/core/platform/threadpool.cc"
 )
 
 if(WIN32)
@@ -40,7 +42,7 @@ add_library(onnxruntime_common ${onnxruntime_common_src})
 if(NOT WIN32)
 	target_link_libraries(onnxruntime_common dl)
 endif()
-target_include_directories(onnxruntime_common PRIVATE ${ONNXRUNTIME_ROOT} ${date_INCLUDE_DIR})
+target_include_directories(onnxruntime_common PRIVATE ${ONNXRUNTIME_ROOT} ${date_INCLUDE_DIR} ${eigen_INCLUDE_DIRS})
 # logging uses date. threadpool uses eigen
 add_dependencies(onnxruntime_common date eigen gsl)
 
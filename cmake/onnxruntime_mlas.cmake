@@ -5,6 +5,7 @@ set(mlas_common_srcs
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/platform.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/threading.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/sgemm.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/qgemm.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/convolve.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/pooling.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/bias.cpp
@@ -65,6 +66,7 @@ if (MSVC)
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/amd64/cvtfp16a.asm
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/amd64/LogisticKernelFma3.asm
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/amd64/TanhKernelFma3.asm
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/qgemm_kernel_avx2.cpp
     )
 
   endif()
@@ -120,6 +122,7 @@ else()
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/x86_64/SgemmKernelFma3.S
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/x86_64/LogisticKernelFma3.S
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/x86_64/TanhKernelFma3.S
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/qgemm_kernel_avx2.cpp
     )
     set_source_files_properties(${mlas_platform_srcs_avx2} PROPERTIES COMPILE_FLAGS "-mavx2 -mfma")
 
@@ -135,6 +138,20 @@ else()
       ${mlas_platform_srcs_avx512f}
     )
 
+    # The AVX512_VNNI intrinsics are only available with newer compilers, so
+    # only build the VNNI kernel if the compiler supports the instruction set.
+    include(CheckCXXCompilerFlag)
+    check_cxx_compiler_flag("-mavx512vnni" COMPILER_SUPPORTS_AVX512VNNI)
+
+    if (COMPILER_SUPPORTS_AVX512VNNI)
+      set(mlas_platform_srcs_avx512vnni
+        ${ONNXRUNTIME_ROOT}/core/mlas/lib/qgemm_kernel_avx512vnni.cpp
+      )
+      set_source_files_properties(${mlas_platform_srcs_avx512vnni} PROPERTIES COMPILE_FLAGS "-mavx512f -mavx512vnni")
+      list(APPEND mlas_platform_srcs ${mlas_platform_srcs_avx512vnni})
+      set(mlas_has_qgemm_avx512vnni ON)
+    endif()
+
   endif()
 
 endif()
@@ -142,3 +159,6 @@ endif()
 add_library(onnxruntime_mlas STATIC ${mlas_common_srcs} ${mlas_platform_srcs})
 target_include_directories(onnxruntime_mlas PRIVATE ${ONNXRUNTIME_ROOT}/core/mlas/inc ${ONNXRUNTIME_ROOT}/core/mlas/lib)
 set_target_properties(onnxruntime_mlas PROPERTIES FOLDER "ONNXRuntime")
+if (mlas_has_qgemm_avx512vnni)
+  target_compile_definitions(onnxruntime_mlas PRIVATE MLAS_HAS_QGEMM_AVX512VNNI)
+endif()
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -20,4 +21,12 @@ using InputDefList = std::vector<const onnxruntime::NodeArg*>;
 using OutputDefList = std::vector<const onnxruntime::NodeArg*>;
 
 using NameMLValMap = std::unordered_map<std::string, MLValue>;
+
+// counters of the per-session cache of memory patterns for the input shapes seen
+struct MemoryPatternCacheStats {
+  int64_t hits = 0;
+  int64_t misses = 0;
+  int64_t evictions = 0;
+  size_t num_entries = 0;
+};
 }  // namespace onnxruntime
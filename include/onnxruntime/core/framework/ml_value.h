@@ -44,6 +44,13 @@ class MLValue {
     return static_cast<T*>(data_.get());
   }
 
+  /**
+     Whether another MLValue, such as the copy of an initializer kept by the session state, holds the same data.
+  */
+  bool IsShared() const noexcept {
+    return data_.use_count() > 1;
+  }
+
   bool IsTensor() const noexcept {
     return DataTypeImpl::GetType<Tensor>() == type_;
   }
@@ -20,6 +20,9 @@
 #include "onnx/defs/schema.h"
 
 namespace onnxruntime {
+namespace concurrency {
+class ThreadPool;
+}
 class ExecutionFrame;
 class OpKernelContext;
 class OpKernelWrapper;
@@ -145,6 +148,14 @@ class OpKernelContext {
   */
   Fence_t OutputFence(int index) const;
 
+  /**
+  Return the thread pool to use for intra-op parallelism.
+  The pool is owned by the session and shared with the executor, so work scheduled on it should be
+  done via ParallelFor, which also uses the calling thread, rather than by blocking on scheduled tasks.
+  @returns Pointer to the session thread pool. May be null, in which case the kernel should run serially.
+  */
+  concurrency::ThreadPool* GetOperatorThreadPool() const;
+
  protected:
   onnxruntime::NodeIndex GetNodeIndex() const;
   const SessionState& GetSessionState() const;
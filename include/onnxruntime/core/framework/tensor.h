@@ -97,6 +97,11 @@ class Tensor final {
   */
   const OrtAllocatorInfo& Location() const { return alloc_info_; }
 
+  /**
+     Returns true if the buffer is released with the tensor, false if it is owned by someone else.
+  */
+  bool OwnsBuffer() const noexcept { return buffer_deleter_ != nullptr; }
+
   /**
      May return nullptr if tensor size is zero
   */
@@ -5,6 +5,8 @@
 #include <iosfwd>
 #include <vector>
 #include <algorithm>
+#include <memory>
+#include <stdexcept>
 #include <string>
 #include <cstring>
 #include "onnxruntime_config.h"
@@ -20,19 +22,84 @@ namespace onnxruntime {
 #pragma GCC diagnostic ignored "-Wnull-dereference"
 #endif
 #endif
-class TensorShape : private std::vector<int64_t> {
-  // TODO - Use a custom STL allocator to avoid heap allocations in the common case.
+
+/**
+   Non-owning, read-only view of the dimensions of a TensorShape or of a std::vector<int64_t>.
+   It is cheap to copy and should be passed by value. The view is only valid while the object it
+   was created from is alive and unmodified.
+   It provides the subset of the const std::vector interface that kernels use, so it can replace
+   a const std::vector<int64_t>& in most places. It converts implicitly to std::vector<int64_t>,
+   but that conversion allocates and should be avoided on hot paths.
+*/
+class TensorShapeView {
+ public:
+  using value_type = int64_t;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using reference = const int64_t&;
+  using const_reference = const int64_t&;
+  using pointer = const int64_t*;
+  using const_pointer = const int64_t*;
+  using iterator = const int64_t*;
+  using const_iterator = const int64_t*;
+
+  TensorShapeView() = default;
+
+  TensorShapeView(const int64_t* dims, size_t num_dims) noexcept : dims_(dims), num_dims_(num_dims) {}
+
+  TensorShapeView(const std::vector<int64_t>& dims) noexcept : dims_(dims.data()), num_dims_(dims.size()) {}
+
+  const_iterator begin() const noexcept { return dims_; }
+  const_iterator end() const noexcept { return dims_ + num_dims_; }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  size_t size() const noexcept { return num_dims_; }
+  bool empty() const noexcept { return num_dims_ == 0; }
+  const int64_t* data() const noexcept { return dims_; }
+
+  const int64_t& operator[](size_t idx) const noexcept { return dims_[idx]; }
+
+  const int64_t& at(size_t idx) const {
+    if (idx >= num_dims_)
+      throw std::out_of_range("TensorShapeView index out of range");
+    return dims_[idx];
+  }
+
+  const int64_t& front() const noexcept { return dims_[0]; }
+  const int64_t& back() const noexcept { return dims_[num_dims_ - 1]; }
+
+  operator std::vector<int64_t>() const { return std::vector<int64_t>(begin(), end()); }
+
+  friend bool operator==(TensorShapeView lhs, TensorShapeView rhs) noexcept {
+    return lhs.num_dims_ == rhs.num_dims_ && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+
+  friend bool operator!=(TensorShapeView lhs, TensorShapeView rhs) noexcept {
+    return !(lhs == rhs);
+  }
+
+ private:
+  const int64_t* dims_ = nullptr;
+  size_t num_dims_ = 0;
+};
+
+class TensorShape {
   // We use negative numbers for unknown symbolic dimension. Each negative
   // number represents a unique symbolic dimension.
-  // Private inheritance is used to prevent ambiguity of element versus dimension size
+  // Up to kMaxInlineDims dimensions are stored inside the object so that creating, copying and
+  // destroying the shape of a typical tensor does not touch the heap. Larger ranks fall back to a
+  // heap allocated buffer.
  public:
-  TensorShape() = default;
+  static constexpr size_t kMaxInlineDims = 6;
+
+  TensorShape() noexcept = default;
 
-  TensorShape(const TensorShape& /*other*/) = default;
-  TensorShape& operator=(const TensorShape& /*other*/) = default;
+  TensorShape(const TensorShape& other);
+  TensorShape& operator=(const TensorShape& other);
 
-  TensorShape(TensorShape&& /*other*/) = default;
-  TensorShape& operator=(TensorShape&& /*other*/) = default;
+  TensorShape(TensorShape&& other) noexcept;
+  TensorShape& operator=(TensorShape&& other) noexcept;
 
   TensorShape(const int64_t* dimension_sizes, size_t dimension_count);
 
@@ -42,21 +109,21 @@ class TensorShape : private std::vector<int64_t> {
 
   TensorShape(const std::vector<int64_t>& dims, size_t start, size_t end);
 
+  TensorShape(TensorShapeView dims);
+
   /**
      Return the dimension specified by <idx>.
   */
   const int64_t& operator[](size_t idx) const {
-    return std::vector<int64_t>::operator[](static_cast<int>(idx));
+    return dims_[idx];
   }
 
   int64_t& operator[](size_t idx) {
-    return std::vector<int64_t>::operator[](static_cast<int>(idx));
+    return dims_[idx];
   }
 
   bool operator==(const TensorShape& other) const noexcept {
-    auto thisVector = static_cast<const std::vector<int64_t>*>(this);
-    auto otherVector = static_cast<const std::vector<int64_t>*>(&other);
-    return *thisVector == *otherVector;
+    return GetDims() == other.GetDims();
   }
 
   bool operator!=(const TensorShape& other) const noexcept {
@@ -64,20 +131,20 @@ class TensorShape : private std::vector<int64_t> {
   }
 
   size_t NumDimensions() const noexcept {
-    return size();
+    return num_dims_;
   }
 
   /**
      Copy dims into an array with given size
   */
   void CopyDims(int64_t* dims, size_t num_dims) const {
-    memcpy(dims, data(), sizeof(value_type) * std::min(num_dims, NumDimensions()));
+    memcpy(dims, dims_, sizeof(int64_t) * std::min(num_dims, NumDimensions()));
   }
 
   /**
-     Return underlying vector representation.
+     Return a view of the dimensions. The view is invalidated if this TensorShape is modified or destroyed.
   */
-  const std::vector<int64_t>& GetDims() const { return *this; }
+  TensorShapeView GetDims() const noexcept { return TensorShapeView(dims_, num_dims_); }
 
   /**
    * Return the total number of elements. Returns 1 for an empty (rank 0) TensorShape.
@@ -127,13 +194,17 @@ class TensorShape : private std::vector<int64_t> {
      empty shape or 1D shape (1) is regarded as scalar tensor
   */
   bool IsScalar() const {
-    return size() == 0 || (size() == 1 && at(0) == 1);
+    return num_dims_ == 0 || (num_dims_ == 1 && dims_[0] == 1);
   }
 
-  static const TensorShape& ReinterpretBaseType(const std::vector<int64_t>& dimensions) {
-    static_assert(sizeof(TensorShape) == sizeof(std::vector<int64_t>), "Size of TensorShape prevents safe casting from vector");
-    return *static_cast<const TensorShape*>(&dimensions);
-  }
+ private:
+  // Set the rank and return the (uninitialized) storage for the dimensions.
+  int64_t* Allocate(size_t num_dims);
+
+  size_t num_dims_ = 0;
+  int64_t* dims_ = small_dims_;  // points to small_dims_ or allocated_dims_
+  int64_t small_dims_[kMaxInlineDims];
+  std::unique_ptr<int64_t[]> allocated_dims_;
 };
 #ifdef __GNUC__
 #pragma GCC diagnostic pop
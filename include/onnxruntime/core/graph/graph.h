@@ -474,6 +474,11 @@ class Graph {
   /** Removes all initializer tensors from this Graph and releases the memory they were using. */
   void CleanAllInitializedTensors() noexcept;
 
+  /** Removes all initializer tensors from this Graph and returns them to the caller.
+  Use instead of CleanAllInitializedTensors if the data of some initializers needs to outlive them being removed.
+  @remarks Includes the initializers that were removed from the Graph but not yet from its GraphProto. */
+  std::vector<std::unique_ptr<ONNX_NAMESPACE::TensorProto>> ReleaseAllInitializedTensors();
+
   /** Gets the Graph inputs excluding initializers. 
   These are the required inputs to the Graph as the initializers can be optionally overridden via graph inputs.
   @remarks Contains no nullptr values. */
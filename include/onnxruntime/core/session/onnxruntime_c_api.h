@@ -224,6 +224,28 @@ ORT_API_STATUS(OrtRunInference, _Inout_ OrtSession* sess,
                _In_ const char* const* input_names, _In_ const OrtValue* const* input, size_t input_len,
                _In_ const char* const* output_names, size_t output_names_len, _Out_ OrtValue** output);
 
+/**
+ * Completion callback of OrtRunInferenceAsync. It is called on a thread of the session and must not block for long.
+ * \param user_data the value passed to OrtRunInferenceAsync
+ * \param output output_names_len values in the order of the output names, or NULL if status is not NULL.
+ *        The array is only valid during the callback. The values should be freed by OrtReleaseValue after use.
+ * \param status NULL if the run succeeded. Otherwise it should be freed by OrtReleaseStatus after use.
+ */
+typedef void(ORT_API_CALL* OrtRunAsyncCallback)(void* user_data, OrtValue** output, size_t output_names_len,
+                                                OrtStatus* status);
+
+/**
+ * Queue a run on the session and return without waiting for it. callback is called once the run has completed.
+ * The inputs are shared with the run, and should not be changed or released until then. run_options may be NULL;
+ * if not, it must remain valid until then.
+ * \return NULL if the run was queued. Errors of the run itself are passed to the callback.
+ */
+ORT_API_STATUS(OrtRunInferenceAsync, _Inout_ OrtSession* sess,
+               _In_opt_ OrtRunOptions* run_options,
+               _In_ const char* const* input_names, _In_ const OrtValue* const* input, size_t input_len,
+               _In_ const char* const* output_names, size_t output_names_len,
+               _In_ OrtRunAsyncCallback callback, _In_opt_ void* user_data);
+
 /**
  * \return A pointer of the newly created object. The pointer should be freed by OrtReleaseObject after use
  */
@@ -260,6 +282,9 @@ ORT_API(void, OrtSetSessionLogVerbosityLevel, _In_ OrtSessionOptions* options, u
 ///How many threads in the session thread pool.
 ORT_API(int, OrtSetSessionThreadPoolSize, _In_ OrtSessionOptions* options, int session_thread_pool_size);
 
+///How many threads run the requests queued by OrtRunInferenceAsync. 0 (the default) uses the number of hardware threads.
+ORT_API(int, OrtSetSessionAsyncRunThreadPoolSize, _In_ OrtSessionOptions* options, int async_run_thread_pool_size);
+
 /**
   * The order of invocation indicates the preference order as well. In other words call this method
   * on your most preferred execution provider first followed by the less preferred ones.
@@ -74,6 +74,9 @@ class SessionOptionsWrapper {
   void SetSessionThreadPoolSize(int session_thread_pool_size) {
     OrtSetSessionThreadPoolSize(value.get(), session_thread_pool_size);
   }
+  void SetSessionAsyncRunThreadPoolSize(int async_run_thread_pool_size) {
+    OrtSetSessionAsyncRunThreadPoolSize(value.get(), async_run_thread_pool_size);
+  }
 
   /**
   * The order of invocation indicates the preference order as well. In other words call this method
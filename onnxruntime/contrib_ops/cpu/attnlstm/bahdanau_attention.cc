@@ -142,16 +142,18 @@ void BahdanauAttention<T>::Compute(
     }
 
     SoftmaxInplace(gsl::span<T>{alignments, mem_steps});
-
-    // Calculate the context
-    auto outspan = output.subspan(b * memory_depth_);
-    auto values = values_.subspan(b * max_memory_steps_ * memory_depth_);
-    math::GemmEx<T, CPUMathUtil>(CblasNoTrans, CblasNoTrans,
-                                 1, memory_depth_, max_memory_steps_, T{1.0},
-                                 alignments, max_memory_steps_,
-                                 values.data(), memory_depth_, T{0.0},
-                                 outspan.data(), memory_depth_, &CPUMathUtil::Instance());
   }
+
+  // Calculate the context of every batch in one call. The alignments past mem_steps are zero, so the
+  // padding steps of values_ don't contribute.
+  math::GemmStridedBatched<T, concurrency::ThreadPool>(CblasNoTrans, CblasNoTrans, batch_size_,
+                                                       1, memory_depth_, max_memory_steps_, T{1.0},
+                                                       aligns.data(), max_memory_steps_, max_memory_steps_,
+                                                       values_.data(), memory_depth_,
+                                                       static_cast<int64_t>(max_memory_steps_) * memory_depth_,
+                                                       T{0.0},
+                                                       output.data(), memory_depth_, memory_depth_,
+                                                       nullptr);
 }
 
 template class BahdanauAttention<float>;
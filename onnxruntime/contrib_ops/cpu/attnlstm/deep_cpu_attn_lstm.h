@@ -8,7 +8,6 @@
 #include "attention_wrapper.h"
 
 #include "core/framework/op_kernel.h"
-#include "core/common/task_thread_pool.h"
 #include "core/providers/cpu/rnn/rnn_helpers.h"
 
 namespace onnxruntime {
@@ -93,11 +92,6 @@ class DeepCpuAttnLstmOp final : public OpKernel {
 
   ActivationFuncs activation_funcs_;
 
-  // Threadpool for operator. If concurrent Compute calls are possible, it will be shared
-  // across them. mutable due to this.
-  // The alternative would be to create a threadpool in each call to Compute but that would incur thread creation
-  // cost on every call.
-  mutable TaskThreadPool ttp_{std::thread::hardware_concurrency()};
 };
 
 }  // namespace contrib
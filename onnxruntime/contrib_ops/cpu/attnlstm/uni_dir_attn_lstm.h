@@ -9,7 +9,6 @@
 
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
-#include "core/common/task_thread_pool.h"
 #include "core/framework/allocator.h"
 
 #include <gsl/span>
@@ -22,7 +21,6 @@ namespace logging = ::onnxruntime::logging;
 
 using ::onnxruntime::AllocatorPtr;
 using ::onnxruntime::IAllocatorUniquePtr;
-using ::onnxruntime::TaskThreadPool;
 using ::onnxruntime::contrib::detail::ActivationInfo;
 using ::onnxruntime::rnn::detail::ActivationFuncs;
 using ::onnxruntime::rnn::detail::Direction;
@@ -53,7 +51,7 @@ class UniDirectionalAttnLstm {
                          const ActivationFuncs::Entry& activation_func_g,
                          const ActivationFuncs::Entry& activation_func_h,
                          const float clip,
-                         TaskThreadPool& ttp);
+                         concurrency::ThreadPool* thread_pool);
 
   void Compute(const gsl::span<const T>& inputs,
                const gsl::span<const int>& sequence_lengths,
@@ -153,7 +151,7 @@ class UniDirectionalAttnLstm {
 
   AttentionWrapper<T>& attention_wrapper_;
 
-  TaskThreadPool& ttp_;
+  concurrency::ThreadPool* thread_pool_;
 };
 
 }  // namespace detail
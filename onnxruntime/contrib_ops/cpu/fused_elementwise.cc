@@ -0,0 +1,284 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "fused_elementwise.h"
+
+#include <cstring>
+
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math_cpuonly.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    FusedElementwise,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedElementwise);
+
+// number of output elements evaluated at a time. the tiles of the inputs and of every intermediate result are
+// live together, so keep them small enough to stay in L1/L2.
+static constexpr int64_t kTileSize = 1024;
+
+FusedElementwise::FusedElementwise(const OpKernelInfo& info) : OpKernel(info) {
+  static const std::unordered_map<std::string, std::pair<OpCode, int>> kOps = {
+      {"Add", {OpCode::Add, 2}},
+      {"Sub", {OpCode::Sub, 2}},
+      {"Mul", {OpCode::Mul, 2}},
+      {"Div", {OpCode::Div, 2}},
+      {"Relu", {OpCode::Relu, 1}},
+      {"Sigmoid", {OpCode::Sigmoid, 1}},
+      {"Tanh", {OpCode::Tanh, 1}},
+      {"LeakyRelu", {OpCode::LeakyRelu, 1}},
+      {"Neg", {OpCode::Neg, 1}},
+      {"Abs", {OpCode::Abs, 1}},
+      {"Exp", {OpCode::Exp, 1}},
+      {"Sqrt", {OpCode::Sqrt, 1}},
+      {"Reciprocal", {OpCode::Reciprocal, 1}},
+  };
+
+  std::vector<std::string> ops;
+  std::vector<int64_t> operands;
+  ORT_ENFORCE(info.GetAttrs<std::string>("ops", ops).IsOK());
+  ORT_ENFORCE(info.GetAttrs<int64_t>("operands", operands).IsOK());
+  std::vector<float> alphas = info.GetAttrsOrDefault<float>("alphas");
+  ORT_ENFORCE(!ops.empty(), "FusedElementwise requires at least one operator");
+  ORT_ENFORCE(alphas.empty() || alphas.size() == ops.size(), "alphas must have one value per operator");
+
+  num_inputs_ = info.GetInputCount();
+
+  size_t next_operand = 0;
+  for (size_t i = 0; i < ops.size(); ++i) {
+    auto it = kOps.find(ops[i]);
+    ORT_ENFORCE(it != kOps.end(), "Unsupported operator in FusedElementwise: ", ops[i]);
+
+    const int arity = it->second.second;
+    ORT_ENFORCE(next_operand + arity <= operands.size(), "Too few operands for operator ", i, " of FusedElementwise");
+
+    // operands can only refer to the inputs and to the results of earlier steps
+    const int64_t num_slots = num_inputs_ + static_cast<int64_t>(i);
+    Step step{it->second.first, operands[next_operand], arity == 2 ? operands[next_operand + 1] : -1,
+              alphas.empty() ? 0.01f : alphas[i]};
+    ORT_ENFORCE(step.lhs >= 0 && step.lhs < num_slots && step.rhs >= -1 && step.rhs < num_slots,
+                "Invalid operand for operator ", i, " of FusedElementwise");
+    next_operand += arity;
+    steps_.push_back(step);
+  }
+  ORT_ENFORCE(next_operand == operands.size(), "Too many operands for FusedElementwise");
+}
+
+// multidirectional broadcast of dims into output_dims
+static Status BroadcastDims(TensorShapeView dims, std::vector<int64_t>& output_dims) {
+  if (dims.size() > output_dims.size()) {
+    output_dims.insert(output_dims.begin(), dims.size() - output_dims.size(), 1);
+  }
+
+  const size_t offset = output_dims.size() - dims.size();
+  for (size_t i = 0; i < dims.size(); ++i) {
+    int64_t& output_dim = output_dims[offset + i];
+    if (dims[i] == output_dim || dims[i] == 1) {
+      continue;
+    }
+    if (output_dim != 1) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "FusedElementwise: inputs can't be broadcast together. ",
+                             "Dimension ", i, " is ", dims[i], " but the output dimension is ", output_dim);
+    }
+    output_dim = dims[i];
+  }
+  return Status::OK();
+}
+
+// expand an input that isn't a suffix of the output shape to the full output shape
+static void ExpandToOutput(const float* input, TensorShapeView dims,
+                           const std::vector<int64_t>& output_dims, std::vector<float>& expanded) {
+  const size_t rank = output_dims.size();
+  const size_t offset = rank - dims.size();
+
+  std::vector<int64_t> strides(rank, 0);
+  int64_t stride = 1;
+  for (size_t i = rank; i-- > offset;) {
+    strides[i] = dims[i - offset] == 1 ? 0 : stride;
+    stride *= dims[i - offset];
+  }
+
+  const int64_t inner = output_dims[rank - 1];
+  const int64_t inner_stride = strides[rank - 1];
+  const int64_t size = TensorShape(output_dims).Size();
+  expanded.resize(static_cast<size_t>(size));
+
+  std::vector<int64_t> index(rank, 0);
+  int64_t input_offset = 0;
+  for (int64_t out = 0; out < size; out += inner) {
+    for (int64_t i = 0; i < inner; ++i) {
+      expanded[out + i] = input[input_offset + i * inner_stride];
+    }
+
+    // advance the outer dimensions
+    for (size_t axis = rank - 1; axis-- > 0;) {
+      input_offset += strides[axis];
+      if (++index[axis] < output_dims[axis]) {
+        break;
+      }
+      input_offset -= strides[axis] * index[axis];
+      index[axis] = 0;
+    }
+  }
+}
+
+Status FusedElementwise::Compute(OpKernelContext* context) const {
+  std::vector<int64_t> output_dims;
+  for (int64_t i = 0; i < num_inputs_; ++i) {
+    const Tensor* input = context->Input<Tensor>(static_cast<int>(i));
+    ORT_RETURN_IF_NOT(input != nullptr, "FusedElementwise: input ", i, " is missing");
+    ORT_RETURN_IF_ERROR(BroadcastDims(input->Shape().GetDims(), output_dims));
+  }
+
+  Tensor* Y = context->Output(0, TensorShape(output_dims));
+  const int64_t size = Y->Shape().Size();
+  if (size == 0) {
+    return Status::OK();
+  }
+
+  // inputs whose dimensions, after dropping leading 1s, are the trailing dimensions of the output repeat with a
+  // period of their size along the flattened output. that covers inputs of the full shape, scalars and the common
+  // bias/scale broadcasts. anything else is expanded to the full shape up front.
+  std::vector<std::pair<const float*, int64_t>> inputs;
+  std::vector<std::vector<float>> expanded_inputs;
+  expanded_inputs.reserve(num_inputs_);
+  for (int64_t i = 0; i < num_inputs_; ++i) {
+    const Tensor& input = *context->Input<Tensor>(static_cast<int>(i));
+    const auto& dims = input.Shape().GetDims();
+
+    auto first = std::find_if(dims.begin(), dims.end(), [](int64_t dim) { return dim != 1; });
+    const bool is_suffix = std::equal(first, dims.end(), output_dims.end() - (dims.end() - first));
+    if (is_suffix) {
+      inputs.emplace_back(input.Data<float>(), input.Shape().Size());
+    } else {
+      expanded_inputs.emplace_back();
+      ExpandToOutput(input.Data<float>(), dims, output_dims, expanded_inputs.back());
+      inputs.emplace_back(expanded_inputs.back().data(), size);
+    }
+  }
+
+  float* output = Y->MutableData<float>();
+  const int64_t num_tiles = (size + kTileSize - 1) / kTileSize;
+
+  // split the tiles between the threads, with enough work in each block to amortize scheduling it
+  constexpr int64_t kMinTilesPerBlock = 16;
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+  if (tp == nullptr || num_tiles <= kMinTilesPerBlock) {
+    EvaluateRange(inputs, 0, size, output);
+    return Status::OK();
+  }
+
+  const int64_t degree = tp->NumThreads() + 1;
+  const int64_t tiles_per_block = std::max(kMinTilesPerBlock, (num_tiles + degree - 1) / degree);
+  tp->ParallelForRange(0, num_tiles, tiles_per_block, [&](int64_t first_tile, int64_t last_tile) {
+    EvaluateRange(inputs, first_tile * kTileSize, std::min(last_tile * kTileSize, size), output);
+  });
+
+  return Status::OK();
+}
+
+void FusedElementwise::EvaluateRange(const std::vector<std::pair<const float*, int64_t>>& inputs,
+                                     int64_t begin, int64_t end, float* output) const {
+  // tile buffers for the inputs that can't be read in place, followed by one per intermediate result
+  std::vector<float> buffers(static_cast<size_t>((num_inputs_ + steps_.size()) * kTileSize));
+  std::vector<const float*> slots(num_inputs_ + steps_.size());
+
+  // scalars are broadcast into their buffer once
+  for (int64_t i = 0; i < num_inputs_; ++i) {
+    if (inputs[i].second == 1) {
+      float* buffer = buffers.data() + i * kTileSize;
+      std::fill_n(buffer, kTileSize, *inputs[i].first);
+      slots[i] = buffer;
+    }
+  }
+
+  for (int64_t tile_begin = begin; tile_begin < end; tile_begin += kTileSize) {
+    const int64_t len = std::min(kTileSize, end - tile_begin);
+
+    for (int64_t i = 0; i < num_inputs_; ++i) {
+      const float* data = inputs[i].first;
+      const int64_t period = inputs[i].second;
+      if (period == 1) {
+        continue;
+      }
+
+      int64_t offset = tile_begin % period;
+      if (offset + len <= period) {
+        slots[i] = data + offset;
+        continue;
+      }
+
+      // the tile wraps around the end of the input, so repeat it into the buffer
+      float* buffer = buffers.data() + i * kTileSize;
+      for (int64_t copied = 0; copied < len;) {
+        const int64_t count = std::min(period - offset, len - copied);
+        memcpy(buffer + copied, data + offset, static_cast<size_t>(count) * sizeof(float));
+        copied += count;
+        offset = 0;
+      }
+      slots[i] = buffer;
+    }
+
+    for (size_t k = 0; k < steps_.size(); ++k) {
+      const Step& step = steps_[k];
+      float* result = k + 1 == steps_.size() ? output + tile_begin
+                                             : buffers.data() + (num_inputs_ + k) * kTileSize;
+      const float* lhs = slots[step.lhs];
+
+      ConstEigenVectorArrayMap<float> a(lhs, len);
+      EigenVectorArrayMap<float> y(result, len);
+      switch (step.op) {
+        case OpCode::Add:
+          y = a + ConstEigenVectorArrayMap<float>(slots[step.rhs], len);
+          break;
+        case OpCode::Sub:
+          y = a - ConstEigenVectorArrayMap<float>(slots[step.rhs], len);
+          break;
+        case OpCode::Mul:
+          y = a * ConstEigenVectorArrayMap<float>(slots[step.rhs], len);
+          break;
+        case OpCode::Div:
+          y = a / ConstEigenVectorArrayMap<float>(slots[step.rhs], len);
+          break;
+        case OpCode::Relu:
+          y = a.cwiseMax(0.0f);
+          break;
+        case OpCode::Sigmoid:
+          MlasComputeLogistic(lhs, result, static_cast<size_t>(len));
+          break;
+        case OpCode::Tanh:
+          MlasComputeTanh(lhs, result, static_cast<size_t>(len));
+          break;
+        case OpCode::LeakyRelu:
+          y = (a >= 0.0f).select(a, a * step.alpha);
+          break;
+        case OpCode::Neg:
+          y = -a;
+          break;
+        case OpCode::Abs:
+          y = a.abs();
+          break;
+        case OpCode::Exp:
+          y = a.exp();
+          break;
+        case OpCode::Sqrt:
+          y = a.sqrt();
+          break;
+        case OpCode::Reciprocal:
+          y = a.inverse();
+          break;
+      }
+      slots[num_inputs_ + k] = result;
+    }
+  }
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
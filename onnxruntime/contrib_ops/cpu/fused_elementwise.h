@@ -0,0 +1,59 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+/**
+  * Evaluates a chain of element-wise operators, as produced by ElementwiseFusion, in a single pass over the output.
+  * The output is processed in tiles small enough for the inputs and the intermediate results of a tile to stay in
+  * cache, so the intermediate tensors of the original nodes are never written to memory.
+  */
+class FusedElementwise final : public OpKernel {
+ public:
+  explicit FusedElementwise(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  enum class OpCode : uint8_t {
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Relu,
+    Sigmoid,
+    Tanh,
+    LeakyRelu,
+    Neg,
+    Abs,
+    Exp,
+    Sqrt,
+    Reciprocal,
+  };
+
+  struct Step {
+    OpCode op;
+    // operand slots. slots [0, num_inputs) are the inputs, slot num_inputs + k is the result of step k.
+    int64_t lhs;
+    int64_t rhs;  // -1 for unary operators
+    float alpha;
+  };
+
+  // evaluate steps_ over [begin, end) of the output. inputs holds, for each input, its data and the period of its
+  // values in the flattened output: the output size if it isn't broadcast, 1 for a scalar, or the size of the
+  // trailing dimensions it is repeated over.
+  void EvaluateRange(const std::vector<std::pair<const float*, int64_t>>& inputs, int64_t begin, int64_t end,
+                     float* output) const;
+
+  std::vector<Step> steps_;
+  int64_t num_inputs_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/matmul_integer.h"
+
+#include "core/mlas/inc/mlas.h"
+#include "core/providers/cpu/math/matmul_helper.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// the output is uint32 when both inputs are uint8 and int32 otherwise. the products of unsigned inputs are never
+// negative, so both are computed as int32.
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    MatMulInteger,
+    1,
+    uint8_t,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("T3", DataTypeImpl::GetTensorType<uint32_t>()),
+    MatMulInteger<uint8_t>);
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    MatMulInteger,
+    1,
+    int8_t,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<int8_t>())
+        .TypeConstraint("T3", DataTypeImpl::GetTensorType<int32_t>()),
+    MatMulInteger<int8_t>);
+
+template <typename T2>
+Status MatMulInteger<T2>::Compute(OpKernelContext* ctx) const {
+  const Tensor* a = ctx->Input<Tensor>(0);
+  const Tensor* b = ctx->Input<Tensor>(1);
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b->Shape()));
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+  int32_t* y_data = static_cast<int32_t*>(y->MutableDataRaw());
+
+  for (size_t i = 0; i < helper.OutputOffsets().size(); i++) {
+    MlasQgemm(M, N, K,
+              a->template Data<uint8_t>() + helper.LeftOffsets()[i], K, 0,
+              b->template Data<T2>() + helper.RightOffsets()[i], N, 0,
+              y_data + helper.OutputOffsets()[i], N,
+              nullptr,
+              ctx->GetOperatorThreadPool());
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
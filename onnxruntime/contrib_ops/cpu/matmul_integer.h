@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+/**
+  * Multiplies a uint8 matrix A by a uint8 or int8 matrix B with 32-bit accumulation, using the MLAS QGEMM kernels.
+  * T2 is the element type of B.
+  */
+template <typename T2>
+class MatMulInteger final : public OpKernel {
+ public:
+  explicit MatMulInteger(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status Compute(OpKernelContext* context) const override;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
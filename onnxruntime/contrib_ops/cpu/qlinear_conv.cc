@@ -0,0 +1,205 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/qlinear_conv.h"
+
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    QLinearConv,
+    1,
+    uint8_t,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<int32_t>()),
+    QLinearConv);
+
+// expand the channels x D1 x ... x Dn image into a (channels * kernel size) x (output size) matrix, filling the
+// positions that fall in the padding with padding_value
+static void Im2col(const uint8_t* image, int64_t channels, const std::vector<int64_t>& image_shape,
+                   const std::vector<int64_t>& output_shape, const std::vector<int64_t>& kernel_shape,
+                   const std::vector<int64_t>& strides, const std::vector<int64_t>& dilations,
+                   const std::vector<int64_t>& pads, uint8_t padding_value, uint8_t* col) {
+  const size_t rank = kernel_shape.size();
+  const int64_t image_size = TensorShape(image_shape).Size();
+  const int64_t kernel_size = TensorShape(kernel_shape).Size();
+  const int64_t output_size = TensorShape(output_shape).Size();
+
+  std::vector<int64_t> kernel_index(rank);
+  std::vector<int64_t> output_index(rank);
+  for (int64_t c = 0; c < channels; ++c, image += image_size) {
+    for (int64_t k = 0; k < kernel_size; ++k) {
+      int64_t remainder = k;
+      for (size_t d = rank; d-- > 0;) {
+        kernel_index[d] = remainder % kernel_shape[d];
+        remainder /= kernel_shape[d];
+      }
+
+      std::fill(output_index.begin(), output_index.end(), 0);
+      for (int64_t o = 0; o < output_size; ++o) {
+        int64_t offset = 0;
+        bool is_padding = false;
+        for (size_t d = 0; d < rank; ++d) {
+          const int64_t i = output_index[d] * strides[d] - pads[d] + kernel_index[d] * dilations[d];
+          is_padding |= i < 0 || i >= image_shape[d];
+          offset = offset * image_shape[d] + i;
+        }
+        *col++ = is_padding ? padding_value : image[offset];
+
+        for (size_t d = rank; d-- > 0;) {
+          if (++output_index[d] < output_shape[d]) {
+            break;
+          }
+          output_index[d] = 0;
+        }
+      }
+    }
+  }
+}
+
+Status QLinearConv::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const Tensor* x_scale = context->Input<Tensor>(1);
+  const Tensor* x_zero_point = context->Input<Tensor>(2);
+  const Tensor* W = context->Input<Tensor>(3);
+  const Tensor* w_scale = context->Input<Tensor>(4);
+  const Tensor* w_zero_point = context->Input<Tensor>(5);
+  const Tensor* y_scale = context->Input<Tensor>(6);
+  const Tensor* y_zero_point = context->Input<Tensor>(7);
+  const Tensor* B = context->Input<Tensor>(8);
+
+  const int64_t N = X->Shape()[0];
+  const int64_t C = X->Shape()[1];
+  const int64_t M = W->Shape()[0];
+  ORT_RETURN_IF_ERROR(ValidateInputShape(X, W));
+
+  ORT_RETURN_IF_NOT(x_scale->Shape().Size() == 1 && x_zero_point->Shape().Size() == 1 &&
+                        w_zero_point->Shape().Size() == 1 && y_scale->Shape().Size() == 1 &&
+                        y_zero_point->Shape().Size() == 1,
+                    "QLinearConv only supports per-tensor zero points and per-tensor input and output scales");
+  ORT_RETURN_IF_NOT(w_scale->Shape().Size() == 1 || w_scale->Shape().Size() == M,
+                    "QLinearConv: w_scale must have 1 or ", M, " elements");
+  ORT_RETURN_IF_NOT(B == nullptr || B->Shape().Size() == M, "QLinearConv: B must have ", M, " elements");
+
+  std::vector<int64_t> kernel_shape = ComputeKernelShape(W->Shape());
+  if (kernel_shape.size() + 2 != W->Shape().NumDimensions()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "kernel_shape num_dims is not compatible with W num_dims.",
+                           " kernel_shape: ", TensorShape(kernel_shape).ToString().c_str(),
+                           " W: ", W->Shape().ToString().c_str());
+  }
+  for (size_t i = 0; i < kernel_shape.size(); ++i) {
+    if (kernel_shape[i] != W->Shape()[i + 2]) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "kernel_shape is not compatible with W shape.",
+                             " kernel_shape: ", TensorShape(kernel_shape).ToString().c_str(),
+                             " W: ", W->Shape().ToString().c_str());
+    }
+  }
+
+  std::vector<int64_t> pads(pads_);
+  if (pads.empty()) {
+    pads.resize(kernel_shape.size() * 2, 0);
+  }
+  std::vector<int64_t> dilations(dilations_);
+  if (dilations.empty()) {
+    dilations.resize(kernel_shape.size(), 1);
+  }
+  std::vector<int64_t> strides(strides_);
+  if (strides.empty()) {
+    strides.resize(kernel_shape.size(), 1);
+  }
+
+  std::vector<int64_t> Y_dims({N, M});
+  TensorShape input_shape = X->Shape().Slice(2);
+  ORT_RETURN_IF_ERROR(InferOutputShape(input_shape, kernel_shape, strides, dilations, &pads, &Y_dims));
+  Tensor* Y = context->Output(0, TensorShape(Y_dims));
+  TensorShape output_shape = Y->Shape().Slice(2);
+
+  const int64_t input_image_size = input_shape.Size();
+  const int64_t output_image_size = output_shape.Size();
+  const int64_t kernel_size = TensorShape(kernel_shape).Size();
+  const int64_t group_input_channels = C / group_;
+  const int64_t group_output_channels = M / group_;
+  const int64_t X_offset = group_input_channels * input_image_size;
+  const int64_t Y_offset = group_output_channels * output_image_size;
+  const int64_t W_offset = W->Shape().Size() / group_;
+  const int64_t kernel_dim = group_input_channels * kernel_size;
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  // a pointwise convolution multiplies the weights by the input directly
+  bool is_pointwise = true;
+  for (size_t i = 0; i < kernel_shape.size(); ++i) {
+    is_pointwise &= kernel_shape[i] == 1 && strides[i] == 1 && pads[i] == 0 && pads[i + kernel_shape.size()] == 0;
+  }
+
+  // the scale of each output channel: (x - x_zero_point) * x_scale * (w - w_zero_point) * w_scale / y_scale
+  const float* w_scale_data = w_scale->template Data<float>();
+  const float x_y_scale = *x_scale->template Data<float>() / *y_scale->template Data<float>();
+  std::vector<float> output_scales(static_cast<size_t>(M));
+  for (int64_t m = 0; m < M; ++m) {
+    output_scales[m] = x_y_scale * (w_scale->Shape().Size() == 1 ? w_scale_data[0] : w_scale_data[m]);
+  }
+
+  const uint8_t x_zero_point_value = *x_zero_point->template Data<uint8_t>();
+  const uint8_t w_zero_point_value = *w_zero_point->template Data<uint8_t>();
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  BufferUniquePtr col_buffer;
+  if (!is_pointwise) {
+    col_buffer = BufferUniquePtr(alloc->Alloc(sizeof(uint8_t) * kernel_dim * output_image_size), BufferDeleter(alloc));
+  }
+  BufferUniquePtr product_buffer(alloc->Alloc(sizeof(int32_t) * Y_offset), BufferDeleter(alloc));
+  uint8_t* col_data = static_cast<uint8_t*>(col_buffer.get());
+  int32_t* product_data = static_cast<int32_t*>(product_buffer.get());
+
+  const std::vector<int64_t>& image_shape = input_shape.GetDims();
+  const uint8_t* Xdata = X->template Data<uint8_t>();
+  uint8_t* Ydata = Y->template MutableData<uint8_t>();
+
+  for (int64_t image_id = 0; image_id < N; ++image_id) {
+    for (int64_t group_id = 0; group_id < group_; ++group_id) {
+      const uint8_t* group_input = Xdata + group_id * X_offset;
+      if (!is_pointwise) {
+        Im2col(group_input, group_input_channels, image_shape, output_shape.GetDims(), kernel_shape, strides,
+               dilations, pads, x_zero_point_value, col_data);
+        group_input = col_data;
+      }
+
+      MLAS_REQUANTIZE_PARAMETERS requantize;
+      requantize.Output = Ydata + group_id * Y_offset;
+      requantize.ldo = static_cast<size_t>(output_image_size);
+      requantize.Bias = B != nullptr ? B->template Data<int32_t>() + group_id * group_output_channels : nullptr;
+      requantize.Scale = output_scales.data() + group_id * group_output_channels;
+      requantize.PerRowScale = true;
+      requantize.ZeroPoint = *y_zero_point->template Data<uint8_t>();
+
+      MlasQgemm(static_cast<size_t>(group_output_channels),
+                static_cast<size_t>(output_image_size),
+                static_cast<size_t>(kernel_dim),
+                W->template Data<uint8_t>() + group_id * W_offset,
+                static_cast<size_t>(kernel_dim),
+                w_zero_point_value,
+                group_input,
+                static_cast<size_t>(output_image_size),
+                x_zero_point_value,
+                product_data,
+                static_cast<size_t>(output_image_size),
+                &requantize,
+                context->GetOperatorThreadPool());
+    }
+
+    Xdata += X_offset * group_;
+    Ydata += Y_offset * group_;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/cpu/nn/conv_base.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+/**
+  * Convolution of a quantized uint8 input with quantized uint8 weights, producing a quantized uint8 output.
+  * The input is expanded with im2col, padded with its zero point, and multiplied by the weights with the MLAS QGEMM
+  * kernels, which requantize the 32-bit results while they are still in cache. The weights may have one scale per
+  * output channel; the other scales and all zero points must be per-tensor.
+  */
+class QLinearConv final : public OpKernel, public ConvBase {
+ public:
+  explicit QLinearConv(const OpKernelInfo& info) : OpKernel(info), ConvBase(info) {}
+
+  Status Compute(OpKernelContext* context) const override;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
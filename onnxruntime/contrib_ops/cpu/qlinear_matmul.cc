@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/qlinear_matmul.h"
+
+#include "core/mlas/inc/mlas.h"
+#include "core/providers/cpu/math/matmul_helper.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    QLinearMatMul,
+    1,
+    uint8_t,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("T3", DataTypeImpl::GetTensorType<uint8_t>()),
+    QLinearMatMul<uint8_t>);
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    QLinearMatMul,
+    1,
+    int8_t,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<int8_t>())
+        .TypeConstraint("T3", DataTypeImpl::GetTensorType<uint8_t>()),
+    QLinearMatMul<int8_t>);
+
+static bool IsScalar(const Tensor& tensor) {
+  return tensor.Shape().Size() == 1;
+}
+
+template <typename T2>
+Status QLinearMatMul<T2>::Compute(OpKernelContext* ctx) const {
+  const Tensor* a = ctx->Input<Tensor>(0);
+  const Tensor* a_scale = ctx->Input<Tensor>(1);
+  const Tensor* a_zero_point = ctx->Input<Tensor>(2);
+  const Tensor* b = ctx->Input<Tensor>(3);
+  const Tensor* b_scale = ctx->Input<Tensor>(4);
+  const Tensor* b_zero_point = ctx->Input<Tensor>(5);
+  const Tensor* y_scale = ctx->Input<Tensor>(6);
+  const Tensor* y_zero_point = ctx->Input<Tensor>(7);
+
+  ORT_RETURN_IF_NOT(IsScalar(*a_scale) && IsScalar(*a_zero_point) && IsScalar(*b_scale) &&
+                        IsScalar(*b_zero_point) && IsScalar(*y_scale) && IsScalar(*y_zero_point),
+                    "QLinearMatMul only supports per-tensor quantization");
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b->Shape()));
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+  if (M == 0 || N == 0) {
+    return Status::OK();
+  }
+
+  // (a - a_zero_point) * a_scale * (b - b_zero_point) * b_scale / y_scale + y_zero_point
+  const float scale = *a_scale->template Data<float>() * *b_scale->template Data<float>() /
+                      *y_scale->template Data<float>();
+
+  MLAS_REQUANTIZE_PARAMETERS requantize;
+  requantize.ldo = N;
+  requantize.Bias = nullptr;
+  requantize.Scale = &scale;
+  requantize.PerRowScale = false;
+  requantize.ZeroPoint = *y_zero_point->template Data<uint8_t>();
+
+  // the 32-bit products of one matrix of the batch
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
+  BufferUniquePtr product_buffer(alloc->Alloc(sizeof(int32_t) * M * N), BufferDeleter(alloc));
+  int32_t* product = static_cast<int32_t*>(product_buffer.get());
+
+  for (size_t i = 0; i < helper.OutputOffsets().size(); i++) {
+    requantize.Output = y->template MutableData<uint8_t>() + helper.OutputOffsets()[i];
+    MlasQgemm(M, N, K,
+              a->template Data<uint8_t>() + helper.LeftOffsets()[i], K, *a_zero_point->template Data<uint8_t>(),
+              b->template Data<T2>() + helper.RightOffsets()[i], N, *b_zero_point->template Data<T2>(),
+              product, N,
+              &requantize,
+              ctx->GetOperatorThreadPool());
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+/**
+  * Multiplies a quantized uint8 matrix A by a quantized uint8 or int8 matrix B and requantizes the result to uint8.
+  * The 32-bit products are requantized by the MLAS QGEMM kernels block by block, while they are still in cache.
+  * Only per-tensor scales and zero points are supported. T2 is the element type of B.
+  */
+template <typename T2>
+class QLinearMatMul final : public OpKernel {
+ public:
+  explicit QLinearMatMul(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status Compute(OpKernelContext* context) const override;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
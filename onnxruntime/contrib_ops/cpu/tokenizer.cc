@@ -456,7 +456,7 @@ Status Tokenizer::Compute(OpKernelContext* ctx) const {
                   "tensor(string) expected as input");
   }
 
-  auto& input_dims = X->Shape().GetDims();
+  const auto& input_dims = X->Shape().GetDims();
   size_t N = 0;
   size_t C = 0;
   if (input_dims.size() == 1) {
@@ -0,0 +1,118 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+namespace concurrency {
+
+/**
+ * Bounded multi-producer/multi-consumer lock-free queue.
+ *
+ * Each slot carries a sequence number which tells producers and consumers whether the slot is free
+ * to write or ready to read for the current lap around the ring, so both ends only need a single
+ * compare-and-swap on their respective position to claim a slot (D. Vyukov's bounded MPMC queue).
+ *
+ * The capacity is rounded up to the next power of two. TryPush fails if the queue is full and
+ * TryPop fails if it is empty; neither blocks.
+ */
+template <typename T>
+class LockFreeQueue {
+ public:
+  explicit LockFreeQueue(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) {
+      size <<= 1;
+    }
+
+    mask_ = size - 1;
+    slots_ = std::make_unique<Slot[]>(size);
+    for (size_t i = 0; i < size; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    enqueue_pos_.value.store(0, std::memory_order_relaxed);
+    dequeue_pos_.value.store(0, std::memory_order_relaxed);
+  }
+
+  size_t Capacity() const { return mask_ + 1; }
+
+  bool TryPush(T value) {
+    Slot* slot;
+    size_t pos = enqueue_pos_.value.load(std::memory_order_relaxed);
+    for (;;) {
+      slot = &slots_[pos & mask_];
+      size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        // the slot from the previous lap has not been consumed yet
+        return false;
+      } else {
+        pos = enqueue_pos_.value.load(std::memory_order_relaxed);
+      }
+    }
+
+    slot->value = std::move(value);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool TryPop(T& value) {
+    Slot* slot;
+    size_t pos = dequeue_pos_.value.load(std::memory_order_relaxed);
+    for (;;) {
+      slot = &slots_[pos & mask_];
+      size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos_.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        // nothing has been published to this slot yet
+        return false;
+      } else {
+        pos = dequeue_pos_.value.load(std::memory_order_relaxed);
+      }
+    }
+
+    value = std::move(slot->value);
+    slot->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(LockFreeQueue);
+
+  // keep the producer and consumer positions on separate cache lines so the two ends don't contend.
+  static constexpr size_t kCacheLineSize = 64;
+
+  struct Slot {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  struct Position {
+    char pad[kCacheLineSize];
+    std::atomic<size_t> value;
+  };
+
+  std::unique_ptr<Slot[]> slots_;
+  size_t mask_;
+  Position enqueue_pos_;
+  Position dequeue_pos_;
+};
+
+}  // namespace concurrency
+}  // namespace onnxruntime
@@ -7,6 +7,11 @@ namespace onnxruntime {
 namespace profiling {
 using namespace std::chrono;
 
+Profiler::Profiler() noexcept {
+  static std::atomic<uint64_t> next_id{1};
+  id_ = next_id++;
+}
+
 ::onnxruntime::TimePoint profiling::Profiler::StartTime() const {
   return std::chrono::high_resolution_clock::now();
 }
@@ -24,10 +29,32 @@ void Profiler::StartProfiling(const logging::Logger* custom_logger) {
 }
 
 void Profiler::StartProfiling(const std::string& file_name) {
-  enabled_ = true;
   profile_stream_ = std::ofstream(file_name, std::ios::out | std::ios::trunc);
   profile_stream_file_ = file_name;
   profiling_start_time_ = StartTime();
+  enabled_ = true;
+}
+
+Profiler::ThreadEventBuffer& Profiler::GetThreadEventBuffer() {
+  // cache the buffer of the last Profiler this thread recorded into. the id rather than the Profiler address
+  // is compared as a Profiler may be destroyed and another one created at the same address.
+  static thread_local uint64_t cached_profiler_id = 0;
+  static thread_local ThreadEventBuffer* cached_buffer = nullptr;
+
+  if (cached_profiler_id == id_) {
+    return *cached_buffer;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& buffer = thread_buffer_map_[std::this_thread::get_id()];
+  if (buffer == nullptr) {
+    thread_buffers_.push_back(std::make_unique<ThreadEventBuffer>(logging::GetThreadId()));
+    buffer = thread_buffers_.back().get();
+  }
+
+  cached_profiler_id = id_;
+  cached_buffer = buffer;
+  return *buffer;
 }
 
 void Profiler::EndTimeAndRecordEvent(EventCategory category,
@@ -35,28 +62,35 @@ void Profiler::EndTimeAndRecordEvent(EventCategory category,
                                      TimePoint& start_time,
                                      const std::initializer_list<std::pair<std::string, std::string>>& event_args,
                                      bool /*sync_gpu*/) {
-  if (!enabled_ && !profile_with_logger_)
+  if (!IsEnabled())
     return;
   long long dur = TimeDiffMicroSeconds(start_time);
   long long ts = TimeDiffMicroSeconds(profiling_start_time_, start_time);
 
-  EventRecord event(category, logging::GetProcessId(),
-                    logging::GetThreadId(), event_name, ts, dur, { event_args.begin(), event_args.end() });
   if (profile_with_logger_) {
+    EventRecord event(category, logging::GetProcessId(),
+                      logging::GetThreadId(), event_name, ts, dur, {event_args.begin(), event_args.end()});
     custom_logger_->SendProfileEvent(event);
-  } else {
-    //TODO: sync_gpu if needed.
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (events_.size() < max_num_events_) {
-      events_.emplace_back(event);
+    return;
+  }
+
+  //TODO: sync_gpu if needed.
+  auto& buffer = GetThreadEventBuffer();
+
+  // pairs with EndProfiling, which clears enabled_ and then waits for recording to be false: either this thread
+  // sees that profiling has ended, or EndProfiling waits for this event to be written.
+  buffer.recording.store(true, std::memory_order_seq_cst);
+  if (enabled_.load(std::memory_order_seq_cst)) {
+    EventRecord event(category, logging::GetProcessId(),
+                      buffer.tid, event_name, ts, dur, {event_args.begin(), event_args.end()});
+    if (buffer.events.size() < max_num_events_) {
+      buffer.events.push_back(std::move(event));
     } else {
-      if (session_logger_ && !max_events_reached) {
-        LOGS(*session_logger_, ERROR)
-            << "Maximum number of events reached, could not record profile event.";
-        max_events_reached = true;
-      }
+      buffer.events[buffer.num_recorded % max_num_events_] = std::move(event);
     }
+    ++buffer.num_recorded;
   }
+  buffer.recording.store(false, std::memory_order_release);
 }
 
 std::string Profiler::EndProfiling() {
@@ -67,11 +101,36 @@ std::string Profiler::EndProfiling() {
     profile_with_logger_ = false;
     return std::string();
   }
+
+  enabled_ = false;  // will not collect profile after writing.
+
   std::lock_guard<std::mutex> lock(mutex_);
+
+  // gather the events of all threads, oldest first for each thread
+  std::vector<const EventRecord*> events;
+  bool max_events_reached = false;
+  for (const auto& buffer : thread_buffers_) {
+    while (buffer->recording.load(std::memory_order_acquire)) {
+      std::this_thread::yield();
+    }
+
+    const size_t num_events = buffer->events.size();
+    const size_t first = buffer->num_recorded > num_events ? buffer->num_recorded % num_events : 0;
+    max_events_reached = max_events_reached || buffer->num_recorded > num_events;
+    for (size_t i = 0; i < num_events; ++i) {
+      events.push_back(&buffer->events[(first + i) % num_events]);
+    }
+  }
+
+  if (max_events_reached && session_logger_) {
+    LOGS(*session_logger_, ERROR)
+        << "Maximum number of events reached on a thread. The oldest profile events were dropped.";
+  }
+
   profile_stream_ << "[\n";
 
-  for (size_t i = 0; i < events_.size(); ++i) {
-    auto& rec = events_[i];
+  for (size_t i = 0; i < events.size(); ++i) {
+    auto& rec = *events[i];
     profile_stream_ << R"({"cat" : ")" << event_categor_names_[rec.cat] << "\",";
     profile_stream_ << "\"pid\" :" << rec.pid << ",";
     profile_stream_ << "\"tid\" :" << rec.tid << ",";
@@ -87,7 +146,7 @@ std::string Profiler::EndProfiling() {
       is_first_arg = false;
     }
     profile_stream_ << "}";
-    if (i == events_.size() - 1) {
+    if (i == events.size() - 1) {
       profile_stream_ << "}\n";
     } else {
       profile_stream_ << "},\n";
@@ -95,7 +154,13 @@ std::string Profiler::EndProfiling() {
   }
   profile_stream_ << "]\n";
   profile_stream_.close();
-  enabled_ = false;  // will not collect profile after writing.
+
+  // the buffers stay registered as other threads may still hold them, but their events can be released.
+  for (const auto& buffer : thread_buffers_) {
+    std::vector<EventRecord>().swap(buffer->events);
+    buffer->num_recorded = 0;
+  }
+
   return profile_stream_file_;
 }
 
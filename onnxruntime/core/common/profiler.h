@@ -2,10 +2,14 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <atomic>
 #include <iostream>
 #include <fstream>
+#include <memory>
+#include <thread>
 #include <tuple>
 #include <initializer_list>
+#include <unordered_map>
 #include "core/common/logging/logging.h"
 
 namespace onnxruntime {
@@ -18,7 +22,7 @@ a corresponding "complete event (X)" in "chrome tracing" format.
 */
 class Profiler {
  public:
-  Profiler() noexcept {};  // turned off by default.
+  Profiler() noexcept;  // turned off by default.
 
   /*
   Initializes Profiler with the session logger to log framework specific messages
@@ -35,6 +39,14 @@ class Profiler {
   */
   void StartProfiling(const std::string& file_name);
 
+  /*
+  Whether events are being recorded. Hot paths should check this before building event names and
+  arguments, so profiling costs nothing when it is off.
+  */
+  bool IsEnabled() const {
+    return enabled_.load(std::memory_order_relaxed) || profile_with_logger_.load(std::memory_order_relaxed);
+  }
+
   /*
   Produce current time point for any profiling action.
   */
@@ -43,6 +55,7 @@ class Profiler {
   /*
   Record a single event. Time is measured till the call of this function from
   the start_time.
+  Events are recorded without taking a lock, into a buffer owned by the calling thread.
   */
   void EndTimeAndRecordEvent(EventCategory category,
                              const std::string& event_name,
@@ -59,18 +72,37 @@ class Profiler {
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Profiler);
 
+  // Ring buffer of the events recorded by one thread. Only the owning thread writes to it. Once full,
+  // the oldest events are overwritten.
+  struct ThreadEventBuffer {
+    explicit ThreadEventBuffer(int thread_id) : tid(thread_id) {}
+
+    const int tid;
+    std::vector<EventRecord> events;
+    size_t num_recorded{0};  // total number of events recorded, including overwritten ones
+    // set while the owner is recording, so EndProfiling can wait for an in-flight event
+    std::atomic<bool> recording{false};
+  };
+
+  ThreadEventBuffer& GetThreadEventBuffer();
+
   // Mutex controlling access to profiler data
   std::mutex mutex_;
-  bool enabled_{false};
+  std::atomic<bool> enabled_{false};
   std::ofstream profile_stream_;
   std::string profile_stream_file_;
   const logging::Logger* session_logger_{nullptr};
   const logging::Logger* custom_logger_{nullptr};
   TimePoint profiling_start_time_;
-  std::vector<EventRecord> events_;
-  bool max_events_reached{false};
-  static constexpr size_t max_num_events_ = 1000000;
-  bool profile_with_logger_{false};
+  // unique id of this profiler, used by threads to look up their buffer.
+  uint64_t id_;
+  // buffers of all the threads that recorded events, in the order they were created. Buffers are kept for
+  // the lifetime of the profiler as a thread may still be using its buffer when profiling ends.
+  // protected by mutex_
+  std::vector<std::unique_ptr<ThreadEventBuffer>> thread_buffers_;
+  std::unordered_map<std::thread::id, ThreadEventBuffer*> thread_buffer_map_;  // protected by mutex_
+  static constexpr size_t max_num_events_ = 1000000;  // per thread
+  std::atomic<bool> profile_with_logger_{false};
 };
 
 }  // namespace profiling
@@ -4,12 +4,24 @@
 #include "core/framework/bfc_arena.h"
 
 namespace onnxruntime {
+namespace {
+std::atomic<uint64_t> next_arena_id{1};
+}  // namespace
+
+const size_t BFCArena::kDefaultThreadCacheCapacity;
+
 BFCArena::BFCArena(std::unique_ptr<IDeviceAllocator> resource_allocator,
-                   size_t total_memory)
+                   size_t total_memory,
+                   size_t thread_cache_capacity)
     : device_allocator_(std::move(resource_allocator)),
       free_chunks_list_(kInvalidChunkHandle),
       next_allocation_id_(1),
-      info_(device_allocator_->Info().name, OrtAllocatorType::OrtArenaAllocator, device_allocator_->Info().id, device_allocator_->Info().mem_type) {
+      info_(device_allocator_->Info().name, OrtAllocatorType::OrtArenaAllocator, device_allocator_->Info().id, device_allocator_->Info().mem_type),
+      thread_cache_capacity_(thread_cache_capacity),
+      id_(next_arena_id++),
+      thread_cache_owner_(std::make_shared<ThreadCacheOwner>()) {
+  thread_cache_owner_->arena = this;
+
   curr_region_allocation_bytes_ = RoundedBytes(std::min(total_memory, size_t{1048576}));
 
   // Allocate the requested amount of memory.
@@ -35,6 +47,12 @@ BFCArena::BFCArena(std::unique_ptr<IDeviceAllocator> resource_allocator,
 }
 
 BFCArena::~BFCArena() {
+  {
+    // the caches of threads that are still running are dropped along with the regions
+    std::lock_guard<std::mutex> lock(thread_cache_owner_->mutex);
+    thread_cache_owner_->arena = nullptr;
+  }
+
   for (const auto& region : region_manager_.regions()) {
     device_allocator_->Free(region.ptr());
   }
@@ -110,6 +128,15 @@ bool BFCArena::Extend(size_t rounded_bytes) {
                      << static_cast<void*>(static_cast<char*>(mem_addr) + bytes);
   region_manager_.AddAllocationRegion(mem_addr, bytes);
 
+  const int num_cacheable_regions = num_cacheable_regions_.load(std::memory_order_relaxed);
+  if (thread_cache_capacity_ > 0 && num_cacheable_regions < kMaxCacheableRegions) {
+    CacheableRegion& region = cacheable_regions_[num_cacheable_regions];
+    region.ptr = static_cast<const char*>(mem_addr);
+    region.end_ptr = region.ptr + bytes;
+    region.requested_sizes.reset(new std::atomic<uint32_t>[bytes / kMinAllocationSize]());
+    num_cacheable_regions_.store(num_cacheable_regions + 1, std::memory_order_release);
+  }
+
   // Create one large chunk for the whole memory space that will
   // be chunked later.
   ChunkHandle h = AllocateChunk();
@@ -160,14 +187,34 @@ size_t BFCArena::RoundedBytes(size_t bytes) {
 }
 
 void* BFCArena::Alloc(size_t size) {
-  return AllocateRawInternal(size, false);
+  if (thread_cache_capacity_ > 0 && size > 0 && RoundedBytes(size) <= kMaxThreadCacheChunkSize) {
+    return AllocateFromThreadCache(size);
+  }
+
+  void* ptr = AllocateRawInternal(size, false);
+  if (ptr == nullptr && size > 0 && thread_cache_capacity_ > 0) {
+    thread_cache_drain_epoch_.fetch_add(1);
+    if (DrainThreadCache(&GetThreadCache())) {
+      ptr = AllocateRawInternal(size, false);
+    }
+  }
+  return ptr;
+}
+
+std::unique_lock<std::mutex> BFCArena::LockArena() {
+  std::unique_lock<std::mutex> lock(lock_, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    num_lock_contentions_.fetch_add(1, std::memory_order_relaxed);
+    lock.lock();
+  }
+  return lock;
 }
 
 void* BFCArena::Reserve(size_t size) {
   if (size == 0)
     return nullptr;
 
-  std::lock_guard<std::mutex> lock(lock_);
+  auto lock = LockArena();
   void* ptr = device_allocator_->Alloc(size);
   ORT_ENFORCE(reserved_chunks_.find(ptr) == reserved_chunks_.end());
   reserved_chunks_.insert(std::pair<void*, size_t>(ptr, size));
@@ -180,6 +227,14 @@ void* BFCArena::Reserve(size_t size) {
 }
 
 size_t BFCArena::RequestedSize(const void* ptr) {
+  // the arena only knows the rounded size of an allocation served from a thread cache
+  if (const std::atomic<uint32_t>* slot = CacheableRequestedSize(ptr)) {
+    const uint32_t requested_size = slot->load(std::memory_order_relaxed);
+    if (requested_size != 0) {
+      return requested_size;
+    }
+  }
+
   std::lock_guard<std::mutex> lock(lock_);
   BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
   ORT_ENFORCE(h != kInvalidChunkHandle);
@@ -196,7 +251,8 @@ size_t BFCArena::AllocatedSize(const void* ptr) {
 }
 
 void* BFCArena::AllocateRawInternal(size_t num_bytes,
-                                    bool dump_log_on_failure) {
+                                    bool dump_log_on_failure,
+                                    size_t* allocated_size) {
   if (num_bytes == 0) {
     LOGS_DEFAULT(WARNING) << "tried to allocate 0 bytes";
     return nullptr;
@@ -209,18 +265,19 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   // The BFC allocator tries to find the best fit first.
   BinNum bin_num = BinNumForSize(rounded_bytes);
 
-  std::lock_guard<std::mutex> lock(lock_);
+  auto lock = LockArena();
   void* ptr = FindChunkPtr(bin_num, rounded_bytes, num_bytes);
-  if (ptr != nullptr) {
-    return ptr;
-  }
 
   // Try to extend
-  if (Extend(rounded_bytes)) {
+  if (ptr == nullptr && Extend(rounded_bytes)) {
     ptr = FindChunkPtr(bin_num, rounded_bytes, num_bytes);
-    if (ptr != nullptr) {
-      return ptr;
+  }
+
+  if (ptr != nullptr) {
+    if (allocated_size != nullptr) {
+      *allocated_size = ChunkFromHandle(region_manager_.get_handle(ptr))->size;
     }
+    return ptr;
   }
 
   // We searched all bins for an existing free chunk to use and
@@ -238,6 +295,28 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
 void BFCArena::GetStats(AllocatorStats* stats) {
   std::lock_guard<std::mutex> lock(lock_);
   *stats = stats_;
+
+  // the chunks in the thread caches are in use as far as the arena is concerned, and allocations served from a
+  // thread cache don't reach the arena. max_bytes_in_use includes the bytes held in the caches at the time.
+  stats->num_thread_cache_hits = retired_thread_cache_hits_;
+  stats->num_thread_cache_misses = retired_thread_cache_misses_;
+  for (const ThreadCache* cache : thread_caches_) {
+    stats->num_thread_cache_hits += cache->num_hits.load(std::memory_order_relaxed);
+    stats->num_thread_cache_misses += cache->num_misses.load(std::memory_order_relaxed);
+    stats->bytes_in_thread_caches += cache->bytes_cached.load(std::memory_order_relaxed);
+  }
+  stats->bytes_in_use -= stats->bytes_in_thread_caches;
+  stats->num_allocs += stats->num_thread_cache_hits;
+  stats->num_lock_contentions = num_lock_contentions_.load();
+}
+
+size_t BFCArena::Used() const {
+  std::lock_guard<std::mutex> lock(lock_);
+  int64_t used = stats_.bytes_in_use;
+  for (const ThreadCache* cache : thread_caches_) {
+    used -= cache->bytes_cached.load(std::memory_order_relaxed);
+  }
+  return static_cast<size_t>(used);
 }
 
 void* BFCArena::FindChunkPtr(BinNum bin_num, size_t rounded_bytes,
@@ -328,7 +407,16 @@ void BFCArena::Free(void* p) {
   if (p == nullptr) {
     return;
   }
-  std::lock_guard<std::mutex> lock(lock_);
+
+  if (std::atomic<uint32_t>* slot = CacheableRequestedSize(p)) {
+    const uint32_t requested_size = slot->load(std::memory_order_relaxed);
+    if (requested_size != 0) {
+      FreeToThreadCache(p, requested_size);
+      return;
+    }
+  }
+
+  auto lock = LockArena();
   auto it = reserved_chunks_.find(p);
   if (it != reserved_chunks_.end()) {
     device_allocator_->Free(it->first);
@@ -340,6 +428,183 @@ void BFCArena::Free(void* p) {
   }
 }
 
+std::atomic<uint32_t>* BFCArena::CacheableRequestedSize(const void* ptr) const {
+  const int num_regions = num_cacheable_regions_.load(std::memory_order_acquire);
+  const char* p = static_cast<const char*>(ptr);
+  for (int i = 0; i < num_regions; ++i) {
+    const CacheableRegion& region = cacheable_regions_[i];
+    if (p >= region.ptr && p < region.end_ptr) {
+      return &region.requested_sizes[static_cast<size_t>(p - region.ptr) >> kMinAllocationBits];
+    }
+  }
+  return nullptr;
+}
+
+BFCArena::ThreadCache::~ThreadCache() {
+  std::lock_guard<std::mutex> lock(owner->mutex);
+  if (owner->arena != nullptr) {
+    owner->arena->ReleaseThreadCache(this);
+  }
+}
+
+BFCArena::ThreadCache& BFCArena::GetThreadCache() {
+  // the caches of all the arenas used by this thread, destroyed when the thread exits. a thread usually uses one
+  // or two arenas, e.g. the CPU arena and the arena of a GPU.
+  static thread_local std::vector<std::unique_ptr<ThreadCache>> thread_caches;
+
+  for (const auto& cache : thread_caches) {
+    if (cache->arena_id == id_) {
+      return *cache;
+    }
+  }
+
+  // drop the caches of arenas that were destroyed
+  thread_caches.erase(std::remove_if(thread_caches.begin(), thread_caches.end(),
+                                     [](const std::unique_ptr<ThreadCache>& cache) {
+                                       std::lock_guard<std::mutex> lock(cache->owner->mutex);
+                                       return cache->owner->arena == nullptr;
+                                     }),
+                      thread_caches.end());
+
+  auto cache = std::make_unique<ThreadCache>(id_, thread_cache_owner_, thread_cache_drain_epoch_.load());
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    thread_caches_.push_back(cache.get());
+  }
+  thread_caches.push_back(std::move(cache));
+  return *thread_caches.back();
+}
+
+void* BFCArena::AllocateFromThreadCache(size_t num_bytes) {
+  const size_t rounded_bytes = RoundedBytes(num_bytes);
+  ThreadCache& cache = GetThreadCache();
+
+  if (cache.drain_epoch != thread_cache_drain_epoch_.load(std::memory_order_relaxed)) {
+    DrainThreadCache(&cache);
+  }
+
+  auto& chunks = cache.classes[ThreadCacheClass(rounded_bytes)];
+  void* ptr;
+  if (!chunks.empty()) {
+    ptr = chunks.back();
+    chunks.pop_back();
+    cache.cached_bytes -= rounded_bytes;
+    size_t& low_water_mark = cache.low_water_marks[ThreadCacheClass(rounded_bytes)];
+    low_water_mark = std::min(low_water_mark, chunks.size());
+    cache.bytes_cached.store(static_cast<int64_t>(cache.cached_bytes), std::memory_order_relaxed);
+    cache.num_hits.store(cache.num_hits.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  } else {
+    cache.num_misses.store(cache.num_misses.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    size_t allocated_size = 0;
+    ptr = AllocateRawInternal(num_bytes, false, &allocated_size);
+    if (ptr == nullptr) {
+      thread_cache_drain_epoch_.fetch_add(1);
+      if (DrainThreadCache(&cache)) {
+        ptr = AllocateRawInternal(num_bytes, false, &allocated_size);
+      }
+    }
+
+    // a chunk that wasn't split is left to the arena, so every chunk of a class has the size of the class
+    if (ptr == nullptr || allocated_size != rounded_bytes) {
+      return ptr;
+    }
+  }
+
+  // null if the chunk is in a region added after the last cacheable one
+  if (std::atomic<uint32_t>* slot = CacheableRequestedSize(ptr)) {
+    slot->store(static_cast<uint32_t>(num_bytes), std::memory_order_relaxed);
+  }
+  return ptr;
+}
+
+void BFCArena::FreeToThreadCache(void* p, size_t requested_size) {
+  const size_t rounded_bytes = RoundedBytes(requested_size);
+  ThreadCache& cache = GetThreadCache();
+
+  if (cache.drain_epoch != thread_cache_drain_epoch_.load(std::memory_order_relaxed)) {
+    DrainThreadCache(&cache);
+  }
+
+  std::vector<void*> chunks_to_return;
+  cache.classes[ThreadCacheClass(rounded_bytes)].push_back(p);
+  cache.cached_bytes += rounded_bytes;
+
+  if (cache.cached_bytes > thread_cache_capacity_) {
+    // give back more than the excess, so the next frees don't have to take the arena lock again
+    TrimThreadCache(&cache, thread_cache_capacity_ / 2, &chunks_to_return);
+  } else if (++cache.frees_since_scavenge >= kThreadCacheScavengeInterval) {
+    ScavengeThreadCache(&cache, &chunks_to_return);
+  }
+
+  if (!chunks_to_return.empty()) {
+    ReturnToArena(&cache, chunks_to_return);
+  } else {
+    cache.bytes_cached.store(static_cast<int64_t>(cache.cached_bytes), std::memory_order_relaxed);
+  }
+}
+
+void BFCArena::TrimThreadCache(ThreadCache* cache, size_t max_cached_bytes, std::vector<void*>* chunks) {
+  // the largest chunks first, as they are the least likely to be reused
+  for (size_t c = kNumThreadCacheClasses; c-- > 0 && cache->cached_bytes > max_cached_bytes;) {
+    auto& bin = cache->classes[c];
+    size_t num_to_return = 0;
+    while (num_to_return < bin.size() && cache->cached_bytes > max_cached_bytes) {
+      cache->cached_bytes -= ThreadCacheClassSize(c);
+      ++num_to_return;
+    }
+    chunks->insert(chunks->end(), bin.begin(), bin.begin() + num_to_return);
+    bin.erase(bin.begin(), bin.begin() + num_to_return);
+    cache->low_water_marks[c] = std::min(cache->low_water_marks[c], bin.size());
+  }
+}
+
+void BFCArena::ScavengeThreadCache(ThreadCache* cache, std::vector<void*>* chunks) {
+  // return half of the chunks each class didn't need during the last interval, so the cache shrinks gradually
+  // when the thread stops allocating a size.
+  for (size_t c = 0; c < kNumThreadCacheClasses; ++c) {
+    auto& bin = cache->classes[c];
+    const size_t num_to_return = std::min(bin.size(), (cache->low_water_marks[c] + 1) / 2);
+    chunks->insert(chunks->end(), bin.begin(), bin.begin() + num_to_return);
+    bin.erase(bin.begin(), bin.begin() + num_to_return);
+    cache->cached_bytes -= num_to_return * ThreadCacheClassSize(c);
+    cache->low_water_marks[c] = bin.size();
+  }
+  cache->frees_since_scavenge = 0;
+}
+
+void BFCArena::ReturnToArena(ThreadCache* cache, const std::vector<void*>& chunks) {
+  auto lock = LockArena();
+  for (void* ptr : chunks) {
+    CacheableRequestedSize(ptr)->store(0, std::memory_order_relaxed);
+    DeallocateRawInternal(ptr);
+  }
+
+  // done under lock_ so GetStats sees bytes_in_use and the cached bytes change together
+  cache->bytes_cached.store(static_cast<int64_t>(cache->cached_bytes), std::memory_order_relaxed);
+}
+
+bool BFCArena::DrainThreadCache(ThreadCache* cache) {
+  cache->drain_epoch = thread_cache_drain_epoch_.load();
+
+  std::vector<void*> chunks;
+  TrimThreadCache(cache, 0, &chunks);
+  if (chunks.empty()) {
+    return false;
+  }
+
+  ReturnToArena(cache, chunks);
+  return true;
+}
+
+void BFCArena::ReleaseThreadCache(ThreadCache* cache) {
+  DrainThreadCache(cache);
+
+  std::lock_guard<std::mutex> lock(lock_);
+  retired_thread_cache_hits_ += cache->num_hits.load(std::memory_order_relaxed);
+  retired_thread_cache_misses_ += cache->num_misses.load(std::memory_order_relaxed);
+  thread_caches_.erase(std::find(thread_caches_.begin(), thread_caches_.end(), cache));
+}
+
 void BFCArena::DeallocateRawInternal(void* ptr) {
   // Find the chunk from the ptr.
   BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
@@ -16,9 +16,12 @@ limitations under the License.
 
 #pragma once
 #include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <unordered_map>
+#include <vector>
 
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
@@ -48,6 +51,11 @@ struct AllocatorStats {
                                   // unknown.
   int64_t bytes_limit;
 
+  int64_t num_thread_cache_hits;    // Number of allocations served from a per-thread cache.
+  int64_t num_thread_cache_misses;  // Number of cacheable allocations that went to the shared arena.
+  int64_t bytes_in_thread_caches;   // Number of bytes freed into the per-thread caches and not yet reused.
+  int64_t num_lock_contentions;     // Number of times the shared arena lock was already held by another thread.
+
   AllocatorStats() { Clear(); }
 
   void Clear() {
@@ -57,6 +65,10 @@ struct AllocatorStats {
     this->max_alloc_size = 0;
     this->bytes_limit = 0;
     this->total_allocated_bytes = 0;
+    this->num_thread_cache_hits = 0;
+    this->num_thread_cache_misses = 0;
+    this->bytes_in_thread_caches = 0;
+    this->num_lock_contentions = 0;
   }
 
   std::string DebugString() const {
@@ -66,7 +78,11 @@ struct AllocatorStats {
        << "TotalAllocated: " << this->total_allocated_bytes << "\n"
        << "MaxInUse:       " << this->max_bytes_in_use << "\n"
        << "NumAllocs:      " << this->num_allocs << "\n"
-       << "MaxAllocSize:   " << this->max_alloc_size << "\n";
+       << "MaxAllocSize:   " << this->max_alloc_size << "\n"
+       << "CacheHits:      " << this->num_thread_cache_hits << "\n"
+       << "CacheMisses:    " << this->num_thread_cache_misses << "\n"
+       << "InThreadCaches: " << this->bytes_in_thread_caches << "\n"
+       << "LockContention: " << this->num_lock_contentions << "\n";
     return ss.str();
   }
 };
@@ -79,9 +95,23 @@ struct AllocatorStats {
 // coalescing.  One assumption we make is that the process using this
 // allocator owns pretty much all of the memory, and that nearly
 // all requests to allocate memory go through this interface.
+//
+// If thread_cache_capacity is not 0, small allocations go through a
+// per-thread cache in front of the arena, similar to the thread caches of
+// tcmalloc. A freed small chunk is kept in the cache of the freeing thread
+// and handed out again by the next allocation of the same rounded size on
+// that thread, without taking any lock. Each cache is bounded by
+// thread_cache_capacity bytes, returns chunks that haven't been reused for
+// a while to the arena, and is returned to the arena when its thread exits.
+// When the arena runs out of memory, the allocating thread drains its own
+// cache and every other thread drains its cache on its next Alloc or Free.
 class BFCArena : public IArenaAllocator {
  public:
-  BFCArena(std::unique_ptr<IDeviceAllocator> resource_allocator, size_t total_memory);
+  // A good thread_cache_capacity for arenas used by concurrent Run calls.
+  static const size_t kDefaultThreadCacheCapacity = 1 << 20;
+
+  BFCArena(std::unique_ptr<IDeviceAllocator> resource_allocator, size_t total_memory,
+           size_t thread_cache_capacity = 0);
 
   ~BFCArena() override;
 
@@ -95,9 +125,7 @@ class BFCArena : public IArenaAllocator {
 
   void* Reserve(size_t size) override;
 
-  size_t Used() const override {
-    return stats_.bytes_in_use;
-  }
+  size_t Used() const override;
 
   size_t Max() const override {
     return memory_limit_;
@@ -119,9 +147,13 @@ class BFCArena : public IArenaAllocator {
   size_t AllocatedSize(const void* ptr);
 
  private:
-  void* AllocateRawInternal(size_t num_bytes, bool dump_log_on_failure);
+  // If allocated_size is not null, it is set to the size of the chunk that was allocated.
+  void* AllocateRawInternal(size_t num_bytes, bool dump_log_on_failure, size_t* allocated_size = nullptr);
   void DeallocateRawInternal(void* ptr);
 
+  // Locks lock_, counting the calls that had to wait for another thread.
+  std::unique_lock<std::mutex> LockArena();
+
   // A ChunkHandle is an index into the chunks_ vector in BFCAllocator
   // kInvalidChunkHandle means an invalid chunk
   using ChunkHandle = size_t;
@@ -398,6 +430,77 @@ class BFCArena : public IArenaAllocator {
   // Computes and returns a BinDebugInfo for each Bin.
   std::array<BinDebugInfo, kNumBins> get_bin_debug_info();
 
+  // Chunks of up to kMaxThreadCacheChunkSize bytes are cached per thread, in one free list per rounded size.
+  // A chunk in a thread cache is still in use as far as the bins are concerned.
+  static const size_t kMaxThreadCacheChunkSize = 1 << 16;
+  static const size_t kNumThreadCacheClasses = kMaxThreadCacheChunkSize / kMinAllocationSize;
+  // The number of frees into a thread cache between two scavenges of the chunks it didn't reuse.
+  static const int kThreadCacheScavengeInterval = 4096;
+
+  static size_t ThreadCacheClass(size_t rounded_bytes) { return (rounded_bytes >> kMinAllocationBits) - 1; }
+  static size_t ThreadCacheClassSize(size_t cache_class) { return (cache_class + 1) << kMinAllocationBits; }
+
+  // Shared by an arena and the thread caches in front of it, so that a thread exiting after the arena was
+  // destroyed doesn't touch it.
+  struct ThreadCacheOwner {
+    std::mutex mutex;
+    BFCArena* arena;
+  };
+
+  // Only used by its thread, so the free lists don't need a lock. The counters are read by GetStats.
+  struct ThreadCache {
+    ThreadCache(uint64_t arena_id, std::shared_ptr<ThreadCacheOwner> owner, uint64_t drain_epoch)
+        : arena_id(arena_id), owner(std::move(owner)), drain_epoch(drain_epoch) {}
+
+    // Returns the cached chunks to the arena if it still exists.
+    ~ThreadCache();
+
+    const uint64_t arena_id;
+    const std::shared_ptr<ThreadCacheOwner> owner;
+    // The drain epoch of the arena when the cache was last drained.
+    uint64_t drain_epoch;
+    // Oldest chunk first in each class.
+    std::array<std::vector<void*>, kNumThreadCacheClasses> classes;
+    // The fewest chunks each class has held since the last scavenge. That many chunks weren't needed by the thread.
+    std::array<size_t, kNumThreadCacheClasses> low_water_marks{};
+    size_t cached_bytes = 0;
+    int frees_since_scavenge = 0;
+
+    // Written by the thread only, so they are updated without read-modify-write operations.
+    std::atomic<int64_t> num_hits{0};
+    std::atomic<int64_t> num_misses{0};
+    std::atomic<int64_t> bytes_cached{0};
+  };
+
+  // The requested sizes of the allocations that go back to a thread cache when freed, for each kMinAllocationSize
+  // piece of a region, 0 for all other pointers. chunks_ and the region manager can change under another thread,
+  // so this is how Free finds out without lock_ that a pointer belongs in a thread cache and what its size is.
+  struct CacheableRegion {
+    const char* ptr = nullptr;
+    const char* end_ptr = nullptr;
+    std::unique_ptr<std::atomic<uint32_t>[]> requested_sizes;
+  };
+
+  // Later regions aren't cacheable.
+  static const int kMaxCacheableRegions = 64;
+
+  // Returns nullptr if ptr isn't in a cacheable region.
+  std::atomic<uint32_t>* CacheableRequestedSize(const void* ptr) const;
+
+  ThreadCache& GetThreadCache();
+  void* AllocateFromThreadCache(size_t num_bytes);
+  void FreeToThreadCache(void* p, size_t requested_size);
+  // Moves the oldest chunks of the cache to chunks until it holds no more than max_cached_bytes.
+  void TrimThreadCache(ThreadCache* cache, size_t max_cached_bytes, std::vector<void*>* chunks);
+  // Moves the chunks the thread didn't reuse since the last scavenge to chunks.
+  void ScavengeThreadCache(ThreadCache* cache, std::vector<void*>* chunks);
+  // Gives chunks back to the arena. The caller must have removed their bytes from cache->cached_bytes.
+  void ReturnToArena(ThreadCache* cache, const std::vector<void*>& chunks);
+  // Returns all the chunks of the cache to the arena. Returns false if there weren't any.
+  bool DrainThreadCache(ThreadCache* cache);
+  // Called when the thread of the cache exits.
+  void ReleaseThreadCache(ThreadCache* cache);
+
   // Structures immutable after construction
   size_t memory_limit_ = 0;
 
@@ -478,6 +581,27 @@ class BFCArena : public IArenaAllocator {
 
   std::unordered_map<void*, size_t> reserved_chunks_;
 
+  const size_t thread_cache_capacity_;
+
+  // Unique for the lifetime of the process, to identify the arena in the thread local lists of caches.
+  const uint64_t id_;
+
+  std::shared_ptr<ThreadCacheOwner> thread_cache_owner_;
+
+  // Guarded by lock_. The counters of the caches of threads that exited are added to the retired counters.
+  std::vector<ThreadCache*> thread_caches_;
+  int64_t retired_thread_cache_hits_ = 0;
+  int64_t retired_thread_cache_misses_ = 0;
+
+  // Incremented when the arena runs out of memory, to make every thread drain its cache on its next Alloc or Free.
+  std::atomic<uint64_t> thread_cache_drain_epoch_{0};
+
+  // Appended to under lock_ when the arena is extended, and read without it.
+  std::array<CacheableRegion, kMaxCacheableRegions> cacheable_regions_;
+  std::atomic<int> num_cacheable_regions_{0};
+
+  std::atomic<int64_t> num_lock_contentions_{0};
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(BFCArena);
 };
 #ifdef __GNUC__
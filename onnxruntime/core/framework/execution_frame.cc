@@ -18,47 +18,151 @@ ExecutionFrame::ExecutionFrame(const std::unordered_map<std::string, MLValue>& f
                                const std::vector<std::string>& output_names,
                                const std::vector<MLValue>& fetches,
                                const ::onnxruntime::SessionState& session_state)
-    : session_state_(session_state), mem_patterns_(nullptr), planner_(nullptr) {
+    : session_state_(session_state), planner_(nullptr) {
   auto* graph = session_state.GetGraphViewer();
   ORT_ENFORCE(graph);
-  Init(*graph, feeds, output_names, fetches);
+  InitNodeValues(*graph);
+
+  auto& mlvalue_idx_map = session_state_.GetMLValueNameIdxMap();
+
+  std::vector<MLValue> feed_values;
+  feed_values.reserve(feeds.size());
+  for (const auto& feed : feeds) {
+    int mlvalue_idx;
+    Status status = mlvalue_idx_map.GetIdx(feed.first, mlvalue_idx);
+    ORT_ENFORCE(status.IsOK(), status.ErrorMessage());
+    feed_mlvalue_idxs_.push_back(mlvalue_idx);
+    feed_values.push_back(feed.second);
+  }
+
+  for (const auto& oname : output_names) {
+    int mlvalue_idx;
+    Status status = mlvalue_idx_map.GetIdx(oname, mlvalue_idx);
+    ORT_ENFORCE(status.IsOK(), status.ErrorMessage());
+    fetch_mlvalue_idxs_.push_back(mlvalue_idx);
+  }
+
+  Reset(feed_values, fetches);
+}
+
+ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs,
+                               const std::vector<MLValue>& feeds,
+                               const std::vector<int>& fetch_mlvalue_idxs,
+                               const std::vector<MLValue>& fetches,
+                               const ::onnxruntime::SessionState& session_state)
+    : feed_mlvalue_idxs_(feed_mlvalue_idxs),
+      fetch_mlvalue_idxs_(fetch_mlvalue_idxs),
+      session_state_(session_state),
+      planner_(nullptr) {
+  auto* graph = session_state.GetGraphViewer();
+  ORT_ENFORCE(graph);
+  InitNodeValues(*graph);
+  Reset(feeds, fetches);
+}
+
+void ExecutionFrame::Reset(const std::vector<MLValue>& feeds, const std::vector<MLValue>& fetches) {
+  ORT_ENFORCE(feeds.size() == feed_mlvalue_idxs_.size(),
+              "feeds vector size: ", feeds.size(), " does not match the number of inputs: ", feed_mlvalue_idxs_.size());
+
+  // 1. drop the values from the previous run. assign() keeps the capacity of all_values_.
+  all_values_.assign(session_state_.GetMLValueNameIdxMap().MaxIdx() + 1, MLValue());
+
+  // 2. handle the weights.
+  for (const auto& entry : session_state_.GetInitializedTensors()) {
+    auto mlvalue_index = entry.first;
+    all_values_[mlvalue_index] = entry.second;  // this copy should be cheap
+  }
+
+  // 3. handle feed in values
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    // we are sharing the underline tensor/object for MLValue
+    all_values_[feed_mlvalue_idxs_[i]] = feeds[i];
+  }
+
+  // 4. Handle non-empty output vector
+  // setup output_indices_, we dont' want to generate mem plan on output tensors.
+  output_indices_ = fetch_mlvalue_idxs_;
+
+  if (!fetches.empty()) {
+    // should've already verified this much before when Run() starts
+    ORT_ENFORCE(fetch_mlvalue_idxs_.size() == fetches.size(),
+                "output_names vector size: " + std::to_string(fetch_mlvalue_idxs_.size()) +
+                    " does not match that of fetches vector: " + std::to_string(fetches.size()));
+
+    // an empty fetch is allocated during execution. skip it so it can't replace a feed or initializer
+    // when a graph output is also a graph input or initializer.
+    for (size_t i = 0; i < fetches.size(); ++i) {
+      if (fetches[i].IsAllocated()) {
+        all_values_[fetch_mlvalue_idxs_[i]] = fetches[i];
+      }
+    }
+  }
+
+  SetupMemoryPatterns(feeds);
+}
+
+void ExecutionFrame::ReleaseValues() {
+  for (auto& value : all_values_) {
+    value = MLValue();
+  }
+}
+
+void ExecutionFrame::SetupMemoryPatterns(const std::vector<MLValue>& feeds) {
+  planner_ = nullptr;
 
   // If the session enable memory pattern optimization
   // and we have execution plan generated, try to setup
   // memory pattern optimization.
-  if (session_state.GetEnableMemoryPattern() &&
-      session_state.GetExecutionPlan()) {
-    std::vector<TensorShape> input_shapes;
-    bool all_tensors = true;
-    for (const auto& feed : feeds) {
-      if (!(feed.second.IsTensor())) {
-        all_tensors = false;
-        break;
-      }
-      auto& tensor = feed.second.Get<Tensor>();
-      input_shapes.push_back(tensor.Shape());
-    }
+  if (!session_state_.GetEnableMemoryPattern() || !session_state_.GetExecutionPlan()) {
+    return;
+  }
+
+  std::vector<TensorShape> input_shapes;
+  input_shapes.reserve(feeds.size());
+  for (const auto& feed : feeds) {
     // if there is some traditional ml value type in inputs
     // disable the memory pattern optimization.
-    if (all_tensors) {
-      mem_patterns_ = session_state.GetMemoryPatternGroup(input_shapes);
-      // if no existing patterns, generate one in this executionframe
-      if (!mem_patterns_) {
-        planner_ = std::make_unique<MLValuePatternPlanner>(*session_state.GetExecutionPlan());
-      } else {
-        // pre-allocate the big chunk requested in memory pattern.
-        // all the internal kernel's input/output tensors will be allocated on these buffer.
-        for (size_t i = 0; i < mem_patterns_->locations.size(); i++) {
-          ORT_ENFORCE(buffers_.find(mem_patterns_->locations[i]) == buffers_.end());
-          AllocatorPtr alloc = GetAllocator(mem_patterns_->locations[i]);
-          void* buffer = mem_patterns_->patterns[i].PeakSize() > 0 ? alloc->Alloc(mem_patterns_->patterns[i].PeakSize()) : nullptr;
-          buffers_[mem_patterns_->locations[i]] = BufferUniquePtr(buffer, alloc);
-        }
-      }
+    if (!feed.IsTensor()) {
+      mem_patterns_ = nullptr;
+      buffers_.clear();
+      return;
+    }
+    input_shapes.push_back(feed.Get<Tensor>().Shape());
+  }
+
+  // a frame reused with the same input shapes keeps the pattern and its buffers from the previous run.
+  if (mem_patterns_ && input_shapes == input_shapes_) {
+    return;
+  }
+
+  buffers_.clear();
+  input_shapes_ = std::move(input_shapes);
+  mem_patterns_ = session_state_.GetMemoryPatternGroup(input_shapes_);
+  // if no existing patterns, generate one in this executionframe
+  if (!mem_patterns_) {
+    planner_ = std::make_unique<MLValuePatternPlanner>(*session_state_.GetExecutionPlan());
+  } else {
+    // pre-allocate the big chunk requested in memory pattern.
+    // all the internal kernel's input/output tensors will be allocated on these buffer.
+    for (size_t i = 0; i < mem_patterns_->locations.size(); i++) {
+      ORT_ENFORCE(buffers_.find(mem_patterns_->locations[i]) == buffers_.end());
+      AllocatorPtr alloc = GetAllocator(mem_patterns_->locations[i]);
+      void* buffer = mem_patterns_->patterns[i].PeakSize() > 0 ? alloc->Alloc(mem_patterns_->patterns[i].PeakSize()) : nullptr;
+      buffers_[mem_patterns_->locations[i]] = BufferUniquePtr(buffer, alloc);
     }
   }
 }
 
+Status ExecutionFrame::UpdateMemoryPatternGroupCache() const {
+  if (!planner_) {
+    return Status::OK();
+  }
+
+  auto mem_patterns = std::make_unique<MemoryPatternGroup>();
+  ORT_RETURN_IF_ERROR(GeneratePatterns(mem_patterns.get()));
+  return session_state_.UpdateMemoryPatternGroupCache(input_shapes_, std::move(mem_patterns));
+}
+
 ExecutionFrame::~ExecutionFrame() = default;
 
 Status ExecutionFrame::AllocateMLValueTensorSelfOwnBuffer(int mlvalue_index,
@@ -112,15 +216,16 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(int mlvalue_inde
       // if block not found, fall back to default behavior
       if (block) {
         auto it = buffers_.find(location);
-        // if the block is not correct, log message then fall back to default behavior
-        if (it != buffers_.end() && block->size_ == size) {
+        // if the block is not correct, log message then fall back to default behavior.
+        // the pattern may have been traced with larger input shapes in the same bucket, so a larger block is fine.
+        if (it != buffers_.end() && block->size_ >= size) {
           void* buffer = it->second.get();
           auto status = AllocateTensorWithPreAllocateBufferHelper(
               p_mlvalue, static_cast<void*>(static_cast<char*>(buffer) + block->offset_),
               element_type, location, shape);
           return status;
         }
-        if (block->size_ != size) {
+        if (block->size_ < size) {
           LOGS_DEFAULT(WARNING) << "For mlvalue with index: " << mlvalue_index << ", block in memory pattern size is: "
                                 << block->size_ << " but the actually size is: " << size << ", fall back to default allocation behavior";
         } else if (it == buffers_.end()) {
@@ -308,61 +413,14 @@ Status ExecutionFrame::AllocateAsPerAllocationPlan(int mlvalue_index,
   return Status::OK();
 }
 
-void ExecutionFrame::Init(const onnxruntime::GraphViewer& graph,
-                          const std::unordered_map<std::string, MLValue>& feeds,
-                          const std::vector<std::string>& output_names,
-                          const std::vector<MLValue>& fetches) {
-  // 1. resize the node_offsets and all_value_ vector
+void ExecutionFrame::InitNodeValues(const onnxruntime::GraphViewer& graph) {
+  // resize the node_offsets vector
   // We need to use the max index rather than number of nodes as we use Node.Index()
   // when inserting into node_offsets_
   auto max_node_index = graph.MaxNodeIndex();
   node_offsets_.resize(max_node_index);
 
-  auto& mlvalue_idx_map = session_state_.GetMLValueNameIdxMap();
-
-  all_values_.resize(mlvalue_idx_map.MaxIdx() + 1);
-
-  // 2. handle the weights.
-  for (const auto& entry : session_state_.GetInitializedTensors()) {
-    auto mlvalue_index = entry.first;
-    all_values_[mlvalue_index] = entry.second;  // this copy should be cheap
-  }
-
-  // 3. handle feed in values
-  for (const auto& feed : feeds) {
-    int mlvalue_idx;
-    Status status = mlvalue_idx_map.GetIdx(feed.first, mlvalue_idx);
-    ORT_ENFORCE(status.IsOK(), status.ErrorMessage());
-    // we are sharing the underline tensor/object for MLValue
-    all_values_[mlvalue_idx] = feed.second;
-  }
-
-  // 4. Handle non-empty output vector
-  // setup output_indices_, we dont' want to generate mem plan on output tensors.
-  for (const auto& oname : output_names) {
-    int mlvalue_idx;
-    Status status = mlvalue_idx_map.GetIdx(oname, mlvalue_idx);
-    ORT_ENFORCE(status.IsOK(), status.ErrorMessage());
-    output_indices_.push_back(mlvalue_idx);
-  }
-
-  if (!fetches.empty()) {
-    // should've already verified this much before when Run() starts
-    ORT_ENFORCE(output_names.size() == fetches.size(),
-                        "output_names vector size: " + std::to_string(output_names.size()) +
-                            " does not match that of fetches vector: " + std::to_string(fetches.size()));
-
-    auto idx = 0;
-    for (const auto& oname : output_names) {
-      int mlvalue_idx;
-      Status status = mlvalue_idx_map.GetIdx(oname, mlvalue_idx);
-      ORT_ENFORCE(status.IsOK(), status.ErrorMessage());
-      all_values_[mlvalue_idx] = fetches.at(idx++);
-      output_indices_.push_back(mlvalue_idx);
-    }
-  }
-
-  // 5. set node args
+  // set node args
   std::size_t total_def_count{};
   for (const auto& node : graph.Nodes())
   {
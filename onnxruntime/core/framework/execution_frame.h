@@ -43,8 +43,24 @@ class ExecutionFrame {
                  const std::vector<MLValue>& fetches,
                  const SessionState& session_state);
 
+  // Create a frame for feeds and fetches that have already been resolved to MLValue indices.
+  // The frame can be reused for subsequent runs with the same inputs and outputs by calling Reset.
+  ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs,
+                 const std::vector<MLValue>& feeds,
+                 const std::vector<int>& fetch_mlvalue_idxs,
+                 const std::vector<MLValue>& fetches,
+                 const SessionState& session_state);
+
   ~ExecutionFrame();
 
+  // Prepare the frame for another run with new feed and fetch values, in the same order as the indices the
+  // frame was created with. The node argument layout is kept, and so is the memory pattern and its buffers
+  // if the input shapes are unchanged.
+  void Reset(const std::vector<MLValue>& feeds, const std::vector<MLValue>& fetches);
+
+  // Release the values held from the last run, without releasing the storage of the frame.
+  void ReleaseValues();
+
   Status AllocateMLValueTensorSelfOwnBuffer(int mlvalue_index,
                                             MLDataType element_type,
                                             const OrtAllocatorInfo& location,
@@ -122,6 +138,14 @@ class ExecutionFrame {
     return planner_ != nullptr;
   }
 
+  // Add the memory pattern traced during this run to the session state's cache, keyed by the input shapes.
+  // No-op if a cached pattern was used or the inputs were not all tensors.
+  Status UpdateMemoryPatternGroupCache() const;
+
+  const std::vector<int>& GetFetchMLValueIdxs() const {
+    return fetch_mlvalue_idxs_;
+  }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ExecutionFrame);
 
@@ -137,10 +161,9 @@ class ExecutionFrame {
                                                   const TensorShape& shape,
                                                   bool create_fence);
 
-  void Init(const onnxruntime::GraphViewer& graph,
-            const std::unordered_map<std::string, MLValue>& feeds,
-            const std::vector<std::string>& output_names,
-            const std::vector<MLValue>& fetches);
+  void InitNodeValues(const onnxruntime::GraphViewer& graph);
+
+  void SetupMemoryPatterns(const std::vector<MLValue>& feeds);
 
   void SetupNodeArg(const onnxruntime::NodeArg* arg);
 
@@ -169,6 +192,10 @@ class ExecutionFrame {
   // The start index into node_values_ for all the nodes.
   std::vector<int> node_offsets_;
 
+  // The indices of the feeds and fetches in all_values_.
+  std::vector<int> feed_mlvalue_idxs_;
+  std::vector<int> fetch_mlvalue_idxs_;
+
   // i-th kernel is still waiting for pending_counts_[i] inputs.
   std::vector<int> pending_counts_;  // not used currently
 
@@ -179,7 +206,10 @@ class ExecutionFrame {
   // If we already have cached memory pattern on these input shapes
   // Use this mem pattern that create a big chunk for all the internal
   // kernel's input/output tensors.
-  const MemoryPatternGroup* mem_patterns_;
+  std::shared_ptr<const MemoryPatternGroup> mem_patterns_;
+
+  // The input shapes mem_patterns_ was looked up for, or the pattern traced by planner_ will be saved for.
+  std::vector<TensorShape> input_shapes_;
 
   // If no cached memory pattern, and we enable the memory pattern optimization
   // use this planner_ to trace the memory allocation in current executor.
@@ -0,0 +1,131 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/mem_pattern_cache.h"
+
+namespace onnxruntime {
+
+namespace {
+
+int64_t RoundUpToPowerOfTwo(int64_t dim) {
+  int64_t bucket = 1;
+  while (bucket < dim) {
+    bucket <<= 1;
+  }
+  return bucket;
+}
+
+// true if every dimension of shapes is no larger than the matching dimension of bound
+bool FitsWithin(const std::vector<TensorShape>& shapes, const std::vector<TensorShape>& bound) {
+  if (shapes.size() != bound.size()) {
+    return false;
+  }
+
+  for (size_t i = 0; i < shapes.size(); ++i) {
+    if (shapes[i].NumDimensions() != bound[i].NumDimensions()) {
+      return false;
+    }
+    for (size_t d = 0; d < shapes[i].NumDimensions(); ++d) {
+      if (shapes[i][d] > bound[i][d]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+void MemoryPatternCache::SetCapacity(size_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  capacity_ = capacity;
+  EvictIfNeeded();
+}
+
+void MemoryPatternCache::SetEnableShapeBucketing(bool enable) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (enable != enable_shape_bucketing_) {
+    // the keys of the existing entries were created with the other setting
+    entries_.clear();
+    index_.clear();
+    enable_shape_bucketing_ = enable;
+  }
+}
+
+MemoryPatternCache::Key MemoryPatternCache::CreateKey(const std::vector<TensorShape>& input_shapes) const {
+  // the rank of each shape is included so that e.g. {2}, {3, 4} and {2, 3}, {4} have different keys
+  size_t key_size = 0;
+  for (const auto& shape : input_shapes) {
+    key_size += 1 + shape.NumDimensions();
+  }
+
+  Key key;
+  key.reserve(key_size);
+  for (const auto& shape : input_shapes) {
+    key.push_back(static_cast<int64_t>(shape.NumDimensions()));
+    for (auto dim : shape.GetDims()) {
+      key.push_back(enable_shape_bucketing_ ? RoundUpToPowerOfTwo(dim) : dim);
+    }
+  }
+  return key;
+}
+
+std::shared_ptr<const MemoryPatternGroup> MemoryPatternCache::Find(const std::vector<TensorShape>& input_shapes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto it = index_.find(CreateKey(input_shapes));
+  if (it == index_.end() || !FitsWithin(input_shapes, it->second->input_shapes)) {
+    ++misses_;
+    return nullptr;
+  }
+
+  entries_.splice(entries_.begin(), entries_, it->second);
+  ++hits_;
+  return it->second->mem_patterns;
+}
+
+void MemoryPatternCache::Insert(const std::vector<TensorShape>& input_shapes,
+                                std::unique_ptr<MemoryPatternGroup> mem_patterns) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (capacity_ == 0) {
+    return;
+  }
+
+  Key key = CreateKey(input_shapes);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    Entry& entry = *it->second;
+    // keep the existing pattern if it already covers these shapes, e.g. if another Run traced a larger shape
+    // in the same bucket concurrently.
+    if (!FitsWithin(input_shapes, entry.input_shapes)) {
+      entry.input_shapes = input_shapes;
+      entry.mem_patterns = std::move(mem_patterns);
+    }
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return;
+  }
+
+  entries_.push_front(Entry{key, input_shapes, std::move(mem_patterns)});
+  index_[std::move(key)] = entries_.begin();
+  EvictIfNeeded();
+}
+
+void MemoryPatternCache::EvictIfNeeded() {
+  while (entries_.size() > capacity_) {
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+    ++evictions_;
+  }
+}
+
+MemoryPatternCacheStats MemoryPatternCache::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  MemoryPatternCacheStats stats;
+  stats.hits = hits_;
+  stats.misses = misses_;
+  stats.evictions = evictions_;
+  stats.num_entries = entries_.size();
+  return stats;
+}
+
+}  // namespace onnxruntime
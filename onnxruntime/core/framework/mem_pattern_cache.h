@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/framework_common.h"
+#include "core/framework/mem_pattern.h"
+#include "core/framework/tensor_shape.h"
+
+namespace onnxruntime {
+
+/**
+Bounded LRU cache of the memory patterns generated for the input shapes seen by a session.
+
+With shape bucketing enabled, every dimension of the input shapes is rounded up to the next power of two
+to form the cache key, so inputs of similar size share one entry. An entry stores the shapes its pattern was
+traced with. A lookup is a hit if the requested shapes are no larger than those in every dimension, as the
+blocks of the pattern are then large enough for the smaller tensors. A lookup with a larger shape in the same
+bucket misses, and the pattern traced by that run replaces the entry, so each entry grows towards the upper
+bound of its bucket.
+
+Thread-safe. Patterns are returned as shared_ptr so an entry can be evicted while a Run is still using it.
+*/
+class MemoryPatternCache {
+ public:
+  static constexpr size_t kDefaultCapacity = 16;
+
+  explicit MemoryPatternCache(size_t capacity = kDefaultCapacity, bool enable_shape_bucketing = true)
+      : capacity_{capacity}, enable_shape_bucketing_{enable_shape_bucketing} {}
+
+  /**
+  Set the maximum number of patterns to keep. 0 disables the cache.
+  */
+  void SetCapacity(size_t capacity);
+
+  void SetEnableShapeBucketing(bool enable);
+
+  /**
+  Get the pattern usable for the given input shapes.
+  @returns nullptr on a miss.
+  */
+  std::shared_ptr<const MemoryPatternGroup> Find(const std::vector<TensorShape>& input_shapes);
+
+  /**
+  Add the pattern generated by running with the given input shapes, evicting the least recently used
+  entry if the cache is full.
+  */
+  void Insert(const std::vector<TensorShape>& input_shapes, std::unique_ptr<MemoryPatternGroup> mem_patterns);
+
+  MemoryPatternCacheStats GetStats() const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(MemoryPatternCache);
+
+  using Key = std::vector<int64_t>;
+
+  struct Entry {
+    Key key;
+    std::vector<TensorShape> input_shapes;  // shapes the pattern was traced with
+    std::shared_ptr<const MemoryPatternGroup> mem_patterns;
+  };
+
+  Key CreateKey(const std::vector<TensorShape>& input_shapes) const;
+  void EvictIfNeeded();
+
+  mutable std::mutex mutex_;
+  size_t capacity_;
+  bool enable_shape_bucketing_;
+
+  // most recently used entry first
+  std::list<Entry> entries_;
+  std::map<Key, std::list<Entry>::iterator> index_;
+
+  int64_t hits_ = 0;
+  int64_t misses_ = 0;
+  int64_t evictions_ = 0;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,237 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/node_cost_model.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "core/graph/graph_viewer.h"
+#include "core/graph/onnx_protobuf.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// number of elements in the tensor described by arg, or -1 if the shape isn't fully known
+int64_t NumElements(const NodeArg* arg) {
+  if (arg == nullptr || !arg->Exists()) {
+    return -1;
+  }
+
+  const auto* shape = arg->Shape();
+  if (shape == nullptr) {
+    return -1;
+  }
+
+  int64_t size = 1;
+  for (const auto& dim : shape->dim()) {
+    if (!dim.has_dim_value() || dim.dim_value() < 0) {
+      return -1;
+    }
+    size *= dim.dim_value();
+  }
+  return size;
+}
+
+int64_t DimValue(const NodeArg* arg, int index) {
+  const auto* shape = arg != nullptr ? arg->Shape() : nullptr;
+  if (shape == nullptr) {
+    return -1;
+  }
+
+  const int rank = shape->dim_size();
+  if (index < 0) {
+    index += rank;
+  }
+  if (index < 0 || index >= rank || !shape->dim(index).has_dim_value()) {
+    return -1;
+  }
+  return shape->dim(index).dim_value();
+}
+
+int64_t ElementSize(const NodeArg* arg) {
+  const auto* type = arg->TypeAsProto();
+  if (type == nullptr || !type->has_tensor_type()) {
+    return 4;
+  }
+
+  switch (type->tensor_type().elem_type()) {
+    case ONNX_NAMESPACE::TensorProto_DataType_BOOL:
+    case ONNX_NAMESPACE::TensorProto_DataType_INT8:
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT8:
+      return 1;
+    case ONNX_NAMESPACE::TensorProto_DataType_INT16:
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT16:
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT16:
+      return 2;
+    case ONNX_NAMESPACE::TensorProto_DataType_DOUBLE:
+    case ONNX_NAMESPACE::TensorProto_DataType_INT64:
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT64:
+      return 8;
+    default:
+      return 4;
+  }
+}
+
+bool IsDataMovementOp(const std::string& op_type) {
+  static const std::unordered_set<std::string> data_movement_ops{
+      "Identity", "Reshape", "Flatten", "Squeeze", "Unsqueeze", "Transpose", "Concat", "Split", "Slice",
+      "Gather", "Pad", "Tile", "Expand", "Cast", "MemcpyFromHost", "MemcpyToHost"};
+  return data_movement_ops.count(op_type) > 0;
+}
+
+int64_t GetIntAttribute(const Node& node, const std::string& name, int64_t default_value) {
+  const auto& attributes = node.GetAttributes();
+  auto entry = attributes.find(name);
+  return entry != attributes.cend() ? entry->second.i() : default_value;
+}
+
+}  // namespace
+
+double NodeCostModel::EstimateCost(const Node& node) {
+  const auto input_defs = node.InputDefs();
+  const auto output_defs = node.OutputDefs();
+  const std::string& op_type = node.OpType();
+
+  const NodeArg* first_output = output_defs.size() == 0 ? nullptr : output_defs[0];
+  const int64_t output_size = NumElements(first_output);
+
+  double cost = -1;
+
+  if ((op_type == "Conv" || op_type == "ConvTranspose") && input_defs.size() >= 2) {
+    // W is {M, C/group, k1, k2, ...} for Conv and {C, M/group, k1, k2, ...} for ConvTranspose.
+    // each element of Y for Conv, or of X for ConvTranspose, involves W.size / W.dims[0] multiply-adds.
+    const int64_t weight_size = NumElements(input_defs[1]);
+    const int64_t weight_channels = DimValue(input_defs[1], 0);
+    const int64_t image_size = op_type == "Conv" ? output_size : NumElements(input_defs[0]);
+    if (weight_size > 0 && weight_channels > 0 && image_size >= 0) {
+      cost = 2.0 * image_size * (weight_size / weight_channels);
+    }
+  } else if ((op_type == "Gemm" || op_type == "MatMul") && input_defs.size() > 0) {
+    int64_t K = -1;
+    if (op_type == "Gemm") {
+      K = DimValue(input_defs[0], GetIntAttribute(node, "transA", 0) != 0 ? 0 : 1);
+    } else {
+      K = DimValue(input_defs[0], -1);
+    }
+    if (K >= 0 && output_size >= 0) {
+      cost = 2.0 * output_size * K;
+    }
+  } else if (IsDataMovementOp(op_type)) {
+    double bytes = 0;
+    bool known = true;
+    for (const auto* def : output_defs) {
+      const int64_t size = NumElements(def);
+      if (size < 0) {
+        known = false;
+        break;
+      }
+      bytes += static_cast<double>(size) * ElementSize(def);
+    }
+    if (known) {
+      cost = bytes;
+    }
+  } else if (output_size >= 0) {
+    cost = static_cast<double>(output_size);
+  }
+
+  return std::max(cost, 1.0);
+}
+
+NodeCostModel::NodeCostModel(const GraphViewer& graph_viewer)
+    : graph_viewer_(graph_viewer) {
+  const size_t num_nodes = static_cast<size_t>(graph_viewer.MaxNodeIndex());
+  estimated_costs_.resize(num_nodes, 1.0);
+  total_duration_ns_ = std::make_unique<std::atomic<int64_t>[]>(num_nodes);
+  num_measurements_ = std::make_unique<std::atomic<int64_t>[]>(num_nodes);
+
+  for (size_t i = 0; i < num_nodes; ++i) {
+    total_duration_ns_[i].store(0, std::memory_order_relaxed);
+    num_measurements_[i].store(0, std::memory_order_relaxed);
+  }
+
+  for (const auto& node : graph_viewer.Nodes()) {
+    estimated_costs_[node.Index()] = EstimateCost(node);
+  }
+}
+
+void NodeCostModel::RecordExecutionTime(NodeIndex node_index, int64_t duration_ns) {
+  total_duration_ns_[node_index].fetch_add(duration_ns, std::memory_order_relaxed);
+  num_measurements_[node_index].fetch_add(1, std::memory_order_relaxed);
+  has_new_measurements_.store(true, std::memory_order_relaxed);
+}
+
+std::shared_ptr<const std::vector<int>> NodeCostModel::GetPriorityLevels(int num_levels) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  bool recompute = priority_levels_ == nullptr || num_levels != num_levels_;
+  if (!recompute && ++calls_since_recompute_ >= kRecomputeInterval) {
+    recompute = has_new_measurements_.exchange(false, std::memory_order_relaxed);
+    calls_since_recompute_ = 0;
+  }
+
+  if (recompute) {
+    ComputePriorityLevels(num_levels);
+  }
+
+  return priority_levels_;
+}
+
+void NodeCostModel::ComputePriorityLevels(int num_levels) {
+  const size_t num_nodes = estimated_costs_.size();
+
+  // scale factor from estimated cost units to nanoseconds, based on the nodes that have been measured
+  std::vector<double> costs(num_nodes, 0.0);
+  std::vector<bool> measured(num_nodes, false);
+  double measured_ns = 0;
+  double measured_estimate = 0;
+  for (size_t i = 0; i < num_nodes; ++i) {
+    const int64_t count = num_measurements_[i].load(std::memory_order_relaxed);
+    if (count > 0) {
+      costs[i] = static_cast<double>(total_duration_ns_[i].load(std::memory_order_relaxed)) / count;
+      measured[i] = true;
+      measured_ns += costs[i];
+      measured_estimate += estimated_costs_[i];
+    }
+  }
+
+  const double scale = measured_estimate > 0 ? measured_ns / measured_estimate : 1.0;
+  for (size_t i = 0; i < num_nodes; ++i) {
+    if (!measured[i]) {
+      costs[i] = estimated_costs_[i] * scale;
+    }
+  }
+
+  // upward rank, computed in reverse topological order so all consumers of a node are ranked before it
+  std::vector<double> ranks(num_nodes, 0.0);
+  double max_rank = 0;
+  const auto& order = graph_viewer_.GetNodesInTopologicalOrder();
+  for (auto it = order.crbegin(); it != order.crend(); ++it) {
+    const Node* node = graph_viewer_.GetNode(*it);
+    if (node == nullptr) {
+      continue;
+    }
+
+    double max_consumer_rank = 0;
+    for (auto consumer = node->OutputNodesBegin(); consumer != node->OutputNodesEnd(); ++consumer) {
+      max_consumer_rank = std::max(max_consumer_rank, ranks[(*consumer).Index()]);
+    }
+
+    ranks[*it] = costs[*it] + max_consumer_rank;
+    max_rank = std::max(max_rank, ranks[*it]);
+  }
+
+  auto levels = std::make_shared<std::vector<int>>(num_nodes, 0);
+  if (max_rank > 0) {
+    for (size_t i = 0; i < num_nodes; ++i) {
+      (*levels)[i] = std::min(num_levels - 1, static_cast<int>(ranks[i] / max_rank * num_levels));
+    }
+  }
+
+  priority_levels_ = std::move(levels);
+  num_levels_ = num_levels;
+  calls_since_recompute_ = 0;
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/graph/basic_types.h"
+
+namespace onnxruntime {
+
+class GraphViewer;
+class Node;
+
+/**
+Estimates the cost of each node in a graph and derives scheduling priorities from it.
+
+The initial cost of a node is estimated from the shapes inferred for its inputs and outputs: FLOPs for
+Conv/ConvTranspose/Gemm/MatMul, bytes moved for data movement ops (Identity, Reshape, Transpose, Concat, ...)
+and the number of output elements for everything else. Nodes whose shapes are unknown get a unit cost.
+
+Execution times measured while running the graph replace the estimates once available. Nodes that have not
+been measured yet keep their estimate, rescaled to nanoseconds using the ratio of measured time to estimated
+cost over the measured nodes.
+
+The priority of a node is its upward rank as used by HEFT: its own cost plus the largest rank of any of its
+consumers, i.e. the length of the longest (critical) path from the node to an output of the graph.
+*/
+class NodeCostModel {
+ public:
+  explicit NodeCostModel(const GraphViewer& graph_viewer);
+
+  /**
+  Record the measured execution time of a node. Thread-safe.
+  */
+  void RecordExecutionTime(NodeIndex node_index, int64_t duration_ns);
+
+  /**
+  Get the priority of every node, quantized to [0, num_levels) with higher values being more critical.
+  Indexed by NodeIndex. The priorities are recomputed from the measured execution times at most once every
+  kRecomputeInterval calls, so the returned snapshot is shared and must not be modified.
+  */
+  std::shared_ptr<const std::vector<int>> GetPriorityLevels(int num_levels);
+
+  /**
+  Estimate the cost of a node from its input and output shapes.
+  */
+  static double EstimateCost(const Node& node);
+
+  static constexpr int kRecomputeInterval = 16;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(NodeCostModel);
+
+  void ComputePriorityLevels(int num_levels);
+
+  const GraphViewer& graph_viewer_;
+  std::vector<double> estimated_costs_;
+
+  // accumulated measurements per node
+  std::unique_ptr<std::atomic<int64_t>[]> total_duration_ns_;
+  std::unique_ptr<std::atomic<int64_t>[]> num_measurements_;
+  std::atomic<bool> has_new_measurements_{false};
+
+  std::mutex mutex_;
+  std::shared_ptr<const std::vector<int>> priority_levels_;  // protected by mutex_
+  int num_levels_ = 0;                                        // protected by mutex_
+  int calls_since_recompute_ = 0;                             // protected by mutex_
+};
+
+}  // namespace onnxruntime
@@ -36,6 +36,20 @@ class OpKernelContextInternal : public OpKernelContext {
     return OpKernelContext::GetOutputMLValue(index);
   }
 
+  // Set an output to an existing MLValue so the Tensor it contains is shared instead of being copied into a newly
+  // allocated output. Used by control flow operators to forward values produced by a subgraph.
+  Status SetOutputMLValue(int index, const MLValue& value) {
+    MLValue* p_mlvalue = GetOutputMLValue(index);
+    if (!p_mlvalue)
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Output ", index, " does not exist.");
+
+    if (p_mlvalue->IsAllocated())
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Output ", index, " has already been allocated.");
+
+    *p_mlvalue = value;
+    return Status::OK();
+  }
+
   std::unordered_map<std::string, const MLValue*> GetImplicitInputs() const {
     // we need to convert implicit_inputs_ to a name to MLValue map so it can be used in the ExecutionFrame
     // for a subgraph (the index numbers will be different there).
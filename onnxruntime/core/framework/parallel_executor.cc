@@ -9,21 +9,32 @@
 #include <vector>
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
-#include "core/common/task_thread_pool.h"
 #include "core/framework/allocation_planner.h"
 #include "core/framework/execution_frame.h"
 #include "core/framework/session_state.h"
 #include "core/framework/op_kernel_context_internal.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 
 ParallelExecutor::ParallelExecutor(const SessionState& session_state, const bool& terminate_flag)
-    : out_standings_(0), terminate_flag_{terminate_flag} {
+    : terminate_flag_{terminate_flag} {
   auto graph_viewer = session_state.GetGraphViewer();
-  node_refs_.resize(graph_viewer->MaxNodeIndex());
+  node_refs_ = std::make_unique<std::atomic<size_t>[]>(graph_viewer->MaxNodeIndex());
   for (auto& node : graph_viewer->Nodes()) {
-    node_refs_[node.Index()] = node.GetInputEdgesCount();
+    node_refs_[node.Index()].store(node.GetInputEdgesCount(), std::memory_order_relaxed);
   }
+
+  cost_model_ = session_state.GetNodeCostModel();
+  if (cost_model_ != nullptr) {
+    priority_levels_ = cost_model_->GetPriorityLevels(kPriorityLevels);
+  }
+
+  ready_nodes_ = std::make_shared<ReadyNodes>(graph_viewer->MaxNodeIndex(),
+                                              priority_levels_ != nullptr ? kPriorityLevels : 1);
+
+  auto* thread_pool = session_state.GetThreadPool();
+  max_workers_ = thread_pool != nullptr ? thread_pool->NumThreads() : 1;
 }
 
 Status ParallelExecutor::Execute(const SessionState& session_state,
@@ -31,9 +42,17 @@ Status ParallelExecutor::Execute(const SessionState& session_state,
                                  const std::vector<std::string>& output_names,
                                  std::vector<MLValue>& fetches,
                                  const logging::Logger& logger) {
-  auto tp = session_state.Profiler().StartTime();
+  const bool is_profiler_enabled = session_state.Profiler().IsEnabled();
+  TimePoint tp;
+  if (is_profiler_enabled) {
+    tp = session_state.Profiler().StartTime();
+  }
 
   root_frame_ = std::make_unique<ExecutionFrame>(feeds, output_names, fetches, session_state);
+
+  // prevent completion from being signalled before all the root nodes have been enqueued
+  out_standings_ = 1;
+
   //std::cout << "start nodes:" << std::endl;
   for (auto node_index : session_state.GetGraphViewer()->GetRootNodes()) {
     auto p_op_kernel = session_state.GetKernel(node_index);
@@ -44,35 +63,28 @@ Status ParallelExecutor::Execute(const SessionState& session_state,
     EnqueueNode(node_index, session_state, logger);
   }
 
+  FinishNodeRun();
+
   // Wait for finish.
   {
     std::unique_lock<std::mutex> lock(complete_mutex_);
-    while (out_standings_ > 0) complete_cv_.wait(lock);
+    while (!completed_) complete_cv_.wait(lock);
+  }
+
+  if (!errors_.empty()) {
+    return errors_.size() == 1 ? errors_.front()
+                               : ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Multiple errors were found. First error: ",
+                                                 errors_.front().ErrorMessage());
   }
 
   VLOGS(logger, 1) << "Fetching output.";
   ORT_RETURN_IF_ERROR(FetchOutput(session_state.GetMLValueNameIdxMap(), *root_frame_, output_names, fetches, logger));
 
-  if (root_frame_->HasPlan()) {
-    std::vector<TensorShape> input_shapes;
-    bool all_tensors = true;
-    for (const auto& feed : feeds) {
-      if (!(feed.second.IsTensor())) {
-        all_tensors = false;
-        break;
-      }
-      auto& tensor = feed.second.Get<Tensor>();
-      input_shapes.push_back(tensor.Shape());
-    }
+  ORT_RETURN_IF_ERROR(root_frame_->UpdateMemoryPatternGroupCache());
 
-    if (all_tensors) {
-      auto mem_patterns = std::make_unique<MemoryPatternGroup>();
-      ORT_RETURN_IF_ERROR(root_frame_->GeneratePatterns(mem_patterns.get()));
-      ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(input_shapes, std::move(mem_patterns)));
-    }
+  if (is_profiler_enabled) {
+    session_state.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "ParallelExecutor::Execute", tp);
   }
-
-  session_state.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "ParallelExecutor::Execute", tp);
   return Status::OK();
 }
 
@@ -81,9 +93,20 @@ void ParallelExecutor::RunNodeAsync(size_t p_node_index,
                                     const logging::Logger& logger) {
   try {
     RunNodeAsyncInternal(p_node_index, session_state, logger);
+  } catch (const std::exception& ex) {
+    // the task is running on the thread pool, so the error has to be reported to Execute() instead of rethrown
+    LOGS(logger, ERROR) << ex.what();
+    {
+      std::lock_guard<std::mutex> lock(complete_mutex_);
+      errors_.push_back(ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what()));
+    }
+    FinishNodeRun();
   } catch (...) {
+    {
+      std::lock_guard<std::mutex> lock(complete_mutex_);
+      errors_.push_back(ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, "Unknown exception was caught by ParallelExecutor."));
+    }
     FinishNodeRun();
-	throw;
   }
 }
 
@@ -95,6 +118,7 @@ void ParallelExecutor::RunNodeAsyncInternal(size_t p_node_index,
   size_t node_index = p_node_index;
   bool keep_running = true;
   auto graph_viewer = session_state.GetGraphViewer();
+  const bool is_profiler_enabled = session_state.Profiler().IsEnabled();
   // Avoid context switching if possible.
   while (keep_running) {
     // TODO: Convert RunNodeAsync return Status.
@@ -116,7 +140,11 @@ void ParallelExecutor::RunNodeAsyncInternal(size_t p_node_index,
                                               p_op_kernel->Node().ImplicitInputDefs(),
                                               terminate_flag_);
 
-    auto sync_time_begin = session_state.Profiler().StartTime();
+    TimePoint sync_time_begin;
+    TimePoint kernel_begin_time;
+    if (is_profiler_enabled) {
+      sync_time_begin = session_state.Profiler().StartTime();
+    }
     // sync before compute
     int queue_id = p_op_kernel->KernelDef().ExecQueueId();
 
@@ -144,28 +172,42 @@ void ParallelExecutor::RunNodeAsyncInternal(size_t p_node_index,
     const std::string& node_name = p_op_kernel->Node().Name();
     const std::string& op_name = p_op_kernel->KernelDef().OpName();
 
-    session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
-                                                   node_name + "_fence_before",
-                                                   sync_time_begin,
-                                                   {{"op_name", op_name}});
+    if (is_profiler_enabled) {
+      session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                     node_name + "_fence_before",
+                                                     sync_time_begin,
+                                                     {{"op_name", op_name}});
+    }
 
     // call compute on the kernel
     VLOGS(logger, 1) << "Computing kernel: " << p_op_kernel->Node().Name();
 
-    auto kernel_begin_time = session_state.Profiler().StartTime();
+    if (is_profiler_enabled) {
+      kernel_begin_time = session_state.Profiler().StartTime();
+    }
 
     // Execute the kernel.
+    auto compute_start = cost_model_ != nullptr ? std::chrono::steady_clock::now()
+                                                : std::chrono::steady_clock::time_point();
     auto status = p_op_kernel->Compute(&op_kernel_context);
     if (!status.IsOK()) {
       ORT_THROW("Compute failed for node: ", graph_viewer->GetNode(node_index)->Name());
     }
 
-    session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
-                                                   node_name + "_kernel_time",
-                                                   kernel_begin_time,
-                                                   {{"op_name", op_name}});
+    if (cost_model_ != nullptr) {
+      auto duration = std::chrono::steady_clock::now() - compute_start;
+      cost_model_->RecordExecutionTime(node_index,
+                                       std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+    }
+
+    if (is_profiler_enabled) {
+      session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                     node_name + "_kernel_time",
+                                                     kernel_begin_time,
+                                                     {{"op_name", op_name}});
 
-    sync_time_begin = session_state.Profiler().StartTime();
+      sync_time_begin = session_state.Profiler().StartTime();
+    }
     // sync after compute for outputs
     for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
       Fence_t fence = op_kernel_context.InputFence(input_index);
@@ -187,33 +229,36 @@ void ParallelExecutor::RunNodeAsyncInternal(size_t p_node_index,
         fence->AfterUsedAsOutput(queue_id);
       }
     }
-    session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
-                                                   node_name + "_fence_after",
-                                                   sync_time_begin,
-                                                   {{"op_name", op_name}});
+    if (is_profiler_enabled) {
+      session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                     node_name + "_fence_after",
+                                                     sync_time_begin,
+                                                     {{"op_name", op_name}});
+    }
 
     //std::cout << "Run async node finish: " << p_node_index << std::endl;
 
     keep_running = false;
 
     // Checking which output nodes ready for running.
+    // Continue with the most critical one on this thread and hand the rest to the thread pool.
     {
       auto begin = p_op_kernel->Node().OutputEdgesBegin();
       auto end = p_op_kernel->Node().OutputEdgesEnd();
 
-      std::lock_guard<std::mutex> lock(ref_mutex_);
       for (auto it = begin; it != end; it++) {
         auto idx = (*it).GetNode().Index();
-        if ((--node_refs_[idx]) == 0) {
+        if (node_refs_[idx].fetch_sub(1, std::memory_order_acq_rel) == 1) {
           if (!keep_running) {
             node_index = idx;
             keep_running = true;
+          } else if (GetPriority(idx) > GetPriority(node_index)) {
+            EnqueueNode(node_index, session_state, logger);
+            node_index = idx;
           } else {
             EnqueueNode(idx, session_state, logger);
           }
         }
-
-        //std::cout << "handle output, current name: " << p_op_kernel->Node().Name() << ", current index: " << p_node_index << ", output name: " << (*it)->GetNode().Name() << ", output index: " << (*it)->GetNode().Index() << ", after -- output ref: " << node_refs_[idx] << std::endl;
       }
     }
   }
@@ -222,13 +267,46 @@ void ParallelExecutor::RunNodeAsyncInternal(size_t p_node_index,
 }
 
 void ParallelExecutor::EnqueueNode(size_t p_node_index, const SessionState& session_state, const logging::Logger& logger) {
-  {
-    std::unique_lock<std::mutex> lock(complete_mutex_);
-    out_standings_++;
+  out_standings_++;
+
+  if (!ready_nodes_->TryPush(p_node_index, GetPriority(p_node_index))) {
+    ORT_THROW("Failed to enqueue node ", p_node_index, ". The ready queue is full.");
+  }
+
+  // pairs with the fence in ProcessReadyNodes: either an exiting worker sees the node pushed above,
+  // or this thread sees that worker's decrement and starts a new one.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  int active = ready_nodes_->active_workers.load(std::memory_order_relaxed);
+  while (active < max_workers_) {
+    if (ready_nodes_->active_workers.compare_exchange_weak(active, active + 1)) {
+      session_state.GetThreadPool()->Schedule([this, ready_nodes = ready_nodes_, &session_state, &logger]() {
+        ProcessReadyNodes(this, ready_nodes, session_state, logger);
+      });
+      break;
+    }
+  }
+}
+
+void ParallelExecutor::ProcessReadyNodes(ParallelExecutor* executor, const std::shared_ptr<ReadyNodes>& ready_nodes,
+                                         const SessionState& session_state, const logging::Logger& logger) {
+  size_t node_index;
+  for (;;) {
+    while (ready_nodes->TryPop(node_index)) {
+      executor->RunNodeAsync(node_index, session_state, logger);
+    }
+
+    ready_nodes->active_workers.fetch_sub(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // a node may have been pushed by a thread that still saw this worker as active. if so keep going.
+    if (!ready_nodes->TryPop(node_index)) {
+      return;
+    }
+
+    ready_nodes->active_workers.fetch_add(1);
+    executor->RunNodeAsync(node_index, session_state, logger);
   }
-  //std::cout << "Enqueue async node: " << p_node_index << ", out_standings: " << out_standings_ << std::endl;
-  std::packaged_task<void()> task{std::bind(&ParallelExecutor::RunNodeAsync, this, p_node_index, std::cref(session_state), std::cref(logger))};
-  session_state.GetThreadPool()->RunTask(std::move(task));
 }
 
 Status ParallelExecutor::FetchOutput(const MLValueNameIdxMap& name_idx_map,
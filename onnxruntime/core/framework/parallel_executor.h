@@ -3,9 +3,13 @@
 
 #pragma once
 
-#include <vector>
+#include <atomic>
 #include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
 #include "core/common/common.h"
+#include "core/common/lock_free_queue.h"
 #include "core/common/status.h"
 #include "core/common/logging/logging.h"
 #include "core/framework/iexecutor.h"
@@ -37,6 +41,47 @@ class ParallelExecutor : public IExecutor {
 
   void EnqueueNode(size_t p_node_index, const SessionState& session_state, const logging::Logger& logger);
 
+  // Nodes that are ready to run, and the number of thread pool tasks currently draining them.
+  // Held via shared_ptr as a task may still be checking the queue after the last node has finished
+  // and Execute has returned.
+  struct ReadyNodes {
+    ReadyNodes(size_t capacity, int num_levels) {
+      // every node is enqueued at most once per Execute call, so a slot per node means a queue can't overflow.
+      for (int i = 0; i < num_levels; ++i) {
+        queues.push_back(std::make_unique<concurrency::LockFreeQueue<size_t>>(capacity));
+      }
+    }
+
+    bool TryPush(size_t node_index, int level) { return queues[level]->TryPush(node_index); }
+
+    // take a node from the highest priority level that has one
+    bool TryPop(size_t& node_index) {
+      for (auto queue = queues.rbegin(); queue != queues.rend(); ++queue) {
+        if ((*queue)->TryPop(node_index)) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    // one queue per priority level, so picking the most critical ready node doesn't need a lock.
+    std::vector<std::unique_ptr<concurrency::LockFreeQueue<size_t>>> queues;
+    std::atomic<int> active_workers{0};
+  };
+
+  // number of priority levels used when a NodeCostModel is available
+  static constexpr int kPriorityLevels = 8;
+
+  int GetPriority(size_t node_index) const {
+    return priority_levels_ != nullptr ? (*priority_levels_)[node_index] : 0;
+  }
+
+  // Worker loop executed on the thread pool. Runs nodes from the ready queue until it is empty.
+  // executor is only dereferenced while a node it owns is being run, as it may have been destroyed
+  // by the time a worker starts or finds the queue empty.
+  static void ProcessReadyNodes(ParallelExecutor* executor, const std::shared_ptr<ReadyNodes>& ready_nodes,
+                                const SessionState& session_state, const logging::Logger& logger);
+
   Status FetchOutput(const MLValueNameIdxMap& name_idx_map,
                      ExecutionFrame& frame,
                      const std::vector<std::string>& output_names,
@@ -44,24 +89,33 @@ class ParallelExecutor : public IExecutor {
                      const logging::Logger& logger);
 
   void FinishNodeRun() {
-    bool finished = false;
-    {
-      //Because we have a mutex here, it's not possible another thread is doing the test("while (out_standings_ > 0)"
+    if (--out_standings_ == 0) {
       std::lock_guard<std::mutex> lock(complete_mutex_);
-      finished = --out_standings_ == 0;
-    }
-    if (finished) {
-      //std::cout << "all out standing nodes are completed." << std::endl;
+      completed_ = true;
       complete_cv_.notify_all();
     }
   }
 
   std::unique_ptr<ExecutionFrame> root_frame_;
-  std::vector<size_t> node_refs_;
-  std::mutex ref_mutex_;
-  int out_standings_;  //protected by complete_mutex_
+
+  // number of inputs edges of each node that have not been satisfied yet. a node is ready when it reaches 0.
+  std::unique_ptr<std::atomic<size_t>[]> node_refs_;
+
+  std::shared_ptr<ReadyNodes> ready_nodes_;
+  int max_workers_ = 1;
+
+  // set if critical path scheduling is enabled. execution times are recorded in cost_model_ and the
+  // priority of each ready node is looked up in priority_levels_.
+  NodeCostModel* cost_model_ = nullptr;
+  std::shared_ptr<const std::vector<int>> priority_levels_;
+
+  // nodes that have been enqueued but have not finished yet, plus one held by Execute while it enqueues the
+  // root nodes. whoever takes it to zero sets completed_.
+  std::atomic<int> out_standings_{0};
   std::mutex complete_mutex_;
   std::condition_variable complete_cv_;
+  bool completed_ = false;  //protected by complete_mutex_
+  std::vector<Status> errors_;  //protected by complete_mutex_
 
   const bool& terminate_flag_;
 };
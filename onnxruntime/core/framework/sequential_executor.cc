@@ -15,9 +15,7 @@
 
 namespace onnxruntime {
 
-static Status FetchOutput(const MLValueNameIdxMap& name_idx_map,
-                          ExecutionFrame& frame,
-                          const std::vector<std::string>& output_names,
+static Status FetchOutput(ExecutionFrame& frame,
                           std::vector<MLValue>& fetches,
                           const logging::Logger& logger);
 
@@ -31,9 +29,20 @@ Status SequentialExecutor::Execute(const SessionState& session_state,
                                    const std::vector<std::string>& output_names,
                                    std::vector<MLValue>& fetches,
                                    const logging::Logger& logger) {
-  auto tp = session_state.Profiler().StartTime();
-
   ExecutionFrame frame{feeds, output_names, fetches, session_state};
+  return Execute(session_state, frame, fetches, logger);
+}
+
+Status SequentialExecutor::Execute(const SessionState& session_state,
+                                   ExecutionFrame& frame,
+                                   std::vector<MLValue>& fetches,
+                                   const logging::Logger& logger) {
+  // the profiling hooks below are skipped entirely when profiling is off, so no event names are built.
+  const bool is_profiler_enabled = session_state.Profiler().IsEnabled();
+  TimePoint tp;
+  if (is_profiler_enabled) {
+    tp = session_state.Profiler().StartTime();
+  }
 
   LOGS(logger, INFO) << "Begin execution";
   const SequentialExecutionPlan& seq_exec_plan = *session_state.GetExecutionPlan();
@@ -65,7 +74,11 @@ Status SequentialExecutor::Execute(const SessionState& session_state,
                                               terminate_flag_);
     // TODO: log kernel outputs?
 
-    auto sync_time_begin = session_state.Profiler().StartTime();
+    TimePoint sync_time_begin;
+    TimePoint kernel_begin_time;
+    if (is_profiler_enabled) {
+      sync_time_begin = session_state.Profiler().StartTime();
+    }
     // sync before compute
     int queue_id = p_op_kernel->KernelDef().ExecQueueId();
     for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
@@ -89,22 +102,28 @@ Status SequentialExecutor::Execute(const SessionState& session_state,
       }
     }
 
-    session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
-                                                   node_name + "_fence_before",
-                                                   sync_time_begin,
-                                                   {{"op_name", op_name}});
+    if (is_profiler_enabled) {
+      session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                     node_name + "_fence_before",
+                                                     sync_time_begin,
+                                                     {{"op_name", op_name}});
+    }
 
     // call compute on the kernel
     VLOGS(logger, 1) << "Computing kernel: " << p_op_kernel->Node().Name();
 
-    auto kernel_begin_time = session_state.Profiler().StartTime();
+    if (is_profiler_enabled) {
+      kernel_begin_time = session_state.Profiler().StartTime();
+    }
     ORT_RETURN_IF_ERROR(p_op_kernel->Compute(&op_kernel_context));
-    session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
-                                                   node_name + "_kernel_time",
-                                                   kernel_begin_time,
-                                                   {{"op_name", op_name}});
+    if (is_profiler_enabled) {
+      session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                     node_name + "_kernel_time",
+                                                     kernel_begin_time,
+                                                     {{"op_name", op_name}});
 
-    sync_time_begin = session_state.Profiler().StartTime();
+      sync_time_begin = session_state.Profiler().StartTime();
+    }
     // sync after compute for outputs
     for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
       Fence_t fence = op_kernel_context.InputFence(input_index);
@@ -126,10 +145,12 @@ Status SequentialExecutor::Execute(const SessionState& session_state,
         fence->AfterUsedAsOutput(queue_id);
       }
     }
-    session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
-                                                   node_name + "_fence_after",
-                                                   sync_time_begin,
-                                                   {{"op_name", op_name}});
+    if (is_profiler_enabled) {
+      session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                     node_name + "_fence_after",
+                                                     sync_time_begin,
+                                                     {{"op_name", op_name}});
+    }
 
     // free ml-values corresponding to this node
     VLOGS(logger, 1) << "Releasing node ML values after computing kernel: " << p_op_kernel->Node().Name();
@@ -137,54 +158,34 @@ Status SequentialExecutor::Execute(const SessionState& session_state,
   }
 
   VLOGS(logger, 1) << "Fetching output.";
-  ORT_RETURN_IF_ERROR(FetchOutput(session_state.GetMLValueNameIdxMap(), frame, output_names, fetches, logger));
-
-  if (frame.HasPlan()) {
-    std::vector<TensorShape> input_shapes;
-    bool all_tensors = true;
-    for (const auto& feed : feeds) {
-      if (!(feed.second.IsTensor())) {
-        all_tensors = false;
-        break;
-      }
-      auto& tensor = feed.second.Get<Tensor>();
-      input_shapes.push_back(tensor.Shape());
-    }
+  ORT_RETURN_IF_ERROR(FetchOutput(frame, fetches, logger));
 
-    if (all_tensors) {
-      auto mem_patterns = std::make_unique<MemoryPatternGroup>();
-      ORT_RETURN_IF_ERROR(frame.GeneratePatterns(mem_patterns.get()));
-      ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(input_shapes, std::move(mem_patterns)));
-    }
-  }
+  ORT_RETURN_IF_ERROR(frame.UpdateMemoryPatternGroupCache());
 
-  session_state.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "SequentialExecutor::Execute", tp);
+  if (is_profiler_enabled) {
+    session_state.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "SequentialExecutor::Execute", tp);
+  }
   return Status::OK();
 }
 
-static Status FetchOutput(const MLValueNameIdxMap& name_idx_map,
-                          ExecutionFrame& frame,
-                          const std::vector<std::string>& output_names,
+static Status FetchOutput(ExecutionFrame& frame,
                           std::vector<MLValue>& fetches,
                           const logging::Logger& logger) {
+  const auto& fetch_mlvalue_idxs = frame.GetFetchMLValueIdxs();
   if (fetches.empty()) {
-    fetches.resize(output_names.size());
+    fetches.resize(fetch_mlvalue_idxs.size());
   } else {
     // this should've been checked before already
-    ORT_ENFORCE(output_names.size() == fetches.size(),
-                        "output_names vector size: " + std::to_string(output_names.size()) +
-                            " does not match that of fetches vector: " + std::to_string(fetches.size()));
+    ORT_ENFORCE(fetch_mlvalue_idxs.size() == fetches.size(),
+                "output_names vector size: " + std::to_string(fetch_mlvalue_idxs.size()) +
+                    " does not match that of fetches vector: " + std::to_string(fetches.size()));
   }
 
   auto idx = 0;
 
-  for (const auto& oname : output_names) {
-    VLOGS(logger, 1) << "Attempting to fetch output with name: " << oname;
-    int mlvalue_index;
-    ORT_RETURN_IF_ERROR(name_idx_map.GetIdx(oname, mlvalue_index));
-    const MLValue& output_mlvalue = frame.GetMLValue(mlvalue_index);
-    VLOGS(logger, 1) << "Copying fetched MLValue to output vector";
-    fetches[idx++] = output_mlvalue;
+  for (auto mlvalue_index : fetch_mlvalue_idxs) {
+    VLOGS(logger, 1) << "Copying fetched MLValue with index " << mlvalue_index << " to output vector";
+    fetches[idx++] = frame.GetMLValue(mlvalue_index);
   }
 
   VLOGS(logger, 1) << "Done with execution.";
@@ -14,6 +14,8 @@
 #include "core/graph/graph_viewer.h"
 
 namespace onnxruntime {
+class ExecutionFrame;
+
 class SequentialExecutor : public IExecutor {
  public:
   SequentialExecutor(const bool& terminate_flag = false) : terminate_flag_{terminate_flag} {}
@@ -24,6 +26,13 @@ class SequentialExecutor : public IExecutor {
                          std::vector<MLValue>& fetches,
                          const logging::Logger& logger) override;
 
+  // Execute using a frame set up by the caller, e.g. one that is reused across runs.
+  // fetches is filled with the values of the outputs the frame was created for.
+  common::Status Execute(const SessionState& session_state,
+                         ExecutionFrame& frame,
+                         std::vector<MLValue>& fetches,
+                         const logging::Logger& logger);
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SequentialExecutor);
   const bool& terminate_flag_;
@@ -50,6 +50,10 @@ const std::unordered_map<int, MLValue>& SessionState::GetInitializedTensors() co
   return initialized_tensors_;
 }
 
+void SessionState::AddInitializedTensorMemory(std::shared_ptr<const void> memory) {
+  initialized_tensor_memory_.push_back(std::move(memory));
+}
+
 SessionState& SessionState::SetLogger(const logging::Logger& logger) {
   logger_ = &logger;
   return *this;
@@ -69,35 +73,14 @@ void SessionState::SetProfiler(profiling::Profiler& profiler) {
   return *profiler_;
 }
 
-static int64_t CalculateMemoryPatternsKey(const std::vector<TensorShape>& shapes) {
-  int64_t key = 0;
-  for (auto& shape : shapes) {
-    for (auto dim : shape.GetDims())
-      key ^= dim;
-  }
-  return key;
-}
-
-const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(const std::vector<TensorShape>& input_shapes) const {
-  std::lock_guard<std::mutex> lock(mem_patterns_lock_);
-  int64_t key = CalculateMemoryPatternsKey(input_shapes);
-  auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end())
-    return nullptr;
-
-  return it->second.get();
+std::shared_ptr<const MemoryPatternGroup> SessionState::GetMemoryPatternGroup(
+    const std::vector<TensorShape>& input_shapes) const {
+  return mem_patterns_.Find(input_shapes);
 }
 
 Status SessionState::UpdateMemoryPatternGroupCache(const std::vector<TensorShape>& input_shape,
                                                    std::unique_ptr<MemoryPatternGroup> mem_patterns) const {
-  int64_t key = CalculateMemoryPatternsKey(input_shape);
-
-  std::lock_guard<std::mutex> lock(mem_patterns_lock_);
-  auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end()) {
-    mem_patterns_[key] = std::move(mem_patterns);
-  }
-
+  mem_patterns_.Insert(input_shape, std::move(mem_patterns));
   return Status::OK();
 }
 
@@ -109,6 +92,15 @@ bool SessionState::GetEnableMemoryPattern() const {
   return enable_mem_pattern_;
 }
 
+void SessionState::SetMemoryPatternCacheOptions(size_t capacity, bool enable_shape_bucketing) {
+  mem_patterns_.SetCapacity(capacity);
+  mem_patterns_.SetEnableShapeBucketing(enable_shape_bucketing);
+}
+
+MemoryPatternCacheStats SessionState::GetMemoryPatternCacheStats() const {
+  return mem_patterns_.GetStats();
+}
+
 void SessionState::AddInputNameToNodeInfoMapping(const std::string& input_name, const NodeInfo& node_info) {
   input_names_to_nodeinfo_mapping_[input_name].push_back(node_info);
 }
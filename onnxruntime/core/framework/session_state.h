@@ -16,16 +16,21 @@
 #include "core/framework/execution_providers.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/mem_pattern.h"
+#include "core/framework/mem_pattern_cache.h"
 #include "core/framework/ml_value.h"
 #include "core/framework/mlvalue_name_idx_map.h"
+#include "core/framework/node_cost_model.h"
 #include "core/graph/graph_viewer.h"
 
 namespace onnxruntime {
 
+namespace concurrency {
+class ThreadPool;
+}
+
 class ExecutionProviders;
 class KernelDef;
 class OpKernel;
-class TaskThreadPool;
 struct SequentialExecutionPlan;
 struct MemoryPatternGroup;
 
@@ -66,6 +71,12 @@ class SessionState {
   */
   const std::unordered_map<int, MLValue>& GetInitializedTensors() const;
 
+  /**
+  * Keeps memory that initialized tensors point into, e.g. a memory mapped external data file, alive for as long
+  * as the SessionState.
+  */
+  void AddInitializedTensorMemory(std::shared_ptr<const void> memory);
+
   // execution plan
   void SetExecutionPlan(std::unique_ptr<SequentialExecutionPlan> p_seq_exec_plan);
   const SequentialExecutionPlan* GetExecutionPlan() const;
@@ -94,8 +105,10 @@ class SessionState {
 
   /**
   Get cached memory pattern based on input shapes
+  @returns nullptr if there is no pattern for the shapes. The pattern may be evicted from the cache while in use,
+  so hold the returned pointer for the lifetime of the ExecutionFrame.
   */
-  const MemoryPatternGroup* GetMemoryPatternGroup(const std::vector<TensorShape>& input_shapes) const;
+  std::shared_ptr<const MemoryPatternGroup> GetMemoryPatternGroup(const std::vector<TensorShape>& input_shapes) const;
 
   /**
   Set generated memory pattern with a given input shapes. 
@@ -114,6 +127,17 @@ class SessionState {
   */
   bool GetEnableMemoryPattern() const;
 
+  /**
+  Set the maximum number of memory patterns to cache, and whether input shapes are bucketed so that similar
+  shapes share a pattern.
+  */
+  void SetMemoryPatternCacheOptions(size_t capacity, bool enable_shape_bucketing);
+
+  /**
+  Get the hit/miss counters of the memory pattern cache.
+  */
+  MemoryPatternCacheStats GetMemoryPatternCacheStats() const;
+
   struct NodeInfo {
     NodeInfo(size_t index0, const onnxruntime::Node* p_node0, const KernelCreateInfo* kci0)
         : index(index0),
@@ -145,8 +169,20 @@ class SessionState {
   /// Return SessionState for the given Node index and attribute name if found.
   const SessionState* GetSubgraphSessionState(onnxruntime::NodeIndex index, const std::string& attribute_name) const;
 
-  TaskThreadPool* GetThreadPool() const { return thread_pool_; }
-  void SetThreadPool(TaskThreadPool* p_pool) { thread_pool_ = p_pool; }
+  concurrency::ThreadPool* GetThreadPool() const { return thread_pool_; }
+  void SetThreadPool(concurrency::ThreadPool* p_pool) { thread_pool_ = p_pool; }
+
+  /**
+  Set the cost model used by the parallel executor to prioritize nodes on the critical path.
+  If not set, ready nodes are executed in the order they become ready.
+  */
+  void SetNodeCostModel(std::unique_ptr<NodeCostModel> cost_model) { node_cost_model_ = std::move(cost_model); }
+
+  /**
+  Get the node cost model. Non-const as execution times are recorded into it while running the graph.
+  @returns nullptr if cost based scheduling is not enabled.
+  */
+  NodeCostModel* GetNodeCostModel() const { return node_cost_model_.get(); }
 
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SessionState);
@@ -160,6 +196,8 @@ class SessionState {
   MLValueNameIdxMap mlvalue_name_idx_map_;
 
   // initialized tensorset
+  // declared before initialized_tensors_ so it is released after them
+  std::vector<std::shared_ptr<const void>> initialized_tensor_memory_;
   std::unordered_map<int, MLValue> initialized_tensors_;  // key is mlvalue_index
   std::unique_ptr<SequentialExecutionPlan> p_seq_exec_plan_ = nullptr;
 
@@ -168,10 +206,8 @@ class SessionState {
 
   // switch for enable memory pattern optimization or not.
   bool enable_mem_pattern_ = true;
-  // lock for the mem_patterns_
-  mutable std::mutex mem_patterns_lock_;
   // cache for the generated mem_patterns. key is calculated based on input shapes.
-  mutable std::map<int64_t, std::unique_ptr<MemoryPatternGroup>> mem_patterns_;
+  mutable MemoryPatternCache mem_patterns_;
 
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
@@ -182,6 +218,7 @@ class SessionState {
       std::unordered_map<onnxruntime::NodeIndex,
                          std::unordered_map<std::string, gsl::not_null<const SessionState*>>>;
   SubgraphSessionStateMap subgraph_session_states_;
-  TaskThreadPool* thread_pool_ = nullptr;
+  concurrency::ThreadPool* thread_pool_ = nullptr;
+  std::unique_ptr<NodeCostModel> node_cost_model_;
 };
 }  // namespace onnxruntime
@@ -4,6 +4,8 @@
 #include "core/framework/session_state_initializer.h"
 
 #include <functional>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
@@ -23,6 +25,7 @@
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/transformer_memcpy.h"
 #include "core/framework/utils.h"
+#include "core/platform/env.h"
 
 namespace onnxruntime {
 
@@ -32,12 +35,63 @@ static common::Status SaveMLValueNameIndexMapping(const onnxruntime::Graph& grap
 
 using SaveTensorFunc = std::function<void(int idx, const onnxruntime::MLValue&)>;
 
+namespace {
+/**
+Loads the data of the initializers of a graph.
+External data files are mapped into memory, once per file. If enabled, CPU initializers with raw data are used
+in place, pointing into the TensorProto or the mapped file, instead of being copied into a buffer.
+*/
+class InitializerLoader {
+ public:
+  InitializerLoader(const std::string& model_dir, bool use_initializers_in_place)
+      : model_dir_{model_dir}, use_initializers_in_place_{use_initializers_in_place} {}
+
+  /**
+  Creates an MLValue that uses the data of the initializer in place.
+  @param mlvalue Left uninitialized if the initializer has to be copied.
+  */
+  common::Status LoadInPlace(const ONNX_NAMESPACE::TensorProto& tensor_proto, const OrtAllocatorInfo& location,
+                             MLValue& mlvalue);
+
+  // Creates an MLValue with a copy of the data of the initializer.
+  common::Status Load(const ONNX_NAMESPACE::TensorProto& tensor_proto, const OrtAllocatorInfo& location,
+                      const ExecutionProviders& exec_providers, MLValue& mlvalue,
+                      void* preallocated, size_t preallocated_size);
+
+  // The initializers whose TensorProto is used in place by an MLValue.
+  const std::unordered_set<const ONNX_NAMESPACE::TensorProto*>& TensorProtosInUse() const {
+    return tensor_protos_in_use_;
+  }
+
+  // Mapped files used in place by an MLValue.
+  const std::vector<std::shared_ptr<const void>>& MappedFilesInUse() const { return mapped_files_in_use_; }
+
+ private:
+  struct MappedFile {
+    std::shared_ptr<const char> data;
+    size_t length;
+    bool in_use;  // set once an MLValue points into the file
+  };
+
+  common::Status GetExternalData(const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                 const char*& data, size_t& length, MappedFile*& mapped_file);
+
+  const std::string model_dir_;
+  const bool use_initializers_in_place_;
+
+  std::unordered_map<std::string, MappedFile> mapped_files_;  // key is the external data location
+  std::unordered_set<const ONNX_NAMESPACE::TensorProto*> tensor_protos_in_use_;
+  std::vector<std::shared_ptr<const void>> mapped_files_in_use_;
+};
+}  // namespace
+
 static common::Status SaveInitializedTensors(const onnxruntime::Graph& graph,
                                              bool enable_memory_pattern,
                                              const SequentialExecutionPlan& execution_plan,
                                              const ExecutionProviders& exec_providers,
                                              const MLValueNameIdxMap& mlvalue_name_idx_map,
                                              std::map<OrtAllocatorInfo, BufferUniquePtr>& weights_buffers,
+                                             InitializerLoader& loader,
                                              const SaveTensorFunc& save_tensor_func,
                                              const logging::Logger& logger);
 
@@ -106,7 +160,9 @@ common::Status SessionStateInitializer::CreatePlan(const std::vector<NodeArg*>&
 }
 
 common::Status SessionStateInitializer::InitializeAndSave(bool enable_memory_pattern,
-                                                          std::map<OrtAllocatorInfo, BufferUniquePtr>& weights_buffers) {
+                                                          std::map<OrtAllocatorInfo, BufferUniquePtr>& weights_buffers,
+                                                          const std::string& model_dir,
+                                                          bool use_initializers_in_place) {
   const auto* exec_plan_ptr = session_state_.GetExecutionPlan();
   ORT_ENFORCE(exec_plan_ptr, "Execution plan was not found in SessionState. CreatePlan must be called first.");
 
@@ -118,11 +174,26 @@ common::Status SessionStateInitializer::InitializeAndSave(bool enable_memory_pat
     session_state_.AddInitializedTensor(idx, value);
   };
 
+  InitializerLoader loader{model_dir, use_initializers_in_place};
   ORT_RETURN_IF_ERROR(SaveInitializedTensors(graph_, enable_memory_pattern, exec_plan,
                                              execution_providers_, mlvalue_name_idx_map, weights_buffers,
-                                             add_initialized_tensor, logger_));
+                                             loader, add_initialized_tensor, logger_));
 
-  graph_.CleanAllInitializedTensors();  // remove weights from the graph now to save memory
+  for (const auto& mapped_file : loader.MappedFilesInUse()) {
+    session_state_.AddInitializedTensorMemory(mapped_file);
+  }
+
+  // remove weights from the graph now to save memory, apart from the ones that are used in place
+  const auto& tensor_protos_in_use = loader.TensorProtosInUse();
+  if (tensor_protos_in_use.empty()) {
+    graph_.CleanAllInitializedTensors();
+  } else {
+    for (auto& tensor_proto : graph_.ReleaseAllInitializedTensors()) {
+      if (tensor_protos_in_use.count(tensor_proto.get()) > 0) {
+        session_state_.AddInitializedTensorMemory(std::shared_ptr<const void>(std::move(tensor_proto)));
+      }
+    }
+  }
 
   ORT_RETURN_IF_ERROR(SaveKernels(execution_providers_, session_state_, kernel_registry_manager_, logger_));
   ORT_RETURN_IF_ERROR(SaveInputOutputNamesToNodeMapping(graph_, kernel_registry_manager_, session_state_));
@@ -232,6 +303,129 @@ common::Status DeserializeTensorProto(const ONNX_NAMESPACE::TensorProto& tensor_
   return common::Status::OK();
 }
 
+static bool IsCpuLocation(const OrtAllocatorInfo& location) {
+  return strcmp(location.name, CPU) == 0 || location.mem_type == OrtMemTypeCPUOutput;
+}
+
+// external data must stay within the directory of the model
+static bool IsValidExternalDataLocation(const std::string& location) {
+  if (location.empty() || location[0] == '/' || location[0] == '\\' ||
+      (location.size() > 1 && location[1] == ':')) {
+    return false;
+  }
+
+  size_t start = 0;
+  while (start <= location.size()) {
+    size_t end = location.find_first_of("/\\", start);
+    if (end == std::string::npos) {
+      end = location.size();
+    }
+    if (location.compare(start, end - start, "..") == 0) {
+      return false;
+    }
+    start = end + 1;
+  }
+  return true;
+}
+
+common::Status InitializerLoader::GetExternalData(const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                                  const char*& data, size_t& length,
+                                                  MappedFile*& mapped_file) {
+  std::string location;
+  size_t offset;
+  ORT_RETURN_IF_ERROR(utils::GetExternalDataInfo(tensor_proto, location, offset, length));
+  if (!IsValidExternalDataLocation(location)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Tensor ", tensor_proto.name(),
+                           " has external data outside of the model directory: ", location);
+  }
+
+  auto it = mapped_files_.find(location);
+  if (it == mapped_files_.end()) {
+    const std::string path = model_dir_.empty() ? location : model_dir_ + "/" + location;
+    size_t file_length;
+    ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(path, file_length));
+
+    Env::MappedMemoryPtr file_data;
+    ORT_RETURN_IF_ERROR(Env::Default().MapFileIntoMemory(path, 0, file_length, file_data));
+    it = mapped_files_.emplace(location, MappedFile{std::shared_ptr<const char>(std::move(file_data)),
+                                                    file_length, false})
+             .first;
+  }
+
+  mapped_file = &it->second;
+  if (offset > mapped_file->length || length > mapped_file->length - offset) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Tensor ", tensor_proto.name(),
+                           " has external data beyond the end of ", location);
+  }
+
+  data = mapped_file->data.get() + offset;
+  return Status::OK();
+}
+
+common::Status InitializerLoader::LoadInPlace(const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                              const OrtAllocatorInfo& location,
+                                              MLValue& mlvalue) {
+  if (!use_initializers_in_place_ || !IsCpuLocation(location)) {
+    return Status::OK();
+  }
+
+  const bool has_external_data = utils::HasExternalData(tensor_proto);
+  if (!has_external_data && !tensor_proto.has_raw_data()) {
+    return Status::OK();
+  }
+
+  const char* data = tensor_proto.raw_data().data();
+  size_t length = tensor_proto.raw_data().size();
+  MappedFile* mapped_file = nullptr;
+  if (has_external_data) {
+    ORT_RETURN_IF_ERROR(GetExternalData(tensor_proto, data, length, mapped_file));
+  }
+
+  std::unique_ptr<Tensor> p_tensor;
+  ORT_RETURN_IF_ERROR(utils::GetTensorFromTensorProtoRawDataInPlace(tensor_proto, data, length, location,
+                                                                    &p_tensor));
+  if (!p_tensor) {
+    return Status::OK();
+  }
+
+  // keep the memory the tensor points into
+  if (mapped_file == nullptr) {
+    tensor_protos_in_use_.insert(&tensor_proto);
+  } else if (!mapped_file->in_use) {
+    mapped_file->in_use = true;
+    mapped_files_in_use_.push_back(mapped_file->data);
+  }
+
+  mlvalue.Init(p_tensor.release(),
+               DataTypeImpl::GetType<Tensor>(),
+               DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+  return Status::OK();
+}
+
+common::Status InitializerLoader::Load(const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                       const OrtAllocatorInfo& location,
+                                       const ExecutionProviders& exec_providers, MLValue& mlvalue,
+                                       void* preallocated, size_t preallocated_size) {
+  if (!utils::HasExternalData(tensor_proto)) {
+    return DeserializeTensorProto(tensor_proto, location, exec_providers, mlvalue, preallocated, preallocated_size);
+  }
+
+  // copy the external data into the raw data of a temporary TensorProto, one initializer at a time
+  const char* data;
+  size_t length;
+  MappedFile* mapped_file;
+  ORT_RETURN_IF_ERROR(GetExternalData(tensor_proto, data, length, mapped_file));
+
+  ONNX_NAMESPACE::TensorProto loaded_tensor_proto;
+  loaded_tensor_proto.set_name(tensor_proto.name());
+  loaded_tensor_proto.set_data_type(tensor_proto.data_type());
+  *loaded_tensor_proto.mutable_dims() = tensor_proto.dims();
+  loaded_tensor_proto.set_raw_data(data, length);
+
+  return DeserializeTensorProto(loaded_tensor_proto, location, exec_providers, mlvalue,
+                                preallocated, preallocated_size);
+}
+
 static common::Status PlanTensor(MLValuePatternPlanner& planner, const MLValueNameIdxMap& mlvalue_name_idx_map, const std::string& name, const ONNX_NAMESPACE::TensorProto& tensor_proto) {
   int mlvalue_index;
   ORT_RETURN_IF_ERROR(mlvalue_name_idx_map.GetIdx(name, mlvalue_index));
@@ -247,6 +441,7 @@ common::Status SaveInitializedTensorsWithMemPattern(const Graph& graph,
                                                     const ExecutionProviders& exec_providers,
                                                     const MLValueNameIdxMap& mlvalue_name_idx_map,
                                                     std::map<OrtAllocatorInfo, BufferUniquePtr>& weights_buffers,
+                                                    InitializerLoader& loader,
                                                     const SaveTensorFunc& save_tensor_func,
                                                     const logging::Logger& logger) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
@@ -256,8 +451,23 @@ common::Status SaveInitializedTensorsWithMemPattern(const Graph& graph,
   MLValuePatternPlanner planner(execution_plan);
 
   //1. first plan the memory
+  // initializers used in place don't need a buffer, so they are saved before planning
+  std::unordered_set<std::string> saved_in_place;
   const onnxruntime::InitializedTensorSet& initialized_tensor_set = graph.GetAllInitializedTensors();
   for (const auto& entry : initialized_tensor_set) {
+    int mlvalue_index;
+    ORT_RETURN_IF_ERROR(mlvalue_name_idx_map.GetIdx(entry.first, mlvalue_index));
+    MLValue mlvalue;
+    ORT_RETURN_IF_ERROR(loader.LoadInPlace(*entry.second, execution_plan.allocation_plan[mlvalue_index].location,
+                                           mlvalue));
+    if (mlvalue.IsAllocated()) {
+      save_tensor_func(mlvalue_index, mlvalue);
+      saved_in_place.insert(entry.first);
+      VLOGS(logger, 1) << "Added weight with name : " << entry.first << " with index: " << mlvalue_index
+                       << " in place";
+      continue;
+    }
+
     //string/complex64/complex128 tensors will be skipped
     ORT_RETURN_IF_ERROR(PlanTensor(planner, mlvalue_name_idx_map, entry.first, *entry.second));
   }
@@ -282,6 +492,10 @@ common::Status SaveInitializedTensorsWithMemPattern(const Graph& graph,
   //3. create weight tensors based on weights buffer
   for (const auto& entry : initialized_tensor_set) {
     const std::string& name = entry.first;
+    if (saved_in_place.count(name) > 0) {
+      continue;
+    }
+
     int mlvalue_index;
     ORT_RETURN_IF_ERROR(mlvalue_name_idx_map.GetIdx(name, mlvalue_index));
     const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
@@ -305,10 +519,10 @@ common::Status SaveInitializedTensorsWithMemPattern(const Graph& graph,
     }
     Status st;
     if (!block) {
-      st = DeserializeTensorProto(tensor_proto, location, exec_providers, mlvalue, nullptr, 0);
+      st = loader.Load(tensor_proto, location, exec_providers, mlvalue, nullptr, 0);
     } else {
-      st = DeserializeTensorProto(tensor_proto, location, exec_providers, mlvalue,
-                                  (uint8_t*)it->second.get() + block->offset_, block->size_);
+      st = loader.Load(tensor_proto, location, exec_providers, mlvalue,
+                       (uint8_t*)it->second.get() + block->offset_, block->size_);
     }
     if (!st.IsOK()) {
       std::ostringstream oss;
@@ -329,6 +543,7 @@ common::Status SaveInitializedTensorsWithSeperateBuffer(const onnxruntime::Graph
                                                         const SequentialExecutionPlan& execution_plan,
                                                         const ExecutionProviders& exec_providers,
                                                         const MLValueNameIdxMap& mlvalue_name_idx_map,
+                                                        InitializerLoader& loader,
                                                         const SaveTensorFunc& save_tensor_func,
                                                         const logging::Logger& logger) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
@@ -343,7 +558,10 @@ common::Status SaveInitializedTensorsWithSeperateBuffer(const onnxruntime::Graph
     VLOGS(logger, 1) << "About to add weight with name: " << name << " and index: " << mlvalue_index;
     auto& location = execution_plan.allocation_plan[mlvalue_index].location;
     MLValue mlvalue;
-    ORT_RETURN_IF_ERROR(DeserializeTensorProto(*(entry.second), location, exec_providers, mlvalue, nullptr, 0));
+    ORT_RETURN_IF_ERROR(loader.LoadInPlace(*(entry.second), location, mlvalue));
+    if (!mlvalue.IsAllocated()) {
+      ORT_RETURN_IF_ERROR(loader.Load(*(entry.second), location, exec_providers, mlvalue, nullptr, 0));
+    }
     save_tensor_func(mlvalue_index, mlvalue);
     VLOGS(logger, 1) << "Added weight with name : " << name << " with index: " << mlvalue_index;
   }
@@ -358,6 +576,7 @@ common::Status SaveInitializedTensors(const onnxruntime::Graph& graph,
                                       const ExecutionProviders& exec_providers,
                                       const MLValueNameIdxMap& mlvalue_name_idx_map,
                                       std::map<OrtAllocatorInfo, BufferUniquePtr>& weights_buffers,
+                                      InitializerLoader& loader,
                                       const SaveTensorFunc& save_tensor_func,
                                       const logging::Logger& logger) {
   // if we enable the memory pattern and already have the execution plan
@@ -365,10 +584,10 @@ common::Status SaveInitializedTensors(const onnxruntime::Graph& graph,
   // the weights.
   if (enable_memory_pattern) {
     return SaveInitializedTensorsWithMemPattern(graph, execution_plan, exec_providers,
-                                                mlvalue_name_idx_map, weights_buffers, save_tensor_func, logger);
+                                                mlvalue_name_idx_map, weights_buffers, loader, save_tensor_func, logger);
   }
   return SaveInitializedTensorsWithSeperateBuffer(graph, execution_plan, exec_providers,
-                                                  mlvalue_name_idx_map, save_tensor_func, logger);
+                                                  mlvalue_name_idx_map, loader, save_tensor_func, logger);
 }
 
 static common::Status CreateOpKernelInternal(const onnxruntime::Node& node,
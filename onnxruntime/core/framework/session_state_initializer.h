@@ -3,6 +3,7 @@
 
 #pragma once
 #include <map>
+#include <string>
 
 #include "core/framework/allocator.h"
 #include "core/framework/tensor.h"
@@ -34,8 +35,13 @@ class SessionStateInitializer {
 
   // initialize tensors, and save. save kernels and input/output node mappings
   // @param enable_memory_pattern
+  // @param model_dir Directory the locations of initializers with external data are relative to.
+  // @param use_initializers_in_place If true, CPU initializers with raw data point into the TensorProto or
+  //                                  the mapped external data file instead of being copied.
   common::Status InitializeAndSave(bool enable_memory_pattern,
-                                   std::map<OrtAllocatorInfo, BufferUniquePtr>& weights_buffers);
+                                   std::map<OrtAllocatorInfo, BufferUniquePtr>& weights_buffers,
+                                   const std::string& model_dir = std::string(),
+                                   bool use_initializers_in_place = false);
 
  private:
   onnxruntime::Graph& graph_;
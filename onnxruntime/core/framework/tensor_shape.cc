@@ -8,35 +8,85 @@
 
 namespace onnxruntime {
 
-TensorShape::TensorShape(const std::vector<int64_t>& dims) : std::vector<int64_t>(dims) {
+constexpr size_t TensorShape::kMaxInlineDims;
+
+TensorShape::TensorShape(const TensorShape& other) {
+  std::copy(other.dims_, other.dims_ + other.num_dims_, Allocate(other.num_dims_));
+}
+
+TensorShape& TensorShape::operator=(const TensorShape& other) {
+  if (this != &other) {
+    std::copy(other.dims_, other.dims_ + other.num_dims_, Allocate(other.num_dims_));
+  }
+  return *this;
 }
 
-TensorShape::TensorShape(const std::initializer_list<int64_t>& dims) : std::vector<int64_t>(dims) {
+TensorShape::TensorShape(TensorShape&& other) noexcept {
+  *this = std::move(other);
 }
 
-TensorShape::TensorShape(const int64_t* dimension_sizes, size_t dimension_count) : std::vector<int64_t>(dimension_count) {
-  for (size_t i = 0; i < dimension_count; ++i) {
-    (*this)[i] = dimension_sizes[i];
+TensorShape& TensorShape::operator=(TensorShape&& other) noexcept {
+  if (this != &other) {
+    if (other.allocated_dims_) {
+      // steal the heap buffer
+      allocated_dims_ = std::move(other.allocated_dims_);
+      dims_ = allocated_dims_.get();
+    } else {
+      allocated_dims_.reset();
+      dims_ = small_dims_;
+      std::copy(other.small_dims_, other.small_dims_ + other.num_dims_, small_dims_);
+    }
+    num_dims_ = other.num_dims_;
+    other.dims_ = other.small_dims_;
+    other.num_dims_ = 0;
   }
+  return *this;
+}
+
+TensorShape::TensorShape(const std::vector<int64_t>& dims) {
+  std::copy(dims.begin(), dims.end(), Allocate(dims.size()));
 }
 
+TensorShape::TensorShape(const std::initializer_list<int64_t>& dims) {
+  std::copy(dims.begin(), dims.end(), Allocate(dims.size()));
+}
+
+TensorShape::TensorShape(const int64_t* dimension_sizes, size_t dimension_count) {
+  std::copy(dimension_sizes, dimension_sizes + dimension_count, Allocate(dimension_count));
+}
 
 TensorShape::TensorShape(const std::vector<int64_t>& dims, size_t start, size_t end) {
-  assign(dims.begin() + start, dims.begin() + end);
+  std::copy(dims.begin() + start, dims.begin() + end, Allocate(end - start));
+}
+
+TensorShape::TensorShape(TensorShapeView dims) {
+  std::copy(dims.begin(), dims.end(), Allocate(dims.size()));
+}
+
+int64_t* TensorShape::Allocate(size_t num_dims) {
+  if (num_dims <= kMaxInlineDims) {
+    allocated_dims_.reset();
+    dims_ = small_dims_;
+  } else if (!allocated_dims_ || num_dims > num_dims_) {
+    // only grow the heap buffer. a buffer that is large enough for the new rank is reused.
+    allocated_dims_.reset(new int64_t[num_dims]);
+    dims_ = allocated_dims_.get();
+  }
+  num_dims_ = num_dims;
+  return dims_;
 }
 
 /**
  * Return the total number of elements. Returns 1 for an empty (rank 0) TensorShape.
  */
 int64_t TensorShape::Size() const {
-  size_t arraySize = size();
-  int64_t size = SizeHelper(0, arraySize);
+  int64_t size = SizeHelper(0, num_dims_);
   //should we cache the size? as multiple operation may be expensive.
   return size;
 }
 
 int64_t TensorShape::SizeToDimension(size_t dimension) const {
-  const size_t num_dims = size();
+  const size_t num_dims = num_dims_;
   ORT_ENFORCE(dimension <= num_dims,
                       "Invalid dimension of ", dimension, " for SizeFromDimension. Tensor has ",
                       num_dims, " dimensions.");
@@ -46,7 +96,7 @@ int64_t TensorShape::SizeToDimension(size_t dimension) const {
 }
 
 int64_t TensorShape::SizeFromDimension(size_t dimension) const {
-  const size_t num_dims = size();
+  const size_t num_dims = num_dims_;
   ORT_ENFORCE(dimension <= num_dims,
                       "Invalid dimension of ", dimension, " for SizeFromDimension. Tensor has ",
                       num_dims, " dimensions.");
@@ -56,13 +106,13 @@ int64_t TensorShape::SizeFromDimension(size_t dimension) const {
 }
 
 TensorShape TensorShape::Slice(size_t dimstart, size_t dimend) const {
-  ORT_ENFORCE(dimstart <= dimend && dimend <= size(),
+  ORT_ENFORCE(dimstart <= dimend && dimend <= num_dims_,
                       "Invalid tensor shape slice argument.");
-  return TensorShape(*this, dimstart, dimend);
+  return TensorShape(dims_ + dimstart, dimend - dimstart);
 }
 
 TensorShape TensorShape::Slice(size_t dimstart) const {
-  return Slice(dimstart, size());
+  return Slice(dimstart, num_dims_);
 }
 
 // output dimensions
@@ -71,7 +121,7 @@ std::string TensorShape::ToString() const {
 
   result.append("{");
   bool first = true;
-  for (auto dim : (*this)) {
+  for (auto dim : GetDims()) {
     if (!first) {
       result.append(",");
     }
@@ -88,8 +138,8 @@ int64_t TensorShape::SizeHelper(size_t start, size_t end) const {
   // Must return 1 for an empty sequence
   int64_t size = 1;
   for (size_t i = start; i < end; i++) {
-    if ((*this)[i] < 0) return -1;
-    size *= (*this)[i];
+    if (dims_[i] < 0) return -1;
+    size *= dims_[i];
   }
   return size;
 }
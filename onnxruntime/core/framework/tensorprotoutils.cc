@@ -3,6 +3,7 @@
 
 #include "core/framework/tensorprotoutils.h"
 
+#include <cstddef>
 #include <memory>
 #include "core/graph/onnx_protobuf.h"
 #include "core/common/logging/logging.h"
@@ -214,6 +215,123 @@ common::Status GetTensorFromTensorProto(const TensorProto& tensor_proto,
   }
 }
 
+bool HasExternalData(const TensorProto& tensor_proto) {
+  return tensor_proto.has_data_location() &&
+         tensor_proto.data_location() == TensorProto_DataLocation_EXTERNAL;
+}
+
+// Gets the type of the elements of a tensor that can be stored as raw data, and their size.
+static bool GetRawDataElementType(int32_t data_type, MLDataType& element_type, size_t& element_size) {
+#define CASE_RAW_DATA_TYPE(X, Y)                                \
+  case TensorProto_DataType_##X:                                \
+    element_type = DataTypeImpl::GetType<Y>();                  \
+    element_size = sizeof(Y);                                   \
+    return true;
+
+  switch (data_type) {
+    CASE_RAW_DATA_TYPE(FLOAT, float);
+    CASE_RAW_DATA_TYPE(DOUBLE, double);
+    CASE_RAW_DATA_TYPE(BOOL, bool);
+    CASE_RAW_DATA_TYPE(INT8, int8_t);
+    CASE_RAW_DATA_TYPE(INT16, int16_t);
+    CASE_RAW_DATA_TYPE(INT32, int32_t);
+    CASE_RAW_DATA_TYPE(INT64, int64_t);
+    CASE_RAW_DATA_TYPE(UINT8, uint8_t);
+    CASE_RAW_DATA_TYPE(UINT16, uint16_t);
+    CASE_RAW_DATA_TYPE(UINT32, uint32_t);
+    CASE_RAW_DATA_TYPE(UINT64, uint64_t);
+    CASE_RAW_DATA_TYPE(FLOAT16, MLFloat16);
+    CASE_RAW_DATA_TYPE(BFLOAT16, BFloat16);
+    default:
+      return false;
+  }
+#undef CASE_RAW_DATA_TYPE
+}
+
+static Status GetRawDataLength(const TensorProto& tensor_proto, const TensorShape& tensor_shape, size_t& length) {
+  MLDataType element_type;
+  size_t element_size;
+  if (!GetRawDataElementType(tensor_proto.data_type(), element_type, element_size)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Tensor ", tensor_proto.name(),
+                           " has a type that can't be stored as raw data: ", tensor_proto.data_type());
+  }
+
+  int64_t tensor_size = tensor_shape.Size();
+  if (tensor_size < 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid shape ", tensor_shape);
+  }
+
+  if (!IAllocator::CalcMemSizeForArray(static_cast<size_t>(tensor_size), element_size, &length)) {
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "size overflow");
+  }
+  return Status::OK();
+}
+
+Status GetExternalDataInfo(const TensorProto& tensor_proto, std::string& location, size_t& offset, size_t& length) {
+  ORT_ENFORCE(HasExternalData(tensor_proto));
+
+  location.clear();
+  offset = 0;
+  ORT_RETURN_IF_ERROR(GetRawDataLength(tensor_proto, TensorShape(GetTensorShapeFromTensorProto(tensor_proto)),
+                                       length));
+
+  for (const auto& entry : tensor_proto.external_data()) {
+    try {
+      if (entry.key() == "location") {
+        location = entry.value();
+      } else if (entry.key() == "offset") {
+        offset = static_cast<size_t>(std::stoull(entry.value()));
+      } else if (entry.key() == "length") {
+        length = static_cast<size_t>(std::stoull(entry.value()));
+      }
+    } catch (const std::exception&) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Tensor ", tensor_proto.name(),
+                             " has an invalid external data ", entry.key(), ": ", entry.value());
+    }
+  }
+
+  if (location.empty()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Tensor ", tensor_proto.name(),
+                           " has external data without a location");
+  }
+  return Status::OK();
+}
+
+Status GetTensorFromTensorProtoRawDataInPlace(const TensorProto& tensor_proto,
+                                              const void* raw_data, size_t raw_data_length,
+                                              const OrtAllocatorInfo& allocator_info,
+                                              std::unique_ptr<Tensor>* p_tensor) {
+  p_tensor->reset();
+
+  MLDataType element_type;
+  size_t element_size;
+  if (!GetRawDataElementType(tensor_proto.data_type(), element_type, element_size)) {
+    return Status::OK();
+  }
+
+  // raw data is little-endian
+  static const int n = 1;
+  if (*reinterpret_cast<const char*>(&n) != 1) {
+    return Status::OK();
+  }
+
+  TensorShape tensor_shape{GetTensorShapeFromTensorProto(tensor_proto)};
+  size_t expected_length;
+  ORT_RETURN_IF_ERROR(GetRawDataLength(tensor_proto, tensor_shape, expected_length));
+  if (raw_data_length != expected_length) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Tensor ", tensor_proto.name(), " has ",
+                           raw_data_length, " bytes of data. Expected ", expected_length);
+  }
+
+  if (reinterpret_cast<std::uintptr_t>(raw_data) % alignof(std::max_align_t) != 0) {
+    return Status::OK();
+  }
+
+  // no allocator, the data isn't owned by the tensor
+  *p_tensor = std::make_unique<Tensor>(element_type, tensor_shape, const_cast<void*>(raw_data), allocator_info);
+  return Status::OK();
+}
+
 TensorProto::DataType GetTensorProtoType(const Tensor& tensor) {
   auto tensor_type = tensor.DataType();
   TensorProto::DataType dtype = TensorProto_DataType_UNDEFINED;
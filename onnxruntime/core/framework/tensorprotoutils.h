@@ -25,5 +25,28 @@ std::vector<int64_t> GetTensorShapeFromTensorShapeProto(const ONNX_NAMESPACE::Te
 common::Status TensorProtoToMLValue(const ONNX_NAMESPACE::TensorProto& input, AllocatorPtr allocator, void* preallocated,
                                     size_t preallocated_size, MLValue& value);
 ONNX_NAMESPACE::TensorProto::DataType GetTensorProtoType(const Tensor& tensor);
+
+// Returns true if the data of tensor_proto is stored in an external file.
+bool HasExternalData(const ONNX_NAMESPACE::TensorProto& tensor_proto);
+
+/**
+Gets where the external data of tensor_proto is.
+@param location The path of the file, relative to the directory of the model.
+@param offset The offset of the data in the file.
+@param length The length of the data. Defaults to the size of the tensor if not specified by tensor_proto.
+*/
+common::Status GetExternalDataInfo(const ONNX_NAMESPACE::TensorProto& tensor_proto, std::string& location,
+                                   size_t& offset, size_t& length);
+
+/**
+Creates a Tensor that uses the raw data of a TensorProto in place rather than copying it.
+@param raw_data Either tensor_proto.raw_data() or the external data of tensor_proto. It must outlive the Tensor.
+@param p_tensor Set to nullptr if the data can't be used in place. This is the case for string tensors, big-endian
+platforms, and data that isn't aligned at least as well as memory returned by the CPU allocator.
+*/
+common::Status GetTensorFromTensorProtoRawDataInPlace(const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                                      const void* raw_data, size_t raw_data_length,
+                                                      const OrtAllocatorInfo& allocator_info,
+                                                      std::unique_ptr<Tensor>* p_tensor);
 }  // namespace utils
 }  // namespace onnxruntime
@@ -99,6 +99,76 @@ activation.)DOC")
         ONNX_NAMESPACE::convPoolTypeAndShapeInference(ctx, false, true);
       });
 
+  ONNX_CONTRIB_OPERATOR_SCHEMA(FusedGemm)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+The fused Gemm operator schema is the same as Gemm besides it includes the attributes
+activation and leaky_relu_alpha.)DOC")
+      .Input(0, "A", "Input tensor A of shape (M, K), or (K, M) if transA is non-zero.", "T")
+      .Input(1, "B", "Input tensor B of shape (K, N), or (N, K) if transB is non-zero.", "T")
+      .Input(2, "C", "Input tensor C, unidirectional broadcastable to (M, N).", "T")
+      .Output(0, "Y", "Output tensor of shape (M, N).", "T")
+      .TypeConstraint("T", {"tensor(float16)", "tensor(float)", "tensor(double)"}, "Constrain input and output types to float tensors")
+      .Attr("transA", "Whether A should be transposed", AttributeProto::INT, static_cast<int64_t>(0))
+      .Attr("transB", "Whether B should be transposed", AttributeProto::INT, static_cast<int64_t>(0))
+      .Attr("alpha", "Scalar multiplier for the product of input tensors A * B.", AttributeProto::FLOAT, 1.0f)
+      .Attr("beta", "Scalar multiplier for input tensor C.", AttributeProto::FLOAT, 1.0f)
+      .Attr("activation", "Activation applied to the output: Relu, Sigmoid, Tanh or LeakyRelu.", AttributeProto::STRING, OPTIONAL)
+      .Attr("leaky_relu_alpha", "Alpha of the LeakyRelu activation.", AttributeProto::FLOAT, OPTIONAL)
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        if (!hasNInputShapes(ctx, 2)) {
+          return;
+        }
+
+        auto& a_shape = ctx.getInputType(0)->tensor_type().shape();
+        auto& b_shape = ctx.getInputType(1)->tensor_type().shape();
+        if (a_shape.dim_size() != 2 || b_shape.dim_size() != 2) {
+          fail_shape_inference("FusedGemm inputs A and B must be 2-D");
+        }
+
+        auto trans_a_attr = ctx.getAttribute("transA");
+        auto trans_b_attr = ctx.getAttribute("transB");
+        const bool trans_a = trans_a_attr != nullptr && trans_a_attr->i() != 0;
+        const bool trans_b = trans_b_attr != nullptr && trans_b_attr->i() != 0;
+        auto* output_shape = ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape();
+        *output_shape->add_dim() = a_shape.dim(trans_a ? 1 : 0);
+        *output_shape->add_dim() = b_shape.dim(trans_b ? 0 : 1);
+      });
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(FusedElementwise)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+Evaluates a chain of element-wise operators in a single pass. The operators are listed in evaluation order in 'ops'.
+Each operator reads one (unary) or two (binary) operand slots, listed in order in 'operands': slots 0 to N-1 are the
+N inputs, and slot N+k is the result of operator k. The result of the last operator is the output. Inputs are
+broadcast together following numpy semantics.
+Supported operators are Add, Sub, Mul, Div, Relu, Sigmoid, Tanh, LeakyRelu, Neg, Abs, Exp, Sqrt and Reciprocal.)DOC")
+      .Attr("ops", "Element-wise operators, in evaluation order.", AttributeProto::STRINGS)
+      .Attr("operands", "Operand slots of each operator, in order.", AttributeProto::INTS)
+      .Attr("alphas", "Alpha of each LeakyRelu operator, ignored for the others.", AttributeProto::FLOATS, OPTIONAL)
+      .Input(0, "inputs", "Inputs of the chain", "T", OpSchema::Variadic)
+      .Output(0, "Y", "Result of the last operator", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+
+        const size_t num_inputs = ctx.getNumInputs();
+        if (!hasNInputShapes(ctx, static_cast<int>(num_inputs))) {
+          return;
+        }
+
+        ONNX_NAMESPACE::TensorShapeProto output_shape = ctx.getInputType(0)->tensor_type().shape();
+        for (size_t i = 1; i < num_inputs; ++i) {
+          ONNX_NAMESPACE::TensorShapeProto shape;
+          bidirectionalBroadcastShapeInference(output_shape, ctx.getInputType(i)->tensor_type().shape(), shape);
+          output_shape = shape;
+        }
+        *ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape() = output_shape;
+      });
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(ExpandDims)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
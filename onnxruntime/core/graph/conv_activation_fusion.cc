@@ -42,7 +42,7 @@ Status ConvActivationFusion::Apply(Graph& graph, bool& modified) const {
                                      "com.microsoft");
 
     //Add a new attribute to specify the activation type
-    fused_conv.AddAttribute("activation", "string");
+    fused_conv.AddAttribute("activation", act_node.OpType());
 
     //Add optional attributes for activations
     if (act_node.OpType() == "LeakyRelu") {
@@ -0,0 +1,174 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/elementwise_fusion.h"
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include "core/graph/graph_utils.h"
+
+using namespace onnx;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+bool IsFusableElementwise(const Node& node) {
+  static const std::pair<const char*, int> kFusableOps[] = {
+      {"Add", 7}, {"Sub", 7}, {"Mul", 7}, {"Div", 7}, {"Relu", 6}, {"Sigmoid", 6}, {"Tanh", 6}, {"LeakyRelu", 6},
+      {"Neg", 6}, {"Abs", 6}, {"Exp", 6}, {"Sqrt", 6}, {"Reciprocal", 6}};
+
+  bool supported = false;
+  for (const auto& op : kFusableOps) {
+    if (utils::IsSupportedOptypeVersionAndDomain(node, op.first, op.second)) {
+      supported = true;
+      break;
+    }
+  }
+
+  // FusedElementwise is only implemented for float on CPU
+  const std::string& provider = node.GetExecutionProviderType();
+  const std::string* type = node.OutputDefs()[0]->Type();
+  return supported && (provider.empty() || provider == kCpuExecutionProvider) &&
+         type != nullptr && *type == "tensor(float)";
+}
+
+// number of elements of arg, or -1 if its shape isn't fully known
+int64_t GetKnownSize(const NodeArg& arg) {
+  const TensorShapeProto* shape = arg.Shape();
+  if (shape == nullptr) {
+    return -1;
+  }
+
+  int64_t size = 1;
+  for (const auto& dim : shape->dim()) {
+    if (!dim.has_dim_value()) {
+      return -1;
+    }
+    size *= dim.dim_value();
+  }
+  return size;
+}
+
+// the node the output of node goes to, if it only has one
+const Node* GetSingleConsumer(const Graph& graph, const Node& node) {
+  if (node.GetOutputEdgesCount() == 0 || graph.IsNodeOutputsInGraphOutputs(node)) {
+    return nullptr;
+  }
+
+  const Node* consumer = &*node.OutputNodesBegin();
+  for (auto it = node.OutputNodesBegin(); it != node.OutputNodesEnd(); ++it) {
+    if ((*it).Index() != consumer->Index()) {
+      return nullptr;
+    }
+  }
+  return consumer;
+}
+}  // namespace
+
+Status ElementwiseFusion::Apply(Graph& graph, bool& modified) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  // group the fusable nodes, visiting consumers before producers. a node joins the group of its consumer if that is
+  // the only node using its output, so the intermediate results of a group are only used inside it. each group is
+  // in reverse topological order, starting with the node producing the output of the group.
+  std::vector<std::vector<NodeIndex>> groups;
+  std::unordered_map<NodeIndex, size_t> group_of;
+  for (auto it = order.rbegin(); it != order.rend(); ++it) {
+    const Node& node = *graph.GetNode(*it);
+    if (!IsFusableElementwise(node)) {
+      continue;
+    }
+
+    size_t group = groups.size();
+    const Node* consumer = GetSingleConsumer(graph, node);
+    if (consumer != nullptr) {
+      auto consumer_group = group_of.find(consumer->Index());
+
+      // don't fuse a node whose output is broadcast by its consumer, as the fused node would compute it once per
+      // element of the larger output.
+      const int64_t size = GetKnownSize(*node.OutputDefs()[0]);
+      const int64_t consumer_size = GetKnownSize(*consumer->OutputDefs()[0]);
+      const bool is_broadcast = size >= 0 && consumer_size >= 0 && size < consumer_size;
+
+      if (consumer_group != group_of.end() && !is_broadcast) {
+        group = consumer_group->second;
+      }
+    }
+
+    if (group == groups.size()) {
+      groups.emplace_back();
+    }
+    groups[group].push_back(node.Index());
+    group_of[node.Index()] = group;
+  }
+
+  std::vector<onnxruntime::NodeIndex> removed_nodes;
+  for (const auto& group : groups) {
+    if (group.size() < 2) {
+      continue;
+    }
+
+    std::unordered_set<const NodeArg*> intermediate_defs;
+    for (auto index : group) {
+      intermediate_defs.insert(graph.GetNode(index)->OutputDefs()[0]);
+    }
+
+    // inputs of the fused node are the inputs of the group produced outside of it
+    std::vector<NodeArg*> input_defs;
+    std::unordered_map<const NodeArg*, int64_t> slots;
+    for (auto it = group.rbegin(); it != group.rend(); ++it) {
+      for (NodeArg* def : graph.GetNode(*it)->MutableInputDefs()) {
+        if (intermediate_defs.count(def) == 0 && slots.count(def) == 0) {
+          slots[def] = static_cast<int64_t>(input_defs.size());
+          input_defs.push_back(def);
+        }
+      }
+    }
+
+    std::vector<std::string> ops;
+    std::vector<int64_t> operands;
+    std::vector<float> alphas;
+    for (auto it = group.rbegin(); it != group.rend(); ++it) {
+      const Node& node = *graph.GetNode(*it);
+      ops.push_back(node.OpType());
+      for (const NodeArg* def : node.InputDefs()) {
+        operands.push_back(slots.at(def));
+      }
+
+      float alpha = 0.01f;
+      auto attr = node.GetAttributes().find("alpha");
+      if (attr != node.GetAttributes().end()) {
+        alpha = attr->second.f();
+      }
+      alphas.push_back(alpha);
+
+      slots[node.OutputDefs()[0]] = static_cast<int64_t>(input_defs.size() + ops.size() - 1);
+    }
+
+    Node& root = *graph.GetNode(group.front());
+    Node& fused = graph.AddNode(graph.GenerateNodeName("fused " + root.Name()), "FusedElementwise",
+                                "fused element-wise ops ending with " + root.Name(),
+                                input_defs,
+                                root.MutableOutputDefs(),
+                                nullptr,
+                                kMSDomain);
+    fused.AddAttribute("ops", ops);
+    fused.AddAttribute("operands", operands);
+    fused.AddAttribute("alphas", alphas);
+
+    removed_nodes.insert(removed_nodes.end(), group.begin(), group.end());
+  }
+
+  for (auto i : removed_nodes) {
+    graph.RemoveNode(i);
+  }
+
+  if (!removed_nodes.empty()) {
+    modified = true;
+    ORT_RETURN_IF_ERROR(graph.Resolve());
+  }
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,22 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/graph/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+  * Fuses chains of float element-wise nodes (Add, Sub, Mul, Div, Relu, Sigmoid, Tanh, LeakyRelu, Neg, Abs, Exp,
+  * Sqrt, Reciprocal) into a single FusedElementwise node. A node joins the chain of its consumer when the consumer
+  * is the only user of its output, so each fused node replaces a tree of nodes whose intermediate results aren't
+  * needed anywhere else.
+  */
+class ElementwiseFusion : public onnxruntime::GraphTransformer {
+ public:
+  ElementwiseFusion() noexcept : onnxruntime::GraphTransformer("ElementwiseFusion", "Fusing chains of element-wise ops") {}
+  Status Apply(onnxruntime::Graph& graph, bool& modified) const override;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,78 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/gemm_activation_fusion.h"
+#include "core/graph/graph_utils.h"
+
+using namespace onnx;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+bool IsFusableActivation(const Node& node) {
+  return utils::IsSupportedOptypeVersionAndDomain(node, "LeakyRelu", 6) || utils::IsSupportedOptypeVersionAndDomain(node, "Relu", 6) || utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", 6) || utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", 6);
+}
+}  // namespace
+
+Status GemmActivationFusion::Apply(Graph& graph, bool& modified) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  std::vector<onnxruntime::NodeIndex> removed_nodes;
+  for (auto index : order) {
+    auto node = graph.GetNode(index);
+    if (!(utils::IsSupportedOptypeVersionAndDomain(*node, "Gemm", 7) ||
+          utils::IsSupportedOptypeVersionAndDomain(*node, "Gemm", 9)) ||
+        node->GetOutputEdgesCount() != 1 || graph.IsNodeOutputsInGraphOutputs(*node)) {
+      continue;
+    }
+
+    // FusedGemm is only implemented on CPU for float
+    const std::string& provider = node->GetExecutionProviderType();
+    const std::string* type = node->OutputDefs()[0]->Type();
+    if (!(provider.empty() || provider == kCpuExecutionProvider) || type == nullptr || *type != "tensor(float)") {
+      continue;
+    }
+
+    const Node& next_node = *(node->OutputNodesBegin());
+    if (!IsFusableActivation(next_node) || next_node.GetExecutionProviderType() != provider) {
+      continue;
+    }
+
+    Node* gemm_node = node;
+    Node& act_node = *graph.GetNode(next_node.Index());
+
+    Node& fused_gemm = graph.AddNode(graph.GenerateNodeName("fused " + gemm_node->Name()), "FusedGemm",
+                                     "fused Gemm " + gemm_node->Name() + " with activation " + act_node.OpType(),
+                                     gemm_node->MutableInputDefs(),
+                                     act_node.MutableOutputDefs(),
+                                     &gemm_node->GetAttributes(),
+                                     kMSDomain);
+    fused_gemm.SetExecutionProviderType(provider);
+
+    //Add a new attribute to specify the activation type
+    fused_gemm.AddAttribute("activation", act_node.OpType());
+
+    //LeakyRelu's alpha is renamed, as Gemm has its own alpha
+    if (act_node.OpType() == "LeakyRelu") {
+      auto alpha = act_node.GetAttributes().find("alpha");
+      if (alpha != act_node.GetAttributes().end()) {
+        fused_gemm.AddAttribute("leaky_relu_alpha", alpha->second.f());
+      }
+    }
+
+    removed_nodes.push_back(act_node.Index());
+    removed_nodes.push_back(gemm_node->Index());
+  }
+
+  for (auto i : removed_nodes) {
+    graph.RemoveNode(i);
+  }
+
+  if (!removed_nodes.empty()) {
+    modified = true;
+    ORT_RETURN_IF_ERROR(graph.Resolve());
+  }
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -1921,6 +1921,25 @@ void Graph::CleanAllInitializedTensors() noexcept {
   }
 }
 
+std::vector<std::unique_ptr<TensorProto>> Graph::ReleaseAllInitializedTensors() {
+  name_to_initial_tensor_.clear();
+  removed_initializer_indexes_.clear();
+
+  std::vector<std::unique_ptr<TensorProto>> initializers;
+  auto* graph_initializers = graph_proto_->mutable_initializer();
+  initializers.reserve(graph_initializers->size());
+  while (!graph_initializers->empty()) {
+    initializers.emplace_back(graph_initializers->ReleaseLast());
+  }
+
+  const int num_cleared = graph_proto_->initializer().ClearedCount();
+  for (int i = 0; i < num_cleared; i++) {
+    delete graph_initializers->ReleaseCleared();
+  }
+
+  return initializers;
+}
+
 const InitializedTensorSet& Graph::GetAllInitializedTensors() const noexcept {
   return name_to_initial_tensor_;
 }
@@ -7,17 +7,32 @@ using namespace ::onnxruntime::common;
 
 namespace onnxruntime {
 
-Status GraphTransformerManager::ApplyAll(Graph& graph) const {
+Status GraphTransformerManager::ApplyAll(Graph& graph, const logging::Logger& logger) const {
+  if (transformers_.empty()) {
+    return Status::OK();
+  }
+
+  const int initial_num_nodes = graph.NumberOfNodes();
+  unsigned steps_run = 0;
   for (unsigned step = 0; step < steps_; ++step) {
+    ++steps_run;
     bool changed = false;
     for (auto& transformer : transformers_) {
       bool t_changed = false;
+      const int num_nodes = graph.NumberOfNodes();
       Status s = transformer->Apply(graph, t_changed);
       if (!s.IsOK()) return s;
+      if (t_changed) {
+        LOGS(logger, INFO) << "Graph transformation step " << step << ": " << transformer->Name()
+                           << " changed the number of nodes from " << num_nodes << " to " << graph.NumberOfNodes();
+      }
       changed = changed || t_changed;
     }
     if (!changed) break;
   }
+
+  LOGS(logger, INFO) << "Graph transformations ran " << steps_run << " of at most " << steps_ << " steps. "
+                     << "Number of nodes went from " << initial_num_nodes << " to " << graph.NumberOfNodes();
   return Status::OK();
 }
 
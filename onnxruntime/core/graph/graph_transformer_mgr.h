@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "core/common/logging/logging.h"
 #include "core/graph/graph_transformer.h"
 
 namespace onnxruntime {
@@ -21,8 +22,9 @@ class GraphTransformerManager {
   }
 
   // Apply the list of graph transformers registered on the specified graph
-  // up to the given number of steps.
-  common::Status ApplyAll(Graph& graph) const;
+  // up to the given number of steps. The transformers that modified the graph in each step, and the number of
+  // steps run, are logged.
+  common::Status ApplyAll(Graph& graph, const logging::Logger& logger) const;
 
  private:
   GraphTransformerManager() = default;
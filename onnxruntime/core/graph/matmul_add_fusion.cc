@@ -0,0 +1,89 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/graph/matmul_add_fusion.h"
+#include "core/graph/graph_utils.h"
+
+using namespace onnx;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+bool IsKnownDim(const TensorShapeProto_Dimension& dim, int64_t value) {
+  return dim.has_dim_value() && dim.dim_value() == value;
+}
+
+// the bias can be passed to Gemm if it is broadcast along the rows of the product, (N) or (1, N)
+bool IsRowBias(const NodeArg& bias, int64_t N) {
+  const TensorShapeProto* shape = bias.Shape();
+  if (shape == nullptr) {
+    return false;
+  }
+  return (shape->dim_size() == 1 && IsKnownDim(shape->dim(0), N)) ||
+         (shape->dim_size() == 2 && IsKnownDim(shape->dim(0), 1) && IsKnownDim(shape->dim(1), N));
+}
+}  // namespace
+
+Status MatMulAddFusion::Apply(Graph& graph, bool& modified) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  std::vector<onnxruntime::NodeIndex> removed_nodes;
+  for (auto index : order) {
+    auto node = graph.GetNode(index);
+    if (!(utils::IsSupportedOptypeVersionAndDomain(*node, "MatMul", 1) ||
+          utils::IsSupportedOptypeVersionAndDomain(*node, "MatMul", 9)) ||
+        node->GetOutputEdgesCount() != 1 ||
+        graph.IsNodeOutputsInGraphOutputs(*node)) {
+      continue;
+    }
+    const Node& next_node = *(node->OutputNodesBegin());
+    if (!utils::IsSupportedOptypeVersionAndDomain(next_node, "Add", 7) ||
+        next_node.GetExecutionProviderType() != node->GetExecutionProviderType()) {
+      continue;
+    }
+
+    const std::string* type = node->OutputDefs()[0]->Type();
+    if (type == nullptr || *type != "tensor(float)") {
+      continue;
+    }
+
+    // Gemm only multiplies 2-D matrices, while MatMul also takes batches of them
+    const TensorShapeProto* a_shape = node->InputDefs()[0]->Shape();
+    const TensorShapeProto* b_shape = node->InputDefs()[1]->Shape();
+    if (a_shape == nullptr || b_shape == nullptr || a_shape->dim_size() != 2 || b_shape->dim_size() != 2 ||
+        !b_shape->dim(1).has_dim_value()) {
+      continue;
+    }
+
+    const NodeArg* matmul_output_def = node->OutputDefs()[0];
+    const auto& add_input_defs = next_node.InputDefs();
+    NodeArg* bias_def = const_cast<NodeArg*>(add_input_defs[0] == matmul_output_def ? add_input_defs[1]
+                                                                                    : add_input_defs[0]);
+    if (bias_def == matmul_output_def || !IsRowBias(*bias_def, b_shape->dim(1).dim_value())) {
+      continue;
+    }
+
+    Node* matmul_node = node;
+    Node& add_node = *graph.GetNode(next_node.Index());
+    Node& gemm = graph.AddNode(graph.GenerateNodeName("gemm " + matmul_node->Name()), "Gemm",
+                               "fused MatMul " + matmul_node->Name() + " with Add " + add_node.Name(),
+                               {matmul_node->MutableInputDefs()[0], matmul_node->MutableInputDefs()[1], bias_def},
+                               add_node.MutableOutputDefs());
+    gemm.SetExecutionProviderType(matmul_node->GetExecutionProviderType());
+
+    removed_nodes.push_back(add_node.Index());
+    removed_nodes.push_back(matmul_node->Index());
+  }
+
+  for (auto i : removed_nodes) {
+    graph.RemoveNode(i);
+  }
+
+  if (!removed_nodes.empty()) {
+    modified = true;
+    ORT_RETURN_IF_ERROR(graph.Resolve());
+  }
+  return Status::OK();
+}
+}  // namespace onnxruntime
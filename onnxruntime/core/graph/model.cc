@@ -340,6 +340,7 @@ Status Model::LoadFromBytes(int count, void* p_bytes, /*out*/ std::shared_ptr<Mo
   return Status::OK();
 }
 
+using ::google::protobuf::io::ArrayInputStream;
 using ::google::protobuf::io::CodedInputStream;
 using ::google::protobuf::io::FileInputStream;
 using ::google::protobuf::io::ZeroCopyInputStream;
@@ -371,6 +372,37 @@ Status Model::Load(int fd, std::shared_ptr<Model>& p_model, const IOnnxRuntimeOp
   return Status::OK();
 }
 
+Status Model::LoadFromMappedFile(const std::string& file_path, std::shared_ptr<Model>& p_model,
+                                 const IOnnxRuntimeOpSchemaRegistryList* local_registries) {
+  const Env& env = Env::Default();
+  size_t length;
+  ORT_RETURN_IF_ERROR(env.GetFileLength(file_path, length));
+  if (length > static_cast<size_t>(INT_MAX)) {
+    return Status(ONNXRUNTIME, INVALID_ARGUMENT, "Model file " + file_path + " is too large to parse.");
+  }
+
+  Env::MappedMemoryPtr mapped_memory;
+  ORT_RETURN_IF_ERROR(env.MapFileIntoMemory(file_path, 0, length, mapped_memory));
+
+  // the mapping is only needed while parsing, as protobuf copies the data it keeps
+  ArrayInputStream raw_input(mapped_memory.get(), static_cast<int>(length));
+  CodedInputStream coded_input(&raw_input);
+
+  // Allows protobuf library versions < 3.2.0 to parse messages greater than 64MB.
+  coded_input.SetTotalBytesLimit(INT_MAX, INT_MAX);
+
+  std::unique_ptr<ModelProto> model_proto = std::make_unique<ModelProto>();
+  if (!model_proto->ParseFromCodedStream(&coded_input)) {
+    return Status(ONNXRUNTIME, INVALID_PROTOBUF, "Protobuf parsing failed.");
+  }
+
+  p_model = std::make_shared<Model>(std::move(model_proto), local_registries);
+
+  ORT_RETURN_IF_ERROR(p_model->MainGraph().Resolve(true));
+
+  return Status::OK();
+}
+
 Status Model::Save(Model& model, int p_fd) {
   if (p_fd < 0) {
     return Status(ONNXRUNTIME, INVALID_ARGUMENT, "<p_fd> is less than 0.");
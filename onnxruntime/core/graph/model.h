@@ -106,6 +106,10 @@ class Model {
   static common::Status Load(int fd, /*out*/ std::shared_ptr<Model>& p_model,
                              const IOnnxRuntimeOpSchemaRegistryList* local_registries = nullptr);
 
+  // Parse the model directly from a read-only memory mapping of the file instead of reading it through a stream.
+  static common::Status LoadFromMappedFile(const std::string& file_path, /*out*/ std::shared_ptr<Model>& p_model,
+                                           const IOnnxRuntimeOpSchemaRegistryList* local_registries = nullptr);
+
   // 'int' rather than 'size_t' because of a protobuf design choice; let callers handle type checks
   static common::Status LoadFromBytes(int count, void* pBytes, /*out*/ std::shared_ptr<Model>& p_model,
                                       const IOnnxRuntimeOpSchemaRegistryList* local_registries = nullptr);
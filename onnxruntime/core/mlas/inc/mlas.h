@@ -43,6 +43,56 @@ typedef enum { CblasNonUnit=131, CblasUnit=132 } CBLAS_DIAG;
 typedef enum { CblasLeft=141, CblasRight=142} CBLAS_SIDE;
 #endif
 
+//
+// Threading support.
+//
+// MLAS does not create worker threads of its own. Routines that can execute
+// across multiple threads accept an optional thread pool object that
+// implements the following interface. If no thread pool is supplied, the
+// platform default threading support (OpenMP or the Windows thread pool) is
+// used if available.
+//
+
+typedef
+void
+(MLAS_THREADED_ROUTINE)(
+    void* Context,
+    int32_t Index
+    );
+
+typedef MLAS_THREADED_ROUTINE* PMLAS_THREADED_ROUTINE;
+
+struct MLAS_THREADPOOL {
+
+    //
+    // Returns the maximum number of threads, including the calling thread,
+    // that can participate in a threaded operation.
+    //
+
+    virtual
+    int32_t
+    GetMaximumThreadCount(
+        void
+        ) = 0;
+
+    //
+    // Invokes the threaded routine for each index in [0, Iterations) and
+    // returns after all iterations have completed. The calling thread is
+    // expected to participate in the operation.
+    //
+
+    virtual
+    void
+    ExecuteThreaded(
+        PMLAS_THREADED_ROUTINE ThreadedRoutine,
+        void* Context,
+        int32_t Iterations
+        ) = 0;
+
+protected:
+    ~MLAS_THREADPOOL() = default;
+};
+
 //
 // Single precision matrix/matrix multiply routine.
 //
@@ -62,7 +112,148 @@ MlasSgemm(
     size_t ldb,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Single precision matrix/matrix multiply routine for a batch of matrices
+// that are a fixed stride apart.
+//
+
+void
+MLASCALL
+MlasSgemmStridedBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    size_t StrideA,
+    const float* B,
+    size_t ldb,
+    size_t StrideB,
+    float beta,
+    float* C,
+    size_t ldc,
+    size_t StrideC,
+    size_t BatchCount,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Single precision matrix/matrix multiply routines using a matrix B that is
+// packed once ahead of time, such as a constant weight tensor. The buffer
+// passed to MlasSgemmPackB must be at least MlasSgemmPackBSize(N, K) bytes.
+//
+
+size_t
+MLASCALL
+MlasSgemmPackBSize(
+    size_t N,
+    size_t K
+    );
+
+void
+MLASCALL
+MlasSgemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+void
+MLASCALL
+MlasSgemm(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Quantized integer matrix/matrix multiply routines.
+//
+// These compute C = (A - offa) * (B - offb) with 32-bit accumulation, where
+// matrix A is unsigned 8-bit and matrix B is unsigned or signed 8-bit, both
+// stored in row major order. If requantization parameters are supplied, each
+// block of matrix C is also scaled back to unsigned 8-bit values as soon as
+// the block is complete, while it is still in the cache. Matrix C then serves
+// as the working buffer for the 32-bit results.
+//
+
+struct MLAS_REQUANTIZE_PARAMETERS {
+    uint8_t* Output;
+    size_t ldo;
+    const int32_t* Bias;
+    const float* Scale;
+    bool PerRowScale;
+    uint8_t ZeroPoint;
+};
+
+void
+MLASCALL
+MlasQgemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const uint8_t* B,
+    size_t ldb,
+    uint8_t offb,
+    int32_t* C,
+    size_t ldc,
+    const MLAS_REQUANTIZE_PARAMETERS* Requantize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MLASCALL
+MlasQgemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const int8_t* B,
+    size_t ldb,
+    int8_t offb,
+    int32_t* C,
+    size_t ldc,
+    const MLAS_REQUANTIZE_PARAMETERS* Requantize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MLASCALL
+MlasRequantizeOutput(
+    const int32_t* Input,
+    size_t ldi,
+    uint8_t* Output,
+    size_t ldo,
+    const int32_t* Bias,
+    const float* Scale,
+    bool PerRowScale,
+    uint8_t ZeroPoint,
+    size_t M,
+    size_t N
     );
 
 //
@@ -73,6 +264,8 @@ enum MLAS_CONV_ALGORITHM {
     MlasConvAlgorithmGemmDirect,
     MlasConvAlgorithmExpandThenGemm,
     MlasConvAlgorithmExpandThenGemmSegmented,
+    MlasConvAlgorithmWinograd,
+    MlasConvAlgorithmDepthwise,
 };
 
 struct MLAS_CONV_PARAMETERS {
@@ -99,6 +292,16 @@ struct MLAS_CONV_PARAMETERS {
         struct {
             size_t ThreadStrideN;
         } ExpandThenGemmSegmented;
+        struct {
+            size_t TileSize;
+            size_t TileCountWidth;
+            size_t TileCount;
+            size_t TileBlockSize;
+            size_t ThreadCount;
+        } Winograd;
+        struct {
+            size_t ThreadCount;
+        } Depthwise;
     } u;
 };
 
@@ -117,7 +320,8 @@ MlasConvPrepare(
     const int64_t* StrideShape,
     const int64_t* OutputShape,
     size_t FilterCount,
-    size_t* WorkingBufferSize
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
     );
 
 void
@@ -128,7 +332,8 @@ MlasConv(
     const float* Filter,
     const float* Bias,
     float* WorkingBuffer,
-    float* Output
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
     );
 
 //
@@ -152,7 +357,8 @@ MlasPool(
     const int64_t* StrideShape,
     const int64_t* OutputShape,
     const float* Input,
-    float* Output
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
     );
 
 //
@@ -732,6 +732,895 @@ Return Value:
     }
 }
 
+//
+// Define the Winograd transforms for F(2x2,3x3) and F(4x4,3x3).
+//
+// Each transform is expressed as a one dimensional transform that is applied
+// to the columns and then to the rows of a tile. The input transform computes
+// B^T * d, the filter transform computes G * g, and the output transform
+// computes A^T * m. The vectors hold the same element from four tiles or four
+// channels.
+//
+
+template<size_t TileSize>
+struct MLAS_CONV_WINOGRAD_TRANSFORM;
+
+template<>
+struct MLAS_CONV_WINOGRAD_TRANSFORM<2> {
+
+    static
+    void
+    Input(
+        const MLAS_FLOAT32X4* d,
+        size_t ds,
+        MLAS_FLOAT32X4* r,
+        size_t rs
+        )
+    {
+        MLAS_FLOAT32X4 d0 = d[0], d1 = d[ds], d2 = d[2 * ds], d3 = d[3 * ds];
+
+        r[0] = MlasSubtractFloat32x4(d0, d2);
+        r[rs] = MlasAddFloat32x4(d1, d2);
+        r[2 * rs] = MlasSubtractFloat32x4(d2, d1);
+        r[3 * rs] = MlasSubtractFloat32x4(d1, d3);
+    }
+
+    static
+    void
+    Filter(
+        const MLAS_FLOAT32X4* g,
+        size_t gs,
+        MLAS_FLOAT32X4* r,
+        size_t rs
+        )
+    {
+        const MLAS_FLOAT32X4 Half = MlasBroadcastFloat32x4(0.5f);
+
+        MLAS_FLOAT32X4 g0 = g[0], g1 = g[gs], g2 = g[2 * gs];
+        MLAS_FLOAT32X4 g02 = MlasAddFloat32x4(g0, g2);
+
+        r[0] = g0;
+        r[rs] = MlasMultiplyFloat32x4(MlasAddFloat32x4(g02, g1), Half);
+        r[2 * rs] = MlasMultiplyFloat32x4(MlasSubtractFloat32x4(g02, g1), Half);
+        r[3 * rs] = g2;
+    }
+
+    static
+    void
+    Output(
+        const MLAS_FLOAT32X4* m,
+        size_t ms,
+        MLAS_FLOAT32X4* r,
+        size_t rs
+        )
+    {
+        MLAS_FLOAT32X4 m0 = m[0], m1 = m[ms], m2 = m[2 * ms], m3 = m[3 * ms];
+
+        r[0] = MlasAddFloat32x4(MlasAddFloat32x4(m0, m1), m2);
+        r[rs] = MlasSubtractFloat32x4(MlasSubtractFloat32x4(m1, m2), m3);
+    }
+};
+
+template<>
+struct MLAS_CONV_WINOGRAD_TRANSFORM<4> {
+
+    static
+    void
+    Input(
+        const MLAS_FLOAT32X4* d,
+        size_t ds,
+        MLAS_FLOAT32X4* r,
+        size_t rs
+        )
+    {
+        const MLAS_FLOAT32X4 Two = MlasBroadcastFloat32x4(2.0f);
+        const MLAS_FLOAT32X4 Four = MlasBroadcastFloat32x4(4.0f);
+        const MLAS_FLOAT32X4 Five = MlasBroadcastFloat32x4(5.0f);
+
+        MLAS_FLOAT32X4 d0 = d[0], d1 = d[ds], d2 = d[2 * ds];
+        MLAS_FLOAT32X4 d3 = d[3 * ds], d4 = d[4 * ds], d5 = d[5 * ds];
+
+        MLAS_FLOAT32X4 t0 = MlasSubtractFloat32x4(d4, MlasMultiplyFloat32x4(Four, d2));
+        MLAS_FLOAT32X4 t1 = MlasSubtractFloat32x4(d3, MlasMultiplyFloat32x4(Four, d1));
+        MLAS_FLOAT32X4 t2 = MlasSubtractFloat32x4(d4, d2);
+        MLAS_FLOAT32X4 t3 = MlasMultiplyFloat32x4(Two, MlasSubtractFloat32x4(d3, d1));
+
+        r[0] = MlasAddFloat32x4(MlasMultiplyFloat32x4(Four, d0),
+            MlasSubtractFloat32x4(d4, MlasMultiplyFloat32x4(Five, d2)));
+        r[rs] = MlasAddFloat32x4(t0, t1);
+        r[2 * rs] = MlasSubtractFloat32x4(t0, t1);
+        r[3 * rs] = MlasAddFloat32x4(t2, t3);
+        r[4 * rs] = MlasSubtractFloat32x4(t2, t3);
+        r[5 * rs] = MlasAddFloat32x4(MlasMultiplyFloat32x4(Four, d1),
+            MlasSubtractFloat32x4(d5, MlasMultiplyFloat32x4(Five, d3)));
+    }
+
+    static
+    void
+    Filter(
+        const MLAS_FLOAT32X4* g,
+        size_t gs,
+        MLAS_FLOAT32X4* r,
+        size_t rs
+        )
+    {
+        MLAS_FLOAT32X4 g0 = g[0], g1 = g[gs], g2 = g[2 * gs];
+
+        MLAS_FLOAT32X4 t0 = MlasMultiplyFloat32x4(MlasBroadcastFloat32x4(-1.0f / 6.0f),
+            MlasAddFloat32x4(g0, g2));
+        MLAS_FLOAT32X4 t1 = MlasMultiplyFloat32x4(MlasBroadcastFloat32x4(-1.0f / 6.0f), g1);
+        MLAS_FLOAT32X4 t2 = MlasAddFloat32x4(
+            MlasMultiplyFloat32x4(MlasBroadcastFloat32x4(1.0f / 24.0f), g0),
+            MlasMultiplyFloat32x4(MlasBroadcastFloat32x4(1.0f / 6.0f), g2));
+        MLAS_FLOAT32X4 t3 = MlasMultiplyFloat32x4(MlasBroadcastFloat32x4(1.0f / 12.0f), g1);
+
+        r[0] = MlasMultiplyFloat32x4(MlasBroadcastFloat32x4(1.0f / 4.0f), g0);
+        r[rs] = MlasAddFloat32x4(t0, t1);
+        r[2 * rs] = MlasSubtractFloat32x4(t0, t1);
+        r[3 * rs] = MlasAddFloat32x4(t2, t3);
+        r[4 * rs] = MlasSubtractFloat32x4(t2, t3);
+        r[5 * rs] = g2;
+    }
+
+    static
+    void
+    Output(
+        const MLAS_FLOAT32X4* m,
+        size_t ms,
+        MLAS_FLOAT32X4* r,
+        size_t rs
+        )
+    {
+        const MLAS_FLOAT32X4 Two = MlasBroadcastFloat32x4(2.0f);
+        const MLAS_FLOAT32X4 Four = MlasBroadcastFloat32x4(4.0f);
+        const MLAS_FLOAT32X4 Eight = MlasBroadcastFloat32x4(8.0f);
+
+        MLAS_FLOAT32X4 m0 = m[0], m1 = m[ms], m2 = m[2 * ms];
+        MLAS_FLOAT32X4 m3 = m[3 * ms], m4 = m[4 * ms], m5 = m[5 * ms];
+
+        MLAS_FLOAT32X4 t0 = MlasAddFloat32x4(m1, m2);
+        MLAS_FLOAT32X4 t1 = MlasSubtractFloat32x4(m1, m2);
+        MLAS_FLOAT32X4 t2 = MlasAddFloat32x4(m3, m4);
+        MLAS_FLOAT32X4 t3 = MlasSubtractFloat32x4(m3, m4);
+
+        r[0] = MlasAddFloat32x4(MlasAddFloat32x4(m0, t0), t2);
+        r[rs] = MlasAddFloat32x4(t1, MlasMultiplyFloat32x4(Two, t3));
+        r[2 * rs] = MlasAddFloat32x4(t0, MlasMultiplyFloat32x4(Four, t2));
+        r[3 * rs] = MlasAddFloat32x4(MlasAddFloat32x4(t1, MlasMultiplyFloat32x4(Eight, t3)), m5);
+    }
+};
+
+//
+// Define the number of working buffer elements to target for the transformed
+// input and output tiles of a single thread.
+//
+
+#define MLAS_CONV_WINOGRAD_TILE_BLOCK_ELEMENTS  (256 * 1024)
+
+#define MLAS_CONV_WINOGRAD_MAXIMUM_TILE_BLOCK   64
+
+//
+// Define the minimum number of input and output channels for a convolution to
+// use the Winograd algorithm.
+//
+
+#define MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS     8
+
+//
+// Define the estimated cost of transforming one filter element relative to a
+// multiply/add operation. The transform is bound by the memory bandwidth of
+// writing the transformed filter.
+//
+
+#define MLAS_CONV_WINOGRAD_FILTER_TRANSFORM_COST 36.0
+
+template<size_t TileSize>
+void
+MlasConvWinogradTransformFilter(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Filter,
+    float* TransformedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms the 3x3 filters of one group to the Winograd
+    domain. The transformed filter holds one FilterCount by InputChannels
+    matrix for each element of the transformed tile. The matrices are
+    interleaved by row, so that the transformed elements of each filter are
+    stored close together. Four input channels are transformed at a time.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Filter - Supplies the filter tensor for the group.
+
+    TransformedFilter - Receives the transformed filter.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    typedef MLAS_CONV_WINOGRAD_TRANSFORM<TileSize> TRANSFORM;
+
+    constexpr size_t TransformSize = TileSize + 2;
+    constexpr size_t TransformElements = TransformSize * TransformSize;
+
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputChannels = Parameters->InputChannels;
+
+    for (size_t f = 0; f < FilterCount; f++) {
+
+        for (size_t c = 0; c < InputChannels; c += 4) {
+
+            const size_t ChannelCount = std::min(InputChannels - c, size_t(4));
+
+            MLAS_DECLSPEC_ALIGN(float Kernel[3][3][4], 16);
+            MLAS_FLOAT32X4 KernelVector[3][3];
+            MLAS_FLOAT32X4 Temporary[TransformSize][3];
+            MLAS_FLOAT32X4 Transformed[TransformSize][TransformSize];
+
+            const float* filter = Filter + (f * InputChannels + c) * 9;
+
+            for (size_t i = 0; i < 3; i++) {
+                for (size_t j = 0; j < 3; j++) {
+                    for (size_t lane = 0; lane < 4; lane++) {
+                        Kernel[i][j][lane] = (lane < ChannelCount) ? filter[lane * 9 + i * 3 + j] : 0.0f;
+                    }
+                    KernelVector[i][j] = MlasLoadFloat32x4(Kernel[i][j]);
+                }
+            }
+
+            for (size_t j = 0; j < 3; j++) {
+                TRANSFORM::Filter(&KernelVector[0][j], 3, &Temporary[0][j], 3);
+            }
+
+            for (size_t i = 0; i < TransformSize; i++) {
+                TRANSFORM::Filter(&Temporary[i][0], 1, &Transformed[i][0], 1);
+            }
+
+            float* transformed = TransformedFilter + f * TransformElements * InputChannels + c;
+
+            for (size_t i = 0; i < TransformSize; i++) {
+
+                for (size_t j = 0; j < TransformSize; j++) {
+
+                    if (ChannelCount == 4) {
+                        MlasStoreFloat32x4(transformed, Transformed[i][j]);
+                    } else {
+                        MLAS_DECLSPEC_ALIGN(float Buffer[4], 16);
+                        MlasStoreAlignedFloat32x4(Buffer, Transformed[i][j]);
+                        std::copy_n(Buffer, ChannelCount, transformed);
+                    }
+
+                    transformed += InputChannels;
+                }
+            }
+        }
+    }
+}
+
+template<size_t TileSize>
+void
+MlasConvWinogradOperation(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* TransformedFilter,
+    const float* Bias,
+    float* TileBuffer,
+    float* Output,
+    size_t TileStart,
+    size_t TileCount
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a block of output tiles of one image and group
+    using the Winograd minimal filtering algorithm.
+
+    The input tiles are transformed to a matrix per element of the transformed
+    tile, multiplied by the transformed filter matrix for the same element,
+    and then transformed back to the output tiles. Four tiles are transformed
+    at a time.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor for the image and group.
+
+    TransformedFilter - Supplies the filter transformed by
+        MlasConvWinogradTransformFilter.
+
+    Bias - Optionally supplies the bias vector for the group.
+
+    TileBuffer - Supplies the thread local slice of the working buffer.
+
+    Output - Supplies the output tensor for the image and group.
+
+    TileStart - Supplies the index of the first output tile to compute.
+
+    TileCount - Supplies the number of output tiles to compute.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    typedef MLAS_CONV_WINOGRAD_TRANSFORM<TileSize> TRANSFORM;
+
+    constexpr size_t TransformSize = TileSize + 2;
+    constexpr size_t TransformElements = TransformSize * TransformSize;
+
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t PaddingTop = Parameters->Padding[0];
+    const size_t PaddingLeft = Parameters->Padding[1];
+    const size_t TileCountWidth = Parameters->u.Winograd.TileCountWidth;
+
+    //
+    // The rows of the transformed matrices are padded to a multiple of four
+    // tiles so that the transforms can store whole vectors. As with the
+    // transformed filter, the matrices are interleaved by row.
+    //
+
+    const size_t TileStride = (TileCount + 3) & ~size_t(3);
+
+    float* TransformedInput = TileBuffer;
+    float* TransformedOutput = TileBuffer + TransformElements * InputChannels * TileStride;
+
+    //
+    // Transform the input tiles. The tiles overlap by the kernel size minus
+    // one and elements outside of the input tensor are zero padding.
+    //
+
+    for (size_t t = 0; t < TileCount; t += 4) {
+
+        size_t TileRow[4];
+        size_t TileColumn[4];
+        bool TileInside = true;
+
+        for (size_t lane = 0; lane < 4; lane++) {
+
+            const size_t Tile = TileStart + std::min(t + lane, TileCount - 1);
+
+            TileRow[lane] = (Tile / TileCountWidth) * TileSize;
+            TileColumn[lane] = (Tile % TileCountWidth) * TileSize;
+
+            TileInside &= TileRow[lane] >= PaddingTop &&
+                TileRow[lane] - PaddingTop + TransformSize <= InputHeight &&
+                TileColumn[lane] >= PaddingLeft &&
+                TileColumn[lane] - PaddingLeft + TransformSize <= InputWidth;
+        }
+
+        for (size_t c = 0; c < InputChannels; c++) {
+
+            const float* input = Input + c * InputHeight * InputWidth;
+
+            MLAS_DECLSPEC_ALIGN(float Data[TransformSize][TransformSize][4], 16);
+            MLAS_FLOAT32X4 DataVector[TransformSize][TransformSize];
+            MLAS_FLOAT32X4 Temporary[TransformSize][TransformSize];
+            MLAS_FLOAT32X4 Transformed[TransformSize][TransformSize];
+
+            for (size_t lane = 0; lane < 4; lane++) {
+
+                for (size_t i = 0; i < TransformSize; i++) {
+
+                    const size_t ih = TileRow[lane] + i;
+                    const size_t y = ih - PaddingTop;
+
+                    for (size_t j = 0; j < TransformSize; j++) {
+
+                        const size_t iw = TileColumn[lane] + j;
+                        const size_t x = iw - PaddingLeft;
+
+                        if (TileInside || (ih >= PaddingTop && y < InputHeight &&
+                            iw >= PaddingLeft && x < InputWidth)) {
+                            Data[i][j][lane] = input[y * InputWidth + x];
+                        } else {
+                            Data[i][j][lane] = 0.0f;
+                        }
+                    }
+                }
+            }
+
+            for (size_t i = 0; i < TransformSize; i++) {
+                for (size_t j = 0; j < TransformSize; j++) {
+                    DataVector[i][j] = MlasLoadFloat32x4(Data[i][j]);
+                }
+            }
+
+            for (size_t j = 0; j < TransformSize; j++) {
+                TRANSFORM::Input(&DataVector[0][j], TransformSize, &Temporary[0][j], TransformSize);
+            }
+
+            for (size_t i = 0; i < TransformSize; i++) {
+                TRANSFORM::Input(&Temporary[i][0], 1, &Transformed[i][0], 1);
+            }
+
+            float* transformed = TransformedInput + c * TransformElements * TileStride + t;
+
+            for (size_t i = 0; i < TransformSize; i++) {
+                for (size_t j = 0; j < TransformSize; j++) {
+                    MlasStoreFloat32x4(transformed, Transformed[i][j]);
+                    transformed += TileStride;
+                }
+            }
+        }
+    }
+
+    //
+    // Multiply the transformed filter and input matrices for each element of
+    // the transformed tile.
+    //
+
+    for (size_t e = 0; e < TransformElements; e++) {
+
+        MlasSgemmOperation(CblasNoTrans, CblasNoTrans, FilterCount, TileCount,
+            InputChannels, 1.0f, TransformedFilter + e * InputChannels,
+            TransformElements * InputChannels, TransformedInput + e * TileStride,
+            TransformElements * TileStride, 0.0f, TransformedOutput + e * TileStride,
+            TransformElements * TileStride);
+    }
+
+    //
+    // Transform the products back to the output tiles, add the optional bias,
+    // and store the elements that are inside the output tensor.
+    //
+
+    for (size_t f = 0; f < FilterCount; f++) {
+
+        const MLAS_FLOAT32X4 BiasBroadcast = MlasBroadcastFloat32x4((Bias != nullptr) ? Bias[f] : 0.0f);
+
+        float* output = Output + f * OutputHeight * OutputWidth;
+
+        for (size_t t = 0; t < TileCount; t += 4) {
+
+            MLAS_FLOAT32X4 Products[TransformSize][TransformSize];
+            MLAS_FLOAT32X4 Temporary[TileSize][TransformSize];
+            MLAS_FLOAT32X4 Transformed[TileSize][TileSize];
+            MLAS_DECLSPEC_ALIGN(float Data[TileSize][TileSize][4], 16);
+
+            const float* transformed = TransformedOutput + f * TransformElements * TileStride + t;
+
+            for (size_t i = 0; i < TransformSize; i++) {
+                for (size_t j = 0; j < TransformSize; j++) {
+                    Products[i][j] = MlasLoadFloat32x4(transformed);
+                    transformed += TileStride;
+                }
+            }
+
+            for (size_t j = 0; j < TransformSize; j++) {
+                TRANSFORM::Output(&Products[0][j], TransformSize, &Temporary[0][j], TransformSize);
+            }
+
+            for (size_t i = 0; i < TileSize; i++) {
+                TRANSFORM::Output(&Temporary[i][0], 1, &Transformed[i][0], 1);
+            }
+
+            for (size_t i = 0; i < TileSize; i++) {
+                for (size_t j = 0; j < TileSize; j++) {
+                    MlasStoreAlignedFloat32x4(Data[i][j], MlasAddFloat32x4(Transformed[i][j], BiasBroadcast));
+                }
+            }
+
+            const size_t LaneCount = std::min(TileCount - t, size_t(4));
+
+            for (size_t lane = 0; lane < LaneCount; lane++) {
+
+                const size_t Tile = TileStart + t + lane;
+                const size_t oh = (Tile / TileCountWidth) * TileSize;
+                const size_t ow = (Tile % TileCountWidth) * TileSize;
+
+                for (size_t i = 0; i < TileSize && oh + i < OutputHeight; i++) {
+                    for (size_t j = 0; j < TileSize && ow + j < OutputWidth; j++) {
+                        output[(oh + i) * OutputWidth + (ow + j)] = Data[i][j][lane];
+                    }
+                }
+            }
+        }
+    }
+}
+
+void
+MlasConvWinogradThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    Winograd convolution operation for one group.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_WORK_BLOCK* WorkBlock = (MLAS_CONV_WORK_BLOCK*)Context;
+
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t TileSize = Parameters->u.Winograd.TileSize;
+    const size_t TileCount = Parameters->u.Winograd.TileCount;
+    const size_t TileBlockSize = Parameters->u.Winograd.TileBlockSize;
+    const size_t TransformElements = (TileSize + 2) * (TileSize + 2);
+
+    //
+    // Compute the range of tile blocks to use for this thread. The tile
+    // blocks of all images are distributed across the threads.
+    //
+
+    const size_t TileBlockCount = (TileCount + TileBlockSize - 1) / TileBlockSize;
+    const size_t WorkCount = Parameters->BatchCount * TileBlockCount;
+
+    const size_t TargetThreadCount = WorkBlock->TargetThreadCount;
+
+    const size_t WorkCountPerThread = WorkCount / TargetThreadCount;
+    const size_t WorkCountExtra = WorkCount % TargetThreadCount;
+
+    size_t WorkStart;
+    size_t WorkEnd;
+
+    if (uint32_t(Index) < WorkCountExtra) {
+        WorkStart = (WorkCountPerThread + 1) * Index;
+        WorkEnd = WorkStart + WorkCountPerThread + 1;
+    } else {
+        WorkStart = WorkCountPerThread * Index + WorkCountExtra;
+        WorkEnd = WorkStart + WorkCountPerThread;
+    }
+
+    float* TileBuffer = WorkBlock->WorkingBuffer + Index * TransformElements *
+        (Parameters->InputChannels + Parameters->FilterCount) * TileBlockSize;
+
+    const size_t GroupCount = Parameters->GroupCount;
+    const size_t InputBatchSize = GroupCount * Parameters->InputChannels * Parameters->InputSize;
+    const size_t OutputBatchSize = GroupCount * Parameters->FilterCount * Parameters->OutputSize;
+
+    for (size_t w = WorkStart; w < WorkEnd; w++) {
+
+        const size_t batch = w / TileBlockCount;
+        const size_t TileStart = (w % TileBlockCount) * TileBlockSize;
+
+        size_t TileBlockCountThisIteration = TileCount - TileStart;
+
+        if (TileBlockCountThisIteration > TileBlockSize) {
+            TileBlockCountThisIteration = TileBlockSize;
+        }
+
+        const float* input = WorkBlock->Input + batch * InputBatchSize;
+        float* output = WorkBlock->Output + batch * OutputBatchSize;
+
+        if (TileSize == 4) {
+            MlasConvWinogradOperation<4>(Parameters, input, WorkBlock->Filter,
+                WorkBlock->Bias, TileBuffer, output, TileStart, TileBlockCountThisIteration);
+        } else {
+            MlasConvWinogradOperation<2>(Parameters, input, WorkBlock->Filter,
+                WorkBlock->Bias, TileBuffer, output, TileStart, TileBlockCountThisIteration);
+        }
+    }
+}
+
+void
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a 3x3 stride 1 convolution operation using the
+    Winograd F(2x2,3x3) or F(4x4,3x3) minimal filtering algorithm.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor.
+
+    Filter - Supplies the filter tensor.
+
+    Bias - Optionally supplies the bias vector.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvPrepare.
+
+    Output - Supplies the output tensor.
+
+    ThreadPool - Optionally supplies the thread pool object to use.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t TileSize = Parameters->u.Winograd.TileSize;
+    const size_t TransformElements = (TileSize + 2) * (TileSize + 2);
+
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputGroupSize = Parameters->InputChannels * Parameters->InputSize;
+    const size_t OutputGroupSize = FilterCount * Parameters->OutputSize;
+    const size_t FilterGroupSize = FilterCount * Parameters->K;
+
+    //
+    // The transformed filter is stored at the start of the working buffer and
+    // is followed by the tile buffers for each thread.
+    //
+
+    float* TransformedFilter = WorkingBuffer;
+
+    MLAS_CONV_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Parameters = Parameters;
+    WorkBlock.Filter = TransformedFilter;
+    WorkBlock.WorkingBuffer = WorkingBuffer + TransformElements * FilterCount * Parameters->InputChannels;
+    WorkBlock.TargetThreadCount = int32_t(Parameters->u.Winograd.ThreadCount);
+
+    for (size_t group = 0; group < Parameters->GroupCount; group++) {
+
+        if (TileSize == 4) {
+            MlasConvWinogradTransformFilter<4>(Parameters, Filter, TransformedFilter);
+        } else {
+            MlasConvWinogradTransformFilter<2>(Parameters, Filter, TransformedFilter);
+        }
+
+        WorkBlock.Input = Input;
+        WorkBlock.Bias = Bias;
+        WorkBlock.Output = Output;
+
+        MlasExecuteThreaded(MlasConvWinogradThreaded, &WorkBlock,
+            WorkBlock.TargetThreadCount, ThreadPool);
+
+        //
+        // Advance the buffer pointers.
+        //
+
+        if (Bias != nullptr) {
+            Bias += FilterCount;
+        }
+
+        Filter += FilterGroupSize;
+        Input += InputGroupSize;
+        Output += OutputGroupSize;
+    }
+}
+
+void
+MlasConvDepthwiseOperation(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    float BiasValue,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the direct convolution of a single channel for a
+    depthwise convolution operation.
+
+    Each kernel element is applied to the range of the output row that maps
+    inside the input tensor, so the inner loop needs no bounds checks and
+    vectorizes for unit strides.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor for the channel.
+
+    Filter - Supplies the filter for the channel.
+
+    BiasValue - Supplies the bias value for the channel.
+
+    Output - Supplies the output tensor for the channel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t KernelHeight = Parameters->KernelShape[0];
+    const size_t KernelWidth = Parameters->KernelShape[1];
+    const size_t DilationHeight = Parameters->DilationShape[0];
+    const size_t DilationWidth = Parameters->DilationShape[1];
+    const size_t PaddingTop = Parameters->Padding[0];
+    const size_t PaddingLeft = Parameters->Padding[1];
+    const size_t StrideHeight = Parameters->StrideShape[0];
+    const size_t StrideWidth = Parameters->StrideShape[1];
+
+    const MLAS_FLOAT32X4 BiasBroadcast = MlasBroadcastFloat32x4(BiasValue);
+
+    for (size_t oh = 0; oh < OutputHeight; oh++) {
+
+        float* output = Output + oh * OutputWidth;
+
+        size_t ow = 0;
+
+        for (; ow + 4 <= OutputWidth; ow += 4) {
+            MlasStoreFloat32x4(output + ow, BiasBroadcast);
+        }
+
+        for (; ow < OutputWidth; ow++) {
+            output[ow] = BiasValue;
+        }
+
+        for (size_t kh = 0; kh < KernelHeight; kh++) {
+
+            //
+            // Skip the kernel rows that map to the padding.
+            //
+
+            const size_t ih = oh * StrideHeight + kh * DilationHeight;
+
+            if (ih < PaddingTop || ih - PaddingTop >= InputHeight) {
+                continue;
+            }
+
+            const float* input = Input + (ih - PaddingTop) * InputWidth;
+
+            for (size_t kw = 0; kw < KernelWidth; kw++) {
+
+                //
+                // Compute the range of the output row that maps inside the
+                // input row for this kernel column.
+                //
+
+                const size_t KernelOffset = kw * DilationWidth;
+
+                if (KernelOffset >= PaddingLeft + InputWidth) {
+                    break;
+                }
+
+                size_t OutputStart = 0;
+
+                if (KernelOffset < PaddingLeft) {
+                    OutputStart = (PaddingLeft - KernelOffset + StrideWidth - 1) / StrideWidth;
+                }
+
+                size_t OutputEnd = (PaddingLeft + InputWidth - KernelOffset + StrideWidth - 1) / StrideWidth;
+
+                if (OutputEnd > OutputWidth) {
+                    OutputEnd = OutputWidth;
+                }
+
+                if (OutputStart >= OutputEnd) {
+                    continue;
+                }
+
+                const float FilterValue = Filter[kh * KernelWidth + kw];
+                const float* in = input + OutputStart * StrideWidth + KernelOffset - PaddingLeft;
+
+                ow = OutputStart;
+
+                if (StrideWidth == 1) {
+
+                    const MLAS_FLOAT32X4 FilterBroadcast = MlasBroadcastFloat32x4(FilterValue);
+
+                    for (; ow + 4 <= OutputEnd; ow += 4) {
+                        MLAS_FLOAT32X4 Accumulator = MlasLoadFloat32x4(output + ow);
+                        Accumulator = MlasAddFloat32x4(Accumulator,
+                            MlasMultiplyFloat32x4(FilterBroadcast, MlasLoadFloat32x4(in)));
+                        MlasStoreFloat32x4(output + ow, Accumulator);
+                        in += 4;
+                    }
+                }
+
+                for (; ow < OutputEnd; ow++) {
+                    output[ow] += FilterValue * in[0];
+                    in += StrideWidth;
+                }
+            }
+        }
+    }
+}
+
+void
+MlasConvDepthwiseThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    depthwise convolution operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_WORK_BLOCK* WorkBlock = (MLAS_CONV_WORK_BLOCK*)Context;
+
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    //
+    // Compute the range of channels to use for this thread.
+    //
+
+    const size_t GroupCount = Parameters->GroupCount;
+    const size_t BatchGroupCount = Parameters->BatchCount * GroupCount;
+
+    const size_t TargetThreadCount = WorkBlock->TargetThreadCount;
+
+    const size_t BatchGroupCountPerThread = BatchGroupCount / TargetThreadCount;
+    const size_t BatchGroupCountExtra = BatchGroupCount % TargetThreadCount;
+
+    size_t BatchGroupStart;
+    size_t BatchGroupEnd;
+
+    if (uint32_t(Index) < BatchGroupCountExtra) {
+        BatchGroupStart = (BatchGroupCountPerThread + 1) * Index;
+        BatchGroupEnd = BatchGroupStart + BatchGroupCountPerThread + 1;
+    } else {
+        BatchGroupStart = BatchGroupCountPerThread * Index + BatchGroupCountExtra;
+        BatchGroupEnd = BatchGroupStart + BatchGroupCountPerThread;
+    }
+
+    //
+    // Iterate over the channels allocated to this thread.
+    //
+
+    const size_t InputSize = Parameters->InputSize;
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t K = Parameters->K;
+
+    for (size_t bg = BatchGroupStart; bg < BatchGroupEnd; bg++) {
+
+        size_t group = bg % GroupCount;
+
+        const float BiasValue = (WorkBlock->Bias != nullptr) ? WorkBlock->Bias[group] : 0.0f;
+
+        MlasConvDepthwiseOperation(Parameters, WorkBlock->Input + bg * InputSize,
+            WorkBlock->Filter + group * K, BiasValue, WorkBlock->Output + bg * OutputSize);
+    }
+}
+
 inline
 bool
 MlasConvTryMultithread(
@@ -740,7 +1629,8 @@ MlasConvTryMultithread(
     const float* Filter,
     const float* Bias,
     float* WorkingBuffer,
-    float* Output
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
     )
 /*++
 
@@ -765,6 +1655,8 @@ Arguments:
 
     Output - Supplies the output tensor.
 
+    ThreadPool - Optionally supplies the thread pool object to use.
+
 Return Value:
 
     Returns true if the operation was completed across multiple threads, else
@@ -772,9 +1664,6 @@ Return Value:
 
 --*/
 {
-
-#if defined(MLAS_HAS_THREADING_SUPPORT)
-
     MLAS_CONV_WORK_BLOCK WorkBlock;
 
     const size_t OutputSize = Parameters->OutputSize;
@@ -816,27 +1705,9 @@ Return Value:
         Index++;
     }
 
-    MlasExecuteThreaded(MlasConvOperationThreaded, &WorkBlock, Index);
+    MlasExecuteThreaded(MlasConvOperationThreaded, &WorkBlock, Index, ThreadPool);
 
     return true;
-
-#else
-
-    //
-    // No threading implementation is available.
-    //
-
-    MLAS_UNREFERENCED_PARAMETER(Parameters);
-    MLAS_UNREFERENCED_PARAMETER(Input);
-    MLAS_UNREFERENCED_PARAMETER(Filter);
-    MLAS_UNREFERENCED_PARAMETER(Bias);
-    MLAS_UNREFERENCED_PARAMETER(WorkingBuffer);
-    MLAS_UNREFERENCED_PARAMETER(Output);
-
-    return false;
-
-#endif
-
 }
 
 void
@@ -847,7 +1718,8 @@ MlasConv(
     const float* Filter,
     const float* Bias,
     float* WorkingBuffer,
-    float* Output
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
     )
 /*++
 
@@ -871,6 +1743,9 @@ Arguments:
 
     Output - Supplies the output tensor.
 
+    ThreadPool - Optionally supplies the thread pool object to use. This must
+        be the same thread pool that was supplied to MlasConvPrepare.
+
 Return Value:
 
     None.
@@ -890,17 +1765,43 @@ Return Value:
 
     const MLAS_CONV_ALGORITHM Algorithm = Parameters->Algorithm;
 
-#if defined(MLAS_HAS_THREADING_SUPPORT)
+    //
+    // The Winograd and depthwise algorithms process all batches and groups
+    // internally.
+    //
+
+    if (Algorithm == MlasConvAlgorithmWinograd) {
+        MlasConvWinograd(Parameters, Input, Filter, Bias, WorkingBuffer, Output, ThreadPool);
+        return;
+    }
+
+    if (Algorithm == MlasConvAlgorithmDepthwise) {
+
+        MLAS_CONV_WORK_BLOCK WorkBlock;
+
+        WorkBlock.Parameters = Parameters;
+        WorkBlock.Input = Input;
+        WorkBlock.Filter = Filter;
+        WorkBlock.Bias = Bias;
+        WorkBlock.WorkingBuffer = nullptr;
+        WorkBlock.Output = Output;
+        WorkBlock.TargetThreadCount = int32_t(Parameters->u.Depthwise.ThreadCount);
+
+        MlasExecuteThreaded(MlasConvDepthwiseThreaded, &WorkBlock, WorkBlock.TargetThreadCount, ThreadPool);
+
+        return;
+    }
 
     //
     // Schedule batches of GEMMs across multiple threads.
     //
 
-    if (Algorithm == MlasConvAlgorithmGemmDirect && ((BatchCount > 1) || (GroupCount > 1))) {
+    if (Algorithm == MlasConvAlgorithmGemmDirect && ((BatchCount > 1) || (GroupCount > 1)) &&
+        MlasGetMaximumThreadCount(ThreadPool) > 1) {
 
         const size_t BatchGroupCount = BatchCount * GroupCount;
 
-        int32_t TargetThreadCount = MlasPlatform.GetMaximumThreadCount();
+        int32_t TargetThreadCount = MlasGetMaximumThreadCount(ThreadPool);
 
         if (size_t(TargetThreadCount) >= BatchGroupCount) {
             TargetThreadCount = int32_t(BatchGroupCount);
@@ -916,13 +1817,11 @@ Return Value:
         WorkBlock.Output = Output;
         WorkBlock.TargetThreadCount = TargetThreadCount;
 
-        MlasExecuteThreaded(MlasConvGemmDirectThreaded, &WorkBlock, TargetThreadCount);
+        MlasExecuteThreaded(MlasConvGemmDirectThreaded, &WorkBlock, TargetThreadCount, ThreadPool);
 
         return;
     }
 
-#endif
-
     //
     // Iterate over each batch and group.
     //
@@ -948,7 +1847,7 @@ Return Value:
 
                     MlasSgemm(CblasNoTrans, Parameters->u.GemmDirect.TransB, FilterCount,
                         OutputSize, K, 1.0f, filter, K, Input, Parameters->u.GemmDirect.ldb, 0.0f,
-                        Output, OutputSize);
+                        Output, OutputSize, ThreadPool);
 
                     //
                     // Add the optional bias vector.
@@ -975,7 +1874,7 @@ Return Value:
                     }
 
                     MlasSgemm(CblasNoTrans, CblasNoTrans, FilterCount, OutputSize, K, 1.0f, filter,
-                        K, WorkingBuffer, OutputSize, 0.0f, Output, OutputSize);
+                        K, WorkingBuffer, OutputSize, 0.0f, Output, OutputSize, ThreadPool);
 
                     //
                     // Add the optional bias vector.
@@ -996,13 +1895,23 @@ Return Value:
                     //
 
                     if (!MlasConvTryMultithread(Parameters, Input, filter, bias, WorkingBuffer,
-                        Output)) {
+                        Output, ThreadPool)) {
                         MlasConvOperation(Parameters, Input, filter, bias, WorkingBuffer,
                             Output, 0, OutputSize);
                     }
 
                     break;
                 }
+
+                case MlasConvAlgorithmWinograd:
+                case MlasConvAlgorithmDepthwise:
+                {
+                    //
+                    // These algorithms are dispatched above.
+                    //
+
+                    break;
+                }
             }
 
             //
@@ -1020,6 +1929,50 @@ Return Value:
     }
 }
 
+inline
+int32_t
+MlasConvComputeTargetThreadCount(
+    double Complexity,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of target threads given the complexity
+    of a convolution operation. Small requests should run using the single
+    threaded path.
+
+Arguments:
+
+    Complexity - Supplies the number of multiply/add operations.
+
+    ThreadPool - Optionally supplies the thread pool object that will be used
+        to execute the convolution operation.
+
+Return Value:
+
+    Returns the number of target threads.
+
+--*/
+{
+    int32_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    return TargetThreadCount;
+}
+
 void
 MLASCALL
 MlasConvPrepare(
@@ -1035,7 +1988,8 @@ MlasConvPrepare(
     const int64_t* StrideShape,
     const int64_t* OutputShape,
     size_t FilterCount,
-    size_t* WorkingBufferSize
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
     )
 /*++
 
@@ -1076,6 +2030,9 @@ Arguments:
     WorkingBufferSize - Receives the number of elements to allocate for the
         working buffer for intermediate results.
 
+    ThreadPool - Optionally supplies the thread pool object that will be used
+        to execute the convolution operation.
+
 Return Value:
 
     None.
@@ -1129,6 +2086,30 @@ Return Value:
 
     *WorkingBufferSize = 0;
 
+    //
+    // Detect a depthwise convolution, where each group has a single input
+    // channel and a single filter. These are computed directly without any
+    // expansion of the input tensor.
+    //
+
+    if (Dimensions == 2 && GroupCount > 1 && InputChannels == 1 && FilterCount == 1) {
+
+        const size_t BatchGroupCount = BatchCount * GroupCount;
+
+        double Complexity = double(BatchGroupCount) * double(OutputSize) * double(K);
+
+        size_t TargetThreadCount = size_t(MlasConvComputeTargetThreadCount(Complexity, ThreadPool));
+
+        if (TargetThreadCount >= BatchGroupCount) {
+            TargetThreadCount = BatchGroupCount;
+        }
+
+        Parameters->Algorithm = MlasConvAlgorithmDepthwise;
+        Parameters->u.Depthwise.ThreadCount = TargetThreadCount;
+
+        return;
+    }
+
     if (AllStridesAreOne && AllPaddingIsZero) {
 
         //
@@ -1172,6 +2153,112 @@ Return Value:
         }
     }
 
+    //
+    // Detect a 3x3 stride 1 convolution that benefits from the Winograd
+    // algorithm. F(4x4,3x3) reduces the number of multiplies by 4x versus 2.25x
+    // for F(2x2,3x3), but wastes more computation on partial tiles at the edges
+    // of the output and has a larger transformed filter. The filter is
+    // transformed on every call, so the transform must be amortized over
+    // enough tiles.
+    //
+
+    if (Dimensions == 2 && AllStridesAreOne && AllDilationsAreOne &&
+        Parameters->KernelShape[0] == 3 && Parameters->KernelShape[1] == 3 &&
+        InputChannels >= MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS &&
+        FilterCount >= MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS) {
+
+        //
+        // Estimate the cost per input channel and filter in units of
+        // multiply/add operations for each tile size. The estimate must be
+        // below three quarters of the cost of the GEMM based algorithms to
+        // also pay for the transforms of the input and output tiles.
+        //
+        // A tile size is only usable if the transformed input and output of
+        // a single tile fit in the per-thread working buffer target, else the
+        // tile block size degenerates to zero. Very wide layers fall back to
+        // the GEMM based algorithms.
+        //
+
+        size_t TileSize = 0;
+        double MinimumCost = 0.75 * 9.0 * double(OutputSize) * double(BatchCount);
+
+        for (size_t ts = 2; ts <= 4; ts += 2) {
+
+            if ((ts + 2) * (ts + 2) * (InputChannels + FilterCount) >
+                MLAS_CONV_WINOGRAD_TILE_BLOCK_ELEMENTS) {
+                continue;
+            }
+
+            const double TransformElements = double((ts + 2) * (ts + 2));
+            const double TileCount = double((Parameters->OutputShape[0] + ts - 1) / ts) *
+                double((Parameters->OutputShape[1] + ts - 1) / ts);
+
+            double Cost = TransformElements * (TileCount * double(BatchCount) +
+                MLAS_CONV_WINOGRAD_FILTER_TRANSFORM_COST);
+
+            if (Cost < MinimumCost) {
+                MinimumCost = Cost;
+                TileSize = ts;
+            }
+        }
+
+        if (TileSize != 0) {
+
+            const size_t TransformElements = (TileSize + 2) * (TileSize + 2);
+            const size_t TileCountHeight = (Parameters->OutputShape[0] + TileSize - 1) / TileSize;
+            const size_t TileCountWidth = (Parameters->OutputShape[1] + TileSize - 1) / TileSize;
+            const size_t TileCount = TileCountHeight * TileCountWidth;
+
+            double Complexity = double(FilterCount) * double(OutputSize) * double(K);
+
+            size_t TargetThreadCount = size_t(MlasConvComputeTargetThreadCount(Complexity, ThreadPool));
+
+            //
+            // Size the blocks of tiles so that the transformed input and
+            // output tiles of a thread stay cache resident, while providing
+            // enough blocks to keep the target threads busy.
+            //
+
+            size_t TileBlockSize = MLAS_CONV_WINOGRAD_TILE_BLOCK_ELEMENTS /
+                (TransformElements * (InputChannels + FilterCount));
+
+            if (TileBlockSize > MLAS_CONV_WINOGRAD_MAXIMUM_TILE_BLOCK) {
+                TileBlockSize = MLAS_CONV_WINOGRAD_MAXIMUM_TILE_BLOCK;
+            }
+
+            const size_t TileBlocksPerImage = (TargetThreadCount + BatchCount - 1) / BatchCount;
+            const size_t TileBlockSizePerThread = (TileCount + TileBlocksPerImage - 1) / TileBlocksPerImage;
+
+            if (TileBlockSize > TileBlockSizePerThread) {
+                TileBlockSize = TileBlockSizePerThread;
+            }
+
+            //
+            // The tiles are transformed four at a time.
+            //
+
+            TileBlockSize = (TileBlockSize + 3) & ~size_t(3);
+
+            const size_t TileBlockCount = (TileCount + TileBlockSize - 1) / TileBlockSize;
+
+            if (TargetThreadCount >= BatchCount * TileBlockCount) {
+                TargetThreadCount = BatchCount * TileBlockCount;
+            }
+
+            Parameters->Algorithm = MlasConvAlgorithmWinograd;
+            Parameters->u.Winograd.TileSize = TileSize;
+            Parameters->u.Winograd.TileCountWidth = TileCountWidth;
+            Parameters->u.Winograd.TileCount = TileCount;
+            Parameters->u.Winograd.TileBlockSize = TileBlockSize;
+            Parameters->u.Winograd.ThreadCount = TargetThreadCount;
+
+            *WorkingBufferSize = TransformElements * FilterCount * InputChannels +
+                TargetThreadCount * TransformElements * (InputChannels + FilterCount) * TileBlockSize;
+
+            return;
+        }
+    }
+
     if (FilterCount > OutputSize) {
 
         //
@@ -1194,20 +2281,9 @@ Return Value:
         // threaded path.
         //
 
-        int32_t TargetThreadCount;
         double Complexity = double(FilterCount) * double(OutputSize) * double(K);
 
-        if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
-            TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
-        } else {
-            TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
-        }
-
-        int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
-
-        if (TargetThreadCount >= MaximumThreadCount) {
-            TargetThreadCount = MaximumThreadCount;
-        }
+        int32_t TargetThreadCount = MlasConvComputeTargetThreadCount(Complexity, ThreadPool);
 
         //
         // Compute the thread stride for slicing the N dimension.
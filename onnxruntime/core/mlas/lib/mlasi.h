@@ -101,6 +101,15 @@ Abstract:
 #define MLAS_SGEMM_STRIDEN                          128
 #define MLAS_SGEMM_STRIDEK                          128
 
+//
+// Define the strides and alignment of a matrix B packed by MlasSgemmPackB.
+// The K stride is fixed by the layout of the packed buffer.
+//
+
+#define MLAS_SGEMM_PACKED_STRIDEN                   128
+#define MLAS_SGEMM_PACKED_STRIDEK                   256
+#define MLAS_SGEMM_PACKED_ALIGNMENT                 64
+
 //
 // Define the alignment for segmenting a SGEMM operation across multiple
 // threads.
@@ -112,6 +121,19 @@ Abstract:
 
 #define MLAS_SGEMM_STRIDEN_THREAD_ALIGN             16
 
+//
+// Define the strides to step through slices of the input matrices of a
+// quantized GEMM operation. The QGEMM kernels produce 16 columns of matrix C
+// per packed panel of matrix B and consume matrix A and matrix B as pairs of
+// 16-bit values, so the N stride must be a multiple of 16 and the K stride
+// must be even.
+//
+
+#define MLAS_QGEMM_STRIDEM                          16
+#define MLAS_QGEMM_STRIDEN                          128
+#define MLAS_QGEMM_STRIDEK                          256
+#define MLAS_QGEMM_PANEL_WIDTH                      16
+
 //
 // Define the prototypes of the platform optimized routines.
 //
@@ -176,6 +198,21 @@ void
 
 typedef MLAS_TANH_KERNEL_ROUTINE* PMLAS_TANH_KERNEL_ROUTINE;
 
+typedef
+void
+(MLASCALL MLAS_QGEMM_KERNEL_ROUTINE)(
+    const int16_t* A,
+    const int16_t* B,
+    int32_t* C,
+    size_t PairCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    bool ZeroMode
+    );
+
+typedef MLAS_QGEMM_KERNEL_ROUTINE* PMLAS_QGEMM_KERNEL_ROUTINE;
+
 extern "C" {
 
     MLAS_SGEMM_KERNEL_ROUTINE MlasSgemmKernelZero;
@@ -210,6 +247,14 @@ extern "C" {
     MLAS_TANH_KERNEL_ROUTINE MlasTanhKernelFma3;
 #endif
 
+    MLAS_QGEMM_KERNEL_ROUTINE MlasQgemmKernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_QGEMM_KERNEL_ROUTINE MlasQgemmKernelAvx2;
+#if defined(MLAS_HAS_QGEMM_AVX512VNNI)
+    MLAS_QGEMM_KERNEL_ROUTINE MlasQgemmKernelAvx512Vnni;
+#endif
+#endif
+
 }
 
 //
@@ -231,6 +276,13 @@ extern "C" {
 #endif
 #endif
 
+//
+// Define the target number of per-thread multiplies before using another
+// thread to perform additional work for a quantized GEMM operation.
+//
+
+#define MLAS_QGEMM_THREAD_COMPLEXITY                MLAS_SGEMM_THREAD_COMPLEXITY
+
 //
 // Single-threaded single precision matrix/matrix multiply operation.
 //
@@ -271,6 +323,7 @@ struct MLAS_PLATFORM {
     PMLAS_SGEMM_TRANSPOSE_PACKB_BLOCK_ROUTINE TransposePackB16x4Routine;
     PMLAS_LOGISTIC_KERNEL_ROUTINE LogisticKernelRoutine;
     PMLAS_TANH_KERNEL_ROUTINE TanhKernelRoutine;
+    PMLAS_QGEMM_KERNEL_ROUTINE QgemmKernelRoutine;
 #endif
 
 #if defined(MLAS_USE_WIN32_THREADPOOL)
@@ -298,20 +351,25 @@ extern MLAS_PLATFORM MlasPlatform;
 // Threading support.
 //
 
-typedef
-void
-(MLAS_THREADED_ROUTINE)(
-    void* Context,
-    int32_t Index
-    );
+inline
+int32_t
+MlasGetMaximumThreadCount(
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    if (ThreadPool != nullptr) {
+        return ThreadPool->GetMaximumThreadCount();
+    }
 
-typedef MLAS_THREADED_ROUTINE* PMLAS_THREADED_ROUTINE;
+    return MlasPlatform.GetMaximumThreadCount();
+}
 
 void
 MlasExecuteThreaded(
     PMLAS_THREADED_ROUTINE ThreadedRoutine,
     void* Context,
-    int32_t Iterations
+    int32_t Iterations,
+    MLAS_THREADPOOL* ThreadPool
     );
 
 //
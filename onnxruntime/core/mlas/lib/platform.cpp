@@ -55,6 +55,7 @@ Return Value:
     this->TransposePackB16x4Routine = MlasSgemmTransposePackB16x4Sse;
     this->LogisticKernelRoutine = MlasLogisticKernel;
     this->TanhKernelRoutine = MlasTanhKernel;
+    this->QgemmKernelRoutine = MlasQgemmKernel;
 #endif
 
     //
@@ -113,6 +114,21 @@ Return Value:
 
                 this->LogisticKernelRoutine = MlasLogisticKernelFma3;
                 this->TanhKernelRoutine = MlasTanhKernelFma3;
+                this->QgemmKernelRoutine = MlasQgemmKernelAvx2;
+
+#if defined(MLAS_HAS_QGEMM_AVX512VNNI)
+
+                //
+                // Check if the processor supports AVX512_VNNI (and the
+                // operating system supports saving AVX512F state).
+                //
+
+                if (((Cpuid7[1] & 0x10000) != 0) && ((Cpuid7[2] & 0x800) != 0) &&
+                    ((xcr0 & 0xE0) == 0xE0)) {
+                    this->QgemmKernelRoutine = MlasQgemmKernelAvx512Vnni;
+                }
+
+#endif
 
             } else {
 
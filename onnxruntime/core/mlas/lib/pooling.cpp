@@ -46,6 +46,21 @@ void
 
 typedef MLAS_POOL_KERNEL_ROUTINE* PMLAS_POOL_KERNEL_ROUTINE;
 
+//
+// Define the parameters to execute a pooling kernel routine across multiple
+// threads by slicing the channel dimension.
+//
+
+struct MLAS_POOL_THREADED_WORK_BLOCK {
+    const MLAS_WORK_BLOCK* WorkBlock;
+    PMLAS_POOL_KERNEL_ROUTINE PoolKernelRoutine;
+    const float* Input;
+    float* Output;
+    size_t OutputSize;
+    size_t TotalChannelCount;
+    int32_t TargetThreadCount;
+};
+
 //
 // Define the number of elements to allocate on the stack for the reduction
 // buffer in the vectorized kernels.
@@ -1171,6 +1186,63 @@ static const PMLAS_POOL_KERNEL_ROUTINE MlasPoolVectorKernels[][2] =
     },
 };
 
+void
+MlasPoolThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    pooling operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_POOL_THREADED_WORK_BLOCK* ThreadedWorkBlock = (MLAS_POOL_THREADED_WORK_BLOCK*)Context;
+
+    //
+    // Compute the range of channels to use for this thread.
+    //
+
+    const size_t TotalChannelCount = ThreadedWorkBlock->TotalChannelCount;
+    const size_t TargetThreadCount = size_t(ThreadedWorkBlock->TargetThreadCount);
+
+    const size_t ChannelCountPerThread = TotalChannelCount / TargetThreadCount;
+    const size_t ChannelCountExtra = TotalChannelCount % TargetThreadCount;
+
+    size_t ChannelStart;
+    size_t ChannelCount;
+
+    if (size_t(Index) < ChannelCountExtra) {
+        ChannelStart = (ChannelCountPerThread + 1) * Index;
+        ChannelCount = ChannelCountPerThread + 1;
+    } else {
+        ChannelStart = ChannelCountPerThread * Index + ChannelCountExtra;
+        ChannelCount = ChannelCountPerThread;
+    }
+
+    if (ChannelCount > 0) {
+
+        const MLAS_WORK_BLOCK* WorkBlock = ThreadedWorkBlock->WorkBlock;
+
+        ThreadedWorkBlock->PoolKernelRoutine(WorkBlock, ChannelCount,
+            ThreadedWorkBlock->Input + ChannelStart * WorkBlock->InputSize,
+            ThreadedWorkBlock->Output + ChannelStart * ThreadedWorkBlock->OutputSize);
+    }
+}
+
 void
 MLASCALL
 MlasPool(
@@ -1182,7 +1254,8 @@ MlasPool(
     const int64_t* StrideShape,
     const int64_t* OutputShape,
     const float* Input,
-    float* Output
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
     )
 /*++
 
@@ -1211,6 +1284,9 @@ Arguments:
 
     Output - Supplies the output tensor.
 
+    ThreadPool - Optionally supplies the thread pool object to use. If
+        nullptr, the platform default threading support is used.
+
 Return Value:
 
     None.
@@ -1315,6 +1391,37 @@ Return Value:
         }
     }
 
+    //
+    // Execute the pooling kernel routine across the threads of the supplied
+    // thread pool by slicing the channel dimension.
+    //
+
+    if (ThreadPool != nullptr) {
+
+        int32_t TargetThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+        if (size_t(TargetThreadCount) >= TotalChannelCount) {
+            TargetThreadCount = int32_t(TotalChannelCount);
+        }
+
+        if (TargetThreadCount > 1) {
+
+            MLAS_POOL_THREADED_WORK_BLOCK ThreadedWorkBlock;
+
+            ThreadedWorkBlock.WorkBlock = &WorkBlock;
+            ThreadedWorkBlock.PoolKernelRoutine = PoolKernelRoutine;
+            ThreadedWorkBlock.Input = Input;
+            ThreadedWorkBlock.Output = Output;
+            ThreadedWorkBlock.OutputSize = OutputSize;
+            ThreadedWorkBlock.TotalChannelCount = TotalChannelCount;
+            ThreadedWorkBlock.TargetThreadCount = TargetThreadCount;
+
+            MlasExecuteThreaded(MlasPoolThreaded, &ThreadedWorkBlock, TargetThreadCount, ThreadPool);
+
+            return;
+        }
+    }
+
     //
     // Execute the pooling kernel routine.
     //
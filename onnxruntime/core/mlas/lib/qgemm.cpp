@@ -0,0 +1,699 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qgemm.cpp
+
+Abstract:
+
+    This module implements the quantized integer matrix/matrix multiply
+    operation (QGEMM) and the requantization of its 32-bit results.
+
+    The zero points are subtracted while matrix A and matrix B are packed, so
+    the packed values are 16-bit and the kernels multiply pairs of values
+    along the K dimension with 32-bit accumulation (the pmaddwd/vpdpwssd
+    instructions on x86). The difference of two 8-bit values always fits in
+    16 bits, so no intermediate product can saturate.
+
+--*/
+
+#include "mlasi.h"
+
+#include <math.h>
+
+//
+// Define the parameters to execute segments of a QGEMM operation on worker
+// threads.
+//
+
+template<typename BType>
+struct MLAS_QGEMM_WORK_BLOCK {
+    size_t M;
+    size_t N;
+    size_t K;
+    const uint8_t* A;
+    size_t lda;
+    uint8_t offa;
+    const BType* B;
+    size_t ldb;
+    BType offb;
+    int32_t* C;
+    size_t ldc;
+    const MLAS_REQUANTIZE_PARAMETERS* Requantize;
+    struct SEGMENT {
+        size_t StartM;
+        size_t CountM;
+        size_t StartN;
+        size_t CountN;
+    } Segments[MLAS_MAXIMUM_THREAD_COUNT];
+};
+
+void
+MLASCALL
+MlasQgemmKernel(
+    const int16_t* A,
+    const int16_t* B,
+    int32_t* C,
+    size_t PairCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine is the portable implementation of the QGEMM kernel. It
+    computes one panel of matrix C from a block of packed rows of matrix A
+    and one packed panel of matrix B.
+
+Arguments:
+
+    A - Supplies the address of the packed rows of matrix A. Each row holds
+        PairCountK pairs of 16-bit values.
+
+    B - Supplies the address of the packed panel of matrix B. Each pair of
+        rows holds MLAS_QGEMM_PANEL_WIDTH interleaved pairs of 16-bit values.
+
+    C - Supplies the address of matrix C.
+
+    PairCountK - Supplies the number of pairs of K elements to process.
+
+    CountM - Supplies the number of rows of matrix C to compute.
+
+    CountN - Supplies the number of columns of matrix C to compute. This is at
+        most MLAS_QGEMM_PANEL_WIDTH.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ZeroMode - Supplies true if the output is stored to matrix C, else the
+        output is accumulated into matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t m = 0; m < CountM; m++) {
+
+        int32_t Accumulators[MLAS_QGEMM_PANEL_WIDTH] = { 0 };
+        const int16_t* a = A + m * PairCountK * 2;
+        const int16_t* b = B;
+
+        for (size_t k = 0; k < PairCountK; k++) {
+
+            const int32_t a0 = a[0];
+            const int32_t a1 = a[1];
+
+            for (size_t n = 0; n < MLAS_QGEMM_PANEL_WIDTH; n++) {
+                Accumulators[n] += a0 * b[n * 2] + a1 * b[n * 2 + 1];
+            }
+
+            a += 2;
+            b += MLAS_QGEMM_PANEL_WIDTH * 2;
+        }
+
+        int32_t* c = C + m * ldc;
+
+        for (size_t n = 0; n < CountN; n++) {
+            c[n] = ZeroMode ? Accumulators[n] : c[n] + Accumulators[n];
+        }
+    }
+}
+
+void
+MlasQgemmPackA(
+    int16_t* D,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    size_t CountM,
+    size_t CountK
+    )
+/*++
+
+Routine Description:
+
+    This routine copies a block of rows of matrix A to the packed layout used
+    by the QGEMM kernels, subtracting the zero point. Rows with an odd number
+    of columns are padded with a zero.
+
+Arguments:
+
+    D - Supplies the address of the destination buffer.
+
+    A - Supplies the address of the source matrix.
+
+    lda - Supplies the first dimension of the source matrix.
+
+    offa - Supplies the zero point of the source matrix.
+
+    CountM - Supplies the number of rows to copy.
+
+    CountK - Supplies the number of columns to copy.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const int16_t ZeroPoint = int16_t(offa);
+
+    for (size_t m = 0; m < CountM; m++) {
+
+        const uint8_t* a = A + m * lda;
+
+        for (size_t k = 0; k < CountK; k++) {
+            *D++ = int16_t(a[k] - ZeroPoint);
+        }
+
+        if ((CountK & 1) != 0) {
+            *D++ = 0;
+        }
+    }
+}
+
+template<typename BType>
+void
+MlasQgemmPackB(
+    int16_t* D,
+    const BType* B,
+    size_t ldb,
+    BType offb,
+    size_t CountN,
+    size_t CountK
+    )
+/*++
+
+Routine Description:
+
+    This routine copies a block of matrix B to the packed layout used by the
+    QGEMM kernels, subtracting the zero point.
+
+    The block is split into panels of MLAS_QGEMM_PANEL_WIDTH columns. Each
+    panel stores the values of two consecutive rows as interleaved pairs, so
+    that a kernel multiplies a pair of values of matrix A by a pair of rows of
+    matrix B with one instruction. The columns past CountN and the row past an
+    odd CountK are padded with zeroes.
+
+Arguments:
+
+    D - Supplies the address of the destination buffer.
+
+    B - Supplies the address of the source matrix.
+
+    ldb - Supplies the first dimension of the source matrix.
+
+    offb - Supplies the zero point of the source matrix.
+
+    CountN - Supplies the number of columns to copy.
+
+    CountK - Supplies the number of rows to copy.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const int16_t ZeroPoint = int16_t(offb);
+
+    for (size_t n = 0; n < CountN; n += MLAS_QGEMM_PANEL_WIDTH) {
+
+        const size_t PanelCountN = std::min(CountN - n, size_t(MLAS_QGEMM_PANEL_WIDTH));
+
+        for (size_t k = 0; k < CountK; k += 2) {
+
+            const BType* b0 = B + k * ldb + n;
+            const BType* b1 = b0 + ldb;
+            const bool HasSecondRow = (k + 1) < CountK;
+
+            for (size_t nn = 0; nn < MLAS_QGEMM_PANEL_WIDTH; nn++) {
+
+                if (nn < PanelCountN) {
+                    D[0] = int16_t(b0[nn] - ZeroPoint);
+                    D[1] = HasSecondRow ? int16_t(b1[nn] - ZeroPoint) : int16_t(0);
+                } else {
+                    D[0] = 0;
+                    D[1] = 0;
+                }
+
+                D += 2;
+            }
+        }
+    }
+}
+
+void
+MLASCALL
+MlasRequantizeOutput(
+    const int32_t* Input,
+    size_t ldi,
+    uint8_t* Output,
+    size_t ldo,
+    const int32_t* Bias,
+    const float* Scale,
+    bool PerRowScale,
+    uint8_t ZeroPoint,
+    size_t M,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine scales the 32-bit results of a QGEMM operation back to
+    unsigned 8-bit values: Output = saturate(round((Input + Bias) * Scale) +
+    ZeroPoint). Halfway cases are rounded away from zero, as done by
+    QuantizeLinear.
+
+Arguments:
+
+    Input - Supplies the address of the 32-bit matrix.
+
+    ldi - Supplies the first dimension of the 32-bit matrix.
+
+    Output - Supplies the address of the output matrix.
+
+    ldo - Supplies the first dimension of the output matrix.
+
+    Bias - Optionally supplies the address of the bias vector, with one value
+        per row.
+
+    Scale - Supplies the address of the scale factors.
+
+    PerRowScale - Supplies true if Scale holds one value per row, else Scale
+        holds a single value for the matrix.
+
+    ZeroPoint - Supplies the zero point of the output matrix.
+
+    M - Supplies the number of rows of the matrix.
+
+    N - Supplies the number of columns of the matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float MinimumValue = float(0 - int32_t(ZeroPoint));
+    const float MaximumValue = float(255 - int32_t(ZeroPoint));
+
+    for (size_t m = 0; m < M; m++) {
+
+        const int32_t* i = Input + m * ldi;
+        uint8_t* o = Output + m * ldo;
+        const int32_t RowBias = (Bias != nullptr) ? Bias[m] : 0;
+        const float RowScale = PerRowScale ? Scale[m] : Scale[0];
+
+        for (size_t n = 0; n < N; n++) {
+
+            float Value = roundf(float(i[n] + RowBias) * RowScale);
+
+            Value = std::min(std::max(Value, MinimumValue), MaximumValue);
+
+            o[n] = uint8_t(int32_t(Value) + int32_t(ZeroPoint));
+        }
+    }
+}
+
+template<typename BType>
+void
+MlasQgemmOperation(
+    const MLAS_QGEMM_WORK_BLOCK<BType>* WorkBlock,
+    size_t StartM,
+    size_t CountM,
+    size_t StartN,
+    size_t CountN
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a single threaded segment of a QGEMM operation.
+
+    The segment is computed in blocks of MLAS_QGEMM_STRIDEN columns. All of
+    the K dimension is accumulated for a block before moving on to the next
+    one, so that the requantization of the block reads matrix C while it is
+    still in the cache.
+
+Arguments:
+
+    WorkBlock - Supplies the structure containing the QGEMM parameters.
+
+    StartM - Supplies the first row of matrix C of the segment.
+
+    CountM - Supplies the number of rows of matrix C of the segment.
+
+    StartN - Supplies the first column of matrix C of the segment.
+
+    CountN - Supplies the number of columns of matrix C of the segment.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(int16_t PanelA[MLAS_QGEMM_STRIDEM * MLAS_QGEMM_STRIDEK], 64);
+    MLAS_DECLSPEC_ALIGN(int16_t PanelB[MLAS_QGEMM_STRIDEN * MLAS_QGEMM_STRIDEK], 64);
+
+#if defined(MLAS_TARGET_AMD64)
+    PMLAS_QGEMM_KERNEL_ROUTINE KernelRoutine = MlasPlatform.QgemmKernelRoutine;
+#else
+    PMLAS_QGEMM_KERNEL_ROUTINE KernelRoutine = MlasQgemmKernel;
+#endif
+
+    const size_t K = WorkBlock->K;
+    const size_t ldc = WorkBlock->ldc;
+
+    size_t StrideN;
+
+    for (size_t n = StartN; n < StartN + CountN; n += StrideN) {
+
+        StrideN = std::min(StartN + CountN - n, size_t(MLAS_QGEMM_STRIDEN));
+
+        int32_t* c = WorkBlock->C + StartM * ldc + n;
+
+        size_t StrideK;
+
+        for (size_t k = 0; k < K; k += StrideK) {
+
+            StrideK = std::min(K - k, size_t(MLAS_QGEMM_STRIDEK));
+
+            const size_t PairCountK = (StrideK + 1) / 2;
+            const size_t PanelSizeB = PairCountK * MLAS_QGEMM_PANEL_WIDTH * 2;
+
+            MlasQgemmPackB(PanelB, WorkBlock->B + k * WorkBlock->ldb + n,
+                WorkBlock->ldb, WorkBlock->offb, StrideN, StrideK);
+
+            size_t StrideM;
+
+            for (size_t m = 0; m < CountM; m += StrideM) {
+
+                StrideM = std::min(CountM - m, size_t(MLAS_QGEMM_STRIDEM));
+
+                MlasQgemmPackA(PanelA, WorkBlock->A + (StartM + m) * WorkBlock->lda + k,
+                    WorkBlock->lda, WorkBlock->offa, StrideM, StrideK);
+
+                const int16_t* b = PanelB;
+
+                for (size_t nn = 0; nn < StrideN; nn += MLAS_QGEMM_PANEL_WIDTH) {
+
+                    KernelRoutine(PanelA, b, c + m * ldc + nn, PairCountK, StrideM,
+                        std::min(StrideN - nn, size_t(MLAS_QGEMM_PANEL_WIDTH)), ldc, k == 0);
+
+                    b += PanelSizeB;
+                }
+            }
+        }
+
+        //
+        // Matrix C is the result of an empty product if K is zero.
+        //
+
+        if (K == 0) {
+            for (size_t m = 0; m < CountM; m++) {
+                std::fill_n(c + m * ldc, StrideN, 0);
+            }
+        }
+
+        const MLAS_REQUANTIZE_PARAMETERS* Requantize = WorkBlock->Requantize;
+
+        if (Requantize != nullptr) {
+
+            MlasRequantizeOutput(c, ldc,
+                Requantize->Output + StartM * Requantize->ldo + n, Requantize->ldo,
+                (Requantize->Bias != nullptr) ? Requantize->Bias + StartM : nullptr,
+                Requantize->PerRowScale ? Requantize->Scale + StartM : Requantize->Scale,
+                Requantize->PerRowScale, Requantize->ZeroPoint, CountM, StrideN);
+        }
+    }
+}
+
+template<typename BType>
+void
+MlasQgemmOperationThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    QGEMM operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (const MLAS_QGEMM_WORK_BLOCK<BType>*)Context;
+    const auto* Segment = &WorkBlock->Segments[Index];
+
+    MlasQgemmOperation(WorkBlock, Segment->StartM, Segment->CountM,
+        Segment->StartN, Segment->CountN);
+}
+
+template<typename BType>
+void
+MlasQgemmSchedule(
+    MLAS_QGEMM_WORK_BLOCK<BType>* WorkBlock,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine splits a QGEMM operation into segments based on the amount
+    of work and the number of available threads, then executes the segments.
+
+    The rows of matrix C are split between the threads if there are enough of
+    them, else the columns of matrix C are split in multiples of the panel
+    width.
+
+Arguments:
+
+    WorkBlock - Supplies the structure containing the QGEMM parameters.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        platform default threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t M = WorkBlock->M;
+    const size_t N = WorkBlock->N;
+
+    const double Complexity = double(M) * double(N) * double(WorkBlock->K);
+
+    int32_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_QGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_QGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (TargetThreadCount == 1) {
+        MlasQgemmOperation(WorkBlock, 0, M, 0, N);
+        return;
+    }
+
+    int32_t SegmentCount = 0;
+
+    if (M >= size_t(TargetThreadCount)) {
+
+        const size_t StrideM = (M + TargetThreadCount - 1) / TargetThreadCount;
+
+        for (size_t m = 0; m < M; m += StrideM) {
+            auto* Segment = &WorkBlock->Segments[SegmentCount++];
+            Segment->StartM = m;
+            Segment->CountM = std::min(M - m, StrideM);
+            Segment->StartN = 0;
+            Segment->CountN = N;
+        }
+
+    } else {
+
+        const size_t PanelCount = (N + MLAS_QGEMM_PANEL_WIDTH - 1) / MLAS_QGEMM_PANEL_WIDTH;
+        const size_t StrideN = ((PanelCount + TargetThreadCount - 1) / TargetThreadCount) *
+            MLAS_QGEMM_PANEL_WIDTH;
+
+        for (size_t n = 0; n < N; n += StrideN) {
+            auto* Segment = &WorkBlock->Segments[SegmentCount++];
+            Segment->StartM = 0;
+            Segment->CountM = M;
+            Segment->StartN = n;
+            Segment->CountN = std::min(N - n, StrideN);
+        }
+    }
+
+    MlasExecuteThreaded(MlasQgemmOperationThreaded<BType>, WorkBlock, SegmentCount, ThreadPool);
+}
+
+template<typename BType>
+void
+MlasQgemmImpl(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const BType* B,
+    size_t ldb,
+    BType offb,
+    int32_t* C,
+    size_t ldc,
+    const MLAS_REQUANTIZE_PARAMETERS* Requantize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    if (M == 0 || N == 0) {
+        return;
+    }
+
+    MLAS_QGEMM_WORK_BLOCK<BType> WorkBlock;
+
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+    WorkBlock.A = A;
+    WorkBlock.lda = lda;
+    WorkBlock.offa = offa;
+    WorkBlock.B = B;
+    WorkBlock.ldb = ldb;
+    WorkBlock.offb = offb;
+    WorkBlock.C = C;
+    WorkBlock.ldc = ldc;
+    WorkBlock.Requantize = Requantize;
+
+    MlasQgemmSchedule(&WorkBlock, ThreadPool);
+}
+
+void
+MLASCALL
+MlasQgemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const uint8_t* B,
+    size_t ldb,
+    uint8_t offb,
+    int32_t* C,
+    size_t ldc,
+    const MLAS_REQUANTIZE_PARAMETERS* Requantize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the quantized integer matrix/matrix multiply
+    operation (QGEMM) for an unsigned matrix B.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    offa - Supplies the zero point of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    offb - Supplies the zero point of matrix B.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    Requantize - Optionally supplies the parameters to scale matrix C back to
+        unsigned 8-bit values.
+
+    ThreadPool - Optionally supplies the thread pool object to use. If
+        nullptr, the platform default threading support is used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasQgemmImpl(M, N, K, A, lda, offa, B, ldb, offb, C, ldc, Requantize, ThreadPool);
+}
+
+void
+MLASCALL
+MlasQgemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const int8_t* B,
+    size_t ldb,
+    int8_t offb,
+    int32_t* C,
+    size_t ldc,
+    const MLAS_REQUANTIZE_PARAMETERS* Requantize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the quantized integer matrix/matrix multiply
+    operation (QGEMM) for a signed matrix B.
+
+Arguments:
+
+    See the unsigned version of MlasQgemm.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasQgemmImpl(M, N, K, A, lda, offa, B, ldb, offb, C, ldc, Requantize, ThreadPool);
+}
@@ -0,0 +1,151 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qgemm_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the QGEMM kernel for processors supporting AVX2.
+
+    This module must be compiled with AVX2 code generation enabled.
+
+--*/
+
+#include "mlasi.h"
+
+template<size_t RowCount>
+inline
+void
+MlasQgemmKernelAvx2Rows(
+    const int16_t* A,
+    const int16_t* B,
+    int32_t* C,
+    size_t PairCountK,
+    size_t CountN,
+    size_t ldc,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine computes RowCount rows of one panel of matrix C. Each row
+    keeps the 16 columns of the panel in two accumulators.
+
+Arguments:
+
+    See MlasQgemmKernelAvx2.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t lda = PairCountK * 2;
+
+    __m256i Accumulators[RowCount][2];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        Accumulators[r][0] = _mm256_setzero_si256();
+        Accumulators[r][1] = _mm256_setzero_si256();
+    }
+
+    for (size_t k = 0; k < PairCountK; k++) {
+
+        __m256i BElements0 = _mm256_load_si256((const __m256i*)B);
+        __m256i BElements1 = _mm256_load_si256((const __m256i*)(B + 16));
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            int32_t APair;
+            memcpy(&APair, A + r * lda + k * 2, sizeof(APair));
+
+            __m256i ABroadcast = _mm256_set1_epi32(APair);
+
+            Accumulators[r][0] = _mm256_add_epi32(Accumulators[r][0], _mm256_madd_epi16(ABroadcast, BElements0));
+            Accumulators[r][1] = _mm256_add_epi32(Accumulators[r][1], _mm256_madd_epi16(ABroadcast, BElements1));
+        }
+
+        B += MLAS_QGEMM_PANEL_WIDTH * 2;
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+
+        int32_t* c = C + r * ldc;
+
+        if (CountN == MLAS_QGEMM_PANEL_WIDTH) {
+
+            if (!ZeroMode) {
+                Accumulators[r][0] = _mm256_add_epi32(Accumulators[r][0], _mm256_loadu_si256((const __m256i*)c));
+                Accumulators[r][1] = _mm256_add_epi32(Accumulators[r][1], _mm256_loadu_si256((const __m256i*)(c + 8)));
+            }
+
+            _mm256_storeu_si256((__m256i*)c, Accumulators[r][0]);
+            _mm256_storeu_si256((__m256i*)(c + 8), Accumulators[r][1]);
+
+        } else {
+
+            MLAS_DECLSPEC_ALIGN(int32_t Buffer[MLAS_QGEMM_PANEL_WIDTH], 32);
+
+            _mm256_store_si256((__m256i*)Buffer, Accumulators[r][0]);
+            _mm256_store_si256((__m256i*)(Buffer + 8), Accumulators[r][1]);
+
+            for (size_t n = 0; n < CountN; n++) {
+                c[n] = ZeroMode ? Buffer[n] : c[n] + Buffer[n];
+            }
+        }
+    }
+}
+
+void
+MLASCALL
+MlasQgemmKernelAvx2(
+    const int16_t* A,
+    const int16_t* B,
+    int32_t* C,
+    size_t PairCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine computes one panel of matrix C from a block of packed rows of
+    matrix A and one packed panel of matrix B using AVX2 instructions. Four
+    rows are computed at a time to reuse each load of matrix B.
+
+Arguments:
+
+    See MlasQgemmKernel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t lda = PairCountK * 2;
+
+    while (CountM >= 4) {
+        MlasQgemmKernelAvx2Rows<4>(A, B, C, PairCountK, CountN, ldc, ZeroMode);
+        A += 4 * lda;
+        C += 4 * ldc;
+        CountM -= 4;
+    }
+
+    while (CountM > 0) {
+        MlasQgemmKernelAvx2Rows<1>(A, B, C, PairCountK, CountN, ldc, ZeroMode);
+        A += lda;
+        C += ldc;
+        CountM -= 1;
+    }
+}
@@ -0,0 +1,137 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qgemm_kernel_avx512vnni.cpp
+
+Abstract:
+
+    This module implements the QGEMM kernel for processors supporting
+    AVX512_VNNI.
+
+    The kernel uses the vpdpwssd instruction, which multiplies the pairs of
+    16-bit values and adds the products to the accumulator in one step. A
+    panel of 16 columns fits in a single 512-bit register.
+
+    This module must be compiled with AVX512F and AVX512_VNNI code generation
+    enabled.
+
+--*/
+
+#include "mlasi.h"
+
+template<size_t RowCount>
+inline
+void
+MlasQgemmKernelAvx512VnniRows(
+    const int16_t* A,
+    const int16_t* B,
+    int32_t* C,
+    size_t PairCountK,
+    size_t CountN,
+    size_t ldc,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine computes RowCount rows of one panel of matrix C.
+
+Arguments:
+
+    See MlasQgemmKernelAvx512Vnni.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t lda = PairCountK * 2;
+
+    __m512i Accumulators[RowCount];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        Accumulators[r] = _mm512_setzero_si512();
+    }
+
+    for (size_t k = 0; k < PairCountK; k++) {
+
+        __m512i BElements = _mm512_load_si512((const void*)B);
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            int32_t APair;
+            memcpy(&APair, A + r * lda + k * 2, sizeof(APair));
+
+            Accumulators[r] = _mm512_dpwssd_epi32(Accumulators[r], _mm512_set1_epi32(APair), BElements);
+        }
+
+        B += MLAS_QGEMM_PANEL_WIDTH * 2;
+    }
+
+    const __mmask16 StoreMask = __mmask16((1u << CountN) - 1);
+
+    for (size_t r = 0; r < RowCount; r++) {
+
+        int32_t* c = C + r * ldc;
+
+        if (!ZeroMode) {
+            Accumulators[r] = _mm512_add_epi32(Accumulators[r], _mm512_maskz_loadu_epi32(StoreMask, c));
+        }
+
+        _mm512_mask_storeu_epi32(c, StoreMask, Accumulators[r]);
+    }
+}
+
+void
+MLASCALL
+MlasQgemmKernelAvx512Vnni(
+    const int16_t* A,
+    const int16_t* B,
+    int32_t* C,
+    size_t PairCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine computes one panel of matrix C from a block of packed rows of
+    matrix A and one packed panel of matrix B using AVX512_VNNI instructions.
+    Eight rows are computed at a time to reuse each load of matrix B.
+
+Arguments:
+
+    See MlasQgemmKernel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t lda = PairCountK * 2;
+
+    while (CountM >= 8) {
+        MlasQgemmKernelAvx512VnniRows<8>(A, B, C, PairCountK, CountN, ldc, ZeroMode);
+        A += 8 * lda;
+        C += 8 * ldc;
+        CountM -= 8;
+    }
+
+    while (CountM > 0) {
+        MlasQgemmKernelAvx512VnniRows<1>(A, B, C, PairCountK, CountN, ldc, ZeroMode);
+        A += lda;
+        C += ldc;
+        CountM -= 1;
+    }
+}
@@ -40,15 +40,48 @@ struct MLAS_SGEMM_WORK_BLOCK {
     size_t ldc;
     float alpha;
     float beta;
+    const float* PackedB;
+    size_t AlignedN;
     struct SEGMENT {
         size_t M;
         size_t N;
+        size_t StartN;
         const float* A;
         const float* B;
         float* C;
     } Segments[MLAS_MAXIMUM_THREAD_COUNT];
 };
 
+//
+// Define the parameters to execute a batch of SGEMM operations on worker
+// threads. Each iteration either executes a range of the batch or a tile of
+// one SGEMM operation.
+//
+
+struct MLAS_SGEMM_BATCH_WORK_BLOCK {
+    CBLAS_TRANSPOSE TransA;
+    CBLAS_TRANSPOSE TransB;
+    size_t M;
+    size_t N;
+    size_t K;
+    float alpha;
+    float beta;
+    const float* A;
+    size_t lda;
+    size_t StrideA;
+    const float* B;
+    size_t ldb;
+    size_t StrideB;
+    float* C;
+    size_t ldc;
+    size_t StrideC;
+    size_t BatchCount;
+    size_t BatchesPerIteration;
+    size_t TilesPerGemm;
+    size_t TileStrideM;
+    size_t TileStrideN;
+};
+
 #if defined(MLAS_TARGET_AMD64_IX86)
 
 //
@@ -772,6 +805,160 @@ Return Value:
     }
 }
 
+inline
+void
+MlasSgemmMultiplyPanelB(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t CountN,
+    size_t CountK,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const float* PanelB,
+    float* PanelA,
+    bool UseKernelZeroRoutine,
+    float* C,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine multiplies a slice of matrix A with a packed panel of matrix
+    B and accumulates the result into the output matrix.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    CountN - Supplies the number of columns of the packed panel.
+
+    CountK - Supplies the number of rows of the packed panel.
+
+    alpha - Supplies the scaler alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of the first element of matrix A to use for this
+        panel.
+
+    lda - Supplies the first dimension of matrix A.
+
+    PanelB - Supplies the address of the packed panel of matrix B.
+
+    PanelA - Supplies the address of a local buffer of
+        MLAS_SGEMM_TRANSA_ROWS * CountK elements used to transpose matrix A.
+
+    UseKernelZeroRoutine - Supplies true if the output matrix should be
+        overwritten instead of accumulated into.
+
+    C - Supplies the address of the first element of matrix C to update.
+
+    ldc - Supplies the first dimension of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Select the kernel routine to use for this panel.
+    //
+
+#if defined(MLAS_TARGET_AMD64_IX86)
+    PMLAS_SGEMM_KERNEL_ROUTINE SgemmKernelRoutine =
+        UseKernelZeroRoutine ? MlasPlatform.KernelZeroRoutine : MlasPlatform.KernelAddRoutine;
+#endif
+
+    //
+    // Step through each slice of matrix A along the M dimension.
+    //
+
+    float* c = C;
+
+    size_t RowsRemaining = M;
+    size_t RowsHandled;
+
+    if (TransA == CblasNoTrans) {
+
+        const float* a = A;
+
+        //
+        // Step through the rows of matrix A.
+        //
+
+        do {
+
+#if defined(MLAS_TARGET_AMD64_IX86)
+            RowsHandled = SgemmKernelRoutine(a, PanelB, c, CountK, RowsRemaining, CountN, lda, ldc, alpha);
+#else
+            if (UseKernelZeroRoutine) {
+                RowsHandled = MlasSgemmKernelZero(a, PanelB, c, CountK, RowsRemaining, CountN, lda, ldc, alpha);
+            } else {
+                RowsHandled = MlasSgemmKernelAdd(a, PanelB, c, CountK, RowsRemaining, CountN, lda, ldc, alpha);
+            }
+#endif
+
+            c += ldc * RowsHandled;
+            a += lda * RowsHandled;
+
+            RowsRemaining -= RowsHandled;
+
+        } while (RowsRemaining > 0);
+
+    } else {
+
+        const float* a = A;
+
+        do {
+
+            //
+            // Transpose elements from matrix A into a local buffer.
+            //
+
+            size_t RowsTransposed = RowsRemaining;
+
+            if (RowsTransposed > MLAS_SGEMM_TRANSA_ROWS) {
+                RowsTransposed = MLAS_SGEMM_TRANSA_ROWS;
+            }
+
+            RowsRemaining -= RowsTransposed;
+
+            MlasSgemmTransposeA(PanelA, a, lda, RowsTransposed, CountK);
+
+            a += RowsTransposed;
+
+            //
+            // Step through the rows of the local buffer.
+            //
+
+            const float* pa = PanelA;
+
+            do {
+
+#if defined(MLAS_TARGET_AMD64_IX86)
+                RowsHandled = SgemmKernelRoutine(pa, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha);
+#else
+                if (UseKernelZeroRoutine) {
+                    RowsHandled = MlasSgemmKernelZero(pa, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha);
+                } else {
+                    RowsHandled = MlasSgemmKernelAdd(pa, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha);
+                }
+#endif
+
+                c += ldc * RowsHandled;
+                pa += CountK * RowsHandled;
+
+                RowsTransposed -= RowsHandled;
+
+            } while (RowsTransposed > 0);
+
+        } while (RowsRemaining > 0);
+    }
+}
+
 void
 MlasSgemmOperation(
     CBLAS_TRANSPOSE TransA,
@@ -932,101 +1119,136 @@ Return Value:
             }
 
             //
-            // Select the kernel routine to use for this panel.
+            // Multiply the panel of matrix B with the matching slice of
+            // matrix A.
             //
 
-            bool UseKernelZeroRoutine = (k == 0 && beta == 0.0f);
+            const float* a = (TransA == CblasNoTrans) ? A + k : A + k * lda;
 
-#if defined(MLAS_TARGET_AMD64_IX86)
-            PMLAS_SGEMM_KERNEL_ROUTINE SgemmKernelRoutine =
-                UseKernelZeroRoutine ? MlasPlatform.KernelZeroRoutine : MlasPlatform.KernelAddRoutine;
-#endif
+            MlasSgemmMultiplyPanelB(TransA, M, CountN, CountK, alpha, a, lda,
+                PanelB, PanelA, k == 0 && beta == 0.0f, C + n, ldc);
+        }
+    }
+}
 
-            //
-            // Step through each slice of matrix A along the M dimension.
-            //
+void
+MlasSgemmPackedOperation(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t StartN,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const float* PackedB,
+    size_t AlignedN,
+    float beta,
+    float* C,
+    size_t ldc
+    )
+/*++
 
-            float* c = C + n;
+Routine Description:
 
-            size_t RowsRemaining = M;
-            size_t RowsHandled;
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) for a range of columns of a matrix B that was packed by
+    MlasSgemmPackB.
 
-            if (TransA == CblasNoTrans) {
+Arguments:
 
-                const float* a = A + k;
+    TransA - Supplies the transpose operation for matrix A.
 
-                //
-                // Step through the rows of matrix A.
-                //
+    M - Supplies the number of rows of matrix A and matrix C.
 
-                do {
+    StartN - Supplies the first column of the packed matrix B to multiply.
+        This must be a multiple of 16.
 
-#if defined(MLAS_TARGET_AMD64_IX86)
-                    RowsHandled = SgemmKernelRoutine(a, PanelB, c, CountK, RowsRemaining, CountN, lda, ldc, alpha);
-#else
-                    if (UseKernelZeroRoutine) {
-                        RowsHandled = MlasSgemmKernelZero(a, PanelB, c, CountK, RowsRemaining, CountN, lda, ldc, alpha);
-                    } else {
-                        RowsHandled = MlasSgemmKernelAdd(a, PanelB, c, CountK, RowsRemaining, CountN, lda, ldc, alpha);
-                    }
-#endif
+    N - Supplies the number of columns of the packed matrix B to multiply.
 
-                    c += ldc * RowsHandled;
-                    a += lda * RowsHandled;
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
 
-                    RowsRemaining -= RowsHandled;
+    alpha - Supplies the scaler alpha multiplier (see SGEMM definition).
 
-                } while (RowsRemaining > 0);
+    A - Supplies the address of matrix A.
 
-            } else {
+    lda - Supplies the first dimension of matrix A.
 
-                const float* a = A + k * lda;
+    PackedB - Supplies the aligned address of the packed matrix B.
 
-                do {
+    AlignedN - Supplies the number of columns of the packed matrix B, rounded
+        up to a multiple of 16.
 
-                    //
-                    // Transpose elements from matrix A into a local buffer.
-                    //
+    beta - Supplies the scaler beta multiplier (see SGEMM definition).
 
-                    size_t RowsTransposed = RowsRemaining;
+    C - Supplies the address of matrix C for column StartN.
 
-                    if (RowsTransposed > MLAS_SGEMM_TRANSA_ROWS) {
-                        RowsTransposed = MLAS_SGEMM_TRANSA_ROWS;
-                    }
+    ldc - Supplies the first dimension of matrix C.
 
-                    RowsRemaining -= RowsTransposed;
+Return Value:
 
-                    MlasSgemmTransposeA(PanelA, a, lda, RowsTransposed, CountK);
+    None.
 
-                    a += RowsTransposed;
+--*/
+{
+    float PanelA[MLAS_SGEMM_TRANSA_ROWS * MLAS_SGEMM_PACKED_STRIDEK];
 
-                    //
-                    // Step through the rows of the local buffer.
-                    //
+    //
+    // The K stride is fixed by the layout of the packed buffer, so only
+    // expand the N stride if K is small.
+    //
 
-                    const float* pa = PanelA;
+    size_t StrideN = MLAS_SGEMM_PACKED_STRIDEN;
+    size_t StrideK = MLAS_SGEMM_PACKED_STRIDEK;
 
-                    do {
+    while (K > 0 && StrideK / 2 >= K) {
+        StrideN *= 2;
+        StrideK /= 2;
+    }
 
-#if defined(MLAS_TARGET_AMD64_IX86)
-                        RowsHandled = SgemmKernelRoutine(pa, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha);
-#else
-                        if (UseKernelZeroRoutine) {
-                            RowsHandled = MlasSgemmKernelZero(pa, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha);
-                        } else {
-                            RowsHandled = MlasSgemmKernelAdd(pa, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha);
-                        }
-#endif
+    //
+    // Step through each slice of matrix B along the N dimension.
+    //
+
+    size_t CountN;
+    size_t CountK;
+
+    for (size_t n = 0; n < N; n += CountN) {
+
+        CountN = StrideN;
+
+        if (CountN > (N - n)) {
+            CountN = N - n;
+        }
+
+        //
+        // Multiply the output matrix by beta as needed.
+        //
 
-                        c += ldc * RowsHandled;
-                        pa += CountK * RowsHandled;
+        if (beta != 0.0f && beta != 1.0f) {
+            MlasSgemmMultiplyBeta(C + n, M, CountN, ldc, beta);
+        }
+
+        //
+        // Step through each slice of matrix B along the K dimension. Each
+        // slice of the packed buffer holds all of the columns of matrix B for
+        // MLAS_SGEMM_PACKED_STRIDEK rows.
+        //
 
-                        RowsTransposed -= RowsHandled;
+        for (size_t k = 0; k < K; k += CountK) {
 
-                    } while (RowsTransposed > 0);
+            CountK = MLAS_SGEMM_PACKED_STRIDEK;
 
-                } while (RowsRemaining > 0);
+            if (CountK > (K - k)) {
+                CountK = K - k;
             }
+
+            const float* PanelB = PackedB + k * AlignedN + (StartN + n) * CountK;
+            const float* a = (TransA == CblasNoTrans) ? A + k : A + k * lda;
+
+            MlasSgemmMultiplyPanelB(TransA, M, CountN, CountK, alpha, a, lda,
+                PanelB, PanelA, k == 0 && beta == 0.0f, C + n, ldc);
         }
     }
 }
@@ -1059,6 +1281,14 @@ Return Value:
 
     MLAS_SGEMM_WORK_BLOCK::SEGMENT* Segment = &WorkBlock->Segments[Index];
 
+    if (WorkBlock->PackedB != nullptr) {
+        MlasSgemmPackedOperation(WorkBlock->TransA, Segment->M, Segment->StartN,
+            Segment->N, WorkBlock->K, WorkBlock->alpha, Segment->A,
+            WorkBlock->lda, WorkBlock->PackedB, WorkBlock->AlignedN,
+            WorkBlock->beta, Segment->C, WorkBlock->ldc);
+        return;
+    }
+
     MlasSgemmOperation(WorkBlock->TransA, WorkBlock->TransB, Segment->M,
         Segment->N, WorkBlock->K, WorkBlock->alpha, Segment->A, WorkBlock->lda,
         Segment->B, WorkBlock->ldb, WorkBlock->beta, Segment->C,
@@ -1078,9 +1308,11 @@ MlasSgemmTryMultithread(
     size_t lda,
     const float* B,
     size_t ldb,
+    const float* PackedB,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
     )
 /*++
 
@@ -1112,12 +1344,17 @@ Arguments:
 
     ldb - Supplies the first dimension of matrix B.
 
+    PackedB - Optionally supplies the aligned address of matrix B packed by
+        MlasSgemmPackB. If supplied, B, TransB and ldb are ignored.
+
     beta - Supplies the scaler beta multiplier (see SGEMM definition).
 
     C - Supplies the address of matrix C.
 
     ldc - Supplies the first dimension of matrix C.
 
+    ThreadPool - Optionally supplies the thread pool object to use.
+
 Return Value:
 
     Returns true if the operation was completed across multiple threads, else
@@ -1125,9 +1362,6 @@ Return Value:
 
 --*/
 {
-
-#if defined(MLAS_HAS_THREADING_SUPPORT)
-
     MLAS_SGEMM_WORK_BLOCK WorkBlock;
     int32_t TargetThreadCount;
 
@@ -1144,13 +1378,13 @@ Return Value:
         TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
     }
 
-    int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+    int32_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
 
     if (TargetThreadCount >= MaximumThreadCount) {
         TargetThreadCount = MaximumThreadCount;
     }
 
-    if (TargetThreadCount == 1) {
+    if (TargetThreadCount <= 1) {
         return false;
     }
 
@@ -1166,6 +1400,8 @@ Return Value:
     WorkBlock.ldc = ldc;
     WorkBlock.alpha = alpha;
     WorkBlock.beta = beta;
+    WorkBlock.PackedB = PackedB;
+    WorkBlock.AlignedN = (N + 15) & ~size_t(15);
 
     //
     // Segment the operation across multiple threads.
@@ -1196,8 +1432,9 @@ Return Value:
 
             WorkBlock.Segments[Index].M = M;
             WorkBlock.Segments[Index].N = CountN;
+            WorkBlock.Segments[Index].StartN = n;
             WorkBlock.Segments[Index].A = A;
-            WorkBlock.Segments[Index].B = B + n * pldb;
+            WorkBlock.Segments[Index].B = (PackedB != nullptr) ? nullptr : B + n * pldb;
             WorkBlock.Segments[Index].C = C + n;
 
             Index++;
@@ -1223,6 +1460,7 @@ Return Value:
 
             WorkBlock.Segments[Index].M = CountM;
             WorkBlock.Segments[Index].N = N;
+            WorkBlock.Segments[Index].StartN = 0;
             WorkBlock.Segments[Index].A = A + m * plda;
             WorkBlock.Segments[Index].B = B;
             WorkBlock.Segments[Index].C = C + m * ldc;
@@ -1231,34 +1469,9 @@ Return Value:
         }
     }
 
-    MlasExecuteThreaded(MlasSgemmOperationThreaded, &WorkBlock, Index);
+    MlasExecuteThreaded(MlasSgemmOperationThreaded, &WorkBlock, Index, ThreadPool);
 
     return true;
-
-#else
-
-    //
-    // No threading implementation is available.
-    //
-
-    MLAS_UNREFERENCED_PARAMETER(TransA);
-    MLAS_UNREFERENCED_PARAMETER(TransB);
-    MLAS_UNREFERENCED_PARAMETER(M);
-    MLAS_UNREFERENCED_PARAMETER(N);
-    MLAS_UNREFERENCED_PARAMETER(K);
-    MLAS_UNREFERENCED_PARAMETER(alpha);
-    MLAS_UNREFERENCED_PARAMETER(A);
-    MLAS_UNREFERENCED_PARAMETER(lda);
-    MLAS_UNREFERENCED_PARAMETER(B);
-    MLAS_UNREFERENCED_PARAMETER(ldb);
-    MLAS_UNREFERENCED_PARAMETER(beta);
-    MLAS_UNREFERENCED_PARAMETER(C);
-    MLAS_UNREFERENCED_PARAMETER(ldc);
-
-    return false;
-
-#endif
-
 }
 
 void
@@ -1276,7 +1489,8 @@ MlasSgemm(
     size_t ldb,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
     )
 /*++
 
@@ -1314,6 +1528,9 @@ Arguments:
 
     ldc - Supplies the first dimension of matrix C.
 
+    ThreadPool - Optionally supplies the thread pool object to use. If
+        nullptr, the platform default threading support is used.
+
 Return Value:
 
     None.
@@ -1325,7 +1542,481 @@ Return Value:
     // single thread based on the GEMM parameters and system configuration.
     //
 
-    if (!MlasSgemmTryMultithread(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc)) {
+    if (!MlasSgemmTryMultithread(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, nullptr, beta, C, ldc, ThreadPool)) {
         MlasSgemmOperation(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
     }
 }
+
+inline
+float*
+MlasSgemmAlignPackedB(
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine aligns the address of a buffer allocated with the size
+    returned by MlasSgemmPackBSize to the alignment of the packed panels.
+
+Arguments:
+
+    PackedB - Supplies the address of the buffer.
+
+Return Value:
+
+    Returns the aligned address of the packed matrix B.
+
+--*/
+{
+    uintptr_t Address = reinterpret_cast<uintptr_t>(PackedB);
+
+    Address = (Address + MLAS_SGEMM_PACKED_ALIGNMENT - 1) & ~uintptr_t(MLAS_SGEMM_PACKED_ALIGNMENT - 1);
+
+    return reinterpret_cast<float*>(Address);
+}
+
+size_t
+MLASCALL
+MlasSgemmPackBSize(
+    size_t N,
+    size_t K
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the size of the buffer required by MlasSgemmPackB.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+Return Value:
+
+    Returns the size in bytes of the packed buffer, including the padding
+    needed to align it.
+
+--*/
+{
+    size_t AlignedN = (N + 15) & ~size_t(15);
+
+    return AlignedN * K * sizeof(float) + MLAS_SGEMM_PACKED_ALIGNMENT;
+}
+
+void
+MLASCALL
+MlasSgemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs matrix B into the layout used by the SGEMM kernels, so
+    that a matrix B used by many SGEMM operations, such as a constant weight
+    tensor, is only packed once.
+
+    The packed buffer is organized as slices of MLAS_SGEMM_PACKED_STRIDEK rows.
+    Each slice holds every column of matrix B as 16 column wide panels, with
+    the columns past N zero-padded.
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    PackedB - Supplies the address of the buffer to receive the packed matrix.
+        The buffer must be at least MlasSgemmPackBSize(N, K) bytes and is used
+        from its first aligned address.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float* D = MlasSgemmAlignPackedB(PackedB);
+    size_t AlignedN = (N + 15) & ~size_t(15);
+
+    if (N == 0) {
+        return;
+    }
+
+    size_t CountK;
+
+    for (size_t k = 0; k < K; k += CountK) {
+
+        CountK = MLAS_SGEMM_PACKED_STRIDEK;
+
+        if (CountK > (K - k)) {
+            CountK = K - k;
+        }
+
+        if (TransB == CblasNoTrans) {
+            MlasSgemmCopyPackB(D, B + k * ldb, ldb, N, CountK);
+        } else {
+            MlasSgemmTransposePackB(D, B + k, ldb, N, CountK);
+        }
+
+        D += AlignedN * CountK;
+    }
+}
+
+void
+MLASCALL
+MlasSgemm(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) using a matrix B that was packed by MlasSgemmPackB.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scaler alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    PackedB - Supplies the address of the buffer passed to MlasSgemmPackB with
+        the same N and K.
+
+    beta - Supplies the scaler beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ThreadPool - Optionally supplies the thread pool object to use. If
+        nullptr, the platform default threading support is used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (M == 0 || N == 0) {
+        return;
+    }
+
+    const float* AlignedPackedB = MlasSgemmAlignPackedB(const_cast<void*>(PackedB));
+
+    //
+    // Try to run the operation across multiple threads or fall back to a
+    // single thread based on the GEMM parameters and system configuration.
+    //
+
+    if (!MlasSgemmTryMultithread(TransA, CblasNoTrans, M, N, K, alpha, A, lda,
+            nullptr, 0, AlignedPackedB, beta, C, ldc, ThreadPool)) {
+        MlasSgemmPackedOperation(TransA, M, 0, N, K, alpha, A, lda,
+            AlignedPackedB, (N + 15) & ~size_t(15), beta, C, ldc);
+    }
+}
+
+void
+MlasSgemmStridedBatchThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    batched SGEMM operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_SGEMM_BATCH_WORK_BLOCK* WorkBlock = (const MLAS_SGEMM_BATCH_WORK_BLOCK*)Context;
+
+    size_t TileIndex = size_t(Index) % WorkBlock->TilesPerGemm;
+    size_t BatchStart = (size_t(Index) / WorkBlock->TilesPerGemm) * WorkBlock->BatchesPerIteration;
+    size_t BatchEnd = BatchStart + WorkBlock->BatchesPerIteration;
+
+    if (BatchEnd > WorkBlock->BatchCount) {
+        BatchEnd = WorkBlock->BatchCount;
+    }
+
+    //
+    // Compute the tile of the output matrix handled by this iteration.
+    //
+
+    size_t m = 0;
+    size_t n = 0;
+    size_t CountM = WorkBlock->M;
+    size_t CountN = WorkBlock->N;
+
+    if (WorkBlock->TileStrideN < WorkBlock->N) {
+
+        n = TileIndex * WorkBlock->TileStrideN;
+
+        if (n >= WorkBlock->N) {
+            return;
+        }
+
+        CountN = WorkBlock->N - n;
+
+        if (CountN > WorkBlock->TileStrideN) {
+            CountN = WorkBlock->TileStrideN;
+        }
+
+    } else if (WorkBlock->TileStrideM < WorkBlock->M) {
+
+        m = TileIndex * WorkBlock->TileStrideM;
+
+        if (m >= WorkBlock->M) {
+            return;
+        }
+
+        CountM = WorkBlock->M - m;
+
+        if (CountM > WorkBlock->TileStrideM) {
+            CountM = WorkBlock->TileStrideM;
+        }
+    }
+
+    size_t OffsetA = (WorkBlock->TransA == CblasNoTrans) ? m * WorkBlock->lda : m;
+    size_t OffsetB = (WorkBlock->TransB == CblasNoTrans) ? n : n * WorkBlock->ldb;
+    size_t OffsetC = m * WorkBlock->ldc + n;
+
+    for (size_t batch = BatchStart; batch < BatchEnd; batch++) {
+
+        MlasSgemmOperation(WorkBlock->TransA, WorkBlock->TransB, CountM, CountN,
+            WorkBlock->K, WorkBlock->alpha,
+            WorkBlock->A + batch * WorkBlock->StrideA + OffsetA, WorkBlock->lda,
+            WorkBlock->B + batch * WorkBlock->StrideB + OffsetB, WorkBlock->ldb,
+            WorkBlock->beta, WorkBlock->C + batch * WorkBlock->StrideC + OffsetC,
+            WorkBlock->ldc);
+    }
+}
+
+void
+MLASCALL
+MlasSgemmStridedBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    size_t StrideA,
+    const float* B,
+    size_t ldb,
+    size_t StrideB,
+    float beta,
+    float* C,
+    size_t ldc,
+    size_t StrideC,
+    size_t BatchCount,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a batch of single precision matrix/matrix multiply
+    operations (SGEMM) where the matrices of each item of the batch are a
+    fixed stride apart.
+
+    The batch is executed as a single threaded operation. Batches with at
+    least as many items as target threads are divided across the threads.
+    Otherwise, each SGEMM operation is also divided into tiles.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scaler alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of the first matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    StrideA - Supplies the number of elements between each matrix A. A stride
+        of zero uses the same matrix for every item of the batch.
+
+    B - Supplies the address of the first matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    StrideB - Supplies the number of elements between each matrix B.
+
+    beta - Supplies the scaler beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of the first matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    StrideC - Supplies the number of elements between each matrix C.
+
+    BatchCount - Supplies the number of items in the batch.
+
+    ThreadPool - Optionally supplies the thread pool object to use. If
+        nullptr, the platform default threading support is used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (BatchCount == 0 || M == 0 || N == 0) {
+        return;
+    }
+
+    MLAS_SGEMM_BATCH_WORK_BLOCK WorkBlock;
+
+    WorkBlock.TransA = TransA;
+    WorkBlock.TransB = TransB;
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+    WorkBlock.alpha = alpha;
+    WorkBlock.beta = beta;
+    WorkBlock.A = A;
+    WorkBlock.lda = lda;
+    WorkBlock.StrideA = StrideA;
+    WorkBlock.B = B;
+    WorkBlock.ldb = ldb;
+    WorkBlock.StrideB = StrideB;
+    WorkBlock.C = C;
+    WorkBlock.ldc = ldc;
+    WorkBlock.StrideC = StrideC;
+    WorkBlock.BatchCount = BatchCount;
+    WorkBlock.BatchesPerIteration = BatchCount;
+    WorkBlock.TilesPerGemm = 1;
+    WorkBlock.TileStrideM = M;
+    WorkBlock.TileStrideN = N;
+
+    //
+    // Compute the number of target threads given the complexity of the whole
+    // batch. Small requests should run using the single threaded path.
+    //
+
+    double Complexity = double(M) * double(N) * double(K) * double(BatchCount);
+    int32_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (TargetThreadCount <= 1) {
+        MlasSgemmStridedBatchThreaded(&WorkBlock, 0);
+        return;
+    }
+
+    size_t Iterations;
+
+    if (BatchCount >= size_t(TargetThreadCount)) {
+
+        //
+        // Divide the batch across the threads.
+        //
+
+        WorkBlock.BatchesPerIteration = (BatchCount + TargetThreadCount - 1) / TargetThreadCount;
+
+        Iterations = (BatchCount + WorkBlock.BatchesPerIteration - 1) / WorkBlock.BatchesPerIteration;
+
+    } else {
+
+        //
+        // Divide each SGEMM operation into tiles along the larger dimension
+        // of the output matrix.
+        //
+
+        size_t TilesPerGemm = (TargetThreadCount + BatchCount - 1) / BatchCount;
+
+        WorkBlock.BatchesPerIteration = 1;
+
+        if (N > M) {
+
+            size_t StrideN = (N + TilesPerGemm - 1) / TilesPerGemm;
+
+            StrideN =
+                (StrideN + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+            WorkBlock.TileStrideN = StrideN;
+            WorkBlock.TilesPerGemm = (N + StrideN - 1) / StrideN;
+
+        } else {
+
+            size_t StrideM = (M + TilesPerGemm - 1) / TilesPerGemm;
+
+            WorkBlock.TileStrideM = StrideM;
+            WorkBlock.TilesPerGemm = (M + StrideM - 1) / StrideM;
+        }
+
+        Iterations = BatchCount * WorkBlock.TilesPerGemm;
+    }
+
+    MlasExecuteThreaded(MlasSgemmStridedBatchThreaded, &WorkBlock, int32_t(Iterations), ThreadPool);
+}
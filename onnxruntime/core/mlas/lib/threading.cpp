@@ -73,7 +73,8 @@ void
 MlasExecuteThreaded(
     MLAS_THREADED_ROUTINE ThreadedRoutine,
     void* Context,
-    int32_t Iterations
+    int32_t Iterations,
+    MLAS_THREADPOOL* ThreadPool
     )
 {
     //
@@ -85,6 +86,15 @@ MlasExecuteThreaded(
         return;
     }
 
+    //
+    // Schedule the threaded iterations using the caller supplied thread pool.
+    //
+
+    if (ThreadPool != nullptr) {
+        ThreadPool->ExecuteThreaded(ThreadedRoutine, Context, Iterations);
+        return;
+    }
+
 #if defined(MLAS_USE_WIN32_THREADPOOL)
 
     //
@@ -109,6 +109,20 @@ class Env {
   virtual common::Status FileOpenWr(const std::string& path, /*out*/ int& fd) const = 0;
   //Mainly for use with protobuf library
   virtual common::Status FileClose(int fd) const = 0;
+
+  /// Memory returned by MapFileIntoMemory. The deleter unmaps it.
+  using MappedMemoryPtr = std::unique_ptr<char, std::function<void(char*)>>;
+
+  /// \brief Gets the length of a file in bytes.
+  virtual common::Status GetFileLength(const std::string& file_path, /*out*/ size_t& length) const = 0;
+
+  /// \brief Maps 'length' bytes of a file, starting at 'offset', into memory for reading.
+  ///
+  /// The mapping is private and read-only. Its pages are read from the file on first access, and are shared
+  /// with other processes that map the same file. 'offset' doesn't need to be a multiple of the page size.
+  /// A 'length' of 0 gives a null pointer.
+  virtual common::Status MapFileIntoMemory(const std::string& file_path, size_t offset, size_t length,
+                                           /*out*/ MappedMemoryPtr& mapped_memory) const = 0;
   //This functions is always successful. It can't fail.
   virtual PIDType GetSelfPid() const = 0;
 
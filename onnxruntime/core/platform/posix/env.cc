@@ -15,6 +15,7 @@ limitations under the License.
 // Portions Copyright (c) Microsoft Corporation
 
 #include <unistd.h>
+#include <sys/mman.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
@@ -119,6 +120,50 @@ class PosixEnv : public Env {
     return Status::OK();
   }
 
+  common::Status GetFileLength(const std::string& file_path, /*out*/ size_t& length) const override {
+    struct stat buf;
+    if (0 != stat(file_path.c_str(), &buf)) {
+      return common::Status(common::SYSTEM, errno, "Failed to get the length of " + file_path);
+    }
+    length = static_cast<size_t>(buf.st_size);
+    return Status::OK();
+  }
+
+  common::Status MapFileIntoMemory(const std::string& file_path, size_t offset, size_t length,
+                                   /*out*/ MappedMemoryPtr& mapped_memory) const override {
+    mapped_memory = MappedMemoryPtr(nullptr, [](char*) {});
+    if (length == 0) {
+      return Status::OK();
+    }
+
+    size_t file_length;
+    ORT_RETURN_IF_ERROR(GetFileLength(file_path, file_length));
+    if (offset > file_length || length > file_length - offset) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Mapping ", length, " bytes at offset ", offset,
+                             " exceeds the length of ", file_path, " (", file_length, " bytes)");
+    }
+
+    int fd;
+    ORT_RETURN_IF_ERROR(FileOpenRd(file_path, fd));
+
+    // the offset of a mapping has to be a multiple of the page size
+    const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t mapped_offset = offset - offset % page_size;
+    const size_t mapped_length = length + (offset - mapped_offset);
+    void* mapped_base = mmap(nullptr, mapped_length, PROT_READ, MAP_PRIVATE, fd, static_cast<off_t>(mapped_offset));
+    const int mmap_errno = errno;
+
+    // the mapping stays valid after the file is closed
+    ORT_RETURN_IF_ERROR(FileClose(fd));
+    if (mapped_base == MAP_FAILED) {
+      return common::Status(common::SYSTEM, mmap_errno, "Failed to map " + file_path + " into memory");
+    }
+
+    mapped_memory = MappedMemoryPtr(static_cast<char*>(mapped_base) + (offset - mapped_offset),
+                                    [mapped_base, mapped_length](char*) { munmap(mapped_base, mapped_length); });
+    return Status::OK();
+  }
+
   virtual common::Status LoadDynamicLibrary(const std::string& library_filename, void** handle) const override {
     char* error_str = dlerror();  // clear any old error_str
     *handle = dlopen(library_filename.c_str(), RTLD_NOW | RTLD_LOCAL);
@@ -0,0 +1,167 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/platform/threadpool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <limits>
+#include <mutex>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+// unsupported/Eigen/CXX11/ThreadPool triggers warnings about unused parameters and
+// structure padding that are outside of our control.
+#pragma warning(disable : 4100)
+#pragma warning(disable : 4324)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#endif
+#define EIGEN_USE_THREADS
+#include "unsupported/Eigen/CXX11/ThreadPool"
+#ifdef _MSC_VER
+#pragma warning(pop)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace onnxruntime {
+namespace concurrency {
+
+namespace {
+
+// State shared between the thread issuing a ParallelFor and the helper tasks it schedules.
+// Iterations are claimed through an atomic counter so that whichever threads are available
+// (including the caller) drain the loop. Helpers that start after all iterations have been
+// claimed exit immediately, so the caller only waits for iterations that are in flight and
+// never for a helper that is still sitting in a queue. Held via shared_ptr as such helpers
+// may run after ParallelFor has returned.
+struct ParallelForState {
+  ParallelForState(int32_t total_in, const std::function<void(int32_t)>& fn_in)
+      : total(total_in), fn(fn_in) {}
+
+  void Drain() {
+    for (;;) {
+      int32_t i = next.fetch_add(1, std::memory_order_relaxed);
+      if (i >= total) {
+        return;
+      }
+
+      // the caller outlives every claimed iteration, so fn is valid here
+      try {
+        fn(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+
+      if (completed.fetch_add(1, std::memory_order_acq_rel) + 1 == total) {
+        std::lock_guard<std::mutex> lock(mutex);
+        cv.notify_all();
+      }
+    }
+  }
+
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [this]() { return completed.load(std::memory_order_acquire) == total; });
+  }
+
+  const int32_t total;
+  const std::function<void(int32_t)>& fn;
+  std::atomic<int32_t> next{0};
+  std::atomic<int32_t> completed{0};
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::exception_ptr error;
+};
+
+}  // namespace
+
+class ThreadPool::Impl : public Eigen::ThreadPool {
+ public:
+  Impl(const std::string& name, int num_threads)
+      : Eigen::ThreadPool(num_threads), name_(name) {}
+
+  const std::string& Name() const { return name_; }
+
+ private:
+  const std::string name_;
+};
+
+ThreadPool::ThreadPool(const std::string& name, int num_threads) {
+  ORT_ENFORCE(num_threads > 0, "Thread pool '", name, "' requires at least one thread. Got ", num_threads);
+  impl_ = std::make_unique<Impl>(name, num_threads);
+}
+
+ThreadPool::~ThreadPool() = default;
+
+void ThreadPool::Schedule(std::function<void()> fn) {
+  impl_->Schedule(std::move(fn));
+}
+
+void ThreadPool::ParallelFor(int32_t total, const std::function<void(int32_t)>& fn) {
+  if (total <= 0) {
+    return;
+  }
+
+  if (total == 1) {
+    fn(0);
+    return;
+  }
+
+  auto state = std::make_shared<ParallelForState>(total, fn);
+
+  // the calling thread participates, so one fewer helper than the degree of parallelism is needed
+  int32_t helpers = std::min<int32_t>(total, NumThreads() + 1) - 1;
+  for (int32_t i = 0; i < helpers; ++i) {
+    impl_->Schedule([state]() { state->Drain(); });
+  }
+
+  state->Drain();
+  state->Wait();
+
+  if (state->error) {
+    std::rethrow_exception(state->error);
+  }
+}
+
+void ThreadPool::ParallelForRange(int64_t first, int64_t last, int64_t block_size,
+                                  const std::function<void(int64_t, int64_t)>& fn) {
+  if (last <= first) {
+    return;
+  }
+
+  block_size = std::max<int64_t>(block_size, 1);
+  const int64_t num_blocks = (last - first + block_size - 1) / block_size;
+  ORT_ENFORCE(num_blocks <= std::numeric_limits<int32_t>::max(), "Too many blocks in ParallelForRange: ", num_blocks);
+
+  ParallelFor(static_cast<int32_t>(num_blocks), [first, last, block_size, &fn](int32_t block) {
+    const int64_t begin = first + block * block_size;
+    fn(begin, std::min(begin + block_size, last));
+  });
+}
+
+int ThreadPool::NumThreads() const {
+  return impl_->NumThreads();
+}
+
+int ThreadPool::CurrentThreadId() const {
+  return impl_->CurrentThreadId();
+}
+
+int32_t ThreadPool::GetMaximumThreadCount(void) {
+  return NumThreads() + 1;
+}
+
+void ThreadPool::ExecuteThreaded(PMLAS_THREADED_ROUTINE ThreadedRoutine, void* Context, int32_t Iterations) {
+  ParallelFor(Iterations, [ThreadedRoutine, Context](int32_t index) { ThreadedRoutine(Context, index); });
+}
+
+}  // namespace concurrency
+}  // namespace onnxruntime
@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "core/common/common.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+namespace concurrency {
+
+/**
+ * Intra-op thread pool shared by the parallel executor, the CPU kernels and MLAS.
+ *
+ * The pool is a work-stealing pool (each worker owns a deque and idle workers steal
+ * from their peers) so that many small tasks can be scheduled without contending on
+ * a single queue. Parallel loops executed through ParallelFor are also run by the
+ * calling thread, which makes it safe to issue a ParallelFor from a task that is
+ * itself running on the pool (e.g. a kernel scheduled by the ParallelExecutor that
+ * calls into MLAS).
+ */
+class ThreadPool final : public MLAS_THREADPOOL {
+ public:
+  /**
+   * Create a thread pool.
+   * @param name Name of the pool, used for diagnostics.
+   * @param num_threads Number of worker threads. Must be greater than zero.
+   */
+  ThreadPool(const std::string& name, int num_threads);
+
+  ~ThreadPool();
+
+  /**
+   * Schedule fn() for execution on one of the worker threads.
+   * fn must not throw; exceptions must be handled inside the task.
+   */
+  void Schedule(std::function<void()> fn);
+
+  /**
+   * Execute fn(i) for every i in [0, total), using the worker threads and the calling thread.
+   * Blocks until all iterations have completed. If any iteration throws, the first exception
+   * is rethrown on the calling thread once the loop has finished.
+   */
+  void ParallelFor(int32_t total, const std::function<void(int32_t)>& fn);
+
+  /**
+   * Partition [first, last) into blocks of at most block_size elements and execute
+   * fn(block_begin, block_end) for each block via ParallelFor.
+   */
+  void ParallelForRange(int64_t first, int64_t last, int64_t block_size,
+                        const std::function<void(int64_t, int64_t)>& fn);
+
+  /**
+   * Number of worker threads in the pool.
+   */
+  int NumThreads() const;
+
+  /**
+   * Index of the current worker thread in [0, NumThreads()), or -1 if the calling
+   * thread does not belong to this pool.
+   */
+  int CurrentThreadId() const;
+
+  // MLAS_THREADPOOL
+  int32_t GetMaximumThreadCount(void) override;
+
+  void ExecuteThreaded(PMLAS_THREADED_ROUTINE ThreadedRoutine, void* Context, int32_t Iterations) override;
+
+  /**
+   * Execute fn(i) for every i in [0, total) on pool if it is not null, otherwise serially
+   * on the calling thread.
+   */
+  static void TryParallelFor(ThreadPool* pool, int32_t total, const std::function<void(int32_t)>& fn) {
+    if (pool != nullptr) {
+      pool->ParallelFor(total, fn);
+    } else {
+      for (int32_t i = 0; i < total; ++i) {
+        fn(i);
+      }
+    }
+  }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ThreadPool);
+
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace concurrency
+}  // namespace onnxruntime
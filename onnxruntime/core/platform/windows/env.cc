@@ -134,6 +134,67 @@ class WindowsEnv : public Env {
     return Status::OK();
   }
 
+  common::Status GetFileLength(const std::string& file_path, /*out*/ size_t& length) const override {
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if (!GetFileAttributesExA(file_path.c_str(), GetFileExInfoStandard, &attributes)) {
+      return common::Status(common::SYSTEM, static_cast<int>(GetLastError()),
+                            "Failed to get the length of " + file_path);
+    }
+    length = static_cast<size_t>((static_cast<uint64_t>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow);
+    return Status::OK();
+  }
+
+  common::Status MapFileIntoMemory(const std::string& file_path, size_t offset, size_t length,
+                                   /*out*/ MappedMemoryPtr& mapped_memory) const override {
+    mapped_memory = MappedMemoryPtr(nullptr, [](char*) {});
+    if (length == 0) {
+      return Status::OK();
+    }
+
+    size_t file_length;
+    ORT_RETURN_IF_ERROR(GetFileLength(file_path, file_length));
+    if (offset > file_length || length > file_length - offset) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Mapping ", length, " bytes at offset ", offset,
+                             " exceeds the length of ", file_path, " (", file_length, " bytes)");
+    }
+
+    HANDLE file = CreateFileA(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+      return common::Status(common::SYSTEM, static_cast<int>(GetLastError()), "Failed to open " + file_path);
+    }
+
+    HANDLE file_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const DWORD create_mapping_error = GetLastError();
+    CloseHandle(file);
+    if (file_mapping == nullptr) {
+      return common::Status(common::SYSTEM, static_cast<int>(create_mapping_error),
+                            "Failed to map " + file_path + " into memory");
+    }
+
+    // the offset of a view has to be a multiple of the allocation granularity
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+    const size_t mapped_offset = offset - offset % system_info.dwAllocationGranularity;
+    const size_t mapped_length = length + (offset - mapped_offset);
+    void* mapped_base = MapViewOfFile(file_mapping, FILE_MAP_READ,
+                                      static_cast<DWORD>(static_cast<uint64_t>(mapped_offset) >> 32),
+                                      static_cast<DWORD>(mapped_offset & 0xFFFFFFFF),
+                                      mapped_length);
+    const DWORD map_view_error = GetLastError();
+
+    // the view stays valid after the mapping handle is closed
+    CloseHandle(file_mapping);
+    if (mapped_base == nullptr) {
+      return common::Status(common::SYSTEM, static_cast<int>(map_view_error),
+                            "Failed to map " + file_path + " into memory");
+    }
+
+    mapped_memory = MappedMemoryPtr(static_cast<char*>(mapped_base) + (offset - mapped_offset),
+                                    [mapped_base](char*) { UnmapViewOfFile(mapped_base); });
+    return Status::OK();
+  }
+
   virtual Status LoadDynamicLibrary(const std::string& library_filename, void** handle) const override {
     ORT_UNUSED_PARAMETER(library_filename);
     ORT_UNUSED_PARAMETER(handle);
@@ -0,0 +1,39 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include "core/common/common.h"
+#include "core/util/math_cpuonly.h"
+
+namespace onnxruntime {
+
+// whether fuse_activation supports the activation of a fused kernel. an empty activation is supported.
+inline bool is_supported_fused_activation(const std::string& activation) {
+  return activation.empty() || activation == "Relu" || activation == "Sigmoid" || activation == "Tanh" ||
+         activation == "LeakyRelu";
+}
+
+// apply the activation of a fused kernel (FusedConv, FusedGemm) in place. an empty activation does nothing.
+template <typename T>
+void fuse_activation(const std::string& activation, T* y_data, size_t size, float alpha) {
+  EigenVectorArrayMap<T> y_vec(y_data, size);
+  if (activation.empty()) {
+    return;
+  } else if (activation == "Relu") {
+    y_vec = y_vec.cwiseMax(0);
+  } else if (activation == "Sigmoid") {
+    y_vec = (y_vec >= 0).select(1 / (1. + (-y_vec.abs()).exp()), 1 - 1 / (1. + (-y_vec.abs()).exp()));
+  } else if (activation == "Tanh") {
+    y_vec = y_vec.tanh();
+  } else if (activation == "LeakyRelu") {
+    y_vec = (y_vec >= 0).select(y_vec, (T)alpha * y_vec);
+  } else {
+    ORT_NOT_IMPLEMENTED("Not implemented fused activation: ", activation);
+  }
+}
+
+}  // namespace onnxruntime
+
@@ -9,6 +9,7 @@
 #include "core/framework/session_state.h"
 
 #include "core/framework/tensorprotoutils.h"
+#include "core/providers/cpu/controlflow/utils.h"
 // #include "core/providers/cpu/tensor/utils.h"
 
 using namespace ONNX_NAMESPACE;
@@ -150,10 +151,8 @@ Status IfImpl::AllocateOutputTensors() {
 
     TensorShape output_shape{onnxruntime::utils::GetTensorShapeFromTensorShapeProto(*graph_output_shape)};
 
-    // TODO: Task 1913: Improve handling of If outputs to avoid copy when the shape is not known
-    //       at subgraph execution time.
-    //
-    // if size < 0 we have a symbolic dimension and need to use a temporary MLValue in the subgraph execution
+    // if size < 0 we have a symbolic dimension and need to use a temporary MLValue in the subgraph execution.
+    // the subgraph allocates it once the shape is known, and it is forwarded as the If output after execution.
     if (output_shape.Size() < 0) {
       outputs_.push_back({AllocationType::Temporary, {}});
     } else {
@@ -204,14 +203,14 @@ Status IfImpl::Execute() {
   status = executor.Execute(session_state_, feeds, subgraph_output_names_, fetches, context_.Logger());
   ORT_RETURN_IF_ERROR(status);
 
+  controlflow::detail::OuterScopeBuffers outer_scope_buffers{implicit_inputs_, session_state_};
+
   for (int i = 0; i < num_outputs_; ++i) {
-    // TODO: Task 1913: Improve handling of If outputs to avoid copy when the shape is not known
-    //       at subgraph execution time.
     if (outputs_[i].first == AllocationType::Temporary) {
-      // need to allocate If output and copy MLValue from fetches
-      auto& data = fetches[i].Get<Tensor>();
-      Tensor* output = context_.Output(i, data.Shape());
-      memcpy(output->MutableDataRaw(), data.DataRaw(), data.Size());
+      // share the Tensor the subgraph allocated with the If output. it's only copied if it could be modified
+      // in-place by a downstream node while still being used elsewhere.
+      status = controlflow::detail::ForwardOrCopyToOutput(context_, i, fetches[i], outer_scope_buffers);
+      ORT_RETURN_IF_ERROR(status);
     }
   }
 
@@ -11,12 +11,14 @@
 
 #include "core/providers/cpu/controlflow/loop.h"
 
+#include "core/framework/execution_frame.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/sequential_executor.h"
 #include "core/framework/session_state.h"
 #include "core/framework/tensorprotoutils.h"
 
+#include "core/providers/cpu/controlflow/utils.h"
 #include "core/providers/cpu/tensor/utils.h"
 
 #include "gsl/gsl_algorithm"
@@ -99,8 +101,13 @@ class LoopImpl {
   Status Execute();
 
  private:
-  NameMLValMap CreateInitialFeeds();
-  void UpdateFeeds(const std::vector<MLValue>& last_output, NameMLValMap& next_input);
+  Status CreateFeedAndFetchIndices();
+  void CreateLoopCarriedVarBuffers();
+
+  std::vector<MLValue> CreateInitialFeeds();
+  void UpdateFeeds(const std::vector<MLValue>& last_output, std::vector<MLValue>& next_input);
+  void SetupFetches(int64_t iter_num, std::vector<MLValue>& fetches);
+  void CopyFetchesUsingBuffers(std::vector<MLValue>& fetches);
 
   // create the single Loop output from a collection of per-iteration outputs
   Status ConcatenateLoopOutput(std::vector<MLValue>& per_iteration_output, int output_index);
@@ -121,8 +128,15 @@ class LoopImpl {
   MLValue iter_num_mlvalue_;
   MLValue condition_mlvalue_;
 
-  std::vector<std::string> subgraph_input_names_;
-  std::vector<std::string> subgraph_output_names_;
+  // MLValue indices in the subgraph for the feeds (subgraph inputs followed by implicit inputs) and fetches
+  std::vector<int> feed_mlvalue_idxs_;
+  std::vector<int> fetch_mlvalue_idxs_;
+
+  // two buffers for each loop carried variable that alternate as the subgraph input and output, so the variable
+  // is updated without allocating a new Tensor in every iteration. empty if the subgraph output shape isn't known.
+  std::vector<std::pair<MLValue, MLValue>> loop_carried_var_buffers_;
+
+  AllocatorPtr allocator_;
 
   // collection of MLValue outputs from each loop iteration for the loop outputs.
   // the order from the subgraph matches the order from the loop output
@@ -161,22 +175,26 @@ LoopImpl::LoopImpl(OpKernelContextInternal& context,
   num_outputs_ = context_.OutputCount();
 }
 
-template <typename T>
-static MLValue MakeScalarMLValue(AllocatorPtr& allocator, T value) {
-  auto* data_type = DataTypeImpl::GetType<T>();
-  std::unique_ptr<Tensor> p_tensor = std::make_unique<Tensor>(data_type,
-                                                              TensorShape({1}),
-                                                              allocator->Alloc(data_type->Size()),
-                                                              allocator->Info(),
-                                                              allocator);
-
-  *p_tensor->MutableData<T>() = value;
+static MLValue AllocateTensorInMLValue(MLDataType data_type, const TensorShape& shape, AllocatorPtr& allocator) {
+  auto p_tensor = std::make_unique<Tensor>(data_type,
+                                           shape,
+                                           allocator->Alloc(shape.Size() * data_type->Size()),
+                                           allocator->Info(),
+                                           allocator);
 
   return MLValue{p_tensor.release(),
                  DataTypeImpl::GetType<Tensor>(),
                  DataTypeImpl::GetType<Tensor>()->GetDeleteFunc()};
 }
 
+template <typename T>
+static MLValue MakeScalarMLValue(AllocatorPtr& allocator, T value) {
+  MLValue mlvalue = AllocateTensorInMLValue(DataTypeImpl::GetType<T>(), TensorShape({1}), allocator);
+  *mlvalue.GetMutable<Tensor>()->MutableData<T>() = value;
+
+  return mlvalue;
+}
+
 Status LoopImpl::Initialize() {
   auto status = Status::OK();
 
@@ -201,61 +219,122 @@ Status LoopImpl::Initialize() {
                                    " but has ", num_subgraph_outputs);
   }
 
-  AllocatorPtr allocator;
-  status = context_.GetTempSpaceAllocator(&allocator);
+  status = context_.GetTempSpaceAllocator(&allocator_);
   ORT_RETURN_IF_ERROR(status);
 
-  condition_mlvalue_ = MakeScalarMLValue<bool>(allocator, condition_);
-  iter_num_mlvalue_ = MakeScalarMLValue<int64_t>(allocator, 0);
+  condition_mlvalue_ = MakeScalarMLValue<bool>(allocator_, condition_);
+  iter_num_mlvalue_ = MakeScalarMLValue<int64_t>(allocator_, 0);
+
+  loop_output_tensors_.resize(num_outputs_ - num_loop_carried_vars_);
+
+  status = CreateFeedAndFetchIndices();
+  ORT_RETURN_IF_ERROR(status);
+
+  CreateLoopCarriedVarBuffers();
+
+  return status;
+}
+
+// resolve the names of the subgraph feeds and fetches to MLValue indices once, rather than in every iteration.
+// the Loop inputs and outputs match the order of the subgraph inputs and outputs.
+Status LoopImpl::CreateFeedAndFetchIndices() {
+  auto& mlvalue_name_idx_map = session_state_.GetMLValueNameIdxMap();
+  int idx;
 
-  subgraph_input_names_.reserve(num_subgraph_inputs_);
-  for (size_t i = 0; i < num_subgraph_inputs_; ++i) {
-    subgraph_input_names_.push_back(subgraph_inputs[i]->Name());
+  feed_mlvalue_idxs_.reserve(num_subgraph_inputs_ + implicit_inputs_.size());
+  for (auto* input : subgraph_.GetInputs()) {
+    ORT_RETURN_IF_ERROR(mlvalue_name_idx_map.GetIdx(input->Name(), idx));
+    feed_mlvalue_idxs_.push_back(idx);
   }
 
-  subgraph_output_names_.reserve(num_subgraph_outputs);
-  loop_output_tensors_.resize(num_outputs_ - num_loop_carried_vars_);
+  for (auto& entry : implicit_inputs_) {
+    ORT_RETURN_IF_ERROR(mlvalue_name_idx_map.GetIdx(entry.first, idx));
+    feed_mlvalue_idxs_.push_back(idx);
+  }
 
-  // save list of subgraph output names in their provided order to use when fetching the results
-  // from each subgraph execution. the Loop outputs will match this order.
-  for (size_t i = 0; i < num_subgraph_outputs; ++i) {
-    auto& output = subgraph_outputs[i];
-    subgraph_output_names_.push_back(output->Name());
+  auto& subgraph_outputs = subgraph_.GetOutputs();
+  fetch_mlvalue_idxs_.reserve(subgraph_outputs.size());
+  for (auto* output : subgraph_outputs) {
+    ORT_RETURN_IF_ERROR(mlvalue_name_idx_map.GetIdx(output->Name(), idx));
+    fetch_mlvalue_idxs_.push_back(idx);
   }
 
-  return status;
+  return Status::OK();
+}
+
+void LoopImpl::CreateLoopCarriedVarBuffers() {
+  auto& subgraph_outputs = subgraph_.GetOutputs();
+  auto& initializers = session_state_.GetInitializedTensors();
+
+  loop_carried_var_buffers_.resize(num_loop_carried_vars_);
+
+  for (int i = 0; i < num_loop_carried_vars_; ++i) {
+    auto fetch_idx = fetch_mlvalue_idxs_[i + 1];  // skip cond
+
+    // the output must be produced by a node in the subgraph rather than being a subgraph input or initializer,
+    // and must not also be used for another output.
+    if (std::find(feed_mlvalue_idxs_.cbegin(), feed_mlvalue_idxs_.cend(), fetch_idx) != feed_mlvalue_idxs_.cend() ||
+        initializers.find(fetch_idx) != initializers.cend() ||
+        std::count(fetch_mlvalue_idxs_.cbegin(), fetch_mlvalue_idxs_.cend(), fetch_idx) > 1) {
+      continue;
+    }
+
+    // and the output shape must be known and match the input, so the buffers can be allocated ahead of time.
+    auto* output_shape_proto = subgraph_outputs[i + 1]->Shape();
+    if (!output_shape_proto) {
+      continue;
+    }
+
+    auto& input = *context_.Input<Tensor>(i + 2);  // skip 'M' and 'cond'
+    if (input.DataType() == DataTypeImpl::GetType<std::string>()) {
+      continue;
+    }
+
+    TensorShape output_shape{onnxruntime::utils::GetTensorShapeFromTensorShapeProto(*output_shape_proto)};
+    if (output_shape != input.Shape()) {
+      continue;
+    }
+
+    auto& buffers = loop_carried_var_buffers_[i];
+    buffers.first = AllocateTensorInMLValue(input.DataType(), output_shape, allocator_);
+
+    // the second buffer is only used from the second iteration on
+    if (max_trip_count_ > 1) {
+      buffers.second = AllocateTensorInMLValue(input.DataType(), output_shape, allocator_);
+    }
+  }
 }
 
-NameMLValMap LoopImpl::CreateInitialFeeds() {
-  NameMLValMap feeds;
+std::vector<MLValue> LoopImpl::CreateInitialFeeds() {
+  std::vector<MLValue> feeds;
 
   feeds.reserve(num_subgraph_inputs_ + implicit_inputs_.size());
 
-  feeds[subgraph_input_names_[0]] = iter_num_mlvalue_;
-  feeds[subgraph_input_names_[1]] = condition_mlvalue_;
+  feeds.push_back(iter_num_mlvalue_);
+  feeds.push_back(condition_mlvalue_);
 
   // populate loop carried var inputs which conveniently start at slot 2 in both the Loop and subgraph inputs
   for (int i = 2; i < num_subgraph_inputs_; ++i) {
-    feeds[subgraph_input_names_[i]] = *context_.GetInputMLValue(i);
+    feeds.push_back(*context_.GetInputMLValue(i));
   }
 
   // pass in implicit inputs as feeds.
   for (auto& entry : implicit_inputs_) {
     ORT_ENFORCE(entry.second, "All implicit inputs should have MLValue instances by now. ",
-                        entry.first, " did not.");
-    feeds[entry.first] = *entry.second;
+                entry.first, " did not.");
+    feeds.push_back(*entry.second);
   }
 
   return feeds;
 }
 
-void LoopImpl::UpdateFeeds(const std::vector<MLValue>& last_output, NameMLValMap& next_input) {
+void LoopImpl::UpdateFeeds(const std::vector<MLValue>& last_output, std::vector<MLValue>& next_input) {
   // last_output: cond, loop vars..., loop output...
   // next_input: iter_num, cond, loop_vars. iter_num is re-used
 
   // simple copy for cond and loop carried vars.
   for (int i = 1; i < num_subgraph_inputs_; ++i) {
-    next_input[subgraph_input_names_[i]] = last_output[i - 1];  // skip iter_num in input
+    next_input[i] = last_output[i - 1];  // skip iter_num in input
   }
 
   // save loop outputs as we have to concatenate at the end
@@ -264,6 +343,58 @@ void LoopImpl::UpdateFeeds(const std::vector<MLValue>& last_output, NameMLValMap
   }
 }
 
+void LoopImpl::SetupFetches(int64_t iter_num, std::vector<MLValue>& fetches) {
+  // the subgraph allocates all the outputs other than the loop carried variables with buffers
+  for (auto& fetch : fetches) {
+    fetch = MLValue();
+  }
+
+  // alternate between the two buffers so the input to this iteration is not overwritten.
+  // the input to the first iteration is the Loop input, so that can use either one.
+  for (int i = 0; i < num_loop_carried_vars_; ++i) {
+    auto& buffers = loop_carried_var_buffers_[i];
+    if (buffers.first.IsAllocated()) {
+      fetches[i + 1] = iter_num % 2 == 0 ? buffers.first : buffers.second;  // skip cond
+    }
+  }
+}
+
+void LoopImpl::CopyFetchesUsingBuffers(std::vector<MLValue>& fetches) {
+  std::vector<const void*> buffers;
+  for (auto& entry : loop_carried_var_buffers_) {
+    if (entry.first.IsAllocated()) {
+      buffers.push_back(entry.first.Get<Tensor>().DataRaw());
+    }
+
+    if (entry.second.IsAllocated()) {
+      buffers.push_back(entry.second.Get<Tensor>().DataRaw());
+    }
+  }
+
+  if (buffers.empty()) {
+    return;
+  }
+
+  // a fetch other than the one a buffer was provided for can share that buffer via a node such as Identity.
+  // copy it, as the buffer is overwritten when it is used as the output of a later iteration.
+  for (size_t i = 0; i < fetches.size(); ++i) {
+    bool is_loop_carried_var_with_buffers = i > 0 && i <= static_cast<size_t>(num_loop_carried_vars_) &&
+                                            loop_carried_var_buffers_[i - 1].first.IsAllocated();
+
+    auto& fetch = fetches[i];
+    if (is_loop_carried_var_with_buffers || !fetch.IsAllocated() || !fetch.IsTensor()) {
+      continue;
+    }
+
+    auto& tensor = fetch.Get<Tensor>();
+    if (std::find(buffers.cbegin(), buffers.cend(), tensor.DataRaw()) != buffers.cend()) {
+      MLValue copy = AllocateTensorInMLValue(tensor.DataType(), tensor.Shape(), allocator_);
+      memcpy(copy.GetMutable<Tensor>()->MutableDataRaw(), tensor.DataRaw(), tensor.Size());
+      fetch = copy;
+    }
+  }
+}
+
 Status LoopImpl::ConcatenateLoopOutput(std::vector<MLValue>& per_iteration_output, int output_index) {
   const auto& first_output = per_iteration_output.front().Get<Tensor>();
   size_t bytes_per_iteration = first_output.Size();
@@ -305,40 +436,51 @@ Status LoopImpl::ConcatenateLoopOutput(std::vector<MLValue>& per_iteration_outpu
 Status LoopImpl::Execute() {
   auto status = Status::OK();
 
-  NameMLValMap feeds{CreateInitialFeeds()};
-  std::vector<MLValue> fetches;
+  std::vector<MLValue> feeds{CreateInitialFeeds()};
+  std::vector<MLValue> fetches(fetch_mlvalue_idxs_.size());
+
+  // the frame is created on the first iteration and reset for each subsequent one
+  std::unique_ptr<ExecutionFrame> frame;
 
   auto& iter_num_value = *iter_num_mlvalue_.GetMutable<Tensor>()->MutableData<int64_t>();
 
   while (iter_num_value < max_trip_count_ && *condition_mlvalue_.GetMutable<Tensor>()->MutableData<bool>()) {
     if (iter_num_value != 0) {
       UpdateFeeds(fetches, feeds);
-      fetches.clear();
+    }
+
+    SetupFetches(iter_num_value, fetches);
+
+    if (frame) {
+      frame->Reset(feeds, fetches);
+    } else {
+      frame = std::make_unique<ExecutionFrame>(feed_mlvalue_idxs_, feeds, fetch_mlvalue_idxs_, fetches,
+                                               session_state_);
     }
 
     SequentialExecutor executor{context_.GetTerminateFlag()};
-    status = executor.Execute(session_state_, feeds, subgraph_output_names_, fetches, context_.Logger());
+    status = executor.Execute(session_state_, *frame, fetches, context_.Logger());
     ORT_RETURN_IF_ERROR(status);
 
+    CopyFetchesUsingBuffers(fetches);
+
     condition_mlvalue_ = fetches[0];
 
     ++iter_num_value;
   }
 
-  // TODO: Task 1913: Improve handling of If and Loop outputs to avoid copy
-  auto copy_tensor_from_mlvalue_to_output = [this](const MLValue& input, int output_idx) {
-    auto& data = input.Get<Tensor>();
-    Tensor* output = context_.Output(output_idx, data.Shape());
-    auto src = gsl::make_span<const gsl::byte>(static_cast<const gsl::byte*>(data.DataRaw()), data.Size());
-    auto dst = gsl::make_span<gsl::byte>(static_cast<gsl::byte*>(output->MutableDataRaw()), output->Size());
-    gsl::copy(src, dst);
-  };
-
-  // copy to Loop output
   if (iter_num_value != 0) {
+    // values created by the subgraph are forwarded to the Loop output. anything that could also be referenced
+    // outside of the Loop, such as a Loop input passed straight through the subgraph, is copied.
+    controlflow::detail::OuterScopeBuffers outer_scope_buffers{implicit_inputs_, session_state_};
+    for (int i = 2; i < num_subgraph_inputs_; ++i) {
+      outer_scope_buffers.Add(*context_.GetInputMLValue(i));
+    }
+
     for (int i = 0; i < num_loop_carried_vars_; ++i) {
-      // need to allocate Loop output and copy MLValue from fetches
-      copy_tensor_from_mlvalue_to_output(fetches[i + 1], i);  // skip cond
+      // skip cond
+      status = controlflow::detail::ForwardOrCopyToOutput(context_, i, fetches[i + 1], outer_scope_buffers);
+      ORT_RETURN_IF_ERROR(status);
     }
 
     for (int i = num_loop_carried_vars_; i < num_outputs_; ++i) {
@@ -346,13 +488,16 @@ Status LoopImpl::Execute() {
       auto& per_iteration_outputs = loop_output_tensors_[i - num_loop_carried_vars_];
       per_iteration_outputs.push_back(fetches[i + 1]);  // skip cond
 
+      // the number of iterations isn't known until the loop completes, so the per-iteration outputs are
+      // concatenated into the Loop output at the end.
       ORT_RETURN_IF_ERROR(ConcatenateLoopOutput(per_iteration_outputs, i));
     }
   } else {
     // no iterations.
     // copy input loop carried vars to output.
     for (int i = 0; i < num_loop_carried_vars_; ++i) {
-      copy_tensor_from_mlvalue_to_output(feeds[subgraph_input_names_[i + 2]], i);  // skip iter# and cond
+      status = controlflow::detail::CopyToOutput(context_, i, feeds[i + 2]);  // skip iter# and cond
+      ORT_RETURN_IF_ERROR(status);
     }
 
     // create empty outputs for loop outputs
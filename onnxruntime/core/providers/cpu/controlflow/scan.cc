@@ -10,12 +10,16 @@
 #endif
 #include "core/providers/cpu/controlflow/scan.h"
 
+#include <atomic>
+
+#include "core/framework/execution_frame.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/mlvalue_tensor_slicer.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/sequential_executor.h"
 #include "core/framework/session_state.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/platform/threadpool.h"
 
 #include "core/providers/cpu/tensor/utils.h"
 
@@ -146,6 +150,15 @@ class OutputIterator {
     return iterator->Initialize();
   }
 
+  // Create an iterator over the sequence of a single batch entry of a scan output that writes directly to
+  // the slice of the overall output buffer. The shape of all_batches must be concrete.
+  // Iterators for different batch entries can be used concurrently.
+  static Status Create(const OutputIterator& all_batches,
+                       int64_t batch_index,
+                       std::unique_ptr<OutputIterator>& iterator);
+
+  bool IsConcreteShape() const { return is_concrete_shape_; }
+
   MLValue& operator*();
   OutputIterator& operator++();
 
@@ -187,6 +200,36 @@ class OutputIterator {
   MLValue* final_output_mlvalue_;
 };
 
+/*
+Class that holds the feeds and fetches for a call to the subgraph, and the ExecutionFrame used to execute it.
+The feeds and fetches are resolved to MLValue indices once by ScanImpl. The frame is created on the first call and
+reset for each subsequent call, so the node argument layout and memory pattern are not re-created for every item
+in the sequence. Each thread processing batch entries uses its own instance.
+*/
+class SubgraphFrame {
+ public:
+  SubgraphFrame(const SessionState& session_state,
+                const std::vector<int>& feed_mlvalue_idxs,
+                const std::vector<int>& fetch_mlvalue_idxs,
+                const std::vector<MLValue>& implicit_inputs);
+
+  // the feeds for the subgraph inputs followed by the implicit inputs, which are set by the constructor
+  std::vector<MLValue>& Feeds() { return feeds_; }
+  std::vector<MLValue>& Fetches() { return fetches_; }
+
+  Status Execute(const bool& terminate_flag, const logging::Logger& logger);
+
+ private:
+  const SessionState& session_state_;
+  const std::vector<int>& feed_mlvalue_idxs_;
+  const std::vector<int>& fetch_mlvalue_idxs_;
+
+  std::vector<MLValue> feeds_;
+  std::vector<MLValue> fetches_;
+
+  std::unique_ptr<ExecutionFrame> frame_;
+};
+
 class ScanImpl {
  public:
   ScanImpl(OpKernelContextInternal& context,
@@ -210,13 +253,28 @@ class ScanImpl {
   Status AllocateOutput(int index, bool is_loop_state_var);
   Status AllocateOutputTensors();
   Status CreateLoopStateVariables(std::vector<std::vector<LoopStateVariable>>& loop_state_variables);
+  Status CreateFeedAndFetchIndices();
+  Status CreateBatchOutputIterators(int64_t batch_index,
+                                    std::vector<std::unique_ptr<OutputIterator>>& output_iterators) const;
 
   using ConstTensorSlicerIterators = std::vector<MLValueTensorSlicer<const MLValue>::Iterator>;
   using MutableTensorSlicerIterators = std::vector<MLValueTensorSlicer<MLValue>::Iterator>;
+  using OutputIterators = std::vector<std::unique_ptr<OutputIterator>>;
+
+  SubgraphFrame CreateSubgraphFrame() const;
+
+  // run the subgraph for each item in the sequence of one batch entry.
+  // output_iterators contains an entry for every output, however only the scan output entries are used.
+  Status ExecuteBatchEntry(int64_t batch_index,
+                           std::vector<LoopStateVariable>& loop_state_variables,
+                           OutputIterators& output_iterators,
+                           SubgraphFrame& frame) const;
 
   Status IterateSequence(std::vector<LoopStateVariable>& loop_state_variables,
                          ConstTensorSlicerIterators& scan_input_stream_iterators,
-                         int64_t seq_length);
+                         OutputIterators& output_iterators,
+                         int64_t seq_length,
+                         SubgraphFrame& frame) const;
 
   OpKernelContextInternal& context_;
   const SessionState& session_state_;
@@ -234,9 +292,14 @@ class ScanImpl {
   std::vector<int64_t> sequence_lens_;
 
   std::vector<std::string> subgraph_output_names_;
-  std::vector<std::unique_ptr<OutputIterator>> output_iterators_;
+  OutputIterators output_iterators_;
 
   std::unordered_map<std::string, const MLValue*> implicit_inputs_;
+
+  // MLValue indices in the subgraph for the feeds (subgraph inputs followed by implicit inputs) and fetches
+  std::vector<int> feed_mlvalue_idxs_;
+  std::vector<int> fetch_mlvalue_idxs_;
+  std::vector<MLValue> implicit_input_values_;
 };
 
 Status Scan::Compute(OpKernelContext* ctx) const {
@@ -244,10 +307,6 @@ Status Scan::Compute(OpKernelContext* ctx) const {
   auto* session_state = ctx_internal->SubgraphSessionState("body");
   ORT_ENFORCE(session_state, "Subgraph SessionState was not found for 'body' attribute.");
 
-  // TODO:
-  //       Consider how usage of ExecutionFrame and SequentialExecutor can be optimized
-  //         - initial implementation is focused on making it work, rather than optimizing.
-
   ScanImpl scan_impl{*ctx_internal, *session_state, num_scan_inputs_, directions_};
 
   auto status = scan_impl.Initialize();
@@ -273,8 +332,7 @@ LoopStateVariable::LoopStateVariable(const MLValue& original_value,
   // the MLValue returned by Input()/Output() gets copied into the execution frame feeds/fetches
   // with the Tensor being used via a shared_ptr (so remains valid during execution and is cleaned up
   // automatically at the end).
-  // TODO: Could allocate one large chunk for all the loop state variable buffers in ScanImpl, although that
-  // may make it harder to parallelize processing of the batch in the future.
+  // each batch entry has its own buffers so the batch entries can be processed in parallel.
   auto allocate_tensor_in_mlvalue = [&]() {
     auto new_tensor = std::make_unique<Tensor>(tensor.DataType(),
                                                shape,
@@ -432,6 +490,24 @@ Status OutputIterator::MakeConcrete() {
   return status;
 }
 
+Status OutputIterator::Create(const OutputIterator& all_batches,
+                              int64_t batch_index,
+                              std::unique_ptr<OutputIterator>& iterator) {
+  ORT_ENFORCE(!all_batches.is_loop_state_var_ && all_batches.is_concrete_shape_,
+              "A batch entry iterator requires a scan output with a concrete shape.");
+
+  iterator.reset(new OutputIterator(all_batches.context_, all_batches.output_index_, false, all_batches.final_shape_));
+
+  // only iterate the sequence dimension for the one batch entry
+  iterator->num_iterations_ = all_batches.final_shape_[1];
+  iterator->final_output_mlvalue_ = all_batches.final_output_mlvalue_;
+  iterator->slicer_iterators_.push_back(
+      MLValueTensorSlicer<MLValue>::Create(*all_batches.final_output_mlvalue_, 1, batch_index).begin());
+  iterator->cur_slicer_iterator_ = iterator->slicer_iterators_.begin();
+
+  return Status::OK();
+}
+
 MLValue& OutputIterator::operator*() {
   ORT_ENFORCE(cur_iteration_ < num_iterations_);
 
@@ -462,6 +538,31 @@ OutputIterator& OutputIterator::operator++() {
   return *this;
 }
 
+SubgraphFrame::SubgraphFrame(const SessionState& session_state,
+                             const std::vector<int>& feed_mlvalue_idxs,
+                             const std::vector<int>& fetch_mlvalue_idxs,
+                             const std::vector<MLValue>& implicit_inputs)
+    : session_state_{session_state},
+      feed_mlvalue_idxs_{feed_mlvalue_idxs},
+      fetch_mlvalue_idxs_{fetch_mlvalue_idxs},
+      feeds_(feed_mlvalue_idxs.size()),
+      fetches_(fetch_mlvalue_idxs.size()) {
+  // the implicit inputs are the same for every call so set them once
+  std::copy(implicit_inputs.cbegin(), implicit_inputs.cend(), feeds_.end() - implicit_inputs.size());
+}
+
+Status SubgraphFrame::Execute(const bool& terminate_flag, const logging::Logger& logger) {
+  if (frame_) {
+    frame_->Reset(feeds_, fetches_);
+  } else {
+    frame_ = std::make_unique<ExecutionFrame>(feed_mlvalue_idxs_, feeds_, fetch_mlvalue_idxs_, fetches_,
+                                              session_state_);
+  }
+
+  SequentialExecutor executor{terminate_flag};
+  return executor.Execute(session_state_, *frame_, fetches_, logger);
+}
+
 ScanImpl::ScanImpl(OpKernelContextInternal& context,
                    const SessionState& session_state,
                    int64_t num_scan_inputs,
@@ -493,12 +594,50 @@ Status ScanImpl::Initialize() {
     subgraph_output_names_.push_back(output->Name());
   }
 
+  status = CreateFeedAndFetchIndices();
+  ORT_RETURN_IF_ERROR(status);
+
   status = AllocateOutputTensors();
   ORT_RETURN_IF_ERROR(status);
 
   return Status::OK();
 }
 
+// resolve the names of the subgraph feeds and fetches to MLValue indices once, rather than on every call
+Status ScanImpl::CreateFeedAndFetchIndices() {
+  auto& mlvalue_name_idx_map = session_state_.GetMLValueNameIdxMap();
+  auto& graph_inputs = subgraph_.GetInputs();
+
+  feed_mlvalue_idxs_.reserve(num_variadic_inputs_ + implicit_inputs_.size());
+  implicit_input_values_.reserve(implicit_inputs_.size());
+
+  // the ordering of the Scan inputs should match the ordering of the subgraph inputs
+  for (int input = 0; input < num_variadic_inputs_; ++input) {
+    int idx;
+    ORT_RETURN_IF_ERROR(mlvalue_name_idx_map.GetIdx(graph_inputs[input]->Name(), idx));
+    feed_mlvalue_idxs_.push_back(idx);
+  }
+
+  // pass in implicit inputs as feeds.
+  for (auto& entry : implicit_inputs_) {
+    ORT_ENFORCE(entry.second, "All implicit inputs should have MLValue instances by now. ",
+                entry.first, " did not.");
+    int idx;
+    ORT_RETURN_IF_ERROR(mlvalue_name_idx_map.GetIdx(entry.first, idx));
+    feed_mlvalue_idxs_.push_back(idx);
+    implicit_input_values_.push_back(*entry.second);
+  }
+
+  fetch_mlvalue_idxs_.reserve(subgraph_output_names_.size());
+  for (const auto& name : subgraph_output_names_) {
+    int idx;
+    ORT_RETURN_IF_ERROR(mlvalue_name_idx_map.GetIdx(name, idx));
+    fetch_mlvalue_idxs_.push_back(idx);
+  }
+
+  return Status::OK();
+}
+
 // get the Scan input that is used in a call to the subgraph as a Tensor,
 // skipping over the optional arg to the Scan operator
 static const Tensor& GetSubgraphInputTensor(const OpKernelContext& context, int index) {
@@ -613,7 +752,7 @@ Status ScanImpl::AllocateOutput(int index, bool is_loop_state_var) {
   }
 
   TensorShape output_shape{onnxruntime::utils::GetTensorShapeFromTensorShapeProto(*graph_output_shape)};
-  auto& graph_output_dims{output_shape.GetDims()};
+  const auto& graph_output_dims{output_shape.GetDims()};
 
   std::vector<int64_t> scan_output_dims;
   scan_output_dims.reserve(graph_output_dims.size() + 2);
@@ -703,6 +842,22 @@ Status ScanImpl::CreateLoopStateVariables(std::vector<std::vector<LoopStateVaria
   return status;
 }
 
+Status ScanImpl::CreateBatchOutputIterators(int64_t batch_index, OutputIterators& output_iterators) const {
+  output_iterators.clear();
+  output_iterators.resize(num_variadic_outputs_);
+
+  for (int output = num_loop_state_variables_; output < num_variadic_outputs_; ++output) {
+    auto status = OutputIterator::Create(*output_iterators_[output], batch_index, output_iterators[output]);
+    ORT_RETURN_IF_ERROR(status);
+  }
+
+  return Status::OK();
+}
+
+SubgraphFrame ScanImpl::CreateSubgraphFrame() const {
+  return SubgraphFrame{session_state_, feed_mlvalue_idxs_, fetch_mlvalue_idxs_, implicit_input_values_};
+}
+
 Status ScanImpl::Execute() {
   Status status = Status::OK();
 
@@ -711,90 +866,139 @@ Status ScanImpl::Execute() {
   status = CreateLoopStateVariables(batch_loop_state_variables);
   ORT_RETURN_IF_ERROR(status);
 
-  for (int64_t b = 0; b < batch_size_; ++b) {
-    // Setup input MLValue streams
-    std::vector<MLValueTensorSlicer<const MLValue>::Iterator> scan_input_stream_iterators;
-    scan_input_stream_iterators.reserve(num_variadic_inputs_ - num_loop_state_variables_);
-
-    for (int i = num_loop_state_variables_, end = num_variadic_inputs_; i < end; ++i) {
-      const auto& mlvalue = GetSubgraphInputMLValue(context_, i);
-
-      // forward
-      if (directions_[i - num_loop_state_variables_] == static_cast<int64_t>(Scan::Direction::kForward)) {
-        // the iterator is self contained, so we don't need to keep the MLValueTensorSlicer instance around
-        scan_input_stream_iterators.push_back(MLValueTensorSlicer<const MLValue>::Create(mlvalue, 1, b).begin());
-      } else {  // reverse
-        scan_input_stream_iterators.push_back(MLValueTensorSlicer<const MLValue>::Create(mlvalue, 1, b).rbegin());
-        // need to skip past the empty entries at the end of the input if sequence length is short
-        auto offset = max_sequence_len_ - sequence_lens_[b];
-        if (offset > 0) {
-          // reverse iterator so += moves backwards through the input
-          scan_input_stream_iterators.back() += offset;
-        }
-      }
+  auto* thread_pool = context_.GetOperatorThreadPool();
+  const int64_t max_workers = thread_pool != nullptr ? thread_pool->NumThreads() + 1 : 1;
+
+  std::vector<SubgraphFrame> frames;
+  frames.reserve(std::max<int64_t>(std::min(batch_size_, max_workers), 1));
+  frames.push_back(CreateSubgraphFrame());
+
+  if (batch_size_ <= 1 || max_workers <= 1) {
+    // process the batch entries in order using the overall output iterators and a single frame
+    for (int64_t b = 0; b < batch_size_; ++b) {
+      status = ExecuteBatchEntry(b, batch_loop_state_variables[b], output_iterators_, frames[0]);
+      ORT_RETURN_IF_ERROR(status);
     }
 
-    // Call the subgraph for each item in the sequence
-    status = IterateSequence(batch_loop_state_variables[b],
-                             scan_input_stream_iterators,
-                             sequence_lens_[b]);
+    return status;
+  }
+
+  int64_t first_parallel_entry = 0;
+
+  // if a scan output has a symbolic dimension the overall output buffer can't be allocated until the subgraph
+  // has produced an output, so process the first batch entry on its own to make all the output shapes concrete.
+  if (std::any_of(output_iterators_.cbegin() + num_loop_state_variables_, output_iterators_.cend(),
+                  [](const std::unique_ptr<OutputIterator>& iterator) { return !iterator->IsConcreteShape(); })) {
+    status = ExecuteBatchEntry(0, batch_loop_state_variables[0], output_iterators_, frames[0]);
+    ORT_RETURN_IF_ERROR(status);
+
+    first_parallel_entry = 1;
+  }
 
+  // the remaining batch entries are independent. each has its own loop state variables and output iterators
+  // that write directly into its slice of the overall outputs.
+  std::vector<OutputIterators> batch_output_iterators(batch_size_);
+  for (int64_t b = first_parallel_entry; b < batch_size_; ++b) {
+    status = CreateBatchOutputIterators(b, batch_output_iterators[b]);
     ORT_RETURN_IF_ERROR(status);
   }
 
+  const int64_t num_workers = std::min(batch_size_ - first_parallel_entry, max_workers);
+  while (static_cast<int64_t>(frames.size()) < num_workers) {
+    frames.push_back(CreateSubgraphFrame());
+  }
+
+  // each worker claims batch entries until none remain, reusing its frame for all of them
+  std::atomic<int64_t> next_entry{first_parallel_entry};
+  std::atomic<bool> failed{false};
+  std::vector<Status> worker_status(num_workers);
+
+  thread_pool->ParallelFor(gsl::narrow<int32_t>(num_workers), [&](int32_t worker) {
+    for (int64_t b = next_entry++; b < batch_size_ && !failed; b = next_entry++) {
+      auto entry_status = ExecuteBatchEntry(b, batch_loop_state_variables[b], batch_output_iterators[b],
+                                            frames[worker]);
+      if (!entry_status.IsOK()) {
+        worker_status[worker] = entry_status;
+        failed = true;
+      }
+    }
+  });
+
+  for (auto& entry_status : worker_status) {
+    ORT_RETURN_IF_ERROR(entry_status);
+  }
+
   return status;
 }
 
+Status ScanImpl::ExecuteBatchEntry(int64_t b,
+                                   std::vector<LoopStateVariable>& loop_state_variables,
+                                   OutputIterators& output_iterators,
+                                   SubgraphFrame& frame) const {
+  // Setup input MLValue streams
+  std::vector<MLValueTensorSlicer<const MLValue>::Iterator> scan_input_stream_iterators;
+  scan_input_stream_iterators.reserve(num_variadic_inputs_ - num_loop_state_variables_);
+
+  for (int i = num_loop_state_variables_, end = num_variadic_inputs_; i < end; ++i) {
+    const auto& mlvalue = GetSubgraphInputMLValue(context_, i);
+
+    // forward
+    if (directions_[i - num_loop_state_variables_] == static_cast<int64_t>(Scan::Direction::kForward)) {
+      // the iterator is self contained, so we don't need to keep the MLValueTensorSlicer instance around
+      scan_input_stream_iterators.push_back(MLValueTensorSlicer<const MLValue>::Create(mlvalue, 1, b).begin());
+    } else {  // reverse
+      scan_input_stream_iterators.push_back(MLValueTensorSlicer<const MLValue>::Create(mlvalue, 1, b).rbegin());
+      // need to skip past the empty entries at the end of the input if sequence length is short
+      auto offset = max_sequence_len_ - sequence_lens_[b];
+      if (offset > 0) {
+        // reverse iterator so += moves backwards through the input
+        scan_input_stream_iterators.back() += offset;
+      }
+    }
+  }
+
+  // Call the subgraph for each item in the sequence
+  return IterateSequence(loop_state_variables, scan_input_stream_iterators, output_iterators, sequence_lens_[b],
+                         frame);
+}
+
 Status ScanImpl::IterateSequence(std::vector<LoopStateVariable>& loop_state_variables,
                                  ConstTensorSlicerIterators& scan_input_stream_iterators,
-                                 int64_t seq_length) {
+                                 OutputIterators& output_iterators,
+                                 int64_t seq_length,
+                                 SubgraphFrame& frame) const {
   Status status = Status::OK();
-  auto& graph_inputs = subgraph_.GetInputs();
-  NameMLValMap feeds;
-  std::vector<MLValue> fetches;
-
-  feeds.reserve(num_variadic_inputs_ + implicit_inputs_.size());
-  fetches.resize(num_variadic_outputs_);
-
-  // pass in implicit inputs as feeds.
-  for (auto& entry : implicit_inputs_) {
-    ORT_ENFORCE(entry.second, "All implicit inputs should have MLValue instances by now. ",
-                        entry.first, " did not.");
-    feeds[entry.first] = *entry.second;
-  }
+  auto& feeds = frame.Feeds();
+  auto& fetches = frame.Fetches();
 
   int64_t seq_no = 0;
   for (; seq_no < seq_length; ++seq_no) {
+    // the feeds are in the same order as the subgraph inputs, which matches the ordering of the Scan inputs
     for (int input = 0; input < num_variadic_inputs_; ++input) {
-      // the ordering of the Scan inputs should match the ordering of the subgraph inputs
-      auto name = graph_inputs[input]->Name();
-
       if (input < num_loop_state_variables_) {
         // add loop state variable input
-        feeds[name] = loop_state_variables[input].Input();
+        feeds[input] = loop_state_variables[input].Input();
       } else {
         // add sliced input
         auto& iterator = scan_input_stream_iterators[input - num_loop_state_variables_];
-        feeds[name] = *iterator;
+        feeds[input] = *iterator;
 
         ++iterator;
       }
     }
 
-    fetches.clear();
-
     // one or more outputs have symbolic dimensions and need the first fetch to be copied to the OutputIterator
     bool have_symbolic_dim_in_output = false;
 
     for (int output = 0, end = num_variadic_outputs_; output < end; ++output) {
       if (output < num_loop_state_variables_) {
         // add loop state variable output
-        fetches.push_back(loop_state_variables[output].Output());
+        fetches[output] = loop_state_variables[output].Output();
       } else {
         // add MLValue from sliced output
-        auto& iterator = *output_iterators_[output];
+        auto& iterator = *output_iterators[output];
         auto& mlvalue = *iterator;
-        fetches.push_back(mlvalue);
+        fetches[output] = mlvalue;
 
         // mlvalue.IsAllocated will be false when the OutputIterator is using a temporary MLValue
         // and not the overall output buffer.
@@ -804,14 +1008,8 @@ Status ScanImpl::IterateSequence(std::vector<LoopStateVariable>& loop_state_vari
       }
     }
 
-    // Create Executor and run graph.
-    // TODO: Consider pulling ExecutionFrame up from within SequentialExecutor
-    // and separating it out a bit so we can maybe just update the feeds/fetches in the frame on each iteration.
-    // Many of the other pieces are constant across usages.
-    // Not sure how best to handle the memory pattern side of things though.
-    // For now just making it work. Optimization and refinement will follow.
-    SequentialExecutor executor{context_.GetTerminateFlag()};
-    status = executor.Execute(session_state_, feeds, subgraph_output_names_, fetches, context_.Logger());
+    // run the subgraph, writing the scan outputs directly to the slices of the overall output
+    status = frame.Execute(context_.GetTerminateFlag(), context_.Logger());
     ORT_RETURN_IF_ERROR(status);
 
     // cycle the LoopStateVariable input/output in preparation for the next iteration
@@ -819,7 +1017,7 @@ Status ScanImpl::IterateSequence(std::vector<LoopStateVariable>& loop_state_vari
 
     // and move the output iterators.
     for (int output = num_loop_state_variables_; output < num_variadic_outputs_; ++output) {
-      auto& iterator = *output_iterators_[output];
+      auto& iterator = *output_iterators[output];
 
       // copy data from the fetch to the iterator so it can setup the overall output when the iterator is incremented.
       // if the iterator is already using the overall output buffer IsAllocated() will be true and no copy is required.
@@ -834,7 +1032,7 @@ Status ScanImpl::IterateSequence(std::vector<LoopStateVariable>& loop_state_vari
   // zero out any remaining values in the sequence
   for (; seq_length < max_sequence_len_; ++seq_length) {
     for (int output = num_loop_state_variables_; output < num_variadic_outputs_; ++output) {
-      auto& iterator = *output_iterators_[output];
+      auto& iterator = *output_iterators[output];
       iterator.ZeroOutCurrent();
       ++iterator;
     }
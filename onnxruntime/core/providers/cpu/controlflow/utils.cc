@@ -0,0 +1,67 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/controlflow/utils.h"
+
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/session_state.h"
+
+namespace onnxruntime {
+namespace controlflow {
+namespace detail {
+
+OuterScopeBuffers::OuterScopeBuffers(const std::unordered_map<std::string, const MLValue*>& implicit_inputs,
+                                     const SessionState& subgraph_session_state) {
+  for (auto& entry : implicit_inputs) {
+    if (entry.second) {
+      Add(*entry.second);
+    }
+  }
+
+  for (auto& entry : subgraph_session_state.GetInitializedTensors()) {
+    Add(entry.second);
+  }
+}
+
+void OuterScopeBuffers::Add(const MLValue& value) {
+  if (value.IsAllocated() && value.IsTensor()) {
+    buffers_.insert(value.Get<Tensor>().DataRaw());
+  }
+}
+
+bool OuterScopeBuffers::Contains(const MLValue& value) const {
+  // a Tensor that aliases an outer scope value, e.g. the output of Reshape, has the same data pointer.
+  return value.IsTensor() && buffers_.find(value.Get<Tensor>().DataRaw()) != buffers_.cend();
+}
+
+Status CopyToOutput(OpKernelContextInternal& context, int output_index, const MLValue& value) {
+  auto& data = value.Get<Tensor>();
+  Tensor* output = context.Output(output_index, data.Shape());
+
+  if (!output)
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to create output tensor for output #", output_index);
+
+  // the output may already have been allocated with this buffer if it is shared
+  if (output->DataRaw() != data.DataRaw()) {
+    memcpy(output->MutableDataRaw(), data.DataRaw(), data.Size());
+  }
+
+  return Status::OK();
+}
+
+Status ForwardOrCopyToOutput(OpKernelContextInternal& context,
+                             int output_index,
+                             const MLValue& value,
+                             const OuterScopeBuffers& outer_scope_buffers) {
+  MLValue* p_output = context.GetOutputMLValue(output_index);
+
+  if (p_output && !p_output->IsAllocated() && value.IsTensor() && !outer_scope_buffers.Contains(value)) {
+    return context.SetOutputMLValue(output_index, value);
+  }
+
+  return CopyToOutput(context, output_index, value);
+}
+
+}  // namespace detail
+}  // namespace controlflow
+}  // namespace onnxruntime
@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "core/common/common.h"
+#include "core/framework/ml_value.h"
+
+namespace onnxruntime {
+class OpKernelContextInternal;
+class SessionState;
+
+namespace controlflow {
+namespace detail {
+
+// The buffers of values that live outside of a subgraph execution: the inputs to the control flow node,
+// its implicit inputs, and the subgraph initializers.
+// A subgraph output that uses one of these buffers must not be forwarded as the output of the control flow node,
+// as a downstream node that runs in-place on that output would modify a value that is still in use.
+class OuterScopeBuffers {
+ public:
+  // add the implicit inputs and subgraph initializers
+  OuterScopeBuffers(const std::unordered_map<std::string, const MLValue*>& implicit_inputs,
+                    const SessionState& subgraph_session_state);
+
+  void Add(const MLValue& value);
+
+  bool Contains(const MLValue& value) const;
+
+ private:
+  std::unordered_set<const void*> buffers_;
+};
+
+// Set output `output_index` of a control flow node to a Tensor fetched from its subgraph.
+// The MLValue is forwarded by reference, unless its buffer is in outer_scope_buffers or the output was
+// already allocated (e.g. it was provided by the caller), in which case the data is copied to the output.
+Status ForwardOrCopyToOutput(OpKernelContextInternal& context,
+                             int output_index,
+                             const MLValue& value,
+                             const OuterScopeBuffers& outer_scope_buffers);
+
+// Copy the Tensor in value to a newly allocated output `output_index` of the same shape.
+Status CopyToOutput(OpKernelContextInternal& context, int output_index, const MLValue& value);
+
+}  // namespace detail
+}  // namespace controlflow
+}  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/framework/allocatormgr.h"
+#include "core/framework/bfc_arena.h"
 #include "core/framework/execution_provider.h"
 #include "core/graph/graph_transformer.h"
 #include "core/graph/constants.h"
@@ -13,9 +14,13 @@ namespace onnxruntime {
 // Information needed to construct CPU execution providers.
 struct CPUExecutionProviderInfo {
   bool create_arena{true};
+  // The capacity of the per-thread caches of the arena, 0 to disable them.
+  size_t arena_thread_cache_capacity{BFCArena::kDefaultThreadCacheCapacity};
 
   explicit CPUExecutionProviderInfo(bool use_arena)
       : create_arena(use_arena) {}
+  CPUExecutionProviderInfo(bool use_arena, size_t thread_cache_capacity)
+      : create_arena(use_arena), arena_thread_cache_capacity(thread_cache_capacity) {}
   CPUExecutionProviderInfo() = default;
 };
 
@@ -26,7 +31,8 @@ class CPUExecutionProvider : public IExecutionProvider {
  public:
   explicit CPUExecutionProvider(const CPUExecutionProviderInfo& info) {
     DeviceAllocatorRegistrationInfo device_info({OrtMemTypeDefault, [](int) {
-          return std::make_unique<CPUAllocator>(); }, std::numeric_limits<size_t>::max()});
+          return std::make_unique<CPUAllocator>(); }, std::numeric_limits<size_t>::max(),
+          info.arena_thread_cache_capacity});
 #ifdef USE_JEMALLOC
     ORT_UNUSED_PARAMETER(info);
     //JEMalloc already has memory pool, so just use device allocator.
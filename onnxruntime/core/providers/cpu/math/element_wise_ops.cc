@@ -861,7 +861,7 @@ struct TBroadcasterExpand {
         broadcaster_(input.Shape().GetDims(), shape) {
   }
 
-  TensorShape GetOutputShape() const { return TensorShape(broadcaster_.output_shape_); }
+  const TensorShape& GetOutputShape() const { return broadcaster_.output_shape_; }
   size_t GetSpanSize() const { return span_size_; }
 
   bool IsInput0Scalar() const { return broadcaster_.iterator1_.deltas_.front() == 0; }
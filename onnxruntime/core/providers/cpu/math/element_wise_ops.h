@@ -393,14 +393,15 @@ struct BroadcastIterator {
 };
 
 struct Broadcaster {
-  Broadcaster(const std::vector<int64_t>& shape1, const std::vector<int64_t>& shape2) {
+  Broadcaster(TensorShapeView shape1, TensorShapeView shape2)
+      : output_shape_(shape1.size() >= shape2.size() ? shape1 : shape2) {
+    // output_shape_ starts as a copy of the larger shape so it has the right rank; every axis is overwritten below
     size_t dimension_count_max = std::max(shape1.size(), shape2.size());
     size_t dimension_count_min = std::min(shape1.size(), shape2.size());
-    output_shape_.resize(dimension_count_max);
 
     auto iter1 = shape1.end();
     auto iter2 = shape2.end();
-    auto output_shape = output_shape_.end();
+    size_t output_axis = dimension_count_max;
 
     // Scalars are a special case, as it's always a broadcast
     size_t index = 0;
@@ -415,13 +416,13 @@ struct Broadcaster {
           auto axis = *--iter2;
           iterator1_.Init(1, axis);
           iterator2_.Init(axis, axis);
-          *--output_shape = axis;
+          output_shape_[--output_axis] = axis;
         }
       } else {  // Shape2 is a scalar
         auto axis = *--iter1;
         iterator1_.Init(axis, axis);
         iterator2_.Init(1, axis);
-        *--output_shape = axis;
+        output_shape_[--output_axis] = axis;
       }
       index++;  // Manually increment since we processed one axis
     }
@@ -431,7 +432,7 @@ struct Broadcaster {
       auto axis2 = *--iter2;
 
       auto largest = std::max(axis1, axis2);
-      *--output_shape = largest;
+      output_shape_[--output_axis] = largest;
 
       if (largest == 1 && index + 1 < dimension_count_min)  // Nothing to do in this case
         continue;
@@ -447,7 +448,7 @@ struct Broadcaster {
       auto axis2 = *--iter2;
 
       auto largest = std::max(axis1, axis2);
-      *--output_shape = largest;
+      output_shape_[--output_axis] = largest;
 
       if (largest == 1)  // Nothing to do in this case
         continue;
@@ -462,12 +463,12 @@ struct Broadcaster {
         auto axis = *--iter2;
         iterator1_.Append(1, axis);
         iterator2_.Append(axis, axis);
-        *--output_shape = axis;
+        output_shape_[--output_axis] = axis;
       } else {
         auto axis = *--iter1;
         iterator1_.Append(axis, axis);
         iterator2_.Append(1, axis);
-        *--output_shape = axis;
+        output_shape_[--output_axis] = axis;
       }
     }
 
@@ -479,7 +480,7 @@ struct Broadcaster {
   size_t GetSpanSize() const { return std::min(iterator1_.counts_.front(), iterator2_.counts_.front()); }
 
   BroadcastIterator iterator1_, iterator2_;
-  std::vector<int64_t> output_shape_;
+  TensorShape output_shape_;
 };
 
 template <typename T>
@@ -489,7 +490,7 @@ struct TBroadcaster {
         input_tensor1_(input1) {
   }
 
-  TensorShape GetOutputShape() const { return TensorShape(broadcaster_.output_shape_); }
+  const TensorShape& GetOutputShape() const { return broadcaster_.output_shape_; }
   size_t GetSpanSize() const { return span_size_; }
 
   bool IsInput0Scalar() const { return broadcaster_.iterator1_.deltas_.front() == 0; }
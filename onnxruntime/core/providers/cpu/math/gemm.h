@@ -5,6 +5,9 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/activation/fuse_activation.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/math/packed_gemm_b.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "gemm_helper.h"
@@ -15,7 +18,7 @@ template <typename T_X,
           typename T_W,
           typename T_B,
           typename T_Y>
-class Gemm final : public OpKernel {
+class Gemm : public OpKernel {
  public:
   Gemm(const OpKernelInfo& info) : OpKernel(info) {
     int64_t temp;
@@ -27,6 +30,8 @@ class Gemm final : public OpKernel {
 
     ORT_ENFORCE(info.GetAttr<float>("alpha", &alpha_).IsOK());
     ORT_ENFORCE(info.GetAttr<float>("beta", &beta_).IsOK());
+
+    packed_b_.TryPack(info, 1, trans_B_);
   }
 
   Status Compute(OpKernelContext* context) const override {
@@ -43,47 +48,91 @@ class Gemm final : public OpKernel {
     int64_t K = helper.K();
     auto Y = context->Output(0, TensorShape({M, N}));
 
+    // an empty output has nothing to compute
+    if (M == 0 || N == 0)
+      return Status::OK();
+
+    T_Y* y_data = Y->template MutableData<T_Y>();
+    concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+    if (activation_.empty()) {
+      ComputeRows(*X, *W, *B, 0, M, M, N, K, y_data, thread_pool);
+      return Status::OK();
+    }
+
+    // with a fused activation, split the rows into blocks that run in parallel. each block runs a single
+    // threaded GEMM and then the activation, so the activation reads the block while it is still in cache.
+    const int64_t degree = thread_pool != nullptr ? thread_pool->NumThreads() + 1 : 1;
+    const int64_t rows_per_block = std::max<int64_t>(std::min(kActivationBlockSize / N, (M + degree - 1) / degree), 1);
+    const int64_t num_blocks = (M + rows_per_block - 1) / rows_per_block;
+    concurrency::ThreadPool::TryParallelFor(thread_pool, static_cast<int32_t>(num_blocks), [&](int32_t block) {
+      const int64_t row = block * rows_per_block;
+      const int64_t rows = std::min(rows_per_block, M - row);
+      T_Y* y_block = y_data + row * N;
+      ComputeRows(*X, *W, *B, row, rows, M, N, K, y_block, nullptr);
+      fuse_activation(activation_, y_block, static_cast<size_t>(rows * N), leaky_relu_alpha_);
+    });
+
+    return Status::OK();
+  }
+
+ protected:
+  // activation applied to the output, set by FusedGemm
+  std::string activation_;
+  float leaky_relu_alpha_ = 0.01f;
+
+ private:
+  // maximum number of output elements in a block of rows computed before applying the activation
+  static constexpr int64_t kActivationBlockSize = 64 * 1024;
+
+  // compute rows [row, row + rows) of Y into y_data. the rows of op(X) are at an offset of row * K in X if it
+  // isn't transposed, else they are the columns of X starting at column row.
+  void ComputeRows(const Tensor& X, const Tensor& W, const Tensor& B, int64_t row, int64_t rows,
+                   int64_t M, int64_t N, int64_t K, T_Y* y_data, concurrency::ThreadPool* thread_pool) const {
+    const T_X* x_data = X.template Data<T_X>() + (trans_A_ == CblasNoTrans ? row * K : row);
+    const int64_t lda = trans_A_ == CblasNoTrans ? K : M;
+
     //bias
     // Todo: we might should move this part into math::gemm to let eigen
     // have better chance to further optimize it.
     if (beta_ != 0) {
       auto output_mat = EigenMatrixMapRowMajor<T_Y>(
-          Y->template MutableData<T_Y>(),
-          M,
+          y_data,
+          rows,
           N);
       output_mat.setZero();
 
-      auto& b_shape = B->Shape();
+      auto& b_shape = B.Shape();
       // if B is (), (1,) or (1, 1), add the scalar
       if (b_shape.Size() == 1) {
-        output_mat.array() += *(B->template Data<T_B>());
+        output_mat.array() += *(B.template Data<T_B>());
       }
       // B is (N,)
       else if (b_shape.NumDimensions() == 1) {
         auto bias_vec = ConstEigenVectorMap<T_B>(
-            B->template Data<T_B>(),
+            B.template Data<T_B>(),
             N);
         output_mat.rowwise() += bias_vec.transpose();
       } else if (b_shape.NumDimensions() == 2) {
         // B is (M, 1)
         if (b_shape[1] == 1) {
           auto bias_vec = ConstEigenVectorMap<T_B>(
-              B->template Data<T_B>(),
-              M);
+              B.template Data<T_B>() + row,
+              rows);
           output_mat.colwise() += bias_vec;
         }
         // B is (1, N)
         else if (b_shape[0] == 1) {
           auto bias_vec = ConstEigenVectorMap<T_B>(
-              B->template Data<T_B>(),
+              B.template Data<T_B>(),
               N);
           output_mat.rowwise() += bias_vec.transpose();
         }
         // B is (M, N), no broadcast needed.
         else {
           auto bias_mat = ConstEigenMatrixMapRowMajor<T_B>(
-              B->template Data<T_B>(),
-              M,
+              B.template Data<T_B>() + row * N,
+              rows,
               N);
           output_mat += bias_mat;
         }
@@ -91,27 +140,45 @@ class Gemm final : public OpKernel {
     }
 
     // W * x
-    math::Gemm<T_X, CPUMathUtil>(
-        trans_A_,
-        trans_B_,
-        M,
-        N,
-        K,
-        alpha_,
-        X->template Data<T_X>(),
-        W->template Data<T_W>(),
-        beta_,
-        Y->template MutableData<T_Y>(),
-        &CPUMathUtil::Instance());
-
-    return Status::OK();
+    if (packed_b_.IsPackedFrom(W)) {
+      MlasSgemm(trans_A_,
+                static_cast<size_t>(rows),
+                static_cast<size_t>(N),
+                static_cast<size_t>(K),
+                alpha_,
+                x_data,
+                static_cast<size_t>(lda),
+                packed_b_.Data(),
+                beta_,
+                y_data,
+                static_cast<size_t>(N),
+                thread_pool);
+    } else {
+      math::GemmEx<T_X, concurrency::ThreadPool>(
+          trans_A_,
+          trans_B_,
+          static_cast<int>(rows),
+          static_cast<int>(N),
+          static_cast<int>(K),
+          alpha_,
+          x_data,
+          static_cast<int>(lda),
+          W.template Data<T_W>(),
+          static_cast<int>(trans_B_ == CblasNoTrans ? N : K),
+          beta_,
+          y_data,
+          static_cast<int>(N),
+          thread_pool);
+    }
   }
 
- private:
   CBLAS_TRANSPOSE trans_A_;
   CBLAS_TRANSPOSE trans_B_;
   float alpha_;
   float beta_;
+
+  // W packed for MLAS if it is a constant 2-D float matrix
+  PackedGemmB packed_b_;
 };
 
 }  // namespace onnxruntime
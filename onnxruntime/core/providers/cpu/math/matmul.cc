@@ -16,6 +16,24 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
   KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
   MatMul<float>);
 
+// Get the number of elements between the matrices of a batch if they are evenly spaced.
+static bool GetBatchStride(const std::vector<size_t>& offsets, size_t& stride) {
+  stride = 0;
+  if (offsets.size() > 1) {
+    if (offsets[1] < offsets[0]) {
+      return false;
+    }
+    stride = offsets[1] - offsets[0];
+  }
+
+  for (size_t i = 2; i < offsets.size(); i++) {
+    if (offsets[i] != offsets[0] + i * stride) {
+      return false;
+    }
+  }
+  return true;
+}
+
 template <>
 Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   const Tensor* left_X = ctx->Input<Tensor>(0);
@@ -26,9 +44,59 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
 
   Tensor* Y = ctx->Output(0, helper.OutputShape());
 
-  // TODO: replace it with GemmBatch for performance, it's OK for now as GemmBatch unrolls as well
-  for (int i = 0; i < helper.OutputOffsets().size(); i++) {
-    math::Gemm<float, CPUMathUtil>(
+  // an empty output has nothing to compute. a zero batch dimension also leaves the offsets empty.
+  if (helper.OutputShape().Size() == 0)
+    return Status::OK();
+
+  if (packed_b_.IsPackedFrom(*right_X) &&
+      static_cast<size_t>(helper.K()) == packed_b_.K() && static_cast<size_t>(helper.N()) == packed_b_.N()) {
+    for (size_t i = 0; i < helper.OutputOffsets().size(); i++) {
+      MlasSgemm(CblasNoTrans,
+                static_cast<size_t>(helper.M()),
+                packed_b_.N(),
+                packed_b_.K(),
+                /* alpha */ 1.0f,
+                left_X->template Data<float>() + helper.LeftOffsets()[i],
+                packed_b_.K(),
+                packed_b_.Data(),
+                /* beta */ 0.0f,
+                Y->template MutableData<float>() + helper.OutputOffsets()[i],
+                packed_b_.N(),
+                ctx->GetOperatorThreadPool());
+    }
+    return Status::OK();
+  }
+
+  // multiply the whole batch with one call if the matrices are evenly spaced, which is the case unless
+  // both inputs are broadcast in different dimensions
+  size_t left_stride, right_stride, output_stride;
+  if (GetBatchStride(helper.LeftOffsets(), left_stride) &&
+      GetBatchStride(helper.RightOffsets(), right_stride) &&
+      GetBatchStride(helper.OutputOffsets(), output_stride)) {
+    math::GemmStridedBatched<float, concurrency::ThreadPool>(
+        CblasNoTrans,
+        CblasNoTrans,
+        static_cast<int>(helper.OutputOffsets().size()),
+        static_cast<int>(helper.M()),
+        static_cast<int>(helper.N()),
+        static_cast<int>(helper.K()),
+        /* alpha */ 1.0f,
+        left_X->template Data<float>() + helper.LeftOffsets()[0],
+        static_cast<int>(helper.K()),
+        static_cast<int64_t>(left_stride),
+        right_X->template Data<float>() + helper.RightOffsets()[0],
+        static_cast<int>(helper.N()),
+        static_cast<int64_t>(right_stride),
+        /* beta */ 0.0f,
+        Y->template MutableData<float>() + helper.OutputOffsets()[0],
+        static_cast<int>(helper.N()),
+        static_cast<int64_t>(output_stride),
+        ctx->GetOperatorThreadPool());
+    return Status::OK();
+  }
+
+  for (size_t i = 0; i < helper.OutputOffsets().size(); i++) {
+    math::Gemm<float, concurrency::ThreadPool>(
         CblasNoTrans,
         CblasNoTrans,
         static_cast<int>(helper.M()),
@@ -39,7 +107,7 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
         right_X->template Data<float>() + helper.RightOffsets()[i],
         /* beta */ 0.0f,
         Y->template MutableData<float>() + helper.OutputOffsets()[i],
-        &CPUMathUtil::Instance());
+        ctx->GetOperatorThreadPool());
   }
 
   return Status::OK();
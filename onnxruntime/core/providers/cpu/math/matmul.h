@@ -5,6 +5,7 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/math/packed_gemm_b.h"
 
 namespace onnxruntime {
 
@@ -13,9 +14,14 @@ class MatMul final : public OpKernel {
  public:
   MatMul(const OpKernelInfo& info)
       : OpKernel(info) {
+    packed_b_.TryPack(info, 1, CblasNoTrans);
   }
 
   Status Compute(OpKernelContext* context) const override;
+
+ private:
+  // B packed for MLAS if it is a constant 2-D float matrix
+  PackedGemmB packed_b_;
 };
 
 }  // namespace onnxruntime
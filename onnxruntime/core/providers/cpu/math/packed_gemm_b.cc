@@ -0,0 +1,52 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/math/packed_gemm_b.h"
+
+namespace onnxruntime {
+
+bool PackedGemmB::TryPack(const OpKernelInfo& info, int input_index, CBLAS_TRANSPOSE trans_b) {
+  const Tensor* B = nullptr;
+  if (!info.TryGetConstantInput(input_index, &B) || B->DataType() != DataTypeImpl::GetType<float>() ||
+      B->Shape().NumDimensions() != 2) {
+    return false;
+  }
+
+  const auto rows = static_cast<size_t>(B->Shape()[0]);
+  const auto cols = static_cast<size_t>(B->Shape()[1]);
+  return Pack(info, *B, B->Data<float>(), rows, cols, trans_b);
+}
+
+bool PackedGemmB::TryPack(const OpKernelInfo& info, int input_index, int64_t index, CBLAS_TRANSPOSE trans_b) {
+  const Tensor* B = nullptr;
+  if (!info.TryGetConstantInput(input_index, &B) || B->DataType() != DataTypeImpl::GetType<float>() ||
+      B->Shape().NumDimensions() != 3 || index < 0 || index >= B->Shape()[0]) {
+    return false;
+  }
+
+  const auto rows = static_cast<size_t>(B->Shape()[1]);
+  const auto cols = static_cast<size_t>(B->Shape()[2]);
+  return Pack(info, *B, B->Data<float>() + static_cast<size_t>(index) * rows * cols, rows, cols, trans_b);
+}
+
+bool PackedGemmB::Pack(const OpKernelInfo& info, const Tensor& B, const float* data, size_t rows, size_t cols,
+                       CBLAS_TRANSPOSE trans_b) {
+  if (rows == 0 || cols == 0) {
+    return false;
+  }
+
+  auto alloc = info.GetExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  if (alloc == nullptr) {
+    return false;
+  }
+
+  k_ = trans_b == CblasNoTrans ? rows : cols;
+  n_ = trans_b == CblasNoTrans ? cols : rows;
+  buffer_ = BufferUniquePtr(alloc->Alloc(MlasSgemmPackBSize(n_, k_)), BufferDeleter(alloc));
+  MlasSgemmPackB(trans_b, n_, k_, data, cols, buffer_.get());
+  source_ = B.DataRaw();
+
+  return true;
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+
+/**
+Matrix B of a float GEMM that is a constant initializer, packed by MLAS once when the kernel is created
+instead of on every call to Compute.
+*/
+class PackedGemmB {
+ public:
+  PackedGemmB() = default;
+
+  /**
+  Pack the input of the kernel if it is a constant 2-D float tensor.
+  @param trans_b Whether the kernel uses the input transposed.
+  @returns true if the input was packed.
+  */
+  bool TryPack(const OpKernelInfo& info, int input_index, CBLAS_TRANSPOSE trans_b);
+
+  /**
+  Pack one matrix of the input of the kernel if it is a constant 3-D float tensor, such as the weights of one
+  direction of an RNN.
+  @param index The index of the matrix along the first dimension of the input.
+  @param trans_b Whether the kernel uses the matrix transposed.
+  @returns true if the matrix was packed.
+  */
+  bool TryPack(const OpKernelInfo& info, int input_index, int64_t index, CBLAS_TRANSPOSE trans_b);
+
+  /**
+  Check if the packed matrix can be used for the input tensor of a Compute call. An initializer can also be
+  a graph input, in which case it may be overridden by a feed.
+  */
+  bool IsPackedFrom(const Tensor& tensor) const {
+    return buffer_ != nullptr && tensor.DataRaw() == source_;
+  }
+
+  const void* Data() const { return buffer_.get(); }
+
+  size_t N() const { return n_; }
+  size_t K() const { return k_; }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PackedGemmB);
+
+  // packs the rows x cols matrix at data, which is part of the tensor B
+  bool Pack(const OpKernelInfo& info, const Tensor& B, const float* data, size_t rows, size_t cols,
+            CBLAS_TRANSPOSE trans_b);
+
+  const void* source_ = nullptr;
+  size_t n_ = 0;
+  size_t k_ = 0;
+  BufferUniquePtr buffer_;
+};
+
+}  // namespace onnxruntime
@@ -3,6 +3,8 @@
 
 #include "core/providers/cpu/ml/linearclassifier.h"
 
+#include <type_traits>
+
 namespace onnxruntime {
 namespace ml {
 
@@ -63,6 +65,10 @@ Status LinearClassifier<T>::Compute(OpKernelContext* ctx) const {
 
   int64_t stride = shape.NumDimensions() == 1 ? shape[0] : shape[1];
   int64_t N = shape.NumDimensions() == 1 ? 1 : shape[0];
+  if (static_cast<int64_t>(coefficients_.size()) < class_count_ * stride) {
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                  "Input has more features than there are coefficients for each class.");
+  }
   Tensor* Y = ctx->Output(0, TensorShape({N}));
 
   int64_t output_classes = class_count_;
@@ -72,79 +78,99 @@ Status LinearClassifier<T>::Compute(OpKernelContext* ctx) const {
     add_second_class = true;
   }
   Tensor* Z = ctx->Output(1, TensorShape({N, output_classes}));
+  if (N == 0) {
+    return Status::OK();
+  }
 
-  int64_t zindex = 0;
+  // the scores are computed in single precision, so other input types are converted once up front
   const auto* x_data = X->template Data<T>();
+  std::vector<float> x_converted;
+  const float* x;
+  if (std::is_same<T, float>::value) {
+    x = reinterpret_cast<const float*>(x_data);
+  } else {
+    x_converted.assign(x_data, x_data + N * stride);
+    x = x_converted.data();
+  }
 
-  size_t class_count = static_cast<size_t>(class_count_);
-  std::vector<float> scores;
-  scores.reserve(class_count);
-  for (int64_t i = 0; i < N; i++)  //for each point
-  {
-    scores.clear();
-    size_t current_weight_0 = i * stride;
-    int maxclass = -1;
-    float maxweight = 0.f;
-    for (int j = 0; j < class_count; j++)  //for each class
-    {
-      size_t current_coeff_0 = j * stride;
-      float weight = 0.f;
-      for (int64_t k = 0; k < stride; k++)  //for each weight
-      {
-        weight += static_cast<float>(x_data[current_weight_0 + k] * coefficients_[current_coeff_0 + k]);
-      }
-      if (intercepts_.size() == class_count) {
-        weight += intercepts_[j];
-      }
-      scores.push_back(weight);
-      if (weight > maxweight || maxclass == -1) {
-        maxweight = weight;
-        maxclass = j;
+  // All the scores are computed by one SGEMM directly into Z, starting from the intercepts. When the score of the
+  // second class is added, the computed score goes in the second column and the first is filled in afterwards.
+  float* z_data = Z->template MutableData<float>();
+  float* scores = add_second_class ? z_data + 1 : z_data;
+  for (int64_t i = 0; i < N; i++) {
+    std::copy(intercepts_.begin(), intercepts_.end(), scores + i * output_classes);
+  }
+
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  MlasSgemm(CblasNoTrans, CblasTrans, static_cast<size_t>(N), static_cast<size_t>(class_count_),
+            static_cast<size_t>(stride), 1.f, x, static_cast<size_t>(stride), coefficients_.data(),
+            static_cast<size_t>(stride), 1.f, scores, static_cast<size_t>(output_classes), tp);
+
+  const int64_t degree = tp != nullptr ? tp->NumThreads() + 1 : 1;
+  const int64_t num_chunks = std::min(N, degree);
+  concurrency::ThreadPool::TryParallelFor(tp, static_cast<int32_t>(num_chunks), [&](int32_t chunk) {
+    const int64_t row_begin = N * chunk / num_chunks;
+    const int64_t row_end = N * (chunk + 1) / num_chunks;
+    for (int64_t i = row_begin; i < row_end; i++) {
+      const float* row = scores + i * output_classes;
+      int64_t maxclass = 0;
+      float maxweight = row[0];
+      for (int64_t j = 1; j < class_count_; j++) {
+        if (row[j] > maxweight) {
+          maxweight = row[j];
+          maxclass = j;
+        }
       }
-    }
-    //write top class
-    if (intercepts_.size() == 1)  //binary
-    {
-      if (using_strings_) {
-        if (classlabels_strings_.size() == 2 && maxweight > 0) {
-          Y->template MutableData<std::string>()[i] = classlabels_strings_[1];  //positive label
-        } else if (classlabels_strings_.size() == 2) {
-          Y->template MutableData<std::string>()[i] = classlabels_strings_[0];  //negative label
-        } else if (maxweight > 0) {
-          Y->template MutableData<std::string>()[i] = "1";  //positive label
-        } else {
-          Y->template MutableData<std::string>()[i] = "0";  //negative label
+      //write top class
+      if (intercepts_.size() == 1)  //binary
+      {
+        if (using_strings_) {
+          if (classlabels_strings_.size() == 2 && maxweight > 0) {
+            Y->template MutableData<std::string>()[i] = classlabels_strings_[1];  //positive label
+          } else if (classlabels_strings_.size() == 2) {
+            Y->template MutableData<std::string>()[i] = classlabels_strings_[0];  //negative label
+          } else if (maxweight > 0) {
+            Y->template MutableData<std::string>()[i] = "1";  //positive label
+          } else {
+            Y->template MutableData<std::string>()[i] = "0";  //negative label
+          }
+        } else  //no strings
+        {
+          if (classlabels_ints_.size() == 2 && maxweight > 0) {
+            Y->template MutableData<int64_t>()[i] = classlabels_ints_[1];  //positive label
+          } else if (classlabels_ints_.size() == 2) {
+            Y->template MutableData<int64_t>()[i] = classlabels_ints_[0];  //negative label
+          } else if (maxweight > 0) {
+            Y->template MutableData<int64_t>()[i] = 1;  //positive label
+          } else {
+            Y->template MutableData<int64_t>()[i] = 0;  //negative label
+          }
         }
-      } else  //no strings
+      } else  //multiclass
       {
-        if (classlabels_ints_.size() == 2 && maxweight > 0) {
-          Y->template MutableData<int64_t>()[i] = classlabels_ints_[1];  //positive label
-        } else if (classlabels_ints_.size() == 2) {
-          Y->template MutableData<int64_t>()[i] = classlabels_ints_[0];  //negative label
-        } else if (maxweight > 0) {
-          Y->template MutableData<int64_t>()[i] = 1;  //positive label
+        if (using_strings_) {
+          Y->template MutableData<std::string>()[i] = classlabels_strings_[maxclass];
         } else {
-          Y->template MutableData<int64_t>()[i] = 0;  //negative label
+          Y->template MutableData<int64_t>()[i] = classlabels_ints_[maxclass];
         }
       }
-    } else  //multiclass
-    {
-      if (using_strings_) {
-        Y->template MutableData<std::string>()[i] = classlabels_strings_[maxclass];
-      } else {
-        Y->template MutableData<int64_t>()[i] = classlabels_ints_[maxclass];
-      }
     }
+
     //write float values
-    if (add_second_class && maxweight > 0) {
-      ::onnxruntime::ml::write_scores(scores, post_transform_, zindex, Z, 0);
-    } else if (add_second_class) {
-      ::onnxruntime::ml::write_scores(scores, post_transform_, zindex, Z, 1);
+    float* z_rows = z_data + row_begin * output_classes;
+    const int64_t num_rows = row_end - row_begin;
+    if (add_second_class) {
+      //put opposite score in positive slot
+      for (int64_t i = 0; i < num_rows; i++) {
+        z_rows[i * 2] = 1.f - z_rows[i * 2 + 1];
+      }
+      // PROBIT is applied to the score of each class
+      batched_update_scores_inplace(z_rows, num_rows * 2, 1, post_transform_);
     } else {
-      ::onnxruntime::ml::write_scores(scores, post_transform_, zindex, Z, -1);
+      batched_update_scores_inplace(z_rows, num_rows, output_classes, post_transform_);
     }
-    zindex += scores.size();
-  }  //for each point
+  });
+
   return Status::OK();
 }
 
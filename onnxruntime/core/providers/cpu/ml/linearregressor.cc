@@ -30,30 +30,38 @@ Status LinearRegressor<float>::Compute(OpKernelContext* ctx) const {
 
   int64_t stride = X->Shape().NumDimensions() == 1 ? X->Shape()[0] : X->Shape()[1];
   int64_t N = X->Shape().NumDimensions() == 1 ? 1 : X->Shape()[0];
+  if (static_cast<int64_t>(coefficients_.size()) < targets_ * stride) {
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                  "Input has more features than there are coefficients for each target.");
+  }
   Tensor* Y = ctx->Output(0, TensorShape({N, targets_}));
+  if (N == 0) {
+    return Status::OK();
+  }
   const auto* Xdata = X->template Data<float>();
-  int64_t yindex = 0;
+  float* Ydata = Y->template MutableData<float>();
 
+  // all the scores are computed by one SGEMM directly into Y, starting from the intercepts if there are any
   bool useIntercepts = intercepts_.size() == static_cast<size_t>(targets_) ? true : false;
-  for (int64_t i = 0; i < N; i++)  //for each point
-  {
-    std::vector<float> scores;
-    int64_t current_weight_0 = i * stride;
-    for (int j = 0; j < targets_; j++)  //for each target
-    {
-      int64_t current_coeff_0 = j * stride;
-      float weight = 0.f;
-      for (int64_t k = 0; k < stride; k++)  //for each weight
-      {
-        weight = weight + Xdata[current_weight_0 + k] * coefficients_[current_coeff_0 + k];
-      }
-      if (useIntercepts) {
-        weight = weight + intercepts_[j];
-      }
-      scores.push_back(weight);
+  if (useIntercepts) {
+    for (int64_t i = 0; i < N; i++) {
+      std::copy(intercepts_.begin(), intercepts_.end(), Ydata + i * targets_);
     }
-    ::onnxruntime::ml::write_scores(scores, post_transform_, yindex, Y, -1);
-    yindex += scores.size();
+  }
+
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  MlasSgemm(CblasNoTrans, CblasTrans, static_cast<size_t>(N), static_cast<size_t>(targets_),
+            static_cast<size_t>(stride), 1.f, Xdata, static_cast<size_t>(stride), coefficients_.data(),
+            static_cast<size_t>(stride), useIntercepts ? 1.f : 0.f, Ydata, static_cast<size_t>(targets_), tp);
+
+  if (post_transform_ != POST_EVAL_TRANSFORM::NONE) {
+    const int64_t degree = tp != nullptr ? tp->NumThreads() + 1 : 1;
+    const int64_t num_chunks = std::min(N, degree);
+    concurrency::ThreadPool::TryParallelFor(tp, static_cast<int32_t>(num_chunks), [&](int32_t chunk) {
+      const int64_t row_begin = N * chunk / num_chunks;
+      const int64_t row_end = N * (chunk + 1) / num_chunks;
+      batched_update_scores_inplace(Ydata + row_begin * targets_, row_end - row_begin, targets_, post_transform_);
+    });
   }
   return Status::OK();
 }
@@ -4,6 +4,7 @@
 #pragma once
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
@@ -324,5 +325,41 @@ static inline void write_scores(std::vector<float>& scores, POST_EVAL_TRANSFORM
   }
 }
 
+// Applies the post transform in place to num_rows rows of num_scores contiguous scores. The result is the same as
+// calling write_scores on each row with add_second_class < 0, but each transform is a single vectorized pass over
+// the rows instead of a loop over individual scores.
+static inline void batched_update_scores_inplace(float* scores, int64_t num_rows, int64_t num_scores,
+                                                 POST_EVAL_TRANSFORM post_transform) {
+  if (num_scores == 1) {
+    if (post_transform == POST_EVAL_TRANSFORM::PROBIT) {
+      for (int64_t i = 0; i < num_rows; i++) {
+        scores[i] = ml_sqrt2 * ml_inv_erf(2 * scores[i] - 1);
+      }
+    }
+    return;
+  }
+
+  if (post_transform == POST_EVAL_TRANSFORM::LOGISTIC) {
+    MlasComputeLogistic(scores, scores, static_cast<size_t>(num_rows * num_scores));
+  } else if (post_transform == POST_EVAL_TRANSFORM::SOFTMAX) {
+    for (int64_t i = 0; i < num_rows; i++) {
+      EigenVectorArrayMap<float> row(scores + i * num_scores, num_scores);
+      // compute exp with negative number to be numerically stable
+      row = (row - row.maxCoeff()).exp();
+      row /= row.sum();
+    }
+  } else if (post_transform == POST_EVAL_TRANSFORM::SOFTMAX_ZERO) {
+    for (int64_t i = 0; i < num_rows; i++) {
+      EigenVectorArrayMap<float> row(scores + i * num_scores, num_scores);
+      const float v_max = row.maxCoeff();
+      // zero scores are skipped, since exp(0) is non zero
+      const auto non_zero = row.abs() > 0.0000001f;
+      const Eigen::ArrayXf exps = (row - v_max).exp();
+      const float this_sum = non_zero.select(exps, 0.f).sum();
+      row = non_zero.select(exps, row * std::exp(-v_max)) / this_sum;
+    }
+  }
+}
+
 }  // namespace ml
 }  // namespace onnxruntime
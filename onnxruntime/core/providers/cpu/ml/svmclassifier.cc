@@ -3,6 +3,8 @@
 
 #include "core/providers/cpu/ml/svmclassifier.h"
 
+#include <type_traits>
+
 namespace onnxruntime {
 namespace ml {
 
@@ -81,178 +83,209 @@ Status SVMClassifier<T>::Compute(OpKernelContext* ctx) const {
 
   int64_t stride = X->Shape().NumDimensions() == 1 ? X->Shape()[0] : X->Shape()[1];
   int64_t N = X->Shape().NumDimensions() == 1 ? 1 : X->Shape()[0];
+  ORT_RETURN_IF_NOT(stride >= feature_count_, "Input has ", stride, " features but the model expects ", feature_count_);
 
   Tensor* Y = ctx->Output(0, TensorShape({N}));
-  Tensor* Z;
 
-  std::vector<int64_t> dims;
+  // a binary classifier writes the scores of both classes
+  int64_t z_stride;
   if (mode_ == SVM_TYPE::SVM_SVC && proba_.size() == 0)
-    dims = {static_cast<int64_t>(N), static_cast<int64_t>(class_count_ * (class_count_ - 1) / 2)};
+    z_stride = class_count_ == 2 ? 2 : class_count_ * (class_count_ - 1) / 2;
   else
-    dims = {static_cast<int64_t>(N), static_cast<int64_t>(class_count_)};
-  Z = ctx->Output(1, TensorShape(dims));
+    z_stride = class_count_;
+  Tensor* Z = ctx->Output(1, TensorShape({N, z_stride}));
+
+  if (N == 0) {
+    return Status::OK();
+  }
 
+  // the kernels are evaluated in single precision, so other input types are converted once up front
   const auto* x_data = X->template Data<T>();
-  int64_t zindex = 0;
+  std::vector<float> x_converted;
+  const float* x;
+  if (std::is_same<T, float>::value) {
+    x = reinterpret_cast<const float*>(x_data);
+  } else {
+    x_converted.assign(x_data, x_data + N * stride);
+    x = x_converted.data();
+  }
 
-  for (int64_t n = 0; n < N; n++)  //for each example
-  {
-    int64_t current_weight_0 = n * stride;
-    int64_t maxclass = -1;
-    double maxweight = 0.f;
-    std::vector<float> decisions;
-    std::vector<float> scores;
-    std::vector<float> kernels;
-    std::vector<int64_t> votes;
+  // In SVC mode a single SGEMM computes the dot products between a batch of examples and all the support vectors.
+  // In liblinear mode the same SGEMM against the coefficients of each class directly gives the scores.
+  const bool svc = mode_ == SVM_TYPE::SVM_SVC;
+  const int64_t columns = svc ? vector_count_ : class_count_;
+  const int64_t rows_per_batch = std::min(N, kernel_rows_per_batch(columns));
+  std::vector<float> kernels(static_cast<size_t>(rows_per_batch * columns));
 
-    if (mode_ == SVM_TYPE::SVM_SVC) {
-      for (int64_t j = 0; j < vector_count_; j++) {
-        float val = kernel_dot(x_data, current_weight_0, support_vectors_, feature_count_ * j, feature_count_, get_kernel_type());
-        kernels.push_back(val);
-      }
-      for (int64_t j = 0; j < class_count_; j++) {
-        votes.push_back(0);
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  const int64_t degree = tp != nullptr ? tp->NumThreads() + 1 : 1;
+
+  for (int64_t batch_begin = 0; batch_begin < N; batch_begin += rows_per_batch) {
+    const int64_t batch_rows = std::min(rows_per_batch, N - batch_begin);
+    const float* batch_x = x + batch_begin * stride;
+    batched_kernel_dot(batch_x, batch_rows, stride, svc ? support_vectors_ : coefficients_, columns, feature_count_,
+                       kernels.data(), tp);
+
+    const int64_t num_chunks = std::min(batch_rows, degree);
+    concurrency::ThreadPool::TryParallelFor(tp, static_cast<int32_t>(num_chunks), [&](int32_t chunk) {
+      const int64_t row_begin = batch_rows * chunk / num_chunks;
+      const int64_t row_end = batch_rows * (chunk + 1) / num_chunks;
+      std::vector<float> scores;
+      std::vector<int64_t> votes;
+      for (int64_t row = row_begin; row < row_end; row++) {
+        ComputeRow(batch_x + row * stride, kernels.data() + row * columns, batch_begin + row, Y, Z, z_stride,
+                   scores, votes);
       }
-      int evals = 0;
-      for (int64_t i = 0; i < class_count_; i++) {        //for each class
-        for (int64_t j = i + 1; j < class_count_; j++) {  //for each class
-          float sum = 0;
-          int64_t start_index_i = starting_vector_[i];  // *feature_count_;
-          int64_t start_index_j = starting_vector_[j];  // *feature_count_;
+    });
+  }
+
+  return Status::OK();
+}
+
+template <typename T>
+void SVMClassifier<T>::ComputeRow(const float* x, float* kernels, int64_t n, Tensor* Y, Tensor* Z, int64_t z_stride,
+                                  std::vector<float>& scores, std::vector<int64_t>& votes) const {
+  int64_t maxclass = -1;
+  double maxweight = 0.f;
+  scores.clear();
+  votes.clear();
+
+  if (mode_ == SVM_TYPE::SVM_SVC) {
+    apply_kernel(x, feature_count_, support_vectors_, kernels, vector_count_);
+    votes.resize(class_count_, 0);
+    int evals = 0;
+    for (int64_t i = 0; i < class_count_; i++) {        //for each class
+      for (int64_t j = i + 1; j < class_count_; j++) {  //for each class
+        int64_t start_index_i = starting_vector_[i];
+        int64_t start_index_j = starting_vector_[j];
 
-          int64_t class_i_support_count = vectors_per_class_[i];
-          int64_t class_j_support_count = vectors_per_class_[j];
+        int64_t class_i_support_count = vectors_per_class_[i];
+        int64_t class_j_support_count = vectors_per_class_[j];
 
-          int64_t pos1 = (vector_count_) * (j - 1);
-          int64_t pos2 = (vector_count_) * (i);
-          for (int64_t m = 0; m < class_i_support_count; m++) {
-            float val1 = coefficients_[pos1 + start_index_i + m];
-            float val2 = kernels[start_index_i + m];
-            sum += val1 * val2;
-          }
-          for (int64_t m = 0; m < class_j_support_count; m++) {
-            float val1 = coefficients_[pos2 + start_index_j + m];
-            float val2 = kernels[start_index_j + m];
-            sum += val1 * val2;
-          }
+        int64_t pos1 = (vector_count_) * (j - 1);
+        int64_t pos2 = (vector_count_) * (i);
+        float sum = ConstEigenVectorMap<float>(coefficients_.data() + pos1 + start_index_i, class_i_support_count)
+                        .dot(ConstEigenVectorMap<float>(kernels + start_index_i, class_i_support_count));
+        sum += ConstEigenVectorMap<float>(coefficients_.data() + pos2 + start_index_j, class_j_support_count)
+                   .dot(ConstEigenVectorMap<float>(kernels + start_index_j, class_j_support_count));
 
-          sum += rho_[evals];
-          scores.push_back(sum);
-          if (sum > 0) {
-            votes[i]++;
-          } else {
-            votes[j]++;
-          }
-          evals++;  //index into rho
+        sum += rho_[evals];
+        scores.push_back(sum);
+        if (sum > 0) {
+          votes[i]++;
+        } else {
+          votes[j]++;
         }
-      }
-    } else if (mode_ == SVM_TYPE::SVM_LINEAR) {     //liblinear
-      for (int64_t j = 0; j < class_count_; j++) {  //for each class
-        float val = kernel_dot(x_data, current_weight_0, coefficients_, feature_count_ * j, feature_count_, get_kernel_type());
-        val += rho_[0];
-        scores.push_back(val);
+        evals++;  //index into rho
       }
     }
-    if (proba_.size() > 0 && mode_ == SVM_TYPE::SVM_SVC) {
-      //compute probabilities from the scores
-      std::vector<float> estimates;
-      std::vector<float> probsp2;
-      int64_t num = class_count_ * class_count_;
-      for (int64_t m = 0; m < num; m++) {
-        probsp2.push_back(0.f);  //min prob
-      }
-      for (int64_t m = 0; m < class_count_; m++) {
-        estimates.push_back(0.f);  //min prob
-      }
-      int64_t index = 0;
-      for (int64_t i = 0; i < class_count_; i++) {
-        for (int64_t j = i + 1; j < class_count_; j++) {
-          float val1 = sigmoid_probability(scores[index], proba_[index], probb_[index]);
-          float val2 = std::max(val1, 1.0e-7f);
-          probsp2[i * class_count_ + j] = std::min(val2, 1 - 1.0e-7f);
-          probsp2[j * class_count_ + i] = 1 - probsp2[i * class_count_ + j];
-          index++;
-        }
-      }
-      multiclass_probability(class_count_, probsp2, estimates);
-      //copy probabilities back into scores
-      scores.resize(estimates.size());
-      for (int64_t k = 0; k < static_cast<int64_t>(estimates.size()); k++) {
-        scores[k] = estimates[k];
+  } else if (mode_ == SVM_TYPE::SVM_LINEAR) {     //liblinear
+    for (int64_t j = 0; j < class_count_; j++) {  //for each class
+      scores.push_back(kernels[j] + rho_[0]);
+    }
+  }
+  if (proba_.size() > 0 && mode_ == SVM_TYPE::SVM_SVC) {
+    //compute probabilities from the scores
+    std::vector<float> estimates(class_count_, 0.f);            //min prob
+    std::vector<float> probsp2(class_count_ * class_count_, 0.f);  //min prob
+    int64_t index = 0;
+    for (int64_t i = 0; i < class_count_; i++) {
+      for (int64_t j = i + 1; j < class_count_; j++) {
+        float val1 = sigmoid_probability(scores[index], proba_[index], probb_[index]);
+        float val2 = std::max(val1, 1.0e-7f);
+        probsp2[i * class_count_ + j] = std::min(val2, 1 - 1.0e-7f);
+        probsp2[j * class_count_ + i] = 1 - probsp2[i * class_count_ + j];
+        index++;
       }
     }
-    int64_t maxvotes = 0;
-    if (votes.size() > 0) {
-      for (int64_t k = 0; k < static_cast<int64_t>(votes.size()); k++) {
-        if (votes[k] > maxvotes) {
-          maxvotes = votes[k];
-          maxclass = k;
-        }
+    multiclass_probability(class_count_, probsp2, estimates);
+    //copy probabilities back into scores
+    scores.assign(estimates.begin(), estimates.end());
+  }
+  int64_t maxvotes = 0;
+  if (votes.size() > 0) {
+    for (int64_t k = 0; k < static_cast<int64_t>(votes.size()); k++) {
+      if (votes[k] > maxvotes) {
+        maxvotes = votes[k];
+        maxclass = k;
       }
-    } else {
-      for (int64_t k = 0; k < static_cast<int64_t>(scores.size()); k++) {
-        if (scores[k] > maxweight) {
-          maxclass = k;
-          maxweight = scores[k];
-        }
+    }
+  } else {
+    for (int64_t k = 0; k < static_cast<int64_t>(scores.size()); k++) {
+      if (scores[k] > maxweight) {
+        maxclass = k;
+        maxweight = scores[k];
       }
     }
-    //write top class
-    int write_additional_scores = -1;
-    if (rho_.size() == 1)  //binary
+  }
+  //write top class
+  int write_additional_scores = -1;
+  // a binary SVC without probabilities has a single decision value, whose sign gives the label
+  const bool svc_decision = mode_ == SVM_TYPE::SVM_SVC && proba_.size() == 0;
+  if (rho_.size() == 1)  //binary
+  {
+    if (using_strings_) {
+      if (classlabels_strings_.size() == 2 && svc_decision) {
+        Y->template MutableData<std::string>()[n] = classlabels_strings_[scores[0] > 0 ? 1 : 0];
+        write_additional_scores = scores[0] > 0 ? 0 : 1;
+      } else if (classlabels_strings_.size() == 2 && weights_are_all_positive_ && maxweight >= 0.5 && proba_.size() == 0) {
+        Y->template MutableData<std::string>()[n] = classlabels_strings_[1];  //positive label
+        write_additional_scores = 0;
+      } else if (classlabels_strings_.size() == 2 && maxweight > 0 && !weights_are_all_positive_ && proba_.size() == 0) {
+        Y->template MutableData<std::string>()[n] = classlabels_strings_[1];  //positive label
+        write_additional_scores = 0;
+      } else if (classlabels_strings_.size() == 2 && proba_.size() > 0) {            //this case all classes are in their rightful spot
+        Y->template MutableData<std::string>()[n] = classlabels_strings_[maxclass];  //whichever label
+        write_additional_scores = -1;
+      } else if (classlabels_strings_.size() == 2) {
+        Y->template MutableData<std::string>()[n] = classlabels_strings_[0];  //negative label
+        write_additional_scores = 1;
+      } else if (maxweight > 0) {
+        Y->template MutableData<std::string>()[n] = "1";  //positive label
+      } else {
+        Y->template MutableData<std::string>()[n] = "0";  //negative label
+      }
+    } else  //no strings
     {
-      if (using_strings_) {
-        if (classlabels_strings_.size() == 2 && weights_are_all_positive_ && maxweight >= 0.5 && proba_.size() == 0) {
-          Y->template MutableData<std::string>()[n] = classlabels_strings_[1];  //positive label
-          write_additional_scores = 0;
-        } else if (classlabels_strings_.size() == 2 && maxweight > 0 && !weights_are_all_positive_ && proba_.size() == 0) {
-          Y->template MutableData<std::string>()[n] = classlabels_strings_[1];  //positive label
-          write_additional_scores = 0;
-        } else if (classlabels_strings_.size() == 2 && proba_.size() > 0) {            //this case all classes are in their rightful spot
-          Y->template MutableData<std::string>()[n] = classlabels_strings_[maxclass];  //whichever label
-          write_additional_scores = -1;
-        } else if (classlabels_strings_.size() == 2) {
-          Y->template MutableData<std::string>()[n] = classlabels_strings_[0];  //negative label
-          write_additional_scores = 1;
-        } else if (maxweight > 0) {
-          Y->template MutableData<std::string>()[n] = "1";  //positive label
-        } else {
-          Y->template MutableData<std::string>()[n] = "0";  //negative label
-        }
-      } else  //no strings
+      if (classlabels_ints_.size() == 2 && svc_decision) {
+        Y->template MutableData<int64_t>()[n] = classlabels_ints_[scores[0] > 0 ? 1 : 0];
+        write_additional_scores = scores[0] > 0 ? 0 : 1;
+      } else if (classlabels_ints_.size() == 2 && weights_are_all_positive_ && maxweight >= 0.5 && proba_.size() == 0) {
+        Y->template MutableData<int64_t>()[n] = classlabels_ints_[1];  //positive label
+        write_additional_scores = 0;
+      } else if (classlabels_ints_.size() == 2 && maxweight > 0 && !weights_are_all_positive_ && proba_.size() == 0) {
+        Y->template MutableData<int64_t>()[n] = classlabels_ints_[0];  //pos  label
+        write_additional_scores = 0;
+      } else if (classlabels_ints_.size() == 2 && proba_.size() > 0)  //this case all classes are in their rightful spot
       {
-        if (classlabels_ints_.size() == 2 && weights_are_all_positive_ && maxweight >= 0.5 && proba_.size() == 0) {
-          Y->template MutableData<int64_t>()[n] = classlabels_ints_[1];  //positive label
-          write_additional_scores = 0;
-        } else if (classlabels_ints_.size() == 2 && maxweight > 0 && !weights_are_all_positive_ && proba_.size() == 0) {
-          Y->template MutableData<int64_t>()[n] = classlabels_ints_[0];  //pos  label
-          write_additional_scores = 0;
-        } else if (classlabels_ints_.size() == 2 && proba_.size() > 0)  //this case all classes are in their rightful spot
-        {
-          Y->template MutableData<int64_t>()[n] = classlabels_ints_[maxclass];  //whichever label
-          write_additional_scores = -1;
-        } else if (classlabels_ints_.size() == 2) {
-          Y->template MutableData<int64_t>()[n] = classlabels_ints_[0];  //negative label
-          write_additional_scores = 1;
-        } else if (maxweight > 0) {
-          Y->template MutableData<int64_t>()[n] = 1;  //positive label
-        } else {
-          Y->template MutableData<int64_t>()[n] = 0;  //negative label
-        }
-      }
-    } else {  //multiclass
-      if (using_strings_) {
-        Y->template MutableData<std::string>()[n] = classlabels_strings_[maxclass];
+        Y->template MutableData<int64_t>()[n] = classlabels_ints_[maxclass];  //whichever label
+        write_additional_scores = -1;
+      } else if (classlabels_ints_.size() == 2) {
+        Y->template MutableData<int64_t>()[n] = classlabels_ints_[0];  //negative label
+        write_additional_scores = 1;
+      } else if (maxweight > 0) {
+        Y->template MutableData<int64_t>()[n] = 1;  //positive label
       } else {
-        Y->template MutableData<int64_t>()[n] = classlabels_ints_[maxclass];
+        Y->template MutableData<int64_t>()[n] = 0;  //negative label
       }
     }
-
-    write_scores(scores, post_transform_, zindex, Z, write_additional_scores);
-    zindex += scores.size();
+  } else {  //multiclass
+    if (using_strings_) {
+      Y->template MutableData<std::string>()[n] = classlabels_strings_[maxclass];
+    } else {
+      Y->template MutableData<int64_t>()[n] = classlabels_ints_[maxclass];
+    }
   }
 
-  return Status::OK();
+  if (post_transform_ == POST_EVAL_TRANSFORM::PROBIT && scores.size() == 1 && z_stride == 2) {
+    // as in LinearClassifier, the binary scores are expanded to both classes and PROBIT is applied to each
+    float* z = Z->template MutableData<float>() + n * z_stride;
+    z[0] = 1.f - scores[0];
+    z[1] = scores[0];
+    batched_update_scores_inplace(z, 2, 1, post_transform_);
+    return;
+  }
+  write_scores(scores, post_transform_, n * z_stride, Z, write_additional_scores);
 }
 
 }  // namespace ml
@@ -5,6 +5,8 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math_cpuonly.h"
 #include "ml_common.h"
 
@@ -29,35 +31,49 @@ class SVMCommon {
   void set_kernel_type(KERNEL new_kernel_type) { kernel_type_ = new_kernel_type; }
   KERNEL get_kernel_type() const { return kernel_type_; }
 
-  float kernel_dot(const T* A, int64_t a, const std::vector<float>& B, int64_t b, int64_t len, KERNEL k) const {
-    float sum = 0.f;
-    if (k == KERNEL::POLY) {
-      for (int64_t i = 0; i < len; i++) {
-        sum += B[b + i] * static_cast<float>(A[a + i]);
-      }
-      sum = gamma_ * sum + coef0_;
-      sum = std::pow(sum, degree_);
-    } else if (k == KERNEL::SIGMOID) {
-      for (int64_t i = 0; i < len; i++) {
-        sum += B[b + i] * static_cast<float>(A[a + i]);
-      }
-      sum = gamma_ * sum + coef0_;
-      sum = std::tanh(sum);
-    } else if (k == KERNEL::RBF) {
-      for (int64_t i = 0; i < len; i++) {
-        float val = static_cast<float>(A[a + i]) - B[b + i];
-        sum += (val * val);
-      }
-      sum = std::exp(-gamma_ * sum);
-    } else if (k == KERNEL::LINEAR) {
-      for (int64_t i = 0; i < len; i++) {
-        sum += B[b + i] * static_cast<float>(A[a + i]);
-      }
+  // Number of rows of X whose kernel values are computed by one SGEMM. Bounds the size of the kernel buffer
+  // when there are many support vectors.
+  static int64_t kernel_rows_per_batch(int64_t vector_count) {
+    return std::max<int64_t>(1, kMaxKernelBufferSize / std::max<int64_t>(1, vector_count));
+  }
+
+  // Computes the dot products between num_rows rows of x, x_stride elements apart, and each of the vector_count
+  // support vectors, writing a num_rows x vector_count matrix to kernels. apply_kernel must then be called on
+  // each row of the result. RBF kernels are computed from the differences to the support vectors instead, so
+  // nothing is done here for them.
+  void batched_kernel_dot(const float* x, int64_t num_rows, int64_t x_stride,
+                          const std::vector<float>& support_vectors, int64_t vector_count, int64_t feature_count,
+                          float* kernels, concurrency::ThreadPool* tp) const {
+    if (kernel_type_ == KERNEL::RBF) {
+      return;
+    }
+    MlasSgemm(CblasNoTrans, CblasTrans,
+              static_cast<size_t>(num_rows), static_cast<size_t>(vector_count), static_cast<size_t>(feature_count),
+              1.f, x, static_cast<size_t>(x_stride), support_vectors.data(), static_cast<size_t>(feature_count),
+              0.f, kernels, static_cast<size_t>(vector_count), tp);
+  }
+
+  // Turns the dot products between the row x and each support vector, as computed by batched_kernel_dot, into
+  // the kernel values. For RBF, ||x - sv||^2 is computed from the differences rather than expanded to
+  // ||x||^2 + ||sv||^2 - 2 x.sv, which cancels catastrophically for large features close to a support vector.
+  void apply_kernel(const float* x, int64_t feature_count, const std::vector<float>& support_vectors,
+                    float* kernels, int64_t vector_count) const {
+    EigenVectorArrayMap<float> k(kernels, vector_count);
+    if (kernel_type_ == KERNEL::POLY) {
+      k = Eigen::pow(gamma_ * k + coef0_, degree_);
+    } else if (kernel_type_ == KERNEL::SIGMOID) {
+      k = gamma_ * k + coef0_;
+      MlasComputeTanh(kernels, kernels, static_cast<size_t>(vector_count));
+    } else if (kernel_type_ == KERNEL::RBF) {
+      ConstEigenMatrixMap<float> sv(support_vectors.data(), feature_count, vector_count);
+      ConstEigenVectorMap<float> xv(x, feature_count);
+      k = (-gamma_ * (sv.colwise() - xv).colwise().squaredNorm().transpose().array()).exp();
     }
-    return sum;
   }
 
  private:
+  static constexpr int64_t kMaxKernelBufferSize = 1 << 20;
+
   KERNEL kernel_type_;
   float gamma_;
   float coef0_;
@@ -66,7 +82,9 @@ class SVMCommon {
 
 template <typename T>
 class SVMClassifier final : public OpKernel, private SVMCommon<T> {
-  using SVMCommon<T>::kernel_dot;
+  using SVMCommon<T>::kernel_rows_per_batch;
+  using SVMCommon<T>::batched_kernel_dot;
+  using SVMCommon<T>::apply_kernel;
   using SVMCommon<T>::set_kernel_type;
   using SVMCommon<T>::get_kernel_type;
 
@@ -91,6 +109,11 @@ class SVMClassifier final : public OpKernel, private SVMCommon<T> {
   std::vector<std::string> classlabels_strings_;
   POST_EVAL_TRANSFORM post_transform_;
   SVM_TYPE mode_;  //how are we computing SVM? 0=LibSVC, 1=LibLinear
+
+  // computes the label and the scores of example n from its row of dot products. scores and votes are scratch
+  // buffers that are reused across rows.
+  void ComputeRow(const float* x, float* kernels, int64_t n, Tensor* Y, Tensor* Z, int64_t z_stride,
+                  std::vector<float>& scores, std::vector<int64_t>& votes) const;
 };
 
 }  // namespace ml
@@ -43,33 +43,56 @@ Status SVMRegressor<T>::Compute(OpKernelContext* ctx) const {
   int64_t stride = X->Shape().NumDimensions() == 1 ? X->Shape()[0] : X->Shape()[1];
   int64_t N = X->Shape().NumDimensions() == 1 ? 1 : X->Shape()[0];
 
+  ORT_RETURN_IF_NOT(stride >= feature_count_, "Input has ", stride, " features but the model expects ", feature_count_);
+
   Tensor* Y = ctx->Output(0, TensorShape({N, 1}));  // this op outputs for one target only
+  if (N == 0) {
+    return Status::OK();
+  }
+
   const auto* x_data = X->template Data<T>();
+  float* y_data = Y->template MutableData<float>();
+
+  // In SVC mode a single SGEMM computes the dot products between a batch of examples and all the support vectors.
+  // In liblinear mode the same SGEMM against the coefficients directly gives the scores.
+  const bool svc = mode_ == SVM_TYPE::SVM_SVC;
+  const int64_t columns = svc ? vector_count_ : 1;
+  const int64_t rows_per_batch = std::min(N, kernel_rows_per_batch(columns));
+  std::vector<float> kernels(static_cast<size_t>(rows_per_batch * columns));
+
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  const int64_t degree = tp != nullptr ? tp->NumThreads() + 1 : 1;
+
+  for (int64_t batch_begin = 0; batch_begin < N; batch_begin += rows_per_batch) {
+    const int64_t batch_rows = std::min(rows_per_batch, N - batch_begin);
+    const T* batch_x = x_data + batch_begin * stride;
+    batched_kernel_dot(batch_x, batch_rows, stride, svc ? support_vectors_ : coefficients_, columns, feature_count_,
+                       kernels.data(), tp);
 
-  for (int64_t n = 0; n < N; n++) {  //for each example
-    int64_t current_weight_0 = n * stride;
-    std::vector<float> scores;
-
-    float sum = 0.f;
-    if (mode_ == SVM_TYPE::SVM_SVC) {
-      for (int64_t j = 0; j < vector_count_; j++) {
-        float val1 = kernel_dot(x_data, current_weight_0, support_vectors_, feature_count_ * j, feature_count_, get_kernel_type());
-        float val2 = coefficients_[j];
-        float val3 = val1 * val2;
-        sum += val3;
+    const int64_t num_chunks = std::min(batch_rows, degree);
+    concurrency::ThreadPool::TryParallelFor(tp, static_cast<int32_t>(num_chunks), [&](int32_t chunk) {
+      const int64_t row_begin = batch_rows * chunk / num_chunks;
+      const int64_t row_end = batch_rows * (chunk + 1) / num_chunks;
+      for (int64_t row = row_begin; row < row_end; row++) {
+        float* row_kernels = kernels.data() + row * columns;
+        float sum;
+        if (svc) {
+          apply_kernel(batch_x + row * stride, feature_count_, support_vectors_, row_kernels, vector_count_);
+          sum = ConstEigenVectorMap<float>(row_kernels, vector_count_)
+                    .dot(ConstEigenVectorMap<float>(coefficients_.data(), vector_count_));
+        } else {  //liblinear
+          sum = row_kernels[0];
+        }
+        sum += rho_[0];
+        if (one_class_ && sum > 0) {
+          y_data[batch_begin + row] = 1.f;
+        } else if (one_class_) {
+          y_data[batch_begin + row] = -1.f;
+        } else {
+          y_data[batch_begin + row] = sum;
+        }
       }
-      sum += rho_[0];
-    } else if (mode_ == SVM_TYPE::SVM_LINEAR) {  //liblinear
-      sum = kernel_dot(x_data, current_weight_0, coefficients_, 0, feature_count_, get_kernel_type());
-      sum += rho_[0];
-    }
-    if (one_class_ && sum > 0) {
-      Y->template MutableData<float>()[n] = 1.f;
-    } else if (one_class_) {
-      Y->template MutableData<float>()[n] = -1.f;
-    } else {
-      Y->template MutableData<float>()[n] = sum;
-    }
+    });
   }
 
   return Status::OK();
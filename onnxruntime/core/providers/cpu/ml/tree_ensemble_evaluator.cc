@@ -0,0 +1,302 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/ml/tree_ensemble_evaluator.h"
+
+#include <map>
+
+namespace onnxruntime {
+namespace ml {
+
+namespace {
+
+// number of rows evaluated against each tree before moving to the next one
+constexpr int64_t kRowBlockSize = 64;
+
+// minimum number of trees evaluated by a thread when the trees are split across the thread pool
+constexpr size_t kMinTreesPerThread = 8;
+
+template <typename T>
+inline bool TakeTrueBranch(NODE_MODE mode, T val, float threshold) {
+  switch (mode) {
+    case NODE_MODE::BRANCH_LEQ:
+      return val <= threshold;
+    case NODE_MODE::BRANCH_LT:
+      return val < threshold;
+    case NODE_MODE::BRANCH_GTE:
+      return val >= threshold;
+    case NODE_MODE::BRANCH_GT:
+      return val > threshold;
+    case NODE_MODE::BRANCH_EQ:
+      return val == threshold;
+    default:
+      return val != threshold;
+  }
+}
+
+}  // namespace
+
+template <typename T>
+TreeEnsembleEvaluator<T>::TreeEnsembleEvaluator(const std::vector<int64_t>& nodes_treeids,
+                                                const std::vector<int64_t>& nodes_nodeids,
+                                                const std::vector<int64_t>& nodes_featureids,
+                                                const std::vector<float>& nodes_values,
+                                                const std::vector<NODE_MODE>& nodes_modes,
+                                                const std::vector<int64_t>& nodes_truenodeids,
+                                                const std::vector<int64_t>& nodes_falsenodeids,
+                                                const std::vector<int64_t>& missing_tracks_true,
+                                                const std::vector<int64_t>& leaf_treeids,
+                                                const std::vector<int64_t>& leaf_nodeids,
+                                                const std::vector<int64_t>& leaf_targetids,
+                                                const std::vector<float>& leaf_weights) {
+  const size_t num_nodes = nodes_treeids.size();
+  ORT_ENFORCE(nodes_nodeids.size() == num_nodes && nodes_featureids.size() == num_nodes &&
+              nodes_values.size() == num_nodes && nodes_modes.size() == num_nodes &&
+              nodes_truenodeids.size() == num_nodes && nodes_falsenodeids.size() == num_nodes);
+  ORT_ENFORCE(leaf_nodeids.size() == leaf_treeids.size() && leaf_targetids.size() == leaf_treeids.size() &&
+              leaf_weights.size() == leaf_treeids.size());
+  ORT_ENFORCE(num_nodes < std::numeric_limits<int32_t>::max() &&
+                  leaf_weights.size() < std::numeric_limits<int32_t>::max(),
+              "Tree ensemble is too large");
+
+  // the missing value flags are only used if there is one per node
+  const bool use_missing_tracks = missing_tracks_true.size() == num_nodes;
+
+  using NodeKey = std::pair<int64_t, int64_t>;  // tree id, node id
+  std::map<NodeKey, size_t> node_index;
+  for (size_t i = 0; i < num_nodes; ++i) {
+    node_index[NodeKey(nodes_treeids[i], nodes_nodeids[i])] = i;
+  }
+
+  // resolve the children and count the parents of every node. the roots are the nodes without parents.
+  std::vector<size_t> true_child(num_nodes), false_child(num_nodes);
+  std::vector<size_t> parent_count(num_nodes, 0);
+  for (size_t i = 0; i < num_nodes; ++i) {
+    if (nodes_modes[i] == NODE_MODE::LEAF) {
+      continue;
+    }
+    auto true_it = node_index.find(NodeKey(nodes_treeids[i], nodes_truenodeids[i]));
+    auto false_it = node_index.find(NodeKey(nodes_treeids[i], nodes_falsenodeids[i]));
+    ORT_ENFORCE(true_it != node_index.end() && false_it != node_index.end(),
+                "Children of node ", nodes_nodeids[i], " of tree ", nodes_treeids[i], " are not in the tree");
+    ORT_ENFORCE(nodes_featureids[i] >= 0 && nodes_featureids[i] < std::numeric_limits<int32_t>::max(),
+                "Invalid feature id ", nodes_featureids[i], " for node ", nodes_nodeids[i],
+                " of tree ", nodes_treeids[i]);
+    true_child[i] = true_it->second;
+    false_child[i] = false_it->second;
+    ++parent_count[true_child[i]];
+    ++parent_count[false_child[i]];
+  }
+
+  std::vector<size_t> roots;
+  for (size_t i = 0; i < num_nodes; ++i) {
+    if (parent_count[i] == 0) {
+      roots.push_back(i);
+    }
+  }
+
+  // a node in a cycle is never left without parents when removing the nodes that have none
+  {
+    std::vector<size_t> remaining_parents = parent_count;
+    std::vector<size_t> ready = roots;
+    size_t removed = 0;
+    while (!ready.empty()) {
+      size_t i = ready.back();
+      ready.pop_back();
+      ++removed;
+      if (nodes_modes[i] != NODE_MODE::LEAF) {
+        if (--remaining_parents[true_child[i]] == 0) ready.push_back(true_child[i]);
+        if (--remaining_parents[false_child[i]] == 0) ready.push_back(false_child[i]);
+      }
+    }
+    ORT_ENFORCE(removed == num_nodes, "The nodes of the tree ensemble contain a cycle");
+  }
+
+  // lay out each tree in depth first order, visiting the true branch first
+  std::vector<int64_t> new_index(num_nodes, -1);
+  std::vector<size_t> order;
+  order.reserve(num_nodes);
+  for (size_t root : roots) {
+    roots_.push_back(static_cast<uint32_t>(order.size()));
+    std::vector<size_t> stack{root};
+    while (!stack.empty()) {
+      size_t i = stack.back();
+      stack.pop_back();
+      if (new_index[i] >= 0) {
+        continue;
+      }
+      new_index[i] = static_cast<int64_t>(order.size());
+      order.push_back(i);
+      if (nodes_modes[i] != NODE_MODE::LEAF) {
+        stack.push_back(false_child[i]);
+        stack.push_back(true_child[i]);
+      }
+    }
+  }
+
+  // group the weights by leaf, keeping the order of the attributes
+  std::map<NodeKey, std::vector<size_t>> leaf_weight_indices;
+  for (size_t i = 0; i < leaf_treeids.size(); ++i) {
+    ORT_ENFORCE(leaf_targetids[i] >= 0 && leaf_targetids[i] < std::numeric_limits<int32_t>::max(),
+                "Invalid target id ", leaf_targetids[i]);
+    leaf_weight_indices[NodeKey(leaf_treeids[i], leaf_nodeids[i])].push_back(i);
+    num_targets_ = std::max(num_targets_, leaf_targetids[i] + 1);
+  }
+
+  bool uniform_branch_mode = true;
+  nodes_.resize(order.size());
+  for (size_t n = 0; n < order.size(); ++n) {
+    const size_t i = order[n];
+    Node& node = nodes_[n];
+    node.mode = nodes_modes[i];
+    node.value = nodes_values[i];
+    node.missing_tracks_true = use_missing_tracks && missing_tracks_true[i] != 0;
+
+    if (node.mode == NODE_MODE::LEAF) {
+      node.feature_id = 0;
+      node.true_index = static_cast<uint32_t>(weights_.size());
+      auto weights = leaf_weight_indices.find(NodeKey(nodes_treeids[i], nodes_nodeids[i]));
+      if (weights != leaf_weight_indices.end()) {
+        for (size_t w : weights->second) {
+          weight_targets_.push_back(static_cast<int32_t>(leaf_targetids[w]));
+          weights_.push_back(leaf_weights[w]);
+        }
+      }
+      node.false_index = static_cast<uint32_t>(weights_.size());
+    } else {
+      node.feature_id = static_cast<int32_t>(nodes_featureids[i]);
+      node.true_index = static_cast<uint32_t>(new_index[true_child[i]]);
+      node.false_index = static_cast<uint32_t>(new_index[false_child[i]]);
+      max_feature_id_ = std::max(max_feature_id_, nodes_featureids[i]);
+
+      if (node.missing_tracks_true || (branch_mode_ != NODE_MODE::LEAF && branch_mode_ != node.mode)) {
+        uniform_branch_mode = false;
+      }
+      branch_mode_ = node.mode;
+    }
+  }
+
+  if (!uniform_branch_mode) {
+    branch_mode_ = NODE_MODE::LEAF;
+  }
+}
+
+template <typename T>
+template <NODE_MODE kBranchMode>
+inline const typename TreeEnsembleEvaluator<T>::Node* TreeEnsembleEvaluator<T>::FindLeaf(const Node* node,
+                                                                                          const T* x) const {
+  const Node* nodes = nodes_.data();
+  while (node->mode != NODE_MODE::LEAF) {
+    const T val = x[node->feature_id];
+    bool take_true;
+    if (kBranchMode != NODE_MODE::LEAF) {
+      take_true = TakeTrueBranch(kBranchMode, val, node->value);
+    } else {
+      take_true = TakeTrueBranch(node->mode, val, node->value) ||
+                  (node->missing_tracks_true && std::isnan(static_cast<float>(val)));
+    }
+    node = nodes + (take_true ? node->true_index : node->false_index);
+  }
+  return node;
+}
+
+template <typename T>
+template <NODE_MODE kBranchMode>
+void TreeEnsembleEvaluator<T>::EvaluateBlock(const T* x, int64_t row_begin, int64_t row_end, int64_t row_stride,
+                                             size_t tree_begin, size_t tree_end,
+                                             float* scores, uint8_t* has_score, int64_t num_columns) const {
+  for (size_t tree = tree_begin; tree < tree_end; ++tree) {
+    const Node* root = nodes_.data() + roots_[tree];
+    for (int64_t row = row_begin; row < row_end; ++row) {
+      const Node* leaf = FindLeaf<kBranchMode>(root, x + row * row_stride);
+      float* row_scores = scores + row * num_columns;
+      uint8_t* row_has_score = has_score + row * num_columns;
+      for (uint32_t w = leaf->true_index; w < leaf->false_index; ++w) {
+        row_scores[weight_targets_[w]] += weights_[w];
+        row_has_score[weight_targets_[w]] = 1;
+      }
+    }
+  }
+}
+
+template <typename T>
+void TreeEnsembleEvaluator<T>::EvaluateBlock(const T* x, int64_t row_begin, int64_t row_end, int64_t row_stride,
+                                             size_t tree_begin, size_t tree_end,
+                                             float* scores, uint8_t* has_score, int64_t num_columns) const {
+  // most ensembles use a single comparison, which can then be resolved when compiling the traversal
+  switch (branch_mode_) {
+    case NODE_MODE::BRANCH_LEQ:
+      EvaluateBlock<NODE_MODE::BRANCH_LEQ>(x, row_begin, row_end, row_stride, tree_begin, tree_end,
+                                           scores, has_score, num_columns);
+      break;
+    case NODE_MODE::BRANCH_LT:
+      EvaluateBlock<NODE_MODE::BRANCH_LT>(x, row_begin, row_end, row_stride, tree_begin, tree_end,
+                                          scores, has_score, num_columns);
+      break;
+    case NODE_MODE::BRANCH_GTE:
+      EvaluateBlock<NODE_MODE::BRANCH_GTE>(x, row_begin, row_end, row_stride, tree_begin, tree_end,
+                                           scores, has_score, num_columns);
+      break;
+    case NODE_MODE::BRANCH_GT:
+      EvaluateBlock<NODE_MODE::BRANCH_GT>(x, row_begin, row_end, row_stride, tree_begin, tree_end,
+                                          scores, has_score, num_columns);
+      break;
+    default:
+      EvaluateBlock<NODE_MODE::LEAF>(x, row_begin, row_end, row_stride, tree_begin, tree_end,
+                                     scores, has_score, num_columns);
+      break;
+  }
+}
+
+template <typename T>
+void TreeEnsembleEvaluator<T>::Evaluate(const T* x, int64_t num_rows, int64_t row_stride,
+                                        float* scores, uint8_t* has_score, int64_t num_columns,
+                                        concurrency::ThreadPool* tp) const {
+  ORT_ENFORCE(num_columns >= num_targets_);
+
+  const int64_t num_blocks = (num_rows + kRowBlockSize - 1) / kRowBlockSize;
+  const size_t num_trees = roots_.size();
+  const int64_t degree = tp != nullptr ? tp->NumThreads() + 1 : 1;
+
+  auto evaluate_rows = [&](int32_t block) {
+    const int64_t row_begin = block * kRowBlockSize;
+    const int64_t row_end = std::min(row_begin + kRowBlockSize, num_rows);
+    EvaluateBlock(x, row_begin, row_end, row_stride, 0, num_trees, scores, has_score, num_columns);
+  };
+
+  const size_t num_tree_chunks = std::min(static_cast<size_t>(degree), num_trees / kMinTreesPerThread);
+  if (num_blocks >= degree || num_tree_chunks <= 1) {
+    ORT_ENFORCE(num_blocks <= std::numeric_limits<int32_t>::max());
+    concurrency::ThreadPool::TryParallelFor(tp, static_cast<int32_t>(num_blocks), evaluate_rows);
+    return;
+  }
+
+  // too few rows to use the thread pool, so split the trees instead. each chunk of trees accumulates into its own
+  // buffers, which are added to the output in order afterwards.
+  const size_t output_size = static_cast<size_t>(num_rows * num_columns);
+  std::vector<std::vector<float>> chunk_scores(num_tree_chunks);
+  std::vector<std::vector<uint8_t>> chunk_has_score(num_tree_chunks);
+  tp->ParallelFor(static_cast<int32_t>(num_tree_chunks), [&](int32_t chunk) {
+    const size_t tree_begin = num_trees * chunk / num_tree_chunks;
+    const size_t tree_end = num_trees * (chunk + 1) / num_tree_chunks;
+    chunk_scores[chunk].assign(output_size, 0.f);
+    chunk_has_score[chunk].assign(output_size, 0);
+    EvaluateBlock(x, 0, num_rows, row_stride, tree_begin, tree_end,
+                  chunk_scores[chunk].data(), chunk_has_score[chunk].data(), num_columns);
+  });
+
+  for (size_t chunk = 0; chunk < num_tree_chunks; ++chunk) {
+    for (size_t i = 0; i < output_size; ++i) {
+      scores[i] += chunk_scores[chunk][i];
+      has_score[i] |= chunk_has_score[chunk][i];
+    }
+  }
+}
+
+template class TreeEnsembleEvaluator<float>;
+template class TreeEnsembleEvaluator<double>;
+template class TreeEnsembleEvaluator<int64_t>;
+template class TreeEnsembleEvaluator<int32_t>;
+
+}  // namespace ml
+}  // namespace onnxruntime
@@ -0,0 +1,99 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "core/common/common.h"
+#include "core/platform/threadpool.h"
+#include "ml_common.h"
+
+namespace onnxruntime {
+namespace ml {
+
+/**
+Tree ensemble compiled for evaluation, shared by TreeEnsembleClassifier and TreeEnsembleRegressor.
+
+The node attributes of the operators are compiled once into a flat array of nodes. The nodes of each tree are
+contiguous, in depth first order with the true branch following its parent, and children are referenced by their
+index in the array. The weights of each leaf are contiguous too, so evaluating a row touches the nodes on its path
+and the weights of one leaf per tree, and no lookup is needed.
+
+Rows are evaluated in blocks, tree by tree, so the nodes of a tree stay in cache for the rows of a block. The blocks
+are split across the thread pool, or the trees are if there are too few rows to keep it busy.
+*/
+template <typename T>
+class TreeEnsembleEvaluator {
+ public:
+  /**
+  Compile the ensemble. The nodes_ arguments are the node attributes of the operator, and the leaf_ arguments the
+  class_ or target_ attributes. missing_tracks_true may be empty.
+  Throws if the attributes don't describe a set of trees.
+  */
+  TreeEnsembleEvaluator(const std::vector<int64_t>& nodes_treeids,
+                        const std::vector<int64_t>& nodes_nodeids,
+                        const std::vector<int64_t>& nodes_featureids,
+                        const std::vector<float>& nodes_values,
+                        const std::vector<NODE_MODE>& nodes_modes,
+                        const std::vector<int64_t>& nodes_truenodeids,
+                        const std::vector<int64_t>& nodes_falsenodeids,
+                        const std::vector<int64_t>& missing_tracks_true,
+                        const std::vector<int64_t>& leaf_treeids,
+                        const std::vector<int64_t>& leaf_nodeids,
+                        const std::vector<int64_t>& leaf_targetids,
+                        const std::vector<float>& leaf_weights);
+
+  size_t NumTrees() const { return roots_.size(); }
+
+  /** One more than the largest target or class id voted for by a leaf. */
+  int64_t NumTargets() const { return num_targets_; }
+
+  /** Largest feature id read by a branch, or -1 if there are no branches. */
+  int64_t MaxFeatureId() const { return max_feature_id_; }
+
+  /**
+  Add the weights of the leaves reached by each row to scores, and set has_score for the targets they vote for.
+  @param x Input of num_rows rows, with row_stride elements between the rows.
+  @param scores Scores of num_rows rows of num_columns values, initialized by the caller.
+  @param has_score Flags of the same layout as scores, initialized to 0 by the caller.
+  @param num_columns Number of values per row, at least NumTargets().
+  */
+  void Evaluate(const T* x, int64_t num_rows, int64_t row_stride,
+                float* scores, uint8_t* has_score, int64_t num_columns,
+                concurrency::ThreadPool* tp) const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(TreeEnsembleEvaluator);
+
+  struct Node {
+    float value;         // threshold of a branch
+    int32_t feature_id;  // feature compared by a branch
+    uint32_t true_index;   // for a leaf, the index of its first weight
+    uint32_t false_index;  // for a leaf, the index past its last weight
+    NODE_MODE mode;
+    bool missing_tracks_true;
+  };
+
+  // kBranchMode is the mode of all the branches if they share it, or LEAF if the mode of each node must be checked
+  template <NODE_MODE kBranchMode>
+  const Node* FindLeaf(const Node* node, const T* x) const;
+
+  template <NODE_MODE kBranchMode>
+  void EvaluateBlock(const T* x, int64_t row_begin, int64_t row_end, int64_t row_stride,
+                     size_t tree_begin, size_t tree_end,
+                     float* scores, uint8_t* has_score, int64_t num_columns) const;
+
+  void EvaluateBlock(const T* x, int64_t row_begin, int64_t row_end, int64_t row_stride,
+                     size_t tree_begin, size_t tree_end,
+                     float* scores, uint8_t* has_score, int64_t num_columns) const;
+
+  std::vector<Node> nodes_;
+  std::vector<uint32_t> roots_;
+  std::vector<int32_t> weight_targets_;
+  std::vector<float> weights_;
+
+  int64_t num_targets_ = 0;
+  int64_t max_feature_id_ = -1;
+  NODE_MODE branch_mode_ = NODE_MODE::LEAF;
+};
+
+}  // namespace ml
+}  // namespace onnxruntime
@@ -75,7 +75,8 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
                     strides.data(),
                     output_shape.GetDims().data(),
                     static_cast<size_t>(M / group_),
-                    &WorkingBufferSize);
+                    &WorkingBufferSize,
+                    context->GetOperatorThreadPool());
 
     auto working_data = WorkingBufferSize > 0 ? alloc->Alloc(sizeof(float) * WorkingBufferSize) : nullptr;
     BufferUniquePtr working_buffer(working_data, BufferDeleter(alloc));
@@ -85,7 +86,8 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
              W->template Data<float>(),
              B != nullptr ? B->template Data<float>() : nullptr,
              static_cast<float*>(working_buffer.get()),
-             Ydata);
+             Ydata,
+             context->GetOperatorThreadPool());
 
     //TODO: this will be replaced with Tracy's changes.
     fuse_activation(activation_, Ydata, Y->Shape().Size(), alpha_);
@@ -124,7 +126,7 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
             static_cast<int>(kernel_shape.size()),
             col_buffer_data,
             &CPUMathUtil::Instance());
-        math::Gemm<float, CPUMathUtil>(
+        math::Gemm<float, concurrency::ThreadPool>(
             CblasNoTrans,
             CblasNoTrans,
             M / group_,
@@ -135,7 +137,7 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
             col_buffer_data,
             0,
             Ydata + group_id * Y_offset,
-            &CPUMathUtil::Instance());
+            context->GetOperatorThreadPool());
       }
 
       if (B != nullptr) {
@@ -108,7 +108,7 @@ class ConvBase {
     if (kernel_shape_specified_)
       return kernel_shape_;
     else {
-      auto& weight_dims = weight_shape.GetDims();
+      const auto& weight_dims = weight_shape.GetDims();
       std::vector<int64_t> result(weight_dims.begin() + 2, weight_dims.end());
       return result;
     }
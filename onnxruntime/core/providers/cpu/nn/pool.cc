@@ -188,7 +188,8 @@ Status PoolBase::Compute(OpKernelContext* context, MLAS_POOLING_KIND kind) const
            global_pooling_ ? nullptr : strides_.data(),
            output_dims.data(),
            X->template Data<float>(),
-           Y->template MutableData<float>());
+           Y->template MutableData<float>(),
+           context->GetOperatorThreadPool());
 
   return Status::OK();
 }
@@ -158,7 +158,7 @@ class PoolBase {
     return output_dims;
   }
 
-  inline void InferOutputSize(const std::vector<int64_t>& input_dims,
+  inline void InferOutputSize(TensorShapeView input_dims,
                               std::vector<int64_t>* output_dims,
                               std::vector<int64_t>* pads) const {
     ORT_ENFORCE(input_dims.size() >= 2);
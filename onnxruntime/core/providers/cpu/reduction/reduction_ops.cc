@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/reduction/reduction_ops.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math_cpuonly.h"
 using namespace std;
 namespace onnxruntime {
@@ -34,387 +35,450 @@ REGISTER_UNARY_ELEMENTWISE_KERNEL(ReduceSumSquare, 1);
 REGISTER_UNARY_ELEMENTWISE_KERNEL(ArgMax, 1);
 REGISTER_UNARY_ELEMENTWISE_KERNEL(ArgMin, 1);
 
-// When all reduce axises located at the tail of the dims, quite general cases, transpose and extra
-// copy could be skiped to improve performance, if required by check_no_transpose = true;
-// return value: true means transposedInputData is not created/copied, input tensor data could
-//               be direct use as row major matrix [block_size, blocks], where blocks is the
-//               size of each reduce.
-template <typename T>
-bool PrepareForReduce(OpKernelContext* ctx,
-                      std::vector<T>& transposedInputData,
-                      Tensor** reducedTensor,
-                      int64_t& block_size,
-                      int64_t& blocks,
-                      const std::vector<int64_t>& axes_,
-                      bool keepdims_,
-                      bool check_no_transpose = false) {
+// Describes how to reduce the input in its original layout. Axes of size 1 are dropped and adjacent axes
+// that are both kept or both reduced are merged, so the input becomes a short list of alternating kept and
+// reduced dimensions, and is walked as runs of inner_size contiguous elements.
+//
+// If the innermost merged axis is reduced, each output element is reduced from the runs at
+// input + OutputOffset(o) + RunOffset(r). e.g. reducing the last axis, or reducing N, H and W of NCHW.
+//
+// If the innermost merged axis is kept, outputs are produced in groups of inner_size contiguous elements, and
+// the runs at input + OutputOffset(g) + RunOffset(r) are reduced element-wise into group g.
+// e.g. reducing the leading axes.
+//
+// The outer kept or reduced axes usually merge into a single axis, whose offsets are a multiple of its stride.
+// The offsets are only enumerated when they don't.
+struct ReductionPlan {
+  bool reduce_inner = true;
+  int64_t inner_size = 1;
+  int64_t reduced_count = 1;  // number of input elements reduced into each output element
+  int64_t output_count = 1;   // number of output elements, or groups of them
+  int64_t output_stride = 0;
+  int64_t run_count = 1;
+  int64_t run_stride = 0;
+  std::vector<int64_t> output_offsets;
+  std::vector<int64_t> run_offsets;
+
+  int64_t OutputOffset(int64_t o) const { return output_offsets.empty() ? o * output_stride : output_offsets[o]; }
+  int64_t RunOffset(int64_t r) const { return run_offsets.empty() ? r * run_stride : run_offsets[r]; }
+};
+
+// Offsets of all the positions of an index space, in row major order.
+static std::vector<int64_t> EnumerateOffsets(const std::vector<int64_t>& dims, const std::vector<int64_t>& strides) {
+  std::vector<int64_t> offsets{0};
+  for (size_t i = 0; i < dims.size(); ++i) {
+    std::vector<int64_t> next;
+    next.reserve(offsets.size() * dims[i]);
+    for (int64_t base : offsets) {
+      for (int64_t j = 0; j < dims[i]; ++j) {
+        next.push_back(base + j * strides[i]);
+      }
+    }
+    offsets.swap(next);
+  }
+  return offsets;
+}
+
+// Create the output tensor, with the reduced axes removed or set to 1 depending on keepdims_, and the plan
+// to reduce the input into it.
+static void PrepareForReduce(OpKernelContext* ctx,
+                             ReductionPlan& plan,
+                             Tensor** reducedTensor,
+                             const std::vector<int64_t>& axes_,
+                             bool keepdims_) {
   const Tensor* input_tensor_ptr = ctx->Input<Tensor>(0);
   ORT_ENFORCE(input_tensor_ptr != nullptr);
   const Tensor& input = *input_tensor_ptr;
 
-  size_t ndim = input.Shape().GetDims().size();
+  const auto& in_dims = input.Shape().GetDims();
+  size_t ndim = in_dims.size();
   for (int64_t axe : axes_) {
     ORT_ENFORCE(axe >= 0 && axe < (int64_t)ndim, "Axis attribute out of range");
   }
 
-  std::vector<int64_t> axes = axes_;
-  if (axes.empty()) {
-    // This is the default case for non-arg kind reductions. Reduce on all dimensions.
-    for (int i = 0; i < ndim; i++)
-      axes.push_back(i);
-  }
-
-  std::sort(axes.begin(), axes.end());
-
-  // If all reduced axes are located at the tail of the input shape, then copy could be skipped is required
-  bool need_copy = true;
-  if (axes.size() <= ndim && axes.front() == static_cast<int64_t>(ndim - axes.size()) 
-      && axes.back() == static_cast<int64_t>(ndim) - 1) {
-    need_copy = false;
-  }
-
-  vector<bool> keep_axis(ndim, true);
-  for (auto i : axes) {
+  // no axes means reducing all of them
+  vector<bool> keep_axis(ndim, !axes_.empty());
+  for (auto i : axes_) {
     keep_axis[i] = false;
   }
 
-  //transpose the input so that all to-be-reduced axes are at the head
-  vector<int64_t> transposed_axes(axes.begin(), axes.end());
-  for (int i = 0; i < ndim; ++i) {
+  //set to-be-reduced axes to one. squeeze is keepdims_ is false
+  std::vector<int64_t> reduced_dims;
+  for (size_t i = 0; i < ndim; i++) {
     if (keep_axis[i]) {
-      transposed_axes.push_back(i);
+      reduced_dims.push_back(in_dims[i]);
+    } else if (keepdims_) {
+      reduced_dims.push_back(1);
     }
   }
 
-  vector<int64_t> new_dims_(transposed_axes.size());
-  for (int i = 0; i < transposed_axes.size(); ++i) {
-    new_dims_[i] = input.Shape().GetDims().at(transposed_axes[i]);
-  }
-
-  int num_axes = static_cast<int>(transposed_axes.size());
-  auto in_dims = input.Shape().GetDims();
+  *reducedTensor = ctx->Output(0, reduced_dims);
 
-  // Measure amount of contiguous data we can copy at once
-  int64_t blocksize = 1;
-  int n_shared_idxs = 0;
-  for (int i = num_axes - 1; i >= 0; --i) {
-    if (transposed_axes[i] == i) {
-      blocksize *= new_dims_[i];
-      ++n_shared_idxs;
+  // merge the axes
+  std::vector<int64_t> dims;
+  std::vector<bool> reduced;
+  for (size_t i = 0; i < ndim; i++) {
+    if (in_dims[i] == 1) {
+      continue;
+    }
+    if (!dims.empty() && reduced.back() == !keep_axis[i]) {
+      dims.back() *= in_dims[i];
     } else {
-      break;
+      dims.push_back(in_dims[i]);
+      reduced.push_back(!keep_axis[i]);
     }
   }
+  if (dims.empty()) {
+    dims.push_back(1);
+    reduced.push_back(true);
+  }
 
-  const T* from_data = input.template Data<T>();
-  size_t count = input.Shape().Size();
+  std::vector<int64_t> strides(dims.size());
+  int64_t stride = 1;
+  for (size_t i = dims.size(); i-- > 0;) {
+    strides[i] = stride;
+    stride *= dims[i];
+  }
 
-  //set to-be-reduced axes to one. squeeze is keepdims_ is false
-  int64_t first_dim = 1;
-  std::vector<int64_t> reduced_dims;
-  for (int i = 0; i < in_dims.size(); i++) {
-    if (keep_axis[i]) {
-      reduced_dims.push_back(in_dims[i]);
+  plan.reduce_inner = reduced.back();
+  plan.inner_size = dims.back();
+
+  std::vector<int64_t> kept_dims, kept_strides, reduced_dims_outer, reduced_strides;
+  plan.reduced_count = plan.reduce_inner ? plan.inner_size : 1;
+  for (size_t i = 0; i + 1 < dims.size(); i++) {
+    if (reduced[i]) {
+      reduced_dims_outer.push_back(dims[i]);
+      reduced_strides.push_back(strides[i]);
+      plan.reduced_count *= dims[i];
     } else {
-      first_dim *= in_dims[i];
-      if (keepdims_) {
-        reduced_dims.push_back(1);
-      }
+      kept_dims.push_back(dims[i]);
+      kept_strides.push_back(strides[i]);
     }
   }
 
-  *reducedTensor = ctx->Output(0, reduced_dims);
-  block_size = input.Shape().Size() / first_dim;
-  blocks = first_dim;
-
-  if (!need_copy && check_no_transpose) {
-    return true;
+  for (int64_t dim : kept_dims) {
+    plan.output_count *= dim;
+  }
+  for (int64_t dim : reduced_dims_outer) {
+    plan.run_count *= dim;
   }
 
-  transposedInputData.resize(input.Shape().Size(), 0);
-  T* to_data = &transposedInputData[0];
-  if (num_axes < 2 || n_shared_idxs == num_axes) {
-    memcpy(to_data, from_data, count * sizeof(T));
-    return false;
+  if (kept_dims.size() == 1) {
+    plan.output_stride = kept_strides[0];
+  } else if (kept_dims.size() > 1) {
+    plan.output_offsets = EnumerateOffsets(kept_dims, kept_strides);
   }
+  if (reduced_dims_outer.size() == 1) {
+    plan.run_stride = reduced_strides[0];
+  } else if (reduced_dims_outer.size() > 1) {
+    plan.run_offsets = EnumerateOffsets(reduced_dims_outer, reduced_strides);
+  }
+}
 
-  int itr_axes = num_axes - n_shared_idxs;
+// Run fn(first, last) over [0, count) on the thread pool, unless the work is too small to be worth it.
+static void ParallelForReduction(concurrency::ThreadPool* tp, int64_t count, int64_t cost_per_item,
+                                 const std::function<void(int64_t, int64_t)>& fn) {
+  constexpr int64_t kMinWorkPerBlock = 16 * 1024;
 
-  // Calculate strides
-  std::vector<int64_t> stride_x(itr_axes, 0);
-  for (size_t i = 0; i < itr_axes; i++) {
-    stride_x[i] = 1;
-    for (size_t j = transposed_axes[i] + 1; j < itr_axes; j++) {
-      stride_x[i] *= in_dims[j];
-    }
+  int64_t items_per_block = std::max<int64_t>(kMinWorkPerBlock / std::max<int64_t>(cost_per_item, 1), 1);
+  if (tp == nullptr || count <= items_per_block) {
+    fn(0, count);
+    return;
   }
 
-  std::vector<int64_t> itr_idxs(itr_axes, 0);
-
-  // Branch here to avoid branching within the loop
-  if (blocksize > 1) {
-    for (size_t index = 0; index < (count / blocksize); index++) {
-      int64_t from_index = 0;
-      for (int i = 0; i < itr_axes; ++i) {
-        from_index += stride_x[i] * itr_idxs[i];
-      }
+  int64_t degree = tp->NumThreads() + 1;
+  items_per_block = std::max(items_per_block, (count + degree - 1) / degree);
+  tp->ParallelForRange(0, count, items_per_block, fn);
+}
 
-      memcpy(
-          to_data + blocksize * index,
-          from_data + blocksize * from_index,
-          blocksize * sizeof(T));
+static constexpr int64_t kColumnBlock = 256;
+
+// Reduce the input following plan. TAggregator defines the reduction:
+//   Init()                   - initial value of the accumulator
+//   Reduce(acc, run)         - accumulate a contiguous run of input elements into one value
+//   Accumulate(acc, run)     - accumulate a contiguous run of input elements element-wise into acc
+//   Finalize(acc, count)     - produce the output value from the accumulator of count input elements
+template <typename T, typename TAggregator>
+void ReduceWithPlan(const ReductionPlan& plan, const T* input, T* output, concurrency::ThreadPool* tp) {
+  const int64_t inner_size = plan.inner_size;
+
+  if (plan.reduce_inner) {
+    ParallelForReduction(
+        tp, plan.output_count, plan.reduced_count,
+        [&plan, input, output, inner_size](int64_t first, int64_t last) {
+          for (int64_t o = first; o < last; ++o) {
+            const T* base = input + plan.OutputOffset(o);
+            T acc = TAggregator::Init();
+            for (int64_t r = 0; r < plan.run_count; ++r) {
+              acc = TAggregator::Reduce(acc, ConstEigenVectorArrayMap<T>(base + plan.RunOffset(r), inner_size));
+            }
+            output[o] = TAggregator::Finalize(acc, plan.reduced_count);
+          }
+        });
+    return;
+  }
 
-      ++itr_idxs[itr_axes - 1];
-      for (int i = itr_axes - 1; i >= 1; --i) {
-        auto expected_dim = new_dims_[i];
-        if (itr_idxs[i] < expected_dim) {
-          break;
+  // split the groups into blocks of columns so that there is parallelism even when there are few groups
+  const int64_t blocks_per_group = (inner_size + kColumnBlock - 1) / kColumnBlock;
+  ParallelForReduction(
+      tp, plan.output_count * blocks_per_group,
+      plan.reduced_count * std::min(inner_size, kColumnBlock),
+      [&plan, input, output, inner_size, blocks_per_group](int64_t first, int64_t last) {
+        for (int64_t i = first; i < last; ++i) {
+          const int64_t group = i / blocks_per_group;
+          const int64_t column = (i % blocks_per_group) * kColumnBlock;
+          const int64_t columns = std::min(kColumnBlock, inner_size - column);
+
+          const T* base = input + plan.OutputOffset(group) + column;
+          T* out = output + group * inner_size + column;
+
+          EigenVectorArrayMap<T> acc(out, columns);
+          acc.setConstant(TAggregator::Init());
+          for (int64_t r = 0; r < plan.run_count; ++r) {
+            TAggregator::Accumulate(acc, ConstEigenVectorArrayMap<T>(base + plan.RunOffset(r), columns));
+          }
+          for (int64_t j = 0; j < columns; ++j) {
+            out[j] = TAggregator::Finalize(out[j], plan.reduced_count);
+          }
         }
-        itr_idxs[i] %= expected_dim;
-        ++itr_idxs[i - 1];
-      }
-    }
-  } else {
-    for (size_t index = 0; index < count; index++) {
-      int64_t from_index = 0;
-      for (int i = 0; i < itr_axes; ++i) {
-        from_index += stride_x[i] * itr_idxs[i];
-      }
+      });
+}
 
-      *(to_data + index) = *(from_data + from_index);
+template <typename T>
+struct ReduceAggregatorSum {
+  static T Init() { return 0; }
+  static T Reduce(T acc, const ConstEigenVectorArrayMap<T>& run) { return acc + run.sum(); }
+  static void Accumulate(EigenVectorArrayMap<T>& acc, const ConstEigenVectorArrayMap<T>& run) { acc += run; }
+  static T Finalize(T acc, int64_t) { return acc; }
+};
 
-      ++itr_idxs[itr_axes - 1];
-      for (int i = itr_axes - 1; i >= 1; --i) {
-        auto expected_dim = new_dims_[i];
-        if (itr_idxs[i] < expected_dim) {
-          break;
-        }
-        itr_idxs[i] %= expected_dim;
-        ++itr_idxs[i - 1];
-      }
-    }
-  }
-  return false;
-}
+template <typename T>
+struct ReduceAggregatorSumSquare : ReduceAggregatorSum<T> {
+  static T Reduce(T acc, const ConstEigenVectorArrayMap<T>& run) { return acc + run.square().sum(); }
+  static void Accumulate(EigenVectorArrayMap<T>& acc, const ConstEigenVectorArrayMap<T>& run) { acc += run.square(); }
+};
 
 template <typename T>
-Status ReduceL1<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+struct ReduceAggregatorL1 : ReduceAggregatorSum<T> {
+  static T Reduce(T acc, const ConstEigenVectorArrayMap<T>& run) { return acc + run.abs().sum(); }
+  static void Accumulate(EigenVectorArrayMap<T>& acc, const ConstEigenVectorArrayMap<T>& run) { acc += run.abs(); }
+};
 
-  T* output_data = reduced->template MutableData<T>();
+template <typename T>
+struct ReduceAggregatorL2 : ReduceAggregatorSumSquare<T> {
+  static T Finalize(T acc, int64_t) { return static_cast<T>(std::sqrt(acc)); }
+};
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).cwiseAbs().rowwise().sum();
+template <typename T>
+struct ReduceAggregatorMean : ReduceAggregatorSum<T> {
+  static T Finalize(T acc, int64_t count) { return acc / static_cast<T>(count); }
+};
 
-  return Status::OK();
-}
+template <typename T>
+struct ReduceAggregatorLogSum : ReduceAggregatorSum<T> {
+  static T Finalize(T acc, int64_t) { return static_cast<T>(std::log(acc)); }
+};
 
 template <typename T>
-Status ReduceL2<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+struct ReduceAggregatorProd : ReduceAggregatorSum<T> {
+  static T Init() { return 1; }
+  static T Reduce(T acc, const ConstEigenVectorArrayMap<T>& run) { return acc * run.prod(); }
+  static void Accumulate(EigenVectorArrayMap<T>& acc, const ConstEigenVectorArrayMap<T>& run) { acc *= run; }
+};
 
-  T* output_data = reduced->template MutableData<T>();
+template <typename T>
+struct ReduceAggregatorMax : ReduceAggregatorSum<T> {
+  static T Init() { return std::numeric_limits<T>::lowest(); }
+  static T Reduce(T acc, const ConstEigenVectorArrayMap<T>& run) { return std::max(acc, run.maxCoeff()); }
+  static void Accumulate(EigenVectorArrayMap<T>& acc, const ConstEigenVectorArrayMap<T>& run) { acc = acc.max(run); }
+};
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().norm();
+template <typename T>
+struct ReduceAggregatorMin : ReduceAggregatorSum<T> {
+  static T Init() { return std::numeric_limits<T>::max(); }
+  static T Reduce(T acc, const ConstEigenVectorArrayMap<T>& run) { return std::min(acc, run.minCoeff()); }
+  static void Accumulate(EigenVectorArrayMap<T>& acc, const ConstEigenVectorArrayMap<T>& run) { acc = acc.min(run); }
+};
+
+template <typename T, typename TAggregator>
+static Status ComputeReduction(OpKernelContext* ctx, const std::vector<int64_t>& axes, bool keepdims) {
+  ReductionPlan plan;
+  Tensor* reduced;
+  PrepareForReduce(ctx, plan, &reduced, axes, keepdims);
+
+  ReduceWithPlan<T, TAggregator>(plan, ctx->Input<Tensor>(0)->template Data<T>(),
+                                 reduced->template MutableData<T>(), ctx->GetOperatorThreadPool());
 
   return Status::OK();
 }
 
 template <typename T>
-Status ReduceLogSum<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  T* output_data = reduced->template MutableData<T>();
+Status ReduceL1<T>::Compute(OpKernelContext* ctx) const {
+  return ComputeReduction<T, ReduceAggregatorL1<T>>(ctx, axes_, keepdims_);
+}
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().sum();
-  for (int j = 0; j < block_size; ++j) {
-    *(output_data) = static_cast<T>(std::log(*(output_data)));
-    ++output_data;
-  }
+template <typename T>
+Status ReduceL2<T>::Compute(OpKernelContext* ctx) const {
+  return ComputeReduction<T, ReduceAggregatorL2<T>>(ctx, axes_, keepdims_);
+}
 
-  return Status::OK();
+template <typename T>
+Status ReduceLogSum<T>::Compute(OpKernelContext* ctx) const {
+  return ComputeReduction<T, ReduceAggregatorLogSum<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceLogSumExp<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
+  ReductionPlan plan;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+  PrepareForReduce(ctx, plan, &reduced, axes_, keepdims_);
 
+  const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
   T* output_data = reduced->template MutableData<T>();
-
-  for (int j = 0; j < block_size; ++j) {
-    T max_value = std::numeric_limits<T>::lowest();
-    for (int i = 0; i < blocks; ++i) {
-      max_value = std::max(max_value, transposedInputData[i * block_size + j]);
-    }
-    T scaled_exp_sum = 0;
-    for (int i = 0; i < blocks; ++i) {
-      scaled_exp_sum += static_cast<T>(std::exp(transposedInputData[i * block_size + j] - max_value));
-    }
-    *(output_data++) = static_cast<T>(std::log(scaled_exp_sum) + max_value);
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+
+  // find the max value of each output first, and then sum the exponentials relative to it
+  ReduceWithPlan<T, ReduceAggregatorMax<T>>(plan, input_data, output_data, tp);
+
+  const int64_t inner_size = plan.inner_size;
+  if (plan.reduce_inner) {
+    ParallelForReduction(
+        tp, plan.output_count, plan.reduced_count,
+        [&plan, input_data, output_data, inner_size](int64_t first, int64_t last) {
+          for (int64_t o = first; o < last; ++o) {
+            const T* base = input_data + plan.OutputOffset(o);
+            const T max_value = output_data[o];
+            T scaled_exp_sum = 0;
+            for (int64_t r = 0; r < plan.run_count; ++r) {
+              const T* run = base + plan.RunOffset(r);
+              for (int64_t i = 0; i < inner_size; ++i) {
+                scaled_exp_sum += static_cast<T>(std::exp(run[i] - max_value));
+              }
+            }
+            output_data[o] = static_cast<T>(std::log(scaled_exp_sum) + max_value);
+          }
+        });
+  } else {
+    ParallelForReduction(
+        tp, plan.output_count, plan.reduced_count * inner_size,
+        [&plan, input_data, output_data, inner_size](int64_t first, int64_t last) {
+          std::vector<T> scaled_exp_sum(inner_size);
+          for (int64_t group = first; group < last; ++group) {
+            const T* base = input_data + plan.OutputOffset(group);
+            T* out = output_data + group * inner_size;
+            std::fill(scaled_exp_sum.begin(), scaled_exp_sum.end(), T{0});
+            for (int64_t r = 0; r < plan.run_count; ++r) {
+              const T* run = base + plan.RunOffset(r);
+              for (int64_t i = 0; i < inner_size; ++i) {
+                scaled_exp_sum[i] += static_cast<T>(std::exp(run[i] - out[i]));
+              }
+            }
+            for (int64_t i = 0; i < inner_size; ++i) {
+              out[i] = static_cast<T>(std::log(scaled_exp_sum[i]) + out[i]);
+            }
+          }
+        });
   }
+
   return Status::OK();
 }
 
 template <typename T>
 Status ReduceMax<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().maxCoeff();
-
-  return Status::OK();
+  return ComputeReduction<T, ReduceAggregatorMax<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceMean<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
-
-    #pragma omp parallel for
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).mean();
-    }
-  }
-  else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().mean();
-  }
-
-  return Status::OK();
+  return ComputeReduction<T, ReduceAggregatorMean<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceMin<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().minCoeff();
-
-  return Status::OK();
+  return ComputeReduction<T, ReduceAggregatorMin<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceProd<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().prod();
-
-  return Status::OK();
+  return ComputeReduction<T, ReduceAggregatorProd<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceSum<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
-    
-    #pragma omp parallel for
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).sum();
-    }
-  }
-  else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().sum();
-  }
-
-  return Status::OK();
+  return ComputeReduction<T, ReduceAggregatorSum<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceSumSquare<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
+  return ComputeReduction<T, ReduceAggregatorSumSquare<T>>(ctx, axes_, keepdims_);
+}
+
+// ArgMax and ArgMin reduce a single axis, so the index of a run, or the position of an element in
+// the run, is the index along that axis. The first occurrence wins on ties.
+template <typename T, typename TCompare>
+static Status ArgReduce(OpKernelContext* ctx, const std::vector<int64_t>& axes, bool keepdims) {
+  ReductionPlan plan;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+  PrepareForReduce(ctx, plan, &reduced, axes, keepdims);
 
-  T* output_data = reduced->template MutableData<T>();
+  const Tensor* input = ctx->Input<Tensor>(0);
+  ORT_RETURN_IF_NOT(input->Shape().Size() > 0 || reduced->Shape().Size() == 0, "Can't reduce an empty axis");
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().squaredNorm();
+  const T* input_data = input->template Data<T>();
+  int64_t* output_data = reduced->template MutableData<int64_t>();
+  const int64_t inner_size = plan.inner_size;
+  TCompare better;
+
+  if (plan.reduce_inner) {
+    ParallelForReduction(
+        ctx->GetOperatorThreadPool(), plan.output_count, plan.reduced_count,
+        [&plan, input_data, output_data, inner_size, better](int64_t first, int64_t last) {
+          for (int64_t o = first; o < last; ++o) {
+            const T* run = input_data + plan.OutputOffset(o);
+            int64_t best = 0;
+            for (int64_t i = 1; i < inner_size; ++i) {
+              if (better(run[i], run[best])) {
+                best = i;
+              }
+            }
+            output_data[o] = best;
+          }
+        });
+  } else {
+    ParallelForReduction(
+        ctx->GetOperatorThreadPool(), plan.output_count,
+        plan.reduced_count * inner_size,
+        [&plan, input_data, output_data, inner_size, better](int64_t first, int64_t last) {
+          std::vector<T> best_values(inner_size);
+          for (int64_t group = first; group < last; ++group) {
+            const T* base = input_data + plan.OutputOffset(group);
+            int64_t* out = output_data + group * inner_size;
+            std::copy(base, base + inner_size, best_values.begin());
+            std::fill(out, out + inner_size, int64_t{0});
+            for (int64_t r = 1; r < plan.run_count; ++r) {
+              const T* run = base + plan.RunOffset(r);
+              for (int64_t i = 0; i < inner_size; ++i) {
+                if (better(run[i], best_values[i])) {
+                  best_values[i] = run[i];
+                  out[i] = r;
+                }
+              }
+            }
+          }
+        });
+  }
 
   return Status::OK();
 }
 
 template <typename T>
 Status ArgMax<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  int64_t* output_data = reduced->template MutableData<int64_t>();
-
-  Eigen::MatrixXf::Index maxIndex;
-  auto matrixData = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks);
-  for (int i = 0; i < block_size; ++i) {
-    matrixData.row(i).maxCoeff(&maxIndex);
-    *(output_data++) = maxIndex;
-  }
-
-  return Status::OK();
+  return ArgReduce<T, std::greater<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ArgMin<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size, blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  int64_t* output_data = reduced->template MutableData<int64_t>();
-
-  Eigen::MatrixXf::Index minIndex;
-  auto matrixData = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks);
-  for (int i = 0; i < block_size; ++i) {
-    matrixData.row(i).minCoeff(&minIndex);
-    *(output_data++) = minIndex;
-  }
-
-  return Status::OK();
+  return ArgReduce<T, std::less<T>>(ctx, axes_, keepdims_);
 }
 
 }  // namespace onnxruntime
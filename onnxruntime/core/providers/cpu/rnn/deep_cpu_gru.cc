@@ -12,7 +12,6 @@
 #include "core/providers/cpu/rnn/deep_cpu_gru.h"
 
 #include <algorithm>
-#include <future>
 #include <stdexcept>
 
 #include "core/common/logging/logging.h"
@@ -177,7 +176,7 @@ class UniDirectionalGru {
                     const ActivationFuncs::Entry& activation_func_f,
                     const ActivationFuncs::Entry& activation_func_g,
                     const float clip,
-                    TaskThreadPool& ttp);
+                    concurrency::ThreadPool* thread_pool);
 
   void Compute(const gsl::span<const T>& inputs,
                const gsl::span<const int>& sequence_lengths,
@@ -192,7 +191,7 @@ class UniDirectionalGru {
  private:
   AllocatorPtr allocator_;
   const logging::Logger& logger_;
-  TaskThreadPool& ttp_;
+  concurrency::ThreadPool* thread_pool_;
 
   int seq_length_;
   int batch_size_;
@@ -309,6 +308,8 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   TensorShape Y_h_dims{num_directions_, batch_size, hidden_size_};
   Tensor* Y_h = context.Output(/*index*/ 1, Y_h_dims);
 
+  concurrency::ThreadPool* thread_pool = context.GetOperatorThreadPool();
+
   AllocatorPtr alloc;
   status = context.GetTempSpaceAllocator(&alloc);
   ORT_RETURN_IF_ERROR(status);
@@ -374,36 +375,35 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
     gsl::span<T> hidden_output_2 = hidden_output.subspan(hidden_output_size_per_direction,
                                                          hidden_output_size_per_direction);
 
-#ifndef USE_MKLDNN
-    std::packaged_task<void()> task_fw{
-        [&]() {
-#endif // ! USE_MKLDNN
-          std::unique_ptr<detail::UniDirectionalGru<T>> fw = std::make_unique<detail::UniDirectionalGru<T>>(
-              alloc, logger,
-              seq_length, batch_size, input_size, hidden_size_, linear_before_reset_, Direction::kForward,
-              bias_1, initial_hidden_1,
-              activation_funcs_.Entries()[0],
-              activation_funcs_.Entries()[1],
-              clip_, ttp_);
-          fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1);
-#ifndef USE_MKLDNN
-        }};
-    auto task_results_fw = task_fw.get_future();
-    ttp_.RunTask(std::move(task_fw));
-#endif // ! USE_MKLDNN
-
-    std::unique_ptr<detail::UniDirectionalGru<T>> bw = std::make_unique<detail::UniDirectionalGru<T>>(
-        alloc, logger,
-        seq_length, batch_size, input_size, hidden_size_, linear_before_reset_, Direction::kReverse,
-        bias_2, initial_hidden_2,
-        activation_funcs_.Entries()[2],
-        activation_funcs_.Entries()[3],
-        clip_, ttp_);
-    bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_2, output_2, hidden_output_2);
+    auto compute_direction = [&](int32_t direction) {
+      if (direction == 0) {
+        std::unique_ptr<detail::UniDirectionalGru<T>> fw = std::make_unique<detail::UniDirectionalGru<T>>(
+            alloc, logger,
+            seq_length, batch_size, input_size, hidden_size_, linear_before_reset_, Direction::kForward,
+            bias_1, initial_hidden_1,
+            activation_funcs_.Entries()[0],
+            activation_funcs_.Entries()[1],
+            clip_, thread_pool);
+        fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1);
+      } else {
+        std::unique_ptr<detail::UniDirectionalGru<T>> bw = std::make_unique<detail::UniDirectionalGru<T>>(
+            alloc, logger,
+            seq_length, batch_size, input_size, hidden_size_, linear_before_reset_, Direction::kReverse,
+            bias_2, initial_hidden_2,
+            activation_funcs_.Entries()[2],
+            activation_funcs_.Entries()[3],
+            clip_, thread_pool);
+        bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_2, output_2, hidden_output_2);
+      }
+    };
 
 #ifndef USE_MKLDNN
-    task_results_fw.get();
-#endif // ! USE_MKLDNN
+    // run the two directions concurrently
+    concurrency::ThreadPool::TryParallelFor(thread_pool, 2, compute_direction);
+#else
+    compute_direction(0);
+    compute_direction(1);
+#endif  // ! USE_MKLDNN
   } else {
     std::unique_ptr<detail::UniDirectionalGru<T>> gru_p = std::make_unique<detail::UniDirectionalGru<T>>(
         alloc, logger,
@@ -411,7 +411,7 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
         bias_1, initial_hidden_1,
         activation_funcs_.Entries()[0],
         activation_funcs_.Entries()[1],
-        clip_, ttp_);
+        clip_, thread_pool);
 
     gru_p->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1);
   }
@@ -442,10 +442,10 @@ UniDirectionalGru<T>::UniDirectionalGru(AllocatorPtr allocator,
                                         const ActivationFuncs::Entry& activation_func_f,
                                         const ActivationFuncs::Entry& activation_func_g,
                                         const float clip,
-                                        TaskThreadPool& ttp)
+                                        concurrency::ThreadPool* thread_pool)
     : allocator_(allocator),
       logger_(logger),
-      ttp_(ttp),
+      thread_pool_(thread_pool),
       seq_length_(seq_length),
       batch_size_(batch_size),
       input_size_(input_size),
@@ -603,7 +603,7 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
     if (batch_size_ % hidden_num_threads_ != 0)
       fused_hidden_rows++;
 
-    // lambda executed by TaskThreadPool
+    // lambda executed by the session thread pool
     auto hidden_gemm_and_activations = [&](const int row) {
       //handling boundaries
       int local_fused_hidden_rows = fused_hidden_rows;
@@ -816,7 +816,7 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
     };
 
     ExecuteLambdaInParallel("Processing batch", hidden_gemm_and_activations, batch_size_, fused_hidden_rows,
-                            ttp_, logger_);
+                            thread_pool_, logger_);
   } else {
     size_t out_added_offset;
 
@@ -13,7 +13,6 @@
 
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
-#include "core/common/task_thread_pool.h"
 #include "core/framework/allocator.h"
 
 #ifdef _MSC_VER
@@ -204,13 +203,15 @@ class UniDirectionalLstm {
                      const ActivationFuncs::Entry& activation_func_g,
                      const ActivationFuncs::Entry& activation_func_h,
                      const float clip,
-                     TaskThreadPool& ttp);
+                     concurrency::ThreadPool* thread_pool);
 
   void Compute(const gsl::span<const T>& inputs,
                const gsl::span<const int>& sequence_lengths,
                const int num_directions,
                const gsl::span<const T>& input_weights,
                const gsl::span<const T>& recurrent_weights,
+               const PackedGemmB* packed_input_weights,
+               const PackedGemmB* packed_recurrent_weights,
                gsl::span<T>& outputs,
                gsl::span<T>& final_hidden_state,
                gsl::span<T>& final_cell_state);
@@ -296,7 +297,7 @@ class UniDirectionalLstm {
   ActivationInfo<deepcpu::ActivationFuncPtr> activation_g_;
   ActivationInfo<deepcpu::LstmMergeGatesFuncPtr> activation_h_;
 
-  TaskThreadPool& ttp_;
+  concurrency::ThreadPool* thread_pool_;
 };
 
 }  // namespace detail
@@ -362,6 +363,8 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
   TensorShape Y_c_dims{num_directions_, batch_size, hidden_size_};
   Tensor* Y_c = context.Output(/*index*/ 2, Y_c_dims);
 
+  concurrency::ThreadPool* thread_pool = context.GetOperatorThreadPool();
+
   AllocatorPtr alloc;
   status = context.GetTempSpaceAllocator(&alloc);
   ORT_RETURN_IF_ERROR(status);
@@ -379,6 +382,9 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
 
   gsl::span<const T> input_weights_1 = input_weights.subspan(0, input_weights_size_per_direction);
   gsl::span<const T> recurrent_weights_1 = recurrent_weights.subspan(0, hidden_weights_size_per_direction);
+  // the weights packed when the kernel was created, unless W or R was overridden by a feed
+  const PackedGemmB* packed_input_weights_1 = packed_W_[0].IsPackedFrom(W) ? &packed_W_[0] : nullptr;
+  const PackedGemmB* packed_recurrent_weights_1 = packed_R_[0].IsPackedFrom(R) ? &packed_R_[0] : nullptr;
   gsl::span<const T> bias_1 = bias.empty() ? bias : bias.subspan(0, bias_size_per_direction);
   gsl::span<const T> peephole_weights_1 =
       peephole_weights.empty() ? peephole_weights
@@ -466,7 +472,7 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
                                                          activation_funcs_.Entries()[0],
                                                          activation_funcs_.Entries()[1],
                                                          activation_funcs_.Entries()[2],
-                                                         clip_, ttp_);
+                                                         clip_, thread_pool);
 
     bw = std::make_unique<detail::UniDirectionalLstm<T>>(alloc, logger,
                                                          seq_length, batch_size, input_size,
@@ -475,10 +481,14 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
                                                          activation_funcs_.Entries()[3],
                                                          activation_funcs_.Entries()[4],
                                                          activation_funcs_.Entries()[5],
-                                                         clip_, ttp_);
-
-    fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
-    bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, hidden_weights_2, output_2, hidden_output_2, last_cell_2);
+                                                         clip_, thread_pool);
+
+    fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
+                packed_input_weights_1, packed_recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
+    bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, hidden_weights_2,
+                packed_W_[1].IsPackedFrom(W) ? &packed_W_[1] : nullptr,
+                packed_R_[1].IsPackedFrom(R) ? &packed_R_[1] : nullptr,
+                output_2, hidden_output_2, last_cell_2);
   } else {
     fw = std::make_unique<detail::UniDirectionalLstm<T>>(alloc, logger,
                                                          seq_length, batch_size, input_size,
@@ -487,9 +497,10 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
                                                          activation_funcs_.Entries()[0],
                                                          activation_funcs_.Entries()[1],
                                                          activation_funcs_.Entries()[2],
-                                                         clip_, ttp_);
+                                                         clip_, thread_pool);
 
-    fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
+    fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
+                packed_input_weights_1, packed_recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
   }
 
   if (!output.empty())
@@ -559,7 +570,7 @@ UniDirectionalLstm<T>::UniDirectionalLstm(AllocatorPtr allocator,
                                           const ActivationFuncs::Entry& activation_func_g,
                                           const ActivationFuncs::Entry& activation_func_h,
                                           const float clip,
-                                          TaskThreadPool& ttp)
+                                          concurrency::ThreadPool* thread_pool)
     : allocator_(allocator),
       logger_(logger),
       seq_length_(seq_length),
@@ -571,7 +582,7 @@ UniDirectionalLstm<T>::UniDirectionalLstm(AllocatorPtr allocator,
       clip_(clip),
       use_bias_(!bias.empty()),
       use_peepholes_(!peephole_weights.empty()),
-      ttp_(ttp) {
+      thread_pool_(thread_pool) {
   activation_f_ = {deepcpu::ActivationFuncByName(activation_func_f.name),
                    activation_func_f.alpha,
                    activation_func_f.beta};
@@ -725,6 +736,8 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
                                     const int num_directions,
                                     const gsl::span<const T>& input_weights,
                                     const gsl::span<const T>& recurrent_weights,
+                                    const PackedGemmB* packed_input_weights,
+                                    const PackedGemmB* packed_recurrent_weights,
                                     gsl::span<T>& outputs,
                                     gsl::span<T>& final_hidden_state,
                                     gsl::span<T>& final_cell_state) {
@@ -781,13 +794,23 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
   const int total_rows = max_sequence_length * batch_size_;
 
   // apply the weights to all the inputs and save to output_IOFC
-  ComputeGemm(total_rows, hidden_size_x4, input_size_, alpha,
-              inputs.cbegin(), inputs.cend(),
-              input_size_,
-              input_weights.cbegin(), input_weights.cend(),  // W[iofc]
-              input_size_, beta,
-              output_iofc_.begin(), output_iofc_.end(),
-              hidden_size_x4);
+  if (packed_input_weights != nullptr) {
+    ComputeGemm(total_rows, hidden_size_x4, input_size_, alpha,
+                inputs.cbegin(), inputs.cend(),
+                input_size_,
+                *packed_input_weights,  // W[iofc]
+                beta,
+                output_iofc_.begin(), output_iofc_.end(),
+                hidden_size_x4);
+  } else {
+    ComputeGemm(total_rows, hidden_size_x4, input_size_, alpha,
+                inputs.cbegin(), inputs.cend(),
+                input_size_,
+                input_weights.cbegin(), input_weights.cend(),  // W[iofc]
+                input_size_, beta,
+                output_iofc_.begin(), output_iofc_.end(),
+                hidden_size_x4);
+  }
 
   DumpMatrix("Xt*(W[iofc]^T)", output_iofc_.data(), total_rows, hidden_size_x4);
 
@@ -830,13 +853,23 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
         span_T_iter step_out_IOFC = output_iofc_.begin() + (step * batch_size_ + row) * hidden_size_x4;
 
         // calculate Xt*(W[iofc]^T) + Ht-t*R[iofc]
-        ComputeGemm(local_fused_hidden_rows, hidden_size_x4, hidden_size_, alpha,
-                    previous_state, previous_state_end,  // Ht-1
-                    hidden_size_,
-                    recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
-                    hidden_size_, beta,
-                    step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
-                    hidden_size_x4);
+        if (packed_recurrent_weights != nullptr) {
+          ComputeGemm(local_fused_hidden_rows, hidden_size_x4, hidden_size_, alpha,
+                      previous_state, previous_state_end,  // Ht-1
+                      hidden_size_,
+                      *packed_recurrent_weights,  // R[iofc]
+                      beta,
+                      step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
+                      hidden_size_x4);
+        } else {
+          ComputeGemm(local_fused_hidden_rows, hidden_size_x4, hidden_size_, alpha,
+                      previous_state, previous_state_end,  // Ht-1
+                      hidden_size_,
+                      recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
+                      hidden_size_, beta,
+                      step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
+                      hidden_size_x4);
+        }
 
         DumpMatrix("Xt*(W[iofc]^T) + Ht-t*R[iofc]" + row_str,
                    &*step_out_IOFC, local_fused_hidden_rows, hidden_size_x4);
@@ -883,7 +916,7 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
     };
 
     ExecuteLambdaInParallel("Processing batch", hidden_gemm_and_activations, batch_size_, fused_hidden_rows,
-                            ttp_, logger_);
+                            thread_pool_, logger_);
 
   } else {
     span_T_iter c_prev = batched_internal_state_prev_one_step.begin();
@@ -904,13 +937,23 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
       span_T_iter step_out_IOFC = output_iofc_.begin() + (step * batch_size_) * hidden_size_x4;
 
       // calculate Xt*(W[iofc]^T) + Ht-t*R[iofc]
-      ComputeGemm(batch_size_, hidden_size_x4, hidden_size_, alpha,
-                  previous_state, previous_state_end,  // Ht-1
-                  hidden_size_,
-                  recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
-                  hidden_size_, beta,
-                  step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
-                  hidden_size_x4);
+      if (packed_recurrent_weights != nullptr) {
+        ComputeGemm(batch_size_, hidden_size_x4, hidden_size_, alpha,
+                    previous_state, previous_state_end,  // Ht-1
+                    hidden_size_,
+                    *packed_recurrent_weights,  // R[iofc]
+                    beta,
+                    step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
+                    hidden_size_x4);
+      } else {
+        ComputeGemm(batch_size_, hidden_size_x4, hidden_size_, alpha,
+                    previous_state, previous_state_end,  // Ht-1
+                    hidden_size_,
+                    recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
+                    hidden_size_, beta,
+                    step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
+                    hidden_size_x4);
+      }
 
       span_T_iter batched_output, batched_output_end;
       if (output_sequence) {
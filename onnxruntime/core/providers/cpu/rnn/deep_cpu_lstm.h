@@ -6,7 +6,7 @@
 #include <limits>
 
 #include "core/framework/op_kernel.h"
-#include "core/common/task_thread_pool.h"
+#include "core/providers/cpu/math/packed_gemm_b.h"
 #include "core/providers/cpu/rnn/rnn_helpers.h"
 
 namespace onnxruntime {
@@ -49,6 +49,12 @@ class DeepCpuLstmOp final : public OpKernel {
     activation_funcs_ = rnn::detail::ActivationFuncs(activation_func_names,
                                                      activation_func_alphas,
                                                      activation_func_betas);
+
+    // W and R are used transposed in the GEMMs of each direction
+    for (int i = 0; i < num_directions_; ++i) {
+      packed_W_[i].TryPack(info, 1, i, CblasTrans);
+      packed_R_[i].TryPack(info, 2, i, CblasTrans);
+    }
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -78,11 +84,9 @@ class DeepCpuLstmOp final : public OpKernel {
 
   rnn::detail::ActivationFuncs activation_funcs_;
 
-  // Threadpool for operator. If concurrent Compute calls are possible, it will be shared
-  // across them. mutable due to this.
-  // The alternative would be to create a threadpool in each call to Compute but that would incur thread creation
-  // cost on every call.
-  mutable TaskThreadPool ttp_{std::thread::hardware_concurrency()};
+  // W and R of each direction packed for MLAS if they are constant float initializers
+  PackedGemmB packed_W_[2];
+  PackedGemmB packed_R_[2];
 };
 
 }  // namespace onnxruntime
@@ -5,7 +5,6 @@
 
 #include <algorithm>
 #include <functional>
-#include <future>
 #include <string>
 #include <vector>
 
@@ -13,9 +12,10 @@
 #include "gsl/gsl_algorithm"
 
 #include "core/common/common.h"
-#include "core/common/task_thread_pool.h"
 #include "core/common/logging/logging.h"
 #include "core/framework/allocator.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/math/packed_gemm_b.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 
@@ -167,6 +167,31 @@ void ComputeGemm(const int M,
       &*C, ldc, &CPUMathUtil::Instance());
 }
 
+// As above, with B (N x K, transposed) prepacked by MLAS
+template <typename TSpanAIter, typename TSpanCIter>
+void ComputeGemm(const int M,
+                 const int N,
+                 const int K,
+                 const float alpha,
+                 TSpanAIter A,
+                 TSpanAIter A_end,
+                 const int lda,
+                 const PackedGemmB& packed_B,
+                 const float beta,
+                 TSpanCIter C,
+                 TSpanCIter C_end,
+                 const int ldc) {
+  ORT_ENFORCE(lda >= K && ldc >= N);
+  ORT_ENFORCE(packed_B.N() == static_cast<size_t>(N) && packed_B.K() == static_cast<size_t>(K));
+  ORT_ENFORCE(A + (M * lda - (lda - K)) <= A_end);
+  ORT_ENFORCE(C + (M * ldc - (ldc - N)) <= C_end);
+
+  MlasSgemm(CblasNoTrans, M, N, K, alpha,
+            &*A, lda,
+            packed_B.Data(), beta,
+            &*C, ldc, nullptr);
+}
+
 // helper to convert a span to a raw pointer
 // after validating the memory covered by the span supports the size required
 template <typename T>
@@ -205,11 +230,11 @@ T* SafeRawPointer(typename gsl::span<T> span, size_t offset, size_t size) {
 
 template <typename TLambda>
 void ExecuteLambdaInParallel(const std::string& name, TLambda lambda, int max, int step,
-                             TaskThreadPool& ttp, const ::onnxruntime::logging::Logger& logger) {
+                             concurrency::ThreadPool* thread_pool, const ::onnxruntime::logging::Logger& logger) {
   // #define NOTHREADS to execute the lambdas directly and in order if you need to do that to debug
 
 #ifdef NOTHREADS
-  ORT_UNUSED_PARAMETER(ttp);
+  ORT_UNUSED_PARAMETER(thread_pool);
   ORT_UNUSED_PARAMETER(logger);
 
   for (int i = 0; i < max; i += step) {
@@ -217,19 +242,13 @@ void ExecuteLambdaInParallel(const std::string& name, TLambda lambda, int max, i
     std::bind(lambda, i)();
   }
 #else
-  std::vector<std::future<void> > task_results{};
-  task_results.reserve(static_cast<size_t>(std::ceil(max / step)));
-
-  for (int i = 0; i < max; i += step) {
-    std::packaged_task<void()> task{std::bind(lambda, i)};
-    task_results.emplace_back(task.get_future());
-    ttp.RunTask(std::move(task));
-  }
+  const int32_t num_tasks = static_cast<int32_t>((max + step - 1) / step);
 
   try {
-    // wait for all and propagate any exceptions
-    for (auto& future : task_results)
-      future.get();
+    // runs on the calling thread as well, and propagates the first exception once all tasks have completed
+    concurrency::ThreadPool::TryParallelFor(thread_pool, num_tasks, [&lambda, step](int32_t task) {
+      lambda(task * step);
+    });
   } catch (const std::exception& ex) {
     LOGS(logger, ERROR) << name << " - exception running tasks: " << ex.what();
     throw;
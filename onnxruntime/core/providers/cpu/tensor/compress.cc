@@ -15,7 +15,7 @@ ONNX_CPU_OPERATOR_KERNEL(
 Status Compress::Compute(OpKernelContext* ctx) const {
   const Tensor* input_tensor = ctx->Input<Tensor>(0);
   size_t rank = input_tensor->Shape().NumDimensions();
-  auto& input_dimensions = input_tensor->Shape().GetDims();
+  const auto& input_dimensions = input_tensor->Shape().GetDims();
   if (has_axis_) {
     ORT_ENFORCE(axis_ < static_cast<int64_t>(rank), "axis greater than input data dimension!");
   }
@@ -43,20 +43,18 @@ Status ConcatBase::PrepareForCompute(OpKernelContext* ctx, int input_count, Prep
   }
 
   // Calculate the shape of the output tensor
-  std::vector<int64_t> dims;
-  for (int dimension_index = 0; dimension_index < inputs_0.Shape().NumDimensions(); dimension_index++)
-    dims.emplace_back(inputs_0.Shape()[dimension_index]);
-  dims[axis] = concat_axis_size;
-  TensorShape outputShape(dims);
+  TensorShape outputShape(inputs_0.Shape());
+  outputShape[axis] = concat_axis_size;
 
   // The output_axis_pitch is the number of elements to add to move to the next split axis in the output
   p.output_axis_pitch = 1;
-  for (auto i = int64_t(dims.size()); i-- > axis;)
-    p.output_axis_pitch *= dims[i];
+  for (auto i = int64_t(outputShape.NumDimensions()); i-- > axis;)
+    p.output_axis_pitch *= outputShape[i];
 
   auto& concat_result = *ctx->Output(0, outputShape);
   p.output_tensor = &concat_result;
 
+  p.inputs.reserve(input_count);
   for (int input_index = 0; input_index < input_count; input_index++) {
     const Tensor* data_n_ptr = ctx->Input<Tensor>(input_index);
     ORT_ENFORCE(data_n_ptr != nullptr);
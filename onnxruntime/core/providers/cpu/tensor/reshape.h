@@ -23,14 +23,14 @@ class Reshape final : public OpKernel {
                 "A shape tensor must be a vector tensor.");
     size_t nDims = static_cast<size_t>(shapeTensor->Shape()[0]);
     const int64_t* data = shapeTensor->template Data<int64_t>();
-    std::vector<int64_t> shape(data, data + nDims);
+    TensorShape shape(data, nDims);
 
     const Tensor* X = context->Input<Tensor>(0);
     const TensorShape& X_shape = X->Shape();
 
     ReshapeHelper helper(X_shape, shape);
 
-    Tensor* Y = context->Output(0, TensorShape(shape));
+    Tensor* Y = context->Output(0, shape);
 
     CopyCpuTensor(X, Y);
 
@@ -46,13 +46,13 @@ class Reshape_1 final : public OpKernel {
   }
 
   Status Compute(OpKernelContext* context) const override {
-    std::vector<int64_t> shape = shape_;
+    TensorShape shape(shape_);
     const Tensor* X = context->Input<Tensor>(0);
     const TensorShape& X_shape = X->Shape();
 
     ReshapeHelper helper(X_shape, shape);
 
-    Tensor* Y = context->Output(0, TensorShape(shape));
+    Tensor* Y = context->Output(0, shape);
 
     CopyCpuTensor(X, Y);
 
@@ -12,8 +12,8 @@ namespace onnxruntime {
 // Verify and convert unknown dim during reshape
 class ReshapeHelper {
  public:
-  ReshapeHelper(const TensorShape& input_shape, std::vector<int64_t>& requested_shape) {
-    auto nDims = requested_shape.size();
+  ReshapeHelper(const TensorShape& input_shape, TensorShape& requested_shape) {
+    auto nDims = requested_shape.NumDimensions();
     int64_t unknown_dim = -1;
     int64_t size = 1;
     for (size_t i = 0; i < nDims; ++i) {
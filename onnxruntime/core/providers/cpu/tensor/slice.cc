@@ -39,7 +39,7 @@ const T& clamp(const T& v, const T& lo, const T& hi) {
   return v;
 }
 }  // namespace
-Status SliceBase::PrepareForCompute(const size_t dimension_count, const std::vector<int64_t>& input_dimensions,
+Status SliceBase::PrepareForCompute(const size_t dimension_count, TensorShapeView input_dimensions,
                                     std::vector<int64_t>& starts, std::vector<int64_t>& output_dims) const {
   // Initialize axes to the provided axes attribute or to the default sequence
   std::vector<int64_t> axes(axes_);
@@ -81,7 +81,7 @@ Status Slice<T>::Compute(OpKernelContext* ctx) const {
   const Tensor* input_tensor_ptr = ctx->Input<Tensor>(0);
   ORT_ENFORCE(input_tensor_ptr != nullptr);
   auto& input_tensor = *input_tensor_ptr;
-  auto& input_dimensions = input_tensor.Shape().GetDims();
+  const auto& input_dimensions = input_tensor.Shape().GetDims();
 
   // Initialize the starts & ends to the actual tensor shape
   const size_t dimension_count = input_dimensions.size();
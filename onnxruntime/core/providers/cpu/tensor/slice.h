@@ -23,7 +23,7 @@ class SliceBase {
     }
   }
 
-  Status PrepareForCompute(const size_t dimension_count, const std::vector<int64_t>& input_dimensions,
+  Status PrepareForCompute(const size_t dimension_count, TensorShapeView input_dimensions,
                            std::vector<int64_t>& starts, std::vector<int64_t>& output_dims) const;
 
   std::vector<int64_t> axes_;
@@ -41,7 +41,7 @@ Status Split::Compute(OpKernelContext* context) const {
 template <typename T>
 Status Split::ComputeImpl(OpKernelContext& context, const Tensor& input) const {
   auto& input_shape = input.Shape();
-  auto& input_dims = input_shape.GetDims();
+  const auto& input_dims = input_shape.GetDims();
   const int64_t num_dimensions = gsl::narrow_cast<int64_t>(input_shape.NumDimensions());
   const int64_t axis = HandleNegativeAxis(axis_, num_dimensions);  // handle negative and enforce axis is valid
   const int64_t split_dim_size = input_dims[axis];
@@ -23,8 +23,8 @@ class SqueezeBase {
   }
 
   static std::vector<int64_t> ComputeOutputShape(
-      std::vector<int64_t> input_shape,
-      std::vector<int64_t> axes) {
+      TensorShapeView input_shape,
+      const std::vector<int64_t>& axes) {
     int j = 0;
     std::vector<int64_t> output_shape;
     for (size_t i = 0; i < input_shape.size(); ++i) {
@@ -92,7 +92,7 @@ Status Transpose<float>::Compute(OpKernelContext* ctx) const {
   ORT_ENFORCE(input_tensor_ptr != nullptr);
   const Tensor& X = *input_tensor_ptr;
   const TensorShape& input_shape = X.Shape();
-  const std::vector<int64_t>& input_dims = input_shape.GetDims();
+  const auto& input_dims = input_shape.GetDims();
   size_t rank = input_dims.size();
 
   std::vector<int64_t> output_dims(rank);
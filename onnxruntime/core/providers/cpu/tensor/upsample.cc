@@ -195,7 +195,7 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context, const std::vector<floa
   const Tensor* X = context->Input<Tensor>(0);
   ORT_ENFORCE(X != nullptr);
 
-  const std::vector<int64_t>& dims = X->Shape().GetDims();
+  const auto& dims = X->Shape().GetDims();
   if (dims.size() != scales.size()) {
     return Status(ONNXRUNTIME, INVALID_ARGUMENT, "Upsample: input tensor's dimension does not match the scales.");
   }
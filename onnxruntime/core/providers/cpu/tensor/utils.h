@@ -8,12 +8,13 @@ namespace onnxruntime {
 struct TensorPitches : std::vector<int64_t> {
   TensorPitches(const Tensor& tensor, size_t rank = 0) : TensorPitches(tensor.Shape(), rank) {}
   TensorPitches(const TensorShape& shape, size_t rank = 0) : TensorPitches(shape.GetDims(), rank) {}
-  TensorPitches(const std::vector<int64_t>& dims, size_t rank = 0)
+  TensorPitches(const std::vector<int64_t>& dims, size_t rank = 0) : TensorPitches(TensorShapeView(dims), rank) {}
+  TensorPitches(TensorShapeView dims, size_t rank = 0)
       : std::vector<int64_t>(std::max(rank, dims.size()), 0) {
     Calculate(gsl::span<int64_t>(data(), size()), dims);
   }
 
-  static bool Calculate(gsl::span<int64_t> p, const std::vector<int64_t>& dims) {
+  static bool Calculate(gsl::span<int64_t> p, TensorShapeView dims) {
     // The pitches is the size of the next inner axis. Aka the amount to move by one of the next inner axis.
     // For a tensor with shape(2,3,4,5) the values would be: (3*4*5, 4*5, 5, 1)
     // Note that the outermost '2' is never used, as you never need to move by the entire size of the outermost axis
@@ -124,7 +125,7 @@ struct ExtentAxisCounters {
 struct SliceSkips : std::vector<int64_t> {
   SliceSkips(const Tensor& tensor, gsl::span<const int64_t> extents)
       : std::vector<int64_t>(tensor.Shape().NumDimensions(), 0) {
-    auto& dims = tensor.Shape().GetDims();
+    const auto& dims = tensor.Shape().GetDims();
     ORT_ENFORCE(static_cast<ptrdiff_t>(dims.size()) == extents.size());
     size_t pitch = dims.back();
     back() = pitch - extents[size() - 1];
@@ -141,7 +142,7 @@ template <typename T>
 struct SliceIterator {
   SliceIterator(const Tensor& tensor, gsl::span<const int64_t> starts, gsl::span<const int64_t> extents)
       : tensor_(tensor), extents_(extents), skips_(tensor, extents), indices_(extents.size(), 0) {
-    auto& dims = tensor_.Shape().GetDims();
+    const auto& dims = tensor_.Shape().GetDims();
     ORT_ENFORCE(static_cast<ptrdiff_t>(dims.size()) == starts.size() && static_cast<ptrdiff_t>(dims.size()) == extents.size());
 
     size_t pitch = 1;
@@ -160,7 +160,7 @@ class ToCudaType<MLFloat16> {
   }
 };
 
-inline bool CalculateFdmStrides(gsl::span<fast_divmod> p, const std::vector<int64_t>& dims) {
+inline bool CalculateFdmStrides(gsl::span<fast_divmod> p, TensorShapeView dims) {
   int stride = 1;
   if (dims.empty() || p.size() < gsl::narrow_cast<ptrdiff_t>(dims.size()))
     return false;
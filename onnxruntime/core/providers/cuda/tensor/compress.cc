@@ -20,7 +20,7 @@ Status Compress::ComputeInternal(OpKernelContext* ctx) const {
   const Tensor* input_tensor = ctx->Input<Tensor>(0);
   ORT_ENFORCE(input_tensor);
   size_t rank = input_tensor->Shape().NumDimensions();
-  auto& input_dimensions = input_tensor->Shape().GetDims();
+  const auto& input_dimensions = input_tensor->Shape().GetDims();
   if (has_axis_) {
     ORT_ENFORCE(axis_ < static_cast<int64_t>(rank), "axis greater than input data dimension!");
   }
@@ -24,16 +24,14 @@ class Reshape final : public CudaKernel {
                 "A shape tensor must be a vector tensor.");
     size_t nDims = static_cast<size_t>(shapeTensor->Shape()[0]);
     const int64_t* data = shapeTensor->template Data<int64_t>();
-    std::vector<int64_t> shape;
-    for (size_t i = 0; i < nDims; ++i)
-      shape.push_back(data[i]);
+    TensorShape shape(data, nDims);
 
     const Tensor* X = context->Input<Tensor>(0);
     const TensorShape& X_shape = X->Shape();
 
     ReshapeHelper helper(X_shape, shape);
 
-    Tensor* Y = context->Output(0, TensorShape(shape));
+    Tensor* Y = context->Output(0, shape);
     const void* source = X->DataRaw();
     void* target = Y->MutableDataRaw();
     //If source and target pointers are not equal (non-inplace operation), we need to copy the data.
@@ -53,13 +51,13 @@ class Reshape_1 final : public CudaKernel {
   }
 
   Status ComputeInternal(OpKernelContext* context) const override {
-    std::vector<int64_t> shape = shape_;
+    TensorShape shape(shape_);
     const Tensor* X = context->Input<Tensor>(0);
     const TensorShape& X_shape = X->Shape();
 
     ReshapeHelper helper(X_shape, shape);
 
-    Tensor* Y = context->Output(0, TensorShape(shape));
+    Tensor* Y = context->Output(0, shape);
     const void* source = X->DataRaw();
     void* target = Y->MutableDataRaw();
     //If source and target pointers are not equal (non-inplace operation), we need to copy the data.
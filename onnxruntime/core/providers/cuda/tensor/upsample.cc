@@ -30,7 +30,7 @@ template <typename T>
 Status Upsample<T>::ComputeInternal(OpKernelContext* context) const {
   const Tensor* X = context->Input<Tensor>(0);
   ORT_ENFORCE(nullptr != X);
-  const std::vector<int64_t>& X_dims = X->Shape().GetDims();
+  const auto& X_dims = X->Shape().GetDims();
   auto rank = X_dims.size();
   if (rank == 0)
     return Status(ONNXRUNTIME, INVALID_ARGUMENT, "Upsample: input tensor cannot be scalar.");
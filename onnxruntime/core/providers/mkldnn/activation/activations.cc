@@ -162,7 +162,7 @@ Status Relu<T>::Compute(OpKernelContext* context) const {
   }
 
   const TensorShape& y_shape = Y->Shape();
-  auto& y_dims = y_shape.GetDims();
+  const auto& y_dims = y_shape.GetDims();
 
   const T* src_data = X->template Data<T>();
   T* dst_data = Y->template MutableData<T>();
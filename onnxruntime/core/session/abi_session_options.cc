@@ -97,6 +97,13 @@ ORT_API(int, OrtSetSessionThreadPoolSize, _In_ OrtSessionOptions* options, int s
   return 0;
 }
 
+///How many threads run the requests queued by OrtRunInferenceAsync. 0 uses the number of hardware threads.
+ORT_API(int, OrtSetSessionAsyncRunThreadPoolSize, _In_ OrtSessionOptions* options, int async_run_thread_pool_size) {
+  if (async_run_thread_pool_size < 0) return -1;
+  options->value.async_run_thread_pool_size = async_run_thread_pool_size;
+  return 0;
+}
+
 ORT_API(void, OrtAddCustomOp, _In_ OrtSessionOptions* options, const char* custom_op_path) {
   options->custom_op_paths.emplace_back(custom_op_path);
 }
@@ -0,0 +1,220 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/constant_folding.h"
+
+#include <memory>
+#include <unordered_set>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/graph/model.h"
+#include "core/session/inference_session.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+bool IsFoldable(const Graph& graph, const Node& node) {
+  static const std::unordered_set<std::string> kNonDeterministicOps = {
+      "RandomNormal", "RandomNormalLike", "RandomUniform", "RandomUniformLike", "Multinomial"};
+  if (kNonDeterministicOps.count(node.OpType()) > 0 || graph.IsNodeOutputsInGraphOutputs(node)) {
+    return false;
+  }
+
+  const std::string& provider = node.GetExecutionProviderType();
+  if (!provider.empty() && provider != kCpuExecutionProvider) {
+    return false;
+  }
+
+  // control flow nodes
+  for (const auto& attr : node.GetAttributes()) {
+    if (attr.second.has_g() || attr.second.graphs_size() > 0) {
+      return false;
+    }
+  }
+
+  // only tensors can become initializers, not the maps and sequences of some ML ops
+  for (const auto* def : node.OutputDefs()) {
+    const std::string* type = def->Type();
+    if (def->Exists() && (type == nullptr || type->compare(0, 7, "tensor(") != 0)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// initializers that are also graph inputs only hold default values, which a feed can override
+bool HasConstantInputs(const Graph& graph, const Node& node, const std::unordered_set<std::string>& graph_inputs) {
+  for (const auto* def : node.InputDefs()) {
+    const TensorProto* initializer;
+    if (def->Exists() &&
+        (graph_inputs.count(def->Name()) > 0 || !graph.GetInitializedTensor(def->Name(), initializer))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// the output of a Shape node whose input has a fully known shape
+bool TryGetStaticShape(const Node& node, TensorProto& shape_tensor) {
+  if (!utils::IsSupportedOptypeVersionAndDomain(node, "Shape", 1)) {
+    return false;
+  }
+
+  const TensorShapeProto* shape = node.InputDefs()[0]->Shape();
+  if (shape == nullptr) {
+    return false;
+  }
+  for (const auto& dim : shape->dim()) {
+    if (!dim.has_dim_value()) {
+      return false;
+    }
+  }
+
+  shape_tensor.set_data_type(TensorProto_DataType_INT64);
+  shape_tensor.add_dims(shape->dim_size());
+  for (const auto& dim : shape->dim()) {
+    shape_tensor.add_int64_data(dim.dim_value());
+  }
+  return true;
+}
+
+Status TensorToTensorProto(const Tensor& tensor, TensorProto& tensor_proto) {
+  for (auto dim : tensor.Shape().GetDims()) {
+    tensor_proto.add_dims(dim);
+  }
+
+  if (tensor.DataType() == DataTypeImpl::GetType<std::string>()) {
+    tensor_proto.set_data_type(TensorProto_DataType_STRING);
+    const std::string* data = tensor.Data<std::string>();
+    for (int64_t i = 0, end = tensor.Shape().Size(); i < end; ++i) {
+      tensor_proto.add_string_data(data[i]);
+    }
+    return Status::OK();
+  }
+
+  tensor_proto.set_data_type(utils::GetTensorProtoType(tensor));
+  ORT_RETURN_IF_NOT(tensor_proto.data_type() != TensorProto_DataType_UNDEFINED, "Unsupported tensor type");
+  tensor_proto.set_raw_data(tensor.DataRaw(), tensor.Size());
+  return Status::OK();
+}
+
+// run node with the CPU kernels, in a model with the node and its inputs as initializers
+Status EvaluateNode(const Graph& graph, const Node& node, std::vector<TensorProto>& outputs) {
+  Model model("constant_folding", false, ModelMetaData(), IOnnxRuntimeOpSchemaRegistryList(),
+              graph.DomainToVersionMap());
+  Graph& node_graph = model.MainGraph();
+  for (const auto* def : node.InputDefs()) {
+    const TensorProto* initializer;
+    if (def->Exists() && graph.GetInitializedTensor(def->Name(), initializer)) {
+      node_graph.AddInitializedTensor(*initializer);
+    }
+  }
+  node_graph.AddNode(node);
+  ORT_RETURN_IF_ERROR(node_graph.Resolve());
+
+  // the node runs once on the calling thread, so the session needs no worker threads, arena or memory pattern
+  SessionOptions so;
+  so.session_logid = "ConstantFolding";
+  so.session_thread_pool_size = 1;
+  so.enable_cpu_mem_arena = false;
+  so.enable_mem_pattern = false;
+  InferenceSession session{so};
+  ORT_RETURN_IF_ERROR(session.Load(std::make_unique<ModelProto>(model.ToProto())));
+  ORT_RETURN_IF_ERROR(session.Initialize());
+
+  std::vector<std::string> output_names;
+  for (const auto* def : node.OutputDefs()) {
+    if (def->Exists()) {
+      output_names.push_back(def->Name());
+    }
+  }
+
+  std::vector<MLValue> fetches;
+  ORT_RETURN_IF_ERROR(session.Run(NameMLValMap(), output_names, &fetches));
+
+  for (size_t i = 0; i < output_names.size(); ++i) {
+    TensorProto tensor_proto;
+    tensor_proto.set_name(output_names[i]);
+    ORT_RETURN_IF_ERROR(TensorToTensorProto(fetches[i].Get<Tensor>(), tensor_proto));
+    outputs.push_back(std::move(tensor_proto));
+  }
+  return Status::OK();
+}
+}  // namespace
+
+Status ConstantFolding::Apply(Graph& graph, bool& modified) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  std::unordered_set<std::string> graph_inputs;
+  for (const auto* def : graph.GetInputsIncludingInitializers()) {
+    graph_inputs.insert(def->Name());
+  }
+
+  std::vector<onnxruntime::NodeIndex> folded_nodes;
+  for (auto index : order) {
+    const Node& node = *graph.GetNode(index);
+    if (!IsFoldable(graph, node)) {
+      continue;
+    }
+
+    std::vector<TensorProto> outputs;
+    TensorProto shape_tensor;
+    if (TryGetStaticShape(node, shape_tensor)) {
+      shape_tensor.set_name(node.OutputDefs()[0]->Name());
+      outputs.push_back(std::move(shape_tensor));
+    } else if (!HasConstantInputs(graph, node, graph_inputs) || !EvaluateNode(graph, node, outputs).IsOK()) {
+      // nodes the CPU kernels can't run, e.g. ops of custom domains, are left in the graph
+      continue;
+    }
+
+    // the outputs are constant for the nodes after this one too
+    for (const auto& output : outputs) {
+      graph.AddInitializedTensor(output);
+    }
+    folded_nodes.push_back(index);
+  }
+
+  if (folded_nodes.empty()) {
+    return Status::OK();
+  }
+
+  for (auto i : folded_nodes) {
+    graph.RemoveNode(i);
+  }
+
+  // drop the initializers only the folded nodes used
+  std::unordered_set<std::string> used_names;
+  for (const auto& node : graph.Nodes()) {
+    for (const auto* def : node.InputDefs()) {
+      used_names.insert(def->Name());
+    }
+    for (const auto* def : node.ImplicitInputDefs()) {
+      used_names.insert(def->Name());
+    }
+  }
+  for (const auto* def : graph.GetOutputs()) {
+    used_names.insert(def->Name());
+  }
+  for (const auto* def : graph.GetInputsIncludingInitializers()) {
+    used_names.insert(def->Name());
+  }
+
+  std::vector<std::string> unused_initializers;
+  for (const auto& initializer : graph.GetAllInitializedTensors()) {
+    if (used_names.count(initializer.first) == 0) {
+      unused_initializers.push_back(initializer.first);
+    }
+  }
+  for (const auto& name : unused_initializers) {
+    graph.RemoveInitializedTensor(name);
+  }
+
+  modified = true;
+  ORT_RETURN_IF_ERROR(graph.Resolve());
+  return Status::OK();
+}
+}  // namespace onnxruntime
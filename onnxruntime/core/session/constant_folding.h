@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/graph/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+  * Replaces the outputs of nodes whose inputs are all initializers, and of Shape nodes whose input has a fully known
+  * shape, with initializers. Folded outputs count as initializers for the nodes after them, so chains such as
+  * Shape->Gather->Concat->Reshape or Transpose->Cast of a weight are folded as a whole. Initializers that are no
+  * longer used, and aren't graph inputs, are removed.
+  *
+  * Each node is evaluated once with the CPU kernels, in a model of its own. Nodes with subgraphs, random generators,
+  * nodes assigned to other execution providers and nodes producing graph outputs are not folded.
+  *
+  * Initializers that are also graph inputs, as every initializer is in models before IR version 4, are not treated
+  * as constants, since a feed can override them.
+  */
+class ConstantFolding : public onnxruntime::GraphTransformer {
+ public:
+  ConstantFolding() noexcept : onnxruntime::GraphTransformer("ConstantFolding", "Evaluating nodes with constant inputs") {}
+  Status Apply(onnxruntime::Graph& graph, bool& modified) const override;
+};
+
+}  // namespace onnxruntime
@@ -3,20 +3,26 @@
 
 #include "core/session/inference_session.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <thread>
 #include <unordered_set>
 #include <list>
 
 #include "core/common/logging/logging.h"
-#include "core/common/task_thread_pool.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/graph_transformer.h"
 #include "core/graph/graph_transformer_mgr.h"
 #include "core/graph/graph_utils.h"
 #include "core/graph/model.h"
+#include "core/platform/threadpool.h"
 #include "core/framework/allocatormgr.h"
+#include "core/framework/bfc_arena.h"
 #include "core/framework/customregistry.h"
 #include "core/framework/environment.h"
 #include "core/framework/execution_frame.h"
@@ -39,11 +45,41 @@
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/session/CustomOpsLoader.h"
 #include "core/session/IOBinding.h"
+#include "core/session/run_context.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
 
 using namespace ONNX_NAMESPACE;
 
 namespace onnxruntime {
 
+#ifdef _WIN32
+// Converts a path to the ANSI code page used by the narrow file APIs.
+// Returns false if the path has characters that the code page can't represent.
+static bool ToMBPath(const std::wstring& path, std::string& mb_path) {
+  mb_path.clear();
+  if (path.empty()) {
+    return true;
+  }
+
+  // WideCharToMultiByte doesn't report lossy conversions for UTF-8, which can represent every path anyway
+  const UINT code_page = GetACP();
+  BOOL used_default_char = FALSE;
+  BOOL* p_used_default_char = code_page == CP_UTF8 ? nullptr : &used_default_char;
+  const int src_len = static_cast<int>(path.size());
+  const int len = WideCharToMultiByte(code_page, 0, path.data(), src_len, nullptr, 0, nullptr, p_used_default_char);
+  if (len <= 0 || used_default_char) {
+    return false;
+  }
+
+  mb_path.resize(len);
+  WideCharToMultiByte(code_page, 0, path.data(), src_len, &mb_path[0], len, nullptr, nullptr);
+  return true;
+}
+#endif
+
 class InferenceSession::Impl {
  public:
   Impl(const SessionOptions& session_options, logging::LoggingManager* logging_manager)
@@ -57,17 +93,18 @@ class InferenceSession::Impl {
 
     InitLogger(logging_manager);
 
-    // currently the threadpool is used by the parallel executor only and hence
-    // there is no point creating it when only sequential execution is enabled.
-    if (!session_options.enable_sequential_execution) {
-      int pool_size = session_options_.session_thread_pool_size == 0
-                          ? std::thread::hardware_concurrency() / 2
-                          : session_options_.session_thread_pool_size;
-      thread_pool_ = std::make_unique<TaskThreadPool>(pool_size);
+    // the threadpool is used by the parallel executor as well as for intra-op parallelism by MLAS and the
+    // CPU kernels, so it is created regardless of the execution mode.
+    int pool_size = session_options_.session_thread_pool_size;
+    if (pool_size <= 0) {
+      pool_size = std::max(static_cast<int>(std::thread::hardware_concurrency()) - 1, 1);
     }
+    thread_pool_ = std::make_unique<concurrency::ThreadPool>("SESSION", pool_size);
 
     session_state_.SetThreadPool(thread_pool_.get());
     session_state_.SetEnableMemoryPattern(session_options.enable_mem_pattern);
+    session_state_.SetMemoryPatternCacheOptions(session_options.mem_pattern_cache_capacity,
+                                                session_options.enable_mem_pattern_shape_bucketing);
     session_profiler_.Initialize(session_logger_);
     session_state_.SetProfiler(session_profiler_);
     if (session_options.enable_profiling) {
@@ -75,6 +112,18 @@ class InferenceSession::Impl {
     }
   }
 
+  ~Impl() {
+    // the queued requests use the rest of the session, so run them before it is destroyed
+    {
+      std::lock_guard<std::mutex> lock(async_run_mutex_);
+      async_run_shutdown_ = true;
+    }
+    async_run_cv_.notify_all();
+    for (auto& worker : async_run_workers_) {
+      worker.join();
+    }
+  }
+
   common::Status RegisterExecutionProvider(std::unique_ptr<IExecutionProvider> p_exec_provider) {
     if (p_exec_provider == nullptr) {
       return Status(common::ONNXRUNTIME, common::FAIL, "Received nullptr for exec provider");
@@ -131,8 +180,7 @@ class InferenceSession::Impl {
       }
 
       std::shared_ptr<onnxruntime::Model> p_tmp_model;
-      ORT_RETURN_IF_ERROR(onnxruntime::Model::Load(model_uri, p_tmp_model,
-                                                   HasLocalSchema() ? &custom_schema_registries_ : nullptr));
+      ORT_RETURN_IF_ERROR(LoadModelFile(model_uri, p_tmp_model));
       model_ = p_tmp_model;
 
       ORT_RETURN_IF_ERROR(DoPostLoadProcessing(*model_.get()));
@@ -149,6 +197,34 @@ class InferenceSession::Impl {
     return common::Status::OK();
   }
 
+  common::Status LoadModelFile(const std::string& model_uri, std::shared_ptr<onnxruntime::Model>& p_model) {
+    // initializers with external data are stored relative to the model file
+    const auto separator = model_uri.find_last_of("/\\");
+    model_dir_ = separator == std::string::npos ? std::string() : model_uri.substr(0, separator);
+
+    if (session_options_.enable_mmap_model_loading) {
+      return onnxruntime::Model::LoadFromMappedFile(model_uri, p_model,
+                                                    HasLocalSchema() ? &custom_schema_registries_ : nullptr);
+    }
+    return onnxruntime::Model::Load(model_uri, p_model, HasLocalSchema() ? &custom_schema_registries_ : nullptr);
+  }
+
+#ifdef _WIN32
+  common::Status LoadModelFile(const std::wstring& model_uri, std::shared_ptr<onnxruntime::Model>& p_model) {
+    // memory mapped loading and the external data of initializers both go through the narrow file APIs
+    std::string mb_model_uri;
+    if (ToMBPath(model_uri, mb_model_uri)) {
+      return LoadModelFile(mb_model_uri, p_model);
+    }
+
+    LOGS(*session_logger_, WARNING) << "The model path can't be represented in the current code page. "
+                                    << "The model is loaded without memory mapping, and initializers with "
+                                    << "external data can't be found.";
+    model_dir_.clear();
+    return onnxruntime::Model::Load(model_uri, p_model, HasLocalSchema() ? &custom_schema_registries_ : nullptr);
+  }
+#endif
+
   common::Status Load(const ModelProto& model_proto) {
     auto tp = session_profiler_.StartTime();
     try {
@@ -252,7 +328,8 @@ class InferenceSession::Impl {
                                        const onnxruntime::GraphTransformerManager& graph_transformer_mgr,
                                        const ExecutionProviders& providers,
                                        KernelRegistryManager& kernel_registry_manager,
-                                       const InsertCastTransformer& insert_cast_transformer) {
+                                       const InsertCastTransformer& insert_cast_transformer,
+                                       const logging::Logger& logger) {
     // The transformer order:
     // 1. built-in graph rewriter
     // 2. each execution provider's transformer
@@ -261,7 +338,7 @@ class InferenceSession::Impl {
     // 5. insert cast nodes.
 
     // first apply the default/system/basic graph to graph optimizations.
-    ORT_RETURN_IF_ERROR(graph_transformer_mgr.ApplyAll(graph));
+    ORT_RETURN_IF_ERROR(graph_transformer_mgr.ApplyAll(graph, logger));
 
     auto kernels{kernel_registry_manager.GetAllKernelRegistries()};
 
@@ -311,6 +388,7 @@ class InferenceSession::Impl {
           // create SessionState for executing subgraph
           subgraph_info.session_state = std::make_unique<SessionState>(execution_providers_);
           subgraph_info.session_state->SetProfiler(session_profiler_);
+          subgraph_info.session_state->SetThreadPool(thread_pool_.get());
 
           // setup everything required to execute the subgraph and save it in subgraph_session_state
           SessionStateInitializer initializer{*subgraph, *subgraph_info.session_state,
@@ -320,7 +398,8 @@ class InferenceSession::Impl {
                                                      session_options_.enable_sequential_execution));
 
           ORT_RETURN_IF_ERROR(initializer.InitializeAndSave(session_state_.GetEnableMemoryPattern(),
-                                                            subgraph_info.weights_buffers));
+                                                            subgraph_info.weights_buffers, model_dir_,
+                                                            session_options_.enable_mmap_model_loading));
 
           // add the subgraph SessionState instance to the parent graph SessionState so it can be retrieved
           // by Compute() via OpKernelContextInternal.
@@ -362,7 +441,10 @@ class InferenceSession::Impl {
       // Register default CPUExecutionProvider if user didn't provide it through the Register() calls
       if (!execution_providers_.Get(onnxruntime::kCpuExecutionProvider)) {
         LOGS(*session_logger_, INFO) << "Adding default CPU execution provider.";
-        CPUExecutionProviderInfo epi{session_options_.enable_cpu_mem_arena};
+        CPUExecutionProviderInfo epi{session_options_.enable_cpu_mem_arena,
+                                     session_options_.enable_cpu_mem_arena_thread_cache
+                                         ? BFCArena::kDefaultThreadCacheCapacity
+                                         : 0};
         execution_providers_.Add(onnxruntime::kCpuExecutionProvider,
                                  std::make_unique<CPUExecutionProvider>(epi));
       }
@@ -387,12 +469,12 @@ class InferenceSession::Impl {
       // apply any transformations to the main graph and any subgraphs
       ORT_RETURN_IF_ERROR(TransformGraph(graph, graph_transformation_mgr_,
                                          execution_providers_, kernel_registry_manager_,
-                                         insert_cast_transformer_));
+                                         insert_cast_transformer_, *session_logger_));
 
       ORT_RETURN_IF_ERROR(utils::ForAllMutableSubgraphs(graph, [this](Graph& subgraph) {
         return TransformGraph(subgraph, graph_transformation_mgr_,
                               execution_providers_, kernel_registry_manager_,
-                              insert_cast_transformer_);
+                              insert_cast_transformer_, *session_logger_);
       }));
 
       // now that all the transforms are done, call Resolve on the main graph. this will recurse into the subgraphs.
@@ -400,7 +482,12 @@ class InferenceSession::Impl {
 
       ORT_RETURN_IF_ERROR(session_initializer.CreatePlan({}, session_options_.enable_sequential_execution));
       ORT_RETURN_IF_ERROR(session_initializer.InitializeAndSave(session_state_.GetEnableMemoryPattern(),
-                                                                weights_buffers_));
+                                                                weights_buffers_, model_dir_,
+                                                                session_options_.enable_mmap_model_loading));
+
+      if (session_options_.enable_critical_path_scheduling && !session_options_.enable_sequential_execution) {
+        session_state_.SetNodeCostModel(std::make_unique<NodeCostModel>(*session_state_.GetGraphViewer()));
+      }
 
       // handle any subgraphs
       ORT_RETURN_IF_ERROR(InitializeSubgraphSessions(graph, session_state_));
@@ -427,6 +514,10 @@ class InferenceSession::Impl {
     return current_num_runs_.load();
   }
 
+  MemoryPatternCacheStats GetMemoryPatternCacheStats() const {
+    return session_state_.GetMemoryPatternCacheStats();
+  }
+
   common::Status Run(const NameMLValMap& feeds,
                      const std::vector<std::string>& output_names,
                      std::vector<MLValue>* p_fetches) {
@@ -434,6 +525,78 @@ class InferenceSession::Impl {
     return Run(run_options, feeds, output_names, p_fetches);
   }
 
+  common::Status RunAsync(const RunOptions* run_options,
+                          const NameMLValMap& feeds,
+                          const std::vector<std::string>& output_names,
+                          std::vector<MLValue> fetches,
+                          RunAsyncCallback callback) {
+    if (!callback) {
+      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "RunAsync requires a callback");
+    }
+
+    {
+      std::lock_guard<std::mutex> l(session_mutex_);
+      if (!is_inited_) {
+        LOGS(*session_logger_, ERROR) << "Session was not initialized";
+        return Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+      }
+    }
+
+    // the feeds and fetches are held by the task. MLValue copies share the underlying data.
+    auto task = [this, run_options, feeds, output_names, fetches, callback]() mutable {
+      Status status;
+      if (run_options != nullptr) {
+        status = Run(*run_options, feeds, output_names, &fetches);
+      } else {
+        RunOptions default_run_options;
+        status = Run(default_run_options, feeds, output_names, &fetches);
+      }
+
+      try {
+        callback(status, fetches);
+      } catch (const std::exception& ex) {
+        LOGS(*session_logger_, ERROR) << "Exception thrown by a RunAsync callback: " << ex.what();
+      } catch (...) {
+        LOGS(*session_logger_, ERROR) << "Unknown exception thrown by a RunAsync callback";
+      }
+    };
+
+    {
+      std::lock_guard<std::mutex> lock(async_run_mutex_);
+      if (async_run_workers_.empty()) {
+        int num_workers = session_options_.async_run_thread_pool_size;
+        if (num_workers <= 0) {
+          num_workers = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+        }
+        for (int i = 0; i < num_workers; ++i) {
+          async_run_workers_.emplace_back([this]() { AsyncRunWorkerLoop(); });
+        }
+      }
+      async_run_queue_.push_back(std::move(task));
+    }
+    async_run_cv_.notify_one();
+
+    return Status::OK();
+  }
+
+  // Runs the requests queued by RunAsync until the session is destroyed.
+  void AsyncRunWorkerLoop() {
+    std::unique_lock<std::mutex> lock(async_run_mutex_);
+    for (;;) {
+      async_run_cv_.wait(lock, [this]() { return async_run_shutdown_ || !async_run_queue_.empty(); });
+      if (async_run_queue_.empty()) {
+        // shutting down, and all the requests have run
+        return;
+      }
+
+      auto task = std::move(async_run_queue_.front());
+      async_run_queue_.pop_front();
+      lock.unlock();
+      task();
+      lock.lock();
+    }
+  }
+
   static common::Status CheckTypes(MLDataType actual, MLDataType expected) {
     if (actual == expected) {
       return Status::OK();
@@ -444,6 +607,19 @@ class InferenceSession::Impl {
                   "Unexpected input data type. Actual: (" + actual_name + ") , expected: (" + expected_name + ")");
   }
 
+  static common::Status ValidateInputType(const NodeArg& arg, const MLValue& input_ml_value) {
+    auto input_type = input_ml_value.Type();
+    auto expected_type = utils::GetMLDataType(arg);
+
+    if (!input_ml_value.IsTensor()) {
+      return CheckTypes(input_type, expected_type);
+    }
+
+    auto expected_element_type = expected_type->AsTensorType()->GetElementType();
+    auto input_element_type = input_ml_value.Get<Tensor>().DataType();
+    return CheckTypes(input_element_type, expected_element_type);
+  }
+
   common::Status ValidateInputTypes(const NameMLValMap& feeds) {
     for (auto& arg : input_def_list_) {
       auto& arg_name = arg->Name();
@@ -451,24 +627,7 @@ class InferenceSession::Impl {
         continue;
       }
 
-      auto& input_ml_value = feeds.at(arg_name);
-      auto input_type = input_ml_value.Type();
-      auto expected_type = utils::GetMLDataType(*arg);
-
-      if (!input_ml_value.IsTensor()) {
-        auto retval = CheckTypes(input_type, expected_type);
-        if (!retval.IsOK()) {
-          return retval;
-        }
-        continue;
-      }
-
-      auto expected_element_type = expected_type->AsTensorType()->GetElementType();
-      auto input_element_type = input_ml_value.Get<Tensor>().DataType();
-      auto retval = CheckTypes(input_element_type, expected_element_type);
-      if (!retval.IsOK()) {
-        return retval;
-      }
+      ORT_RETURN_IF_ERROR(ValidateInputType(*arg, feeds.at(arg_name)));
     }
     return Status::OK();
   }
@@ -909,6 +1068,144 @@ class InferenceSession::Impl {
     return Run(run_options, io_binding);
   }
 
+  common::Status NewRunContext(const std::vector<std::string>& input_names,
+                               const std::vector<std::string>& output_names,
+                               std::unique_ptr<RunContext>* run_context) {
+    {
+      std::lock_guard<std::mutex> l(session_mutex_);
+      if (!is_inited_) {
+        LOGS(*session_logger_, ERROR) << "Session was not initialized";
+        return common::Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+      }
+    }
+
+    // validate the names the same way Run would, using placeholder values
+    NameMLValMap feeds;
+    for (const auto& name : input_names) {
+      if (!feeds.emplace(name, MLValue()).second) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Duplicate input name: ", name);
+      }
+    }
+    ORT_RETURN_IF_ERROR(ValidateInputNames(feeds));
+    std::vector<MLValue> fetches;
+    ORT_RETURN_IF_ERROR(ValidateOutputs(output_names, &fetches));
+
+    // private constructor, can't use make_unique
+    auto context = std::unique_ptr<RunContext>(new RunContext(input_names, output_names));
+
+    // the frame can only be reused if no values need to be copied across devices before or after execution,
+    // and the sequential executor is used as the parallel executor owns its frame.
+    bool cpu_only = true;
+    for (auto& xp : execution_providers_) {
+      cpu_only = cpu_only && xp->Type() == onnxruntime::kCpuExecutionProvider;
+    }
+    context->reuse_frame_ = cpu_only && session_options_.enable_sequential_execution;
+
+    if (context->reuse_frame_) {
+      const auto& mlvalue_name_idx_map = session_state_.GetMLValueNameIdxMap();
+      for (const auto& name : input_names) {
+        int mlvalue_idx;
+        ORT_RETURN_IF_ERROR(mlvalue_name_idx_map.GetIdx(name, mlvalue_idx));
+        context->feed_mlvalue_idxs_.push_back(mlvalue_idx);
+
+        auto def = std::find_if(input_def_list_.cbegin(), input_def_list_.cend(),
+                                [&name](const NodeArg* arg) { return arg->Name() == name; });
+        context->input_defs_.push_back(def != input_def_list_.cend() ? *def : nullptr);
+      }
+
+      for (const auto& name : output_names) {
+        int mlvalue_idx;
+        ORT_RETURN_IF_ERROR(mlvalue_name_idx_map.GetIdx(name, mlvalue_idx));
+        context->fetch_mlvalue_idxs_.push_back(mlvalue_idx);
+
+        // an output that was constant folded into a weight is handled by MatchOutputsWithProviders in Run
+        if (session_state_.GetInitializedTensors().count(mlvalue_idx) > 0) {
+          context->reuse_frame_ = false;
+        }
+      }
+    }
+
+    *run_context = std::move(context);
+    return Status::OK();
+  }
+
+  common::Status Run(const RunOptions& run_options,
+                     RunContext& run_context,
+                     const std::vector<MLValue>& feeds,
+                     std::vector<MLValue>* p_fetches) {
+    if (feeds.size() != run_context.input_names_.size()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Expected ", run_context.input_names_.size(),
+                             " feeds but got ", feeds.size());
+    }
+
+    if (!run_context.reuse_frame_) {
+      NameMLValMap feed_map;
+      for (size_t i = 0; i < feeds.size(); ++i) {
+        feed_map[run_context.input_names_[i]] = feeds[i];
+      }
+      return Run(run_options, feed_map, run_context.output_names_, p_fetches);
+    }
+
+    if (!p_fetches) {
+      return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "Output vector pointer is NULL");
+    }
+
+    if (!p_fetches->empty() && p_fetches->size() != run_context.output_names_.size()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Output vector incorrectly sized: output_names.size(): ",
+                             run_context.output_names_.size(), " p_fetches->size(): ", p_fetches->size());
+    }
+
+    for (size_t i = 0; i < feeds.size(); ++i) {
+      if (run_context.input_defs_[i] != nullptr) {
+        ORT_RETURN_IF_ERROR(ValidateInputType(*run_context.input_defs_[i], feeds[i]));
+      }
+    }
+
+    auto tp = session_profiler_.StartTime();
+    Status retval = Status::OK();
+
+    try {
+      if (!run_options.run_tag.empty()) {
+        LOGS(*session_logger_, INFO) << "Running with tag: " << run_options.run_tag;
+      }
+
+      ++current_num_runs_;
+
+      std::unique_ptr<logging::Logger> owned_run_logger;
+      auto run_logger = CreateLoggerForRun(run_options, owned_run_logger);
+
+      for (auto& xp : execution_providers_)
+        ORT_CHECK_AND_SET_RETVAL(xp->OnRunStart());
+
+      if (retval.IsOK()) {
+        if (run_context.frame_ == nullptr) {
+          run_context.frame_ = std::make_unique<ExecutionFrame>(run_context.feed_mlvalue_idxs_, feeds,
+                                                                run_context.fetch_mlvalue_idxs_, *p_fetches,
+                                                                session_state_);
+        } else {
+          run_context.frame_->Reset(feeds, *p_fetches);
+        }
+
+        SequentialExecutor executor(run_options.terminate);
+        retval = executor.Execute(session_state_, *run_context.frame_, *p_fetches, run_logger);
+
+        // don't keep the feeds and fetches alive until the next run
+        run_context.frame_->ReleaseValues();
+      }
+    } catch (const std::exception& e) {
+      retval = Status(common::ONNXRUNTIME, common::FAIL, e.what());
+    } catch (...) {
+      retval = Status(common::ONNXRUNTIME, common::RUNTIME_EXCEPTION, "Encountered unknown exception in Run()");
+    }
+
+    for (auto& xp : execution_providers_)
+      ORT_CHECK_AND_SET_RETVAL(xp->OnRunEnd());
+
+    --current_num_runs_;
+    session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "model_run", tp);
+    return retval;
+  }
+
   void StartProfiling(const std::string& file_prefix) {
     std::ostringstream ss;
     ss << file_prefix << "_" << GetCurrentTimeString() << ".json";
@@ -1092,6 +1389,9 @@ class InferenceSession::Impl {
   // if they need.
   std::shared_ptr<onnxruntime::Model> model_;
 
+  // Directory of the model file, if loaded from a path. Locations of external initializer data are relative to it.
+  std::string model_dir_;
+
   // A set of executors that can run in parallel.
   std::vector<std::unique_ptr<IExecutor>> executors_;  // TODO do we need this vector?
 
@@ -1114,8 +1414,7 @@ class InferenceSession::Impl {
   //Env* env_;
 
   // Threadpool for this session
-  //thread::ThreadPool thread_pool_; // not used for now; will add it later when implementing RunAsync
-  std::unique_ptr<TaskThreadPool> thread_pool_;
+  std::unique_ptr<concurrency::ThreadPool> thread_pool_;
 
   // Number of concurrently running executors
   std::atomic<int> current_num_runs_;
@@ -1129,6 +1428,14 @@ class InferenceSession::Impl {
 
   // memory allocations for any subgraphs
   std::vector<SubgraphMemory> subgraph_memory_;
+
+  // The requests queued by RunAsync, run by async_run_workers_. The queue is unbounded, so RunAsync never runs a
+  // request on the calling thread. The workers are started by the first RunAsync call.
+  std::mutex async_run_mutex_;
+  std::condition_variable async_run_cv_;
+  std::deque<std::function<void()>> async_run_queue_;  // GUARDED_BY(async_run_mutex_)
+  bool async_run_shutdown_ = false;                    // GUARDED_BY(async_run_mutex_)
+  std::vector<std::thread> async_run_workers_;         // GUARDED_BY(async_run_mutex_)
 };  // namespace onnxruntime
 
 //
@@ -1170,6 +1477,38 @@ common::Status InferenceSession::Run(const RunOptions& run_options,
   return impl_->Run(run_options, feeds, output_names, p_fetches);
 }
 
+common::Status InferenceSession::RunAsync(const RunOptions* run_options,
+                                          const NameMLValMap& feeds,
+                                          const std::vector<std::string>& output_names,
+                                          RunAsyncCallback callback) {
+  return impl_->RunAsync(run_options, feeds, output_names, {}, std::move(callback));
+}
+
+std::future<common::Status> InferenceSession::RunAsync(const RunOptions* run_options,
+                                                       const NameMLValMap& feeds,
+                                                       const std::vector<std::string>& output_names,
+                                                       std::vector<MLValue>* p_fetches) {
+  auto promise = std::make_shared<std::promise<common::Status>>();
+  std::future<common::Status> future = promise->get_future();
+  if (p_fetches == nullptr) {
+    promise->set_value(Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "Output vector pointer is NULL"));
+    return future;
+  }
+
+  auto status = impl_->RunAsync(run_options, feeds, output_names, *p_fetches,
+                                [promise, p_fetches](const common::Status& run_status, std::vector<MLValue>& fetches) {
+                                  if (run_status.IsOK()) {
+                                    *p_fetches = std::move(fetches);
+                                  }
+                                  promise->set_value(run_status);
+                                });
+  if (!status.IsOK()) {
+    promise->set_value(status);
+  }
+
+  return future;
+}
+
 std::pair<common::Status, const ModelMetadata*> InferenceSession::GetModelMetadata() const {
   return impl_->GetModelMetadata();
 }
@@ -1182,10 +1521,27 @@ std::pair<common::Status, const OutputDefList*> InferenceSession::GetModelOutput
   return impl_->GetModelOutputs();
 }
 
+common::Status InferenceSession::NewRunContext(const std::vector<std::string>& input_names,
+                                               const std::vector<std::string>& output_names,
+                                               std::unique_ptr<RunContext>* run_context) {
+  return impl_->NewRunContext(input_names, output_names, run_context);
+}
+
+common::Status InferenceSession::Run(const RunOptions& run_options,
+                                     RunContext& run_context,
+                                     const std::vector<MLValue>& feeds,
+                                     std::vector<MLValue>* p_fetches) {
+  return impl_->Run(run_options, run_context, feeds, p_fetches);
+}
+
 int InferenceSession::GetCurrentNumRuns() {
   return impl_->GetCurrentNumRuns();
 }
 
+MemoryPatternCacheStats InferenceSession::GetMemoryPatternCacheStats() const {
+  return impl_->GetMemoryPatternCacheStats();
+}
+
 void InferenceSession::StartProfiling(const std::string& file_prefix) {
   impl_->StartProfiling(file_prefix);
 }
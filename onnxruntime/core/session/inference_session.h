@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <functional>
+#include <future>
 #include <string>
 #include <unordered_map>
 
@@ -23,6 +25,7 @@ class ModelProto;
 namespace onnxruntime {
 class IExecutionProvider;  // forward decl
 class IOBinding;
+class RunContext;
 
 class CustomRegistry;
 
@@ -34,7 +37,6 @@ class LoggingManager;
   * Configuration information for a session.
   */
 struct SessionOptions {
-  //int num_threads; // not used now until we re-introduce threadpools for async execution
   bool enable_sequential_execution = true;  // TODO: should we default to sequential execution?
 
   // enable profiling for this session.
@@ -46,11 +48,23 @@ struct SessionOptions {
   // with a big chunk for all the internal memory allocation.
   bool enable_mem_pattern = true;
 
+  // maximum number of memory patterns cached for different input shapes. the least recently used pattern
+  // is evicted when the limit is reached. 0 disables the cache.
+  size_t mem_pattern_cache_capacity = 16;
+
+  // round the input dimensions up to the next power of two when looking up a memory pattern, so inputs of
+  // similar size (e.g. variable sequence lengths) reuse the pattern traced for the largest one seen.
+  bool enable_mem_pattern_shape_bucketing = true;
+
   // enable the memory arena on CPU
   // Arena may pre-allocate memory for future usage.
   // set this option to false if you don't want it.
   bool enable_cpu_mem_arena = true;
 
+  // keep small blocks freed on a thread in a per-thread cache in front of the CPU arena, so concurrent
+  // Run calls don't contend on the arena lock. Only used if enable_cpu_mem_arena is true.
+  bool enable_cpu_mem_arena_thread_cache = true;
+
   // the prefix of the profile file. The current time will be appended to the file name.
   std::string profile_file_prefix = "onnxruntime_profile_";
 
@@ -59,10 +73,31 @@ struct SessionOptions {
 
   unsigned max_num_graph_transformation_steps = 5;  // TODO choose a good default here?
 
-  // How many threads in the session thread pool.
+  // How many worker threads in the session thread pool. The pool is shared by the parallel executor,
+  // MLAS and the CPU kernels that parallelize internally. The thread calling Run() also participates in
+  // intra-op parallel loops. 0 means one thread less than the number of hardware threads.
   int session_thread_pool_size = 0;
+
+  // When using the parallel executor, estimate the cost of each node from its shapes (refined with measured
+  // execution times as the session runs) and run the ready nodes on the critical path first.
+  bool enable_critical_path_scheduling = false;
+
+  // Load the model file through a read-only memory mapping, and use the data of CPU initializers in place
+  // instead of copying it into separate buffers. Initializers with external data are mapped from their files.
+  bool enable_mmap_model_loading = false;
+
+  // How many threads run the requests queued by RunAsync(). The threads are started by the first RunAsync call.
+  // 0 means the number of hardware threads.
+  int async_run_thread_pool_size = 0;
 };
 
+/**
+  * Completion callback of InferenceSession::RunAsync.
+  * @param status the status the Run returned.
+  * @param fetches output values in the order specified by the output names. Only valid if status is OK.
+  */
+using RunAsyncCallback = std::function<void(const common::Status& status, std::vector<MLValue>& fetches)>;
+
 /**
   * Pre-defined and custom metadata about the model.
   */
@@ -196,6 +231,34 @@ class InferenceSession {
                      const std::vector<std::string>& output_names,
                      std::vector<MLValue>* p_fetches);
 
+  /**
+    * Queue a Run on the session's async run threads and return without waiting for it.
+    * Multiple threads are allowed to call this function, and any number of requests may be queued.
+    * @param run_options options of the Run. May be null. If not null it must remain valid until the
+    *        callback is called, and can be used to terminate the request.
+    * @param feeds named inputs. The values are shared, not copied, and should not be changed until
+    *        the callback is called.
+    * @param output_names output names
+    * @param callback called on a thread of the pool once the Run has completed. It must not throw.
+    * @return OK if the request was queued. Errors of the Run itself are passed to the callback.
+    */
+  common::Status RunAsync(const RunOptions* run_options,
+                          const NameMLValMap& feeds,
+                          const std::vector<std::string>& output_names,
+                          RunAsyncCallback callback);
+
+  /**
+    * Queue a Run as above, and return a future that is ready once it has completed.
+    * @param p_fetches output values in the order specified by output_names. As with Run, values already in
+    *        it are used as pre-allocated outputs. It is set before the future is ready, and must remain valid
+    *        until then.
+    * @return the status of the Run, or the error that prevented queuing it.
+    */
+  std::future<common::Status> RunAsync(const RunOptions* run_options,
+                                       const NameMLValMap& feeds,
+                                       const std::vector<std::string>& output_names,
+                                       std::vector<MLValue>* p_fetches);
+
   /**
   * Creates a new binding object for binding inputs and outputs.
   * @param provider_type specifies the location where the inputs need to be potentially copied. 
@@ -206,6 +269,30 @@ class InferenceSession {
   common::Status Run(const RunOptions& run_options, IOBinding& io_binding);
   common::Status Run(IOBinding& io_binding);
 
+  /**
+    * Create a RunContext to run the model repeatedly with the same input and output names.
+    * The names are validated and resolved once here instead of on every Run.
+    * See RunContext class for more info.
+    * @param input_names names of the inputs that will be fed, in the order the values are passed to Run.
+    * @param output_names names of the outputs to fetch, in the order they are returned by Run.
+    * @return OK if success.
+    */
+  common::Status NewRunContext(const std::vector<std::string>& input_names,
+                               const std::vector<std::string>& output_names,
+                               std::unique_ptr<RunContext>* run_context);
+
+  /**
+    * Run the model using a RunContext created by NewRunContext.
+    * @param feeds the values of the inputs, in the order of the input names the context was created with.
+    * @param p_fetches output values in the order of the output names the context was created with.
+    *        This should not be null. All outputs are allocated by the runtime if p_fetches is empty.
+    * @return OK if success.
+    */
+  common::Status Run(const RunOptions& run_options,
+                     RunContext& run_context,
+                     const std::vector<MLValue>& feeds,
+                     std::vector<MLValue>* p_fetches);
+
   /**
     * @return pair.first = OK; FAIL otherwise. pair.second is non-NULL when pair.first = OK.
     * @note lifetime of the returned pointer is valid as long as the Session object is live.
@@ -232,6 +319,11 @@ class InferenceSession {
     */
   int GetCurrentNumRuns();
 
+  /**
+    * Get the hit/miss counters of the memory pattern cache, to help tune mem_pattern_cache_capacity.
+    */
+  MemoryPatternCacheStats GetMemoryPatternCacheStats() const;
+
   /**
     * Start profiling on this inference session. This simply turns on profiling events to be 
     * recorded. A corresponding EndProfiling has to follow to write profiling data to a file.
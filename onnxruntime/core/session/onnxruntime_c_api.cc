@@ -404,13 +404,11 @@ ORT_API_STATUS_IMPL(OrtCreateInferenceSession, _In_ OrtEnv* env, _In_ const char
 }
 #endif
 
-ORT_API_STATUS_IMPL(OrtRunInference, _In_ OrtSession* sess,
-                    _In_ OrtRunOptions* run_options,
-                    _In_ const char* const* input_names, _In_ const OrtValue* const* input, size_t input_len,
-                    _In_ const char* const* output_names1, size_t output_names_len, _Out_ OrtValue** output) {
-  API_IMPL_BEGIN
-  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
-  ::onnxruntime::NameMLValMap in;
+// convert the arguments of OrtRunInference* to the ones of InferenceSession::Run
+static OrtStatus* CreateFeedsAndOutputNames(_In_ const char* const* input_names, _In_ const OrtValue* const* input,
+                                            size_t input_len, _In_ const char* const* output_names1,
+                                            size_t output_names_len, ::onnxruntime::NameMLValMap& in,
+                                            std::vector<std::string>& output_names) {
   const int queue_id = 0;
   for (size_t i = 0; i != input_len; ++i) {
     auto kvp = in.insert(std::make_pair(std::string(input_names[i]),
@@ -423,13 +421,30 @@ ORT_API_STATUS_IMPL(OrtRunInference, _In_ OrtSession* sess,
       value.Fence()->BeforeUsingAsInput(onnxruntime::kCpuExecutionProvider, queue_id);
   }
   // Create output feed
-  std::vector<std::string> output_names(output_names_len);
+  output_names.resize(output_names_len);
   for (size_t i = 0; i != output_names_len; ++i) {
     if (output_names1[i] == nullptr || output_names1[i][0] == '\0') {
       return OrtCreateStatus(ORT_INVALID_ARGUMENT, "output name cannot be empty");
     }
     output_names[i] = output_names1[i];
   }
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtRunInference, _In_ OrtSession* sess,
+                    _In_ OrtRunOptions* run_options,
+                    _In_ const char* const* input_names, _In_ const OrtValue* const* input, size_t input_len,
+                    _In_ const char* const* output_names1, size_t output_names_len, _Out_ OrtValue** output) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  ::onnxruntime::NameMLValMap in;
+  std::vector<std::string> output_names;
+  const int queue_id = 0;
+  OrtStatus* create_status = CreateFeedsAndOutputNames(input_names, input, input_len, output_names1, output_names_len,
+                                                       in, output_names);
+  if (create_status != nullptr) {
+    return create_status;
+  }
 
   std::vector<MLValue> fetches(output_names_len);
   for (size_t i = 0; i != output_names_len; ++i) {
@@ -462,6 +477,47 @@ ORT_API_STATUS_IMPL(OrtRunInference, _In_ OrtSession* sess,
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtRunInferenceAsync, _In_ OrtSession* sess,
+                    _In_opt_ OrtRunOptions* run_options,
+                    _In_ const char* const* input_names, _In_ const OrtValue* const* input, size_t input_len,
+                    _In_ const char* const* output_names1, size_t output_names_len,
+                    _In_ OrtRunAsyncCallback callback, _In_opt_ void* user_data) {
+  API_IMPL_BEGIN
+  if (callback == nullptr) {
+    return OrtCreateStatus(ORT_INVALID_ARGUMENT, "callback cannot be NULL");
+  }
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  ::onnxruntime::NameMLValMap in;
+  std::vector<std::string> output_names;
+  OrtStatus* create_status = CreateFeedsAndOutputNames(input_names, input, input_len, output_names1, output_names_len,
+                                                       in, output_names);
+  if (create_status != nullptr) {
+    return create_status;
+  }
+
+  auto status = session->RunAsync(
+      run_options, in, output_names,
+      [callback, user_data, output_names_len](const Status& run_status, std::vector<MLValue>& fetches) {
+        if (!run_status.IsOK()) {
+          callback(user_data, nullptr, output_names_len, ToOrtStatus(run_status));
+          return;
+        }
+        const int queue_id = 0;
+        std::vector<OrtValue*> output(fetches.size());
+        for (size_t i = 0; i != fetches.size(); ++i) {
+          ::onnxruntime::MLValue& value = fetches[i];
+          if (value.Fence())
+            value.Fence()->BeforeUsingAsInput(onnxruntime::kCpuExecutionProvider, queue_id);
+          output[i] = reinterpret_cast<OrtValue*>(new MLValue(value));
+        }
+        callback(user_data, output.data(), output.size(), nullptr);
+      });
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtGetTensorMutableData, _In_ OrtValue* value, _Out_ void** output) {
   TENSOR_READWRITE_API_BEGIN
   //TODO: test if it's a string tensor
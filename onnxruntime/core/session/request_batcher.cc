@@ -0,0 +1,327 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/request_batcher.h"
+
+#include <algorithm>
+#include <cstring>
+#include <future>
+
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+
+// the batch dimension can be batched if it doesn't have a fixed size
+static Status CheckBatchDimension(const NodeArg& arg) {
+  const ONNX_NAMESPACE::TensorShapeProto* shape = arg.Shape();
+  if (shape == nullptr) {
+    // unknown shape. checked when the batch runs.
+    return Status::OK();
+  }
+
+  if (shape->dim_size() == 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "'", arg.Name(), "' is a scalar and can't be batched");
+  }
+
+  if (shape->dim(0).has_dim_value()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The batch dimension of '", arg.Name(),
+                           "' has a fixed size of ", shape->dim(0).dim_value(), " and can't be batched");
+  }
+
+  return Status::OK();
+}
+
+Status RequestBatcher::Create(InferenceSession& session,
+                              const std::vector<std::string>& output_names,
+                              const RequestBatcherOptions& options,
+                              std::unique_ptr<RequestBatcher>* batcher) {
+  ORT_RETURN_IF_NOT(batcher != nullptr, "batcher is null");
+  ORT_RETURN_IF_NOT(options.max_batch_size > 0, "max_batch_size must be positive");
+  ORT_RETURN_IF_NOT(options.num_threads > 0, "num_threads must be positive");
+  ORT_RETURN_IF_NOT(!output_names.empty(), "At least one output is required");
+
+  auto inputs = session.GetModelInputs();
+  ORT_RETURN_IF_ERROR(inputs.first);
+  auto outputs = session.GetModelOutputs();
+  ORT_RETURN_IF_ERROR(outputs.first);
+
+  std::vector<std::string> input_names;
+  for (const NodeArg* input : *inputs.second) {
+    ORT_RETURN_IF_ERROR(CheckBatchDimension(*input));
+    input_names.push_back(input->Name());
+  }
+  ORT_RETURN_IF_NOT(!input_names.empty(), "The model has no inputs to batch");
+
+  for (const auto& name : output_names) {
+    auto it = std::find_if(outputs.second->cbegin(), outputs.second->cend(),
+                           [&name](const NodeArg* output) { return output->Name() == name; });
+    if (it == outputs.second->cend()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid output name: ", name);
+    }
+    ORT_RETURN_IF_ERROR(CheckBatchDimension(**it));
+  }
+
+  batcher->reset(new RequestBatcher(session, input_names, output_names, options));
+  return Status::OK();
+}
+
+RequestBatcher::RequestBatcher(InferenceSession& session,
+                               const std::vector<std::string>& input_names,
+                               const std::vector<std::string>& output_names,
+                               const RequestBatcherOptions& options)
+    : session_(session),
+      input_names_(input_names),
+      output_names_(output_names),
+      options_(options),
+      allocator_(std::make_shared<CPUAllocator>()) {
+  for (int i = 0; i < options_.num_threads; ++i) {
+    workers_.emplace_back([this]() { WorkerLoop(); });
+  }
+}
+
+RequestBatcher::~RequestBatcher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+Status RequestBatcher::RunAsync(const NameMLValMap& feeds, RunAsyncCallback callback) {
+  ORT_RETURN_IF_NOT(callback, "RunAsync requires a callback");
+  if (feeds.size() != input_names_.size()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Expected ", input_names_.size(), " inputs, got ",
+                           feeds.size());
+  }
+
+  auto request = std::make_unique<Request>();
+  request->feeds.reserve(input_names_.size());
+  for (const auto& name : input_names_) {
+    auto it = feeds.find(name);
+    if (it == feeds.cend()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Missing input: ", name);
+    }
+    if (!it->second.IsTensor()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input '", name, "' is not a tensor");
+    }
+
+    const Tensor& tensor = it->second.Get<Tensor>();
+    if (strcmp(tensor.Location().name, CPU) != 0) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input '", name, "' is not on CPU");
+    }
+
+    const TensorShape& shape = tensor.Shape();
+    if (shape.NumDimensions() == 0) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input '", name, "' has no batch dimension");
+    }
+    if (request->feeds.empty()) {
+      request->rows = shape[0];
+    } else if (shape[0] != request->rows) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Batch dimension of input '", name, "' is ", shape[0],
+                             " while the one of input '", input_names_[0], "' is ", request->rows);
+    }
+
+    request->feeds.push_back(it->second);
+  }
+
+  request->callback = std::move(callback);
+  request->enqueue_time = std::chrono::steady_clock::now();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ORT_RETURN_IF_NOT(!shutdown_, "The batcher is shutting down");
+    pending_rows_ += request->rows;
+    pending_.push_back(std::move(request));
+  }
+  cv_.notify_all();
+  return Status::OK();
+}
+
+Status RequestBatcher::Run(const NameMLValMap& feeds, std::vector<MLValue>* p_fetches) {
+  ORT_RETURN_IF_NOT(p_fetches != nullptr, "Output vector pointer is NULL");
+
+  std::promise<Status> promise;
+  std::future<Status> future = promise.get_future();
+  ORT_RETURN_IF_ERROR(RunAsync(feeds, [&promise, p_fetches](const Status& status, std::vector<MLValue>& fetches) {
+    if (status.IsOK()) {
+      *p_fetches = std::move(fetches);
+    }
+    promise.set_value(status);
+  }));
+  return future.get();
+}
+
+bool RequestBatcher::CanBatchWith(const Request& first, const Request& request) {
+  for (size_t i = 0, end = first.feeds.size(); i < end; ++i) {
+    const Tensor& a = first.feeds[i].Get<Tensor>();
+    const Tensor& b = request.feeds[i].Get<Tensor>();
+    if (a.DataType() != b.DataType()) {
+      return false;
+    }
+
+    const auto& a_dims = a.Shape().GetDims();
+    const auto& b_dims = b.Shape().GetDims();
+    if (a_dims.size() != b_dims.size() || !std::equal(a_dims.cbegin() + 1, a_dims.cend(), b_dims.cbegin() + 1)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::vector<std::unique_ptr<RequestBatcher::Request>> RequestBatcher::TakeBatch() {
+  std::vector<std::unique_ptr<Request>> batch;
+  batch.push_back(std::move(pending_.front()));
+  pending_.pop_front();
+  int64_t rows = batch[0]->rows;
+
+  // requests that can't join the batch keep their place in the queue
+  for (auto it = pending_.begin(); it != pending_.end() && rows < options_.max_batch_size;) {
+    if ((*it)->rows + rows <= options_.max_batch_size && CanBatchWith(*batch[0], **it)) {
+      rows += (*it)->rows;
+      batch.push_back(std::move(*it));
+      it = pending_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  pending_rows_ -= rows;
+  return batch;
+}
+
+void RequestBatcher::WorkerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    cv_.wait(lock, [this]() { return shutdown_ || !pending_.empty(); });
+    if (pending_.empty()) {
+      // shutting down, and all the requests have run
+      return;
+    }
+
+    // wait for the batch to fill up, or for the oldest request to have waited long enough.
+    // the pending requests may have changed meanwhile, so check again after waiting.
+    auto deadline = pending_.front()->enqueue_time + options_.max_wait;
+    if (!shutdown_ && pending_rows_ < options_.max_batch_size && std::chrono::steady_clock::now() < deadline) {
+      cv_.wait_until(lock, deadline, [this]() {
+        return shutdown_ || pending_.empty() || pending_rows_ >= options_.max_batch_size;
+      });
+      continue;
+    }
+
+    auto batch = TakeBatch();
+    lock.unlock();
+    RunBatch(batch);
+    lock.lock();
+  }
+}
+
+void RequestBatcher::RunBatch(std::vector<std::unique_ptr<Request>>& batch) {
+  std::vector<std::vector<MLValue>> request_fetches(batch.size());
+  Status status;
+  try {
+    status = RunBatch(batch, request_fetches);
+  } catch (const std::exception& ex) {
+    status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exception while running a batch: ", ex.what());
+  }
+
+  for (size_t i = 0; i < batch.size(); ++i) {
+    try {
+      batch[i]->callback(status, request_fetches[i]);
+    } catch (...) {
+      // the callbacks must not throw. ignore it so the other requests of the batch complete.
+    }
+  }
+}
+
+static void CopyRows(const Tensor& src, int64_t src_row, Tensor& dst, int64_t dst_row, int64_t rows) {
+  const int64_t row_size = src.Shape().SizeFromDimension(1);
+  if (src.DataType() == DataTypeImpl::GetType<std::string>()) {
+    const std::string* src_data = src.Data<std::string>() + src_row * row_size;
+    std::copy(src_data, src_data + rows * row_size, dst.MutableData<std::string>() + dst_row * row_size);
+  } else {
+    const size_t row_bytes = static_cast<size_t>(row_size) * src.DataType()->Size();
+    if (rows * row_bytes > 0) {
+      memcpy(static_cast<char*>(dst.MutableDataRaw()) + dst_row * row_bytes,
+             static_cast<const char*>(src.DataRaw()) + src_row * row_bytes,
+             rows * row_bytes);
+    }
+  }
+}
+
+Status RequestBatcher::RunBatch(std::vector<std::unique_ptr<Request>>& batch,
+                                std::vector<std::vector<MLValue>>& request_fetches) {
+  if (batch.size() == 1) {
+    NameMLValMap feeds;
+    for (size_t i = 0; i < input_names_.size(); ++i) {
+      feeds.insert({input_names_[i], batch[0]->feeds[i]});
+    }
+    return session_.Run(run_options_, feeds, output_names_, &request_fetches[0]);
+  }
+
+  int64_t total_rows = 0;
+  for (const auto& request : batch) {
+    total_rows += request->rows;
+  }
+
+  // concatenate the inputs
+  NameMLValMap feeds;
+  for (size_t i = 0; i < input_names_.size(); ++i) {
+    const Tensor& first = batch[0]->feeds[i].Get<Tensor>();
+    std::vector<int64_t> dims = first.Shape().GetDims();
+    dims[0] = total_rows;
+    TensorShape shape(dims);
+    size_t size = static_cast<size_t>(shape.Size()) * first.DataType()->Size();
+    auto tensor = std::make_unique<Tensor>(first.DataType(), shape, size == 0 ? nullptr : allocator_->Alloc(size),
+                                           allocator_->Info(), allocator_);
+
+    int64_t row = 0;
+    for (const auto& request : batch) {
+      CopyRows(request->feeds[i].Get<Tensor>(), 0, *tensor, row, request->rows);
+      row += request->rows;
+    }
+
+    MLValue value{tensor.release(), DataTypeImpl::GetType<Tensor>(), DataTypeImpl::GetType<Tensor>()->GetDeleteFunc()};
+    feeds.insert({input_names_[i], value});
+  }
+
+  std::vector<MLValue> fetches;
+  ORT_RETURN_IF_ERROR(session_.Run(run_options_, feeds, output_names_, &fetches));
+
+  // split the outputs
+  for (auto& outputs : request_fetches) {
+    outputs.reserve(fetches.size());
+  }
+  for (size_t i = 0; i < fetches.size(); ++i) {
+    ORT_RETURN_IF_NOT(fetches[i].IsTensor(), "Output '", output_names_[i], "' is not a tensor");
+    const Tensor& output = fetches[i].Get<Tensor>();
+    const TensorShape& shape = output.Shape();
+    if (shape.NumDimensions() == 0 || shape[0] != total_rows) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Output '", output_names_[i], "' of shape ", shape,
+                             " doesn't have a batch dimension of ", total_rows);
+    }
+
+    int64_t row = 0;
+    std::vector<int64_t> dims = shape.GetDims();
+    for (size_t r = 0; r < batch.size(); ++r) {
+      dims[0] = batch[r]->rows;
+      TensorShape request_shape(dims);
+      size_t size = static_cast<size_t>(request_shape.Size()) * output.DataType()->Size();
+      auto tensor = std::make_unique<Tensor>(output.DataType(), request_shape,
+                                             size == 0 ? nullptr : allocator_->Alloc(size),
+                                             allocator_->Info(), allocator_);
+      CopyRows(output, row, *tensor, 0, batch[r]->rows);
+      row += batch[r]->rows;
+
+      request_fetches[r].emplace_back(tensor.release(), DataTypeImpl::GetType<Tensor>(),
+                                      DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,122 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ml_value.h"
+#include "core/session/inference_session.h"
+
+namespace onnxruntime {
+
+struct RequestBatcherOptions {
+  // maximum number of rows, summed over the batch dimension of the requests, in a batch.
+  // a request with more rows than this is run on its own.
+  int64_t max_batch_size = 32;
+
+  // how long the oldest pending request waits for others to join its batch.
+  std::chrono::microseconds max_wait{1000};
+
+  // number of batches run concurrently.
+  int num_threads = 1;
+};
+
+/**
+  * Dynamic batching front end of an InferenceSession.
+  * Usage is as follows:
+  *
+  * std::unique_ptr<RequestBatcher> batcher;
+  * RequestBatcher::Create(session, {"Y"}, RequestBatcherOptions(), &batcher);
+  *
+  * // from any number of threads
+  * std::vector<MLValue> fetches;
+  * batcher->Run({{"X", x}}, &fetches);
+  *
+  * Requests that arrive within max_wait of each other are concatenated along their first dimension, the batch
+  * dimension, and run with a single InferenceSession::Run. The outputs are then split along their first dimension
+  * and returned to each request. Requests are only batched together if the rest of the shapes of their inputs match.
+  *
+  * Every input of the model must be fed, and the batch dimension of the model inputs and of the requested outputs
+  * must not have a fixed size. The inputs must be CPU tensors.
+  *
+  * The session must outlive the batcher. Destroying the batcher runs the pending requests first.
+  */
+class RequestBatcher {
+ public:
+  static common::Status Create(InferenceSession& session,
+                               const std::vector<std::string>& output_names,
+                               const RequestBatcherOptions& options,
+                               std::unique_ptr<RequestBatcher>* batcher);
+
+  ~RequestBatcher();
+
+  /**
+    * Queue a request, and call callback with its outputs once its batch has run.
+    * @param feeds values of all the inputs of the model. The values are shared, not copied, and should not be
+    *        changed until the callback is called.
+    * @param callback called on a thread of the batcher. It must not throw.
+    * @return OK if the request was queued. Errors of the run are passed to the callback.
+    */
+  common::Status RunAsync(const NameMLValMap& feeds, RunAsyncCallback callback);
+
+  /**
+    * Queue a request and wait for its outputs.
+    * @param p_fetches output values in the order of the output names the batcher was created with.
+    */
+  common::Status Run(const NameMLValMap& feeds, std::vector<MLValue>* p_fetches);
+
+  const std::vector<std::string>& GetInputNames() const { return input_names_; }
+  const std::vector<std::string>& GetOutputNames() const { return output_names_; }
+
+ private:
+  struct Request {
+    std::vector<MLValue> feeds;  // in the order of input_names_
+    int64_t rows;
+    RunAsyncCallback callback;
+    std::chrono::steady_clock::time_point enqueue_time;
+  };
+
+  RequestBatcher(InferenceSession& session,
+                 const std::vector<std::string>& input_names,
+                 const std::vector<std::string>& output_names,
+                 const RequestBatcherOptions& options);
+
+  static bool CanBatchWith(const Request& first, const Request& request);
+
+  // take the oldest request and the pending requests that can join its batch. mutex_ must be held.
+  std::vector<std::unique_ptr<Request>> TakeBatch();
+
+  void RunBatch(std::vector<std::unique_ptr<Request>>& batch);
+
+  common::Status RunBatch(std::vector<std::unique_ptr<Request>>& batch,
+                          std::vector<std::vector<MLValue>>& request_fetches);
+
+  void WorkerLoop();
+
+  InferenceSession& session_;
+  const std::vector<std::string> input_names_;
+  const std::vector<std::string> output_names_;
+  const RequestBatcherOptions options_;
+  AllocatorPtr allocator_;
+  RunOptions run_options_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::unique_ptr<Request>> pending_;  // GUARDED_BY(mutex_)
+  int64_t pending_rows_ = 0;                      // GUARDED_BY(mutex_)
+  bool shutdown_ = false;                         // GUARDED_BY(mutex_)
+
+  std::vector<std::thread> workers_;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RequestBatcher);
+};
+}  // namespace onnxruntime
@@ -0,0 +1,16 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/run_context.h"
+
+#include "core/framework/execution_frame.h"
+
+namespace onnxruntime {
+
+RunContext::RunContext(const std::vector<std::string>& input_names, const std::vector<std::string>& output_names)
+    : input_names_(input_names), output_names_(output_names) {
+}
+
+RunContext::~RunContext() = default;
+
+}  // namespace onnxruntime
@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/ml_value.h"
+#include "core/session/inference_session.h"
+
+namespace onnxruntime {
+class ExecutionFrame;
+class NodeArg;
+
+/**
+  * Pre-bound context for running a session repeatedly with the same input and output names.
+  * Usage is as follows:
+  *
+  * InferenceSession session;
+  * session.Load();
+  * session.Initialize();
+  * ...
+  * std::unique_ptr<RunContext> run_context;
+  * session.NewRunContext({"X"}, {"Y"}, &run_context);
+  *
+  * for (...) {
+  *   std::vector<MLValue> fetches;
+  *   session.Run(run_options, *run_context, {x}, &fetches);
+  * }
+  *
+  * The input and output names are validated and resolved to MLValue indices once, and the ExecutionFrame is
+  * kept across runs so each Run only has to bind the new values. The memory pattern and its buffers are also
+  * kept for as long as the input shapes don't change.
+  *
+  * This applies to sessions using sequential execution with only the CPU execution provider. For other sessions
+  * the context falls back to a regular Run with the names it was created with.
+  *
+  * A RunContext must not be used by concurrent Run calls. Create one per thread instead.
+  */
+class RunContext {
+ public:
+  ~RunContext();
+
+  const std::vector<std::string>& GetInputNames() const { return input_names_; }
+  const std::vector<std::string>& GetOutputNames() const { return output_names_; }
+
+ private:
+  friend InferenceSession;
+
+  RunContext(const std::vector<std::string>& input_names, const std::vector<std::string>& output_names);
+
+  std::vector<std::string> input_names_;
+  std::vector<std::string> output_names_;
+
+  // set if the frame can be reused. the following members are only used in that case.
+  bool reuse_frame_ = false;
+
+  std::vector<const NodeArg*> input_defs_;  // for type validation. nullptr if the input has no definition.
+  std::vector<int> feed_mlvalue_idxs_;
+  std::vector<int> fetch_mlvalue_idxs_;
+
+  // created by the first Run
+  std::unique_ptr<ExecutionFrame> frame_;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RunContext);
+};
+}  // namespace onnxruntime
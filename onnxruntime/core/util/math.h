@@ -40,6 +40,9 @@ extern "C" {
 #include "core/framework/tensor.h"
 
 namespace onnxruntime {
+namespace concurrency {
+class ThreadPool;
+}
 
 enum StorageOrder {
   UNKNOWN = 0,
@@ -213,6 +216,29 @@ void GemmEx(
     const int ldc,
     Provider* provider);
 
+// GemmEx for a batch of matrices that are a fixed number of elements apart. A stride of 0 uses the same
+// matrix for every item of the batch.
+template <typename T, class Provider>
+void GemmStridedBatched(
+    const CBLAS_TRANSPOSE TransA,
+    const CBLAS_TRANSPOSE TransB,
+    const int batch_count,
+    const int M,
+    const int N,
+    const int K,
+    const T alpha,
+    const T* A,
+    const int lda,
+    const int64_t stride_a,
+    const T* B,
+    const int ldb,
+    const int64_t stride_b,
+    const T beta,
+    T* C,
+    const int ldc,
+    const int64_t stride_c,
+    Provider* provider);
+
 // GemmBatched provides a simple abstraction into library routines
 template <typename T, class Provider>
 void GemmBatched(
@@ -34,6 +34,7 @@
 #include <random>
 #include <unordered_set>
 #include "core/platform/env.h"
+#include "core/platform/threadpool.h"
 #include "core/common/logging/logging.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/util/math.h"
@@ -108,7 +109,7 @@ void Gemm<float, CPUMathUtil>(
 #elif defined(USE_MLAS)
   int lda = (int)((TransA == CblasNoTrans) ? K : M);
   int ldb = (int)((TransB == CblasNoTrans) ? N : K);
-  MlasSgemm(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, N);
+  MlasSgemm(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, N, nullptr);
 #else
   auto C_mat = EigenMatrixMap<float>(C, N, M);
   if (beta == 0) {
@@ -179,7 +180,7 @@ void GemmEx<float, CPUMathUtil>(
     ORT_THROW("mkldnn_sgemm failed with status: ", status);
   }
 #elif defined(USE_MLAS)
-  MlasSgemm(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+  MlasSgemm(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, nullptr);
 #else
   using OuterStride = Eigen::OuterStride<Eigen::Dynamic>;
   using StridedMap = Eigen::Map<Eigen::MatrixXf, 0, OuterStride>;
@@ -475,6 +476,90 @@ void GemmBatched<float, CPUMathUtil>(
   }
 }
 
+// Gemm variants that use the session thread pool for intra-op parallelism. MLAS partitions the
+// work across the pool; the other backends manage their own threading.
+template <>
+void Gemm<float, concurrency::ThreadPool>(
+    const CBLAS_TRANSPOSE TransA,
+    const CBLAS_TRANSPOSE TransB,
+    const int64_t M,
+    const int64_t N,
+    const int64_t K,
+    const float alpha,
+    const float* A,
+    const float* B,
+    const float beta,
+    float* C,
+    concurrency::ThreadPool* threadpool,
+    MLDataType math_type) {
+#if defined(USE_MLAS) && !defined(USE_MKLDNN) && (defined(USE_EIGEN_FOR_BLAS) && !defined(USE_MKLML_FOR_BLAS))
+  ORT_UNUSED_PARAMETER(math_type);
+  int lda = (int)((TransA == CblasNoTrans) ? K : M);
+  int ldb = (int)((TransB == CblasNoTrans) ? N : K);
+  MlasSgemm(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, N, threadpool);
+#else
+  ORT_UNUSED_PARAMETER(threadpool);
+  Gemm<float, CPUMathUtil>(TransA, TransB, M, N, K, alpha, A, B, beta, C, nullptr, math_type);
+#endif
+}
+
+template <>
+void GemmEx<float, concurrency::ThreadPool>(
+    const CBLAS_TRANSPOSE TransA,
+    const CBLAS_TRANSPOSE TransB,
+    const int M,
+    const int N,
+    const int K,
+    const float alpha,
+    const float* A,
+    const int lda,
+    const float* B,
+    const int ldb,
+    const float beta,
+    float* C,
+    const int ldc,
+    concurrency::ThreadPool* threadpool) {
+#if defined(USE_MLAS) && !defined(USE_MKLDNN) && (defined(USE_EIGEN_FOR_BLAS) && !defined(USE_MKLML_FOR_BLAS))
+  MlasSgemm(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, threadpool);
+#else
+  ORT_UNUSED_PARAMETER(threadpool);
+  GemmEx<float, CPUMathUtil>(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, nullptr);
+#endif
+}
+
+template <>
+void GemmStridedBatched<float, concurrency::ThreadPool>(
+    const CBLAS_TRANSPOSE TransA,
+    const CBLAS_TRANSPOSE TransB,
+    const int batch_count,
+    const int M,
+    const int N,
+    const int K,
+    const float alpha,
+    const float* A,
+    const int lda,
+    const int64_t stride_a,
+    const float* B,
+    const int ldb,
+    const int64_t stride_b,
+    const float beta,
+    float* C,
+    const int ldc,
+    const int64_t stride_c,
+    concurrency::ThreadPool* threadpool) {
+#if defined(USE_MLAS) && !defined(USE_MKLDNN) && (defined(USE_EIGEN_FOR_BLAS) && !defined(USE_MKLML_FOR_BLAS))
+  MlasSgemmStridedBatch(TransA, TransB, M, N, K, alpha, A, lda, static_cast<size_t>(stride_a),
+                        B, ldb, static_cast<size_t>(stride_b), beta, C, ldc, static_cast<size_t>(stride_c),
+                        batch_count, threadpool);
+#else
+  for (int i = 0; i < batch_count; ++i) {
+    GemmEx<float, concurrency::ThreadPool>(TransA, TransB, M, N, K, alpha,
+                                           A + stride_a * i, lda, B + stride_b * i, ldb, beta,
+                                           C + stride_c * i, ldc, threadpool);
+  }
+#endif
+}
+
 // MKL will be implmenet as an execution provider
 ////////////////////////////////////////////////////////////////////////////////
 // MKL VML alternatives.
@@ -75,7 +75,29 @@ bool PyObjectCheck_Array(PyObject* o) {
   return PyObject_HasAttrString(o, "__array_finalize__");
 }
 
-void CreateTensorMLValue(AllocatorPtr alloc, const std::string& name_input, PyArrayObject* pyObject, MLValue* p_mlvalue) {
+static bool IsStringType(int npy_type) {
+  return npy_type == NPY_UNICODE || npy_type == NPY_STRING || npy_type == NPY_VOID || npy_type == NPY_OBJECT;
+}
+
+void CreateTensorMLValue(AllocatorPtr alloc, const std::string& name_input, PyArrayObject* pyObject, MLValue* p_mlvalue,
+                         bool use_numpy_data_memory) {
+  if (use_numpy_data_memory && PyArray_ISCARRAY_RO(pyObject) && PyArray_ISNOTSWAPPED(pyObject) &&
+      !IsStringType(PyArray_TYPE(pyObject))) {
+    // The tensor points to the buffer of the array, which the caller keeps alive while the MLValue is in use.
+    int ndim = PyArray_NDIM(pyObject);
+    npy_intp* npy_dims = PyArray_DIMS(pyObject);
+    std::vector<int64_t> dims(npy_dims, npy_dims + ndim);
+    auto element_type = NumpyToOnnxRuntimeTensorType(PyArray_TYPE(pyObject));
+    std::unique_ptr<Tensor> p_tensor = std::make_unique<Tensor>(element_type,
+                                                                TensorShape(dims),
+                                                                PyArray_DATA(pyObject),
+                                                                alloc->Info());
+    p_mlvalue->Init(p_tensor.release(),
+                    DataTypeImpl::GetType<Tensor>(),
+                    DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+    return;
+  }
+
   PyArrayObject* darray = PyArray_GETCONTIGUOUS(pyObject);
   if (darray == NULL) {
     throw std::runtime_error(std::string("The object must be a contiguous array for input '") + name_input + std::string("'."));
@@ -382,11 +404,12 @@ void CreateGenericIterableMLValue(PyObject* iterator, AllocatorPtr alloc, const
   }
 }
 
-void CreateGenericMLValue(AllocatorPtr alloc, const std::string& name_input, py::object& value, MLValue* p_mlvalue) {
+void CreateGenericMLValue(AllocatorPtr alloc, const std::string& name_input, py::object& value, MLValue* p_mlvalue,
+                          bool use_numpy_data_memory) {
   if (PyObjectCheck_Array(value.ptr())) {
     // The most frequent case: input comes as an array.
     PyArrayObject* arr = reinterpret_cast<PyArrayObject*>(value.ptr());
-    CreateTensorMLValue(alloc, name_input, arr, p_mlvalue);
+    CreateTensorMLValue(alloc, name_input, arr, p_mlvalue, use_numpy_data_memory);
   } else if (PyDict_Check(value.ptr())) {
     CreateMapMLValue_AgnosticVectorMap((PyObject*)NULL, value.ptr(), alloc, name_input, p_mlvalue);
   } else {
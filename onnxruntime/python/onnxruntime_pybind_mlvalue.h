@@ -24,7 +24,10 @@ namespace py = pybind11;
 
 int OnnxRuntimeTensorToNumpyType(const DataTypeImpl* tensor_type);
 
-void CreateGenericMLValue(AllocatorPtr alloc, const std::string& name_input, py::object& value, MLValue* p_mlvalue);
+// If use_numpy_data_memory is true, a C-contiguous, aligned numpy array of a numeric type is wrapped without a copy.
+// The caller must then keep the array alive and unmodified for as long as p_mlvalue is used.
+void CreateGenericMLValue(AllocatorPtr alloc, const std::string& name_input, py::object& value, MLValue* p_mlvalue,
+                          bool use_numpy_data_memory = false);
 
 }  // namespace python
 }  // namespace onnxruntime
@@ -121,6 +121,10 @@ void AddNonTensorAsPyObj(onnxruntime::MLValue& val, vector<py::object>& pyobjs)
   }
 }
 
+static void DeleteMLValue(void* p) {
+  delete static_cast<MLValue*>(p);
+}
+
 void AddTensorAsPyObj(onnxruntime::MLValue& val, vector<py::object>& pyobjs) {
   const Tensor& rtensor = val.Get<Tensor>();
   std::vector<npy_intp> npy_dims;
@@ -132,6 +136,23 @@ void AddTensorAsPyObj(onnxruntime::MLValue& val, vector<py::object>& pyobjs) {
 
   MLDataType dtype = rtensor.DataType();
   const int numpy_type = OnnxRuntimeTensorToNumpyType(dtype);
+
+  if (numpy_type != NPY_OBJECT && rtensor.OwnsBuffer() && !val.IsShared() &&
+      strcmp(rtensor.Location().name, CPU) == 0) {
+    // The array uses the buffer of the tensor, and keeps the tensor alive through its base object.
+    // Buffers the tensor doesn't own, such as the ones of the feeds or of a memory pattern, are copied instead.
+    // So are tensors the session still holds, e.g. an initializer that is a graph output, so that writing to
+    // the array can't change the weights used by later runs.
+    py::capsule base(new MLValue(val), DeleteMLValue);
+    py::object obj = py::reinterpret_steal<py::object>(PyArray_SimpleNewFromData(
+        shape.NumDimensions(), npy_dims.data(), numpy_type, const_cast<void*>(rtensor.DataRaw(dtype))));
+    if (!obj || PyArray_SetBaseObject(reinterpret_cast<PyArrayObject*>(obj.ptr()), base.release().ptr()) != 0) {
+      throw py::error_already_set();
+    }
+    pyobjs.push_back(obj);
+    return;
+  }
+
   py::object obj = py::reinterpret_steal<py::object>(PyArray_SimpleNew(
       shape.NumDimensions(), npy_dims.data(), numpy_type));
 
@@ -240,6 +261,11 @@ with a big chunk for all the internal memory allocation. Default is true.)pbdoc"
       .def_readwrite("enable_cpu_mem_arena", &SessionOptions::enable_cpu_mem_arena,
                      R"pbdoc(Enables the memory arena on CPU. Arena may pre-allocate memory for future usage.
 Set this option to false if you don't want it. Default is True.)pbdoc")
+      .def_readwrite("mem_pattern_cache_capacity", &SessionOptions::mem_pattern_cache_capacity,
+                     R"pbdoc(Maximum number of memory patterns cached for different input shapes. Default is 16.)pbdoc")
+      .def_readwrite("enable_mem_pattern_shape_bucketing", &SessionOptions::enable_mem_pattern_shape_bucketing,
+                     R"pbdoc(Share memory patterns between inputs whose dimensions round up to the same power of two.
+Default is true.)pbdoc")
       .def_readwrite("enable_profiling", &SessionOptions::enable_profiling,
                      R"pbdoc(Enable profiling for this session. Default is false.)pbdoc")
       .def_readwrite("enable_sequential_execution", &SessionOptions::enable_sequential_execution,
@@ -252,7 +278,14 @@ Set this option to false if you don't want it. Default is True.)pbdoc")
                      R"pbdoc(Applies to session load, initialization, etc. Default is 0.)pbdoc")
       .def_readwrite("session_thread_pool_size", &SessionOptions::session_thread_pool_size,
                      R"pbdoc(How many threads in the session thread pool. Default is 0 to let onnxruntime choose.
-This parameter is unused unless *enable_sequential_execution* is false.)pbdoc");
+The pool is used for parallel execution of nodes when *enable_sequential_execution* is false,
+and for intra-op parallelism in the CPU kernels in both execution modes.)pbdoc")
+      .def_readwrite("enable_critical_path_scheduling", &SessionOptions::enable_critical_path_scheduling,
+                     R"pbdoc(Run the nodes on the critical path first when *enable_sequential_execution* is false.
+Node costs are estimated from the tensor shapes and refined with the measured execution times. Default is false.)pbdoc")
+      .def_readwrite("enable_mmap_model_loading", &SessionOptions::enable_mmap_model_loading,
+                     R"pbdoc(Load the model file through a memory mapping and use the initializer data in place
+instead of copying it. Default is false.)pbdoc");
 
   py::class_<RunOptions>(m, "RunOptions", R"pbdoc(Configuration information for a single Run.)pbdoc")
       .def(py::init())
@@ -356,7 +389,8 @@ including arg name, arg type (contains both type and shape).)pbdoc")
         NameMLValMap feeds;
         for (auto _ : pyfeeds) {
           MLValue ml_value;
-          CreateGenericMLValue(GetAllocator(), _.first, _.second, &ml_value);
+          // pyfeeds keeps the arrays alive until the end of the run, so their buffers can be used directly
+          CreateGenericMLValue(GetAllocator(), _.first, _.second, &ml_value, true);
           if (PyErr_Occurred()) {
             PyObject *ptype, *pvalue, *ptraceback;
             PyErr_Fetch(&ptype, &pvalue, &ptraceback);
@@ -376,10 +410,14 @@ including arg name, arg type (contains both type and shape).)pbdoc")
         std::vector<MLValue> fetches;
         common::Status status;
 
-        if (run_options != nullptr) {
-          status = sess->Run(*run_options, feeds, output_names, &fetches);
-        } else {
-          status = sess->Run(feeds, output_names, &fetches);
+        {
+          // the feeds and fetches are only MLValues at this point, so other Python threads can run meanwhile
+          py::gil_scoped_release release;
+          if (run_options != nullptr) {
+            status = sess->Run(*run_options, feeds, output_names, &fetches);
+          } else {
+            status = sess->Run(feeds, output_names, &fetches);
+          }
         }
 
         if (!status.IsOK()) {
@@ -389,7 +427,8 @@ including arg name, arg type (contains both type and shape).)pbdoc")
 
         std::vector<py::object> rfetch;
         rfetch.reserve(fetches.size());
-        for (auto _ : fetches) {
+        // iterate by reference so that a fetch only the run produced isn't seen as shared
+        for (auto& _ : fetches) {
           if (_.IsTensor()) {
             AddTensorAsPyObj(_, rfetch);
           } else {
@@ -0,0 +1,77 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/lock_free_queue.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(LockFreeQueueTest, FifoAndCapacity) {
+  concurrency::LockFreeQueue<int> queue(5);
+  EXPECT_EQ(queue.Capacity(), 8u);
+
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_TRUE(queue.TryPush(i));
+  }
+  EXPECT_FALSE(queue.TryPush(8));
+
+  int value;
+  for (int i = 0; i < 8; ++i) {
+    ASSERT_TRUE(queue.TryPop(value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_FALSE(queue.TryPop(value));
+
+  // the slots can be reused once consumed
+  EXPECT_TRUE(queue.TryPush(42));
+  ASSERT_TRUE(queue.TryPop(value));
+  EXPECT_EQ(value, 42);
+}
+
+TEST(LockFreeQueueTest, MultipleProducersAndConsumers) {
+  constexpr int kThreads = 4;
+  constexpr int kItemsPerProducer = 10000;
+
+  concurrency::LockFreeQueue<int> queue(64);
+  std::vector<std::atomic<int>> seen(kThreads * kItemsPerProducer);
+  for (auto& count : seen) count = 0;
+  std::atomic<int> consumed{0};
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&queue, t]() {
+      for (int i = 0; i < kItemsPerProducer; ++i) {
+        while (!queue.TryPush(t * kItemsPerProducer + i)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+    threads.emplace_back([&queue, &seen, &consumed]() {
+      int value;
+      while (consumed < kThreads * kItemsPerProducer) {
+        if (queue.TryPop(value)) {
+          ++seen[value];
+          ++consumed;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (auto& count : seen) {
+    EXPECT_EQ(count, 1);
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/profiler.h"
+
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+static int CountEvents(const std::string& profile_file, const std::string& name) {
+  std::ifstream profile(profile_file);
+  std::string line;
+  int count = 0;
+  while (std::getline(profile, line)) {
+    if (line.find("\"" + name + "\"") != std::string::npos) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+TEST(ProfilerTest, DisabledByDefault) {
+  profiling::Profiler profiler;
+  EXPECT_FALSE(profiler.IsEnabled());
+
+  auto start = profiler.StartTime();
+  profiler.EndTimeAndRecordEvent(profiling::NODE_EVENT, "not_recorded", start);
+  EXPECT_EQ(profiler.EndProfiling(), std::string());
+}
+
+TEST(ProfilerTest, RecordFromMultipleThreads) {
+  constexpr int kThreads = 4;
+  constexpr int kEventsPerThread = 1000;
+
+  profiling::Profiler profiler;
+  profiler.StartProfiling("profiler_test_multiple_threads.json");
+  EXPECT_TRUE(profiler.IsEnabled());
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&profiler]() {
+      for (int i = 0; i < kEventsPerThread; ++i) {
+        auto start = profiler.StartTime();
+        profiler.EndTimeAndRecordEvent(profiling::NODE_EVENT, "worker_event", start, {{"op_name", "Test"}});
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  auto start = profiler.StartTime();
+  profiler.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "main_event", start);
+
+  std::string profile_file = profiler.EndProfiling();
+  EXPECT_FALSE(profiler.IsEnabled());
+  EXPECT_EQ(CountEvents(profile_file, "worker_event"), kThreads * kEventsPerThread);
+  EXPECT_EQ(CountEvents(profile_file, "main_event"), 1);
+
+  // the buffers are emptied once written, and reused if profiling is started again
+  profiler.StartProfiling("profiler_test_multiple_threads.json");
+  start = profiler.StartTime();
+  profiler.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "main_event", start);
+  profile_file = profiler.EndProfiling();
+  EXPECT_EQ(CountEvents(profile_file, "worker_event"), 0);
+  EXPECT_EQ(CountEvents(profile_file, "main_event"), 1);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
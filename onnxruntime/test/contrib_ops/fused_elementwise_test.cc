@@ -0,0 +1,84 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+static float Sigmoid(float x) {
+  return 1.0f / (1.0f + std::exp(-x));
+}
+
+// Y = Relu(X * W + B)
+TEST(ContribOpTest, FusedElementwise_MulAddRelu) {
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("ops", std::vector<std::string>{"Mul", "Add", "Relu"});
+  test.AddAttribute("operands", std::vector<int64_t>{0, 1, 3, 2, 4});
+
+  std::vector<float> x = {-2.0f, -1.0f, 0.0f, 1.0f, 2.0f, 3.0f};
+  std::vector<float> w = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  std::vector<float> y;
+  for (size_t i = 0; i < x.size(); ++i) {
+    y.push_back(std::max(x[i] * w[i] + 0.5f, 0.0f));
+  }
+
+  test.AddInput<float>("X", {2, 3}, x);
+  test.AddInput<float>("W", {2, 3}, w);
+  test.AddInput<float>("B", {}, {0.5f});
+  test.AddOutput<float>("Y", {2, 3}, y);
+  test.Run();
+}
+
+// Y = LeakyRelu(Sigmoid(X + B) - C) * X, with B broadcast over the trailing dimension and C over the middle one.
+// the output is large enough to be split into several tiles, some of which wrap around the end of B.
+TEST(ContribOpTest, FusedElementwise_Broadcast) {
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("ops", std::vector<std::string>{"Add", "Sigmoid", "Sub", "LeakyRelu", "Mul"});
+  test.AddAttribute("operands", std::vector<int64_t>{0, 1, 3, 4, 2, 5, 6, 0});
+  test.AddAttribute("alphas", std::vector<float>{0.0f, 0.0f, 0.0f, 0.2f, 0.0f});
+
+  const int64_t N = 4, C = 30, W = 37;
+  std::vector<float> x, b, c, y;
+  for (int64_t i = 0; i < N * C * W; ++i) {
+    x.push_back(std::sin(0.1f * i));
+  }
+  for (int64_t i = 0; i < W; ++i) {
+    b.push_back(0.05f * i - 1.0f);
+  }
+  for (int64_t i = 0; i < N; ++i) {
+    c.push_back(0.25f * i);
+  }
+  for (int64_t n = 0; n < N; ++n) {
+    for (int64_t i = 0; i < C * W; ++i) {
+      const float x_value = x[n * C * W + i];
+      const float t = Sigmoid(x_value + b[i % W]) - c[n];
+      y.push_back((t >= 0.0f ? t : 0.2f * t) * x_value);
+    }
+  }
+
+  test.AddInput<float>("X", {N, C, W}, x);
+  test.AddInput<float>("B", {W}, b);
+  test.AddInput<float>("C", {N, 1, 1}, c);
+  test.AddOutput<float>("Y", {N, C, W}, y);
+  test.Run();
+}
+
+TEST(ContribOpTest, FusedElementwise_InvalidBroadcast) {
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("ops", std::vector<std::string>{"Add", "Exp"});
+  test.AddAttribute("operands", std::vector<int64_t>{0, 1, 2});
+
+  // skip shape inference so the kernel sees the mismatch
+  test.AddShapeToTensorData(false);
+  test.AddInput<float>("X", {2, 3}, std::vector<float>(6, 1.0f));
+  test.AddInput<float>("B", {2}, {1.0f, 2.0f});
+  test.AddOutput<float>("Y", {2, 3}, std::vector<float>(6, 0.0f));
+  test.Run(OpTester::ExpectResult::kExpectFailure, "inputs can't be broadcast together");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(ContribOpTest, FusedGemm_Tanh) {
+  OpTester test("FusedGemm", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("activation", std::string("Tanh"));
+
+  test.AddInput<float>("A", {2, 3}, {1.0f, -1.0f, 0.5f, -0.25f, 0.0f, 2.0f});
+  test.AddInput<float>("B", {3, 2}, {0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f});
+  test.AddInput<float>("C", {2}, {0.5f, -0.5f});
+  test.AddOutput<float>("Y", {2, 2}, {std::tanh(0.05f + 0.5f), std::tanh(0.1f - 0.5f),
+                                      std::tanh(0.975f + 0.5f), std::tanh(1.15f - 0.5f)});
+  test.Run();
+}
+
+// enough output elements for the rows to be split into several blocks, with a bias per row
+TEST(ContribOpTest, FusedGemm_LeakyReluBlocks) {
+  OpTester test("FusedGemm", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("activation", std::string("LeakyRelu"));
+  test.AddAttribute("leaky_relu_alpha", 0.1f);
+  test.AddAttribute("alpha", 2.0f);
+
+  const int64_t M = 20000, K = 3, N = 4;
+  std::vector<float> a, b, c, y;
+  for (int64_t i = 0; i < M * K; ++i) {
+    a.push_back(static_cast<float>(i % 7) - 3.0f);
+  }
+  for (int64_t i = 0; i < K * N; ++i) {
+    b.push_back(0.25f * static_cast<float>(i % 5) - 0.5f);
+  }
+  for (int64_t i = 0; i < M; ++i) {
+    c.push_back(static_cast<float>(i % 3) - 1.0f);
+  }
+  for (int64_t m = 0; m < M; ++m) {
+    for (int64_t n = 0; n < N; ++n) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; ++k) {
+        sum += a[m * K + k] * b[k * N + n];
+      }
+      const float value = 2.0f * sum + c[m];
+      y.push_back(value >= 0.0f ? value : 0.1f * value);
+    }
+  }
+
+  test.AddInput<float>("A", {M, K}, a);
+  test.AddInput<float>("B", {K, N}, b);
+  test.AddInput<float>("C", {M, 1}, c);
+  test.AddOutput<float>("Y", {M, N}, y);
+  test.Run();
+}
+
+// blocks of rows of a transposed A, with a constant B that is packed when the kernel is created and a full bias
+TEST(ContribOpTest, FusedGemm_ReluBlocksTransposedA) {
+  OpTester test("FusedGemm", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("activation", std::string("Relu"));
+  test.AddAttribute("transA", int64_t{1});
+  test.AddAttribute("beta", 0.5f);
+
+  const int64_t M = 3000, K = 5, N = 40;
+  std::vector<float> a, b, c, y;
+  for (int64_t i = 0; i < K * M; ++i) {
+    a.push_back(static_cast<float>(i % 11) - 5.0f);
+  }
+  for (int64_t i = 0; i < K * N; ++i) {
+    b.push_back(0.125f * static_cast<float>(i % 9) - 0.5f);
+  }
+  for (int64_t i = 0; i < M * N; ++i) {
+    c.push_back(static_cast<float>(i % 5) - 2.0f);
+  }
+  for (int64_t m = 0; m < M; ++m) {
+    for (int64_t n = 0; n < N; ++n) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; ++k) {
+        sum += a[k * M + m] * b[k * N + n];
+      }
+      const float value = sum + 0.5f * c[m * N + n];
+      y.push_back(value > 0.0f ? value : 0.0f);
+    }
+  }
+
+  test.AddInput<float>("A", {K, M}, a);
+  test.AddInput<float>("B", {K, N}, b, true);
+  test.AddInput<float>("C", {M, N}, c);
+  test.AddOutput<float>("Y", {M, N}, y);
+  test.Run();
+}
+
+TEST(ContribOpTest, FusedGemm_EmptyOutput) {
+  OpTester test("FusedGemm", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("activation", std::string("Relu"));
+
+  test.AddInput<float>("A", {2, 3}, {1.0f, -1.0f, 0.5f, -0.25f, 0.0f, 2.0f});
+  test.AddInput<float>("B", {3, 0}, {});
+  test.AddInput<float>("C", {1}, {0.5f});
+  test.AddOutput<float>("Y", {2, 0}, {});
+  test.Run();
+}
+
+// an unsupported activation is rejected when the kernel is created, not when it runs
+TEST(ContribOpTest, FusedGemm_UnsupportedActivation) {
+  OpTester test("FusedGemm", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("activation", std::string("Elu"));
+
+  test.AddInput<float>("A", {2, 3}, {1.0f, -1.0f, 0.5f, -0.25f, 0.0f, 2.0f});
+  test.AddInput<float>("B", {3, 2}, {0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f});
+  test.AddInput<float>("C", {2}, {0.5f, -0.5f});
+  test.AddOutput<float>("Y", {2, 2}, {0.0f, 0.0f, 0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "Unsupported activation for FusedGemm: Elu");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
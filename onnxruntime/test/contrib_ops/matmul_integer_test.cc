@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(MatMulIntegerOpTest, UInt8Int8) {
+  OpTester test("MatMulInteger", 1, onnxruntime::kMSDomain);
+  test.AddInput<uint8_t>("A", {2, 3}, {1, 2, 3, 4, 5, 6});
+  test.AddInput<int8_t>("B", {3, 2}, {1, -1, 2, -2, 3, -3});
+  test.AddOutput<int32_t>("Y", {2, 2}, {14, -14, 32, -32});
+  test.Run();
+}
+
+TEST(MatMulIntegerOpTest, UInt8UInt8Batch) {
+  OpTester test("MatMulInteger", 1, onnxruntime::kMSDomain);
+  test.AddInput<uint8_t>("A", {2, 1, 3}, {1, 2, 3, 4, 5, 6});
+  test.AddInput<uint8_t>("B", {3, 2}, {1, 2, 3, 4, 5, 255});
+  test.AddOutput<uint32_t>("Y", {2, 1, 2}, {22, 775, 49, 1558});
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,49 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+// x - x_zero_point is {1, ..., 9}
+static void AddConvInputs(OpTester& test, const std::vector<int64_t>& w_dims, const std::vector<uint8_t>& w,
+                          const std::vector<float>& w_scale) {
+  test.AddInput<uint8_t>("x", {1, 1, 3, 3}, {11, 12, 13, 14, 15, 16, 17, 18, 19});
+  test.AddInput<float>("x_scale", {}, {1.0f});
+  test.AddInput<uint8_t>("x_zero_point", {}, {10});
+  test.AddInput<uint8_t>("w", w_dims, w);
+  if (w_scale.size() == 1) {
+    test.AddInput<float>("w_scale", {}, w_scale);
+  } else {
+    test.AddInput<float>("w_scale", {static_cast<int64_t>(w_scale.size())}, w_scale);
+  }
+  test.AddInput<uint8_t>("w_zero_point", {}, {0});
+}
+
+TEST(QLinearConvOpTest, PerChannelScaleWithBias) {
+  OpTester test("QLinearConv", 1, onnxruntime::kMSDomain);
+  AddConvInputs(test, {2, 1, 2, 2}, {1, 0, 0, 1, 1, 1, 1, 1}, {1.0f, 0.5f});
+  test.AddInput<float>("y_scale", {}, {1.0f});
+  test.AddInput<uint8_t>("y_zero_point", {}, {5});
+  test.AddInput<int32_t>("B", {2}, {1, -2});
+  test.AddOutput<uint8_t>("y", {1, 2, 2, 2}, {12, 14, 18, 20, 10, 12, 16, 18});
+  test.Run();
+}
+
+TEST(QLinearConvOpTest, PaddingUsesZeroPoint) {
+  OpTester test("QLinearConv", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+  AddConvInputs(test, {1, 1, 2, 2}, {1, 1, 1, 1}, {1.0f});
+  test.AddInput<float>("y_scale", {}, {1.0f});
+  test.AddInput<uint8_t>("y_zero_point", {}, {0});
+  test.AddOutput<uint8_t>("y", {1, 1, 4, 4}, {1, 3, 5, 3,
+                                               5, 12, 16, 9,
+                                               11, 24, 28, 15,
+                                               7, 15, 17, 9});
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
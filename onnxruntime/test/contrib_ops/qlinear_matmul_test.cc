@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(QLinearMatMulOpTest, UInt8Int8) {
+  OpTester test("QLinearMatMul", 1, onnxruntime::kMSDomain);
+  // a = {1, 2, 0, -1}, b = {0.5, -1, 1.5, 0}
+  test.AddInput<uint8_t>("a", {2, 2}, {130, 132, 128, 126});
+  test.AddInput<float>("a_scale", {}, {0.5f});
+  test.AddInput<uint8_t>("a_zero_point", {}, {128});
+  test.AddInput<int8_t>("b", {2, 2}, {2, -4, 6, 0});
+  test.AddInput<float>("b_scale", {}, {0.25f});
+  test.AddInput<int8_t>("b_zero_point", {}, {0});
+  test.AddInput<float>("y_scale", {}, {0.5f});
+  test.AddInput<uint8_t>("y_zero_point", {}, {100});
+  // y = {3.5, -1, -1.5, 0}
+  test.AddOutput<uint8_t>("y", {2, 2}, {107, 98, 97, 100});
+  test.Run();
+}
+
+TEST(QLinearMatMulOpTest, UInt8UInt8Saturate) {
+  OpTester test("QLinearMatMul", 1, onnxruntime::kMSDomain);
+  test.AddInput<uint8_t>("a", {2, 2}, {255, 255, 0, 0});
+  test.AddInput<float>("a_scale", {}, {1.0f});
+  test.AddInput<uint8_t>("a_zero_point", {}, {0});
+  test.AddInput<uint8_t>("b", {2, 2}, {255, 0, 255, 0});
+  test.AddInput<float>("b_scale", {}, {1.0f});
+  test.AddInput<uint8_t>("b_zero_point", {}, {1});
+  test.AddInput<float>("y_scale", {}, {1.0f});
+  test.AddInput<uint8_t>("y_zero_point", {}, {10});
+  test.AddOutput<uint8_t>("y", {2, 2}, {255, 0, 10, 10});
+  test.Run();
+}
+
+TEST(QLinearMatMulOpTest, PerTensorOnly) {
+  OpTester test("QLinearMatMul", 1, onnxruntime::kMSDomain);
+  test.AddInput<uint8_t>("a", {2, 2}, {1, 2, 3, 4});
+  test.AddInput<float>("a_scale", {2}, {1.0f, 2.0f});
+  test.AddInput<uint8_t>("a_zero_point", {2}, {0, 0});
+  test.AddInput<uint8_t>("b", {2, 2}, {1, 2, 3, 4});
+  test.AddInput<float>("b_scale", {}, {1.0f});
+  test.AddInput<uint8_t>("b_zero_point", {}, {0});
+  test.AddInput<float>("y_scale", {}, {1.0f});
+  test.AddInput<uint8_t>("y_zero_point", {}, {0});
+  test.AddOutput<uint8_t>("y", {2, 2}, {0, 0, 0, 0});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "QLinearMatMul only supports per-tensor quantization");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
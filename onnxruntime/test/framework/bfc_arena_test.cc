@@ -4,6 +4,10 @@
 #include "core/framework/bfc_arena.h"
 #include "gtest/gtest.h"
 #include <cstdlib>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
 
 namespace onnxruntime {
 namespace test {
@@ -234,5 +238,189 @@ TEST(BFCArenaTest, TestReserve) {
   a.GetStats(&stats);
   EXPECT_EQ(stats.total_allocated_bytes, 1048576);
 }
+
+TEST(BFCArenaTest, ThreadCacheReuse) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30, BFCArena::kDefaultThreadCacheCapacity);
+
+  void* first_ptr = a.Alloc(1000);
+  a.Free(first_ptr);
+
+  // a freed small chunk is reused by the next allocation of a similar size on the same thread
+  void* second_ptr = a.Alloc(900);
+  EXPECT_EQ(first_ptr, second_ptr);
+  EXPECT_EQ(900, a.RequestedSize(second_ptr));
+  EXPECT_EQ(1024, a.AllocatedSize(second_ptr));
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_allocs, 2);
+  EXPECT_EQ(stats.num_thread_cache_hits, 1);
+  EXPECT_EQ(stats.num_thread_cache_misses, 1);
+  EXPECT_EQ(stats.bytes_in_use, 1024);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 0);
+
+  a.Free(second_ptr);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 1024);
+}
+
+TEST(BFCArenaTest, ThreadCacheDisabledByDefault) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30);
+
+  void* ptr = a.Alloc(1000);
+  a.Free(ptr);
+  ptr = a.Alloc(1000);
+  a.Free(ptr);
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_allocs, 2);
+  EXPECT_EQ(stats.num_thread_cache_hits, 0);
+  EXPECT_EQ(stats.num_thread_cache_misses, 0);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 0);
+}
+
+TEST(BFCArenaTest, ThreadCacheIsBounded) {
+  const size_t capacity = 16 * 1024;
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30, capacity);
+
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 64; ++i) {
+    ptrs.push_back(a.Alloc(1024));
+  }
+  for (void* ptr : ptrs) {
+    a.Free(ptr);
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_LE(stats.bytes_in_thread_caches, static_cast<int64_t>(capacity));
+  EXPECT_GT(stats.bytes_in_thread_caches, 0);
+}
+
+TEST(BFCArenaTest, ThreadCachesAreDrainedWhenOutOfMemory) {
+  // Configure a 1MiB byte limit
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 20, BFCArena::kDefaultThreadCacheCapacity);
+
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 8; ++i) {
+    ptrs.push_back(a.Alloc(60000));
+  }
+  for (void* ptr : ptrs) {
+    a.Free(ptr);
+  }
+
+  // only fits once the cached chunks are given back to the arena
+  void* large_ptr = a.Alloc(900 * 1024);
+  EXPECT_NE(nullptr, large_ptr);
+  a.Free(large_ptr);
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 0);
+}
+
+TEST(BFCArenaTest, ThreadCacheWithCrossThreadFrees) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30, BFCArena::kDefaultThreadCacheCapacity);
+
+  constexpr int kThreads = 4;
+  constexpr int kIterations = 1000;
+  std::vector<std::vector<void*>> ptrs(kThreads);
+
+  // every thread allocates, and frees both its own allocations and the ones of the previous round of another thread
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&a, &ptrs, t]() {
+      for (int i = 0; i < kIterations; ++i) {
+        size_t size = 256 * (1 + (i + t) % 64);
+        void* ptr = a.Alloc(size);
+        ASSERT_NE(nullptr, ptr);
+        EXPECT_EQ(size, a.RequestedSize(ptr));
+        memset(ptr, t, size);
+        ptrs[t].push_back(ptr);
+        if (ptrs[t].size() > 8) {
+          a.Free(ptrs[t].front());
+          ptrs[t].erase(ptrs[t].begin());
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  threads.clear();
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&a, &ptrs, t]() {
+      for (void* ptr : ptrs[(t + 1) % kThreads]) {
+        a.Free(ptr);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 0);
+  EXPECT_EQ(stats.num_allocs, kThreads * kIterations);
+  EXPECT_EQ(stats.num_thread_cache_hits + stats.num_thread_cache_misses, kThreads * kIterations);
+}
+
+TEST(BFCArenaTest, ThreadCacheIsReturnedWhenThreadExits) {
+  BFCArena a(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30, BFCArena::kDefaultThreadCacheCapacity);
+
+  std::thread thread([&a]() {
+    void* ptr = a.Alloc(1000);
+    a.Free(ptr);
+
+    AllocatorStats stats;
+    a.GetStats(&stats);
+    EXPECT_EQ(stats.bytes_in_thread_caches, 1024);
+  });
+  thread.join();
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 0);
+  EXPECT_EQ(stats.num_thread_cache_misses, 1);
+  EXPECT_EQ(0u, a.Used());
+}
+
+TEST(BFCArenaTest, ThreadCacheOutlivesArena) {
+  auto a = std::make_unique<BFCArena>(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30,
+                                      BFCArena::kDefaultThreadCacheCapacity);
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool freed = false;
+  bool arena_destroyed = false;
+
+  // the thread exits with a cached chunk after the arena is gone
+  std::thread thread([&]() {
+    a->Free(a->Alloc(1000));
+    std::unique_lock<std::mutex> lock(mutex);
+    freed = true;
+    cv.notify_all();
+    cv.wait(lock, [&]() { return arena_destroyed; });
+  });
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&]() { return freed; });
+  }
+  a.reset();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    arena_destroyed = true;
+  }
+  cv.notify_all();
+  thread.join();
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,237 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/constant_folding.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "core/framework/tensorutils.h"
+#include "core/graph/model.h"
+#include "core/session/inference_session.h"
+#include "test/test_environment.h"
+#include "test_utils.h"
+#include "gtest/gtest.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+static TypeProto MakeTensorType(TensorProto_DataType type, const std::vector<int64_t>& dims) {
+  TypeProto type_proto;
+  type_proto.mutable_tensor_type()->set_elem_type(type);
+  auto* shape = type_proto.mutable_tensor_type()->mutable_shape();
+  for (auto dim : dims) {
+    if (dim < 0) {
+      shape->add_dim()->set_dim_param("N");
+    } else {
+      shape->add_dim()->set_dim_value(dim);
+    }
+  }
+  return type_proto;
+}
+
+// R = Reshape(MatMul(X, Transpose(W)) + Cast(K), Concat(minus_one, Gather(Shape(Transpose(W)), 1)))
+// everything but MatMul, Add and Reshape only depends on initializers or static shapes.
+static void BuildModel(Graph& graph) {
+  TensorProto w;
+  w.set_name("W");
+  w.set_data_type(TensorProto_DataType_FLOAT);
+  w.add_dims(3);
+  w.add_dims(2);
+  for (float value : {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}) {
+    w.add_float_data(value);
+  }
+  graph.AddInitializedTensor(w);
+
+  TensorProto k;
+  k.set_name("K");
+  k.set_data_type(TensorProto_DataType_INT64);
+  k.add_dims(3);
+  for (int64_t value : {10, 20, 30}) {
+    k.add_int64_data(value);
+  }
+  graph.AddInitializedTensor(k);
+
+  TensorProto index;
+  index.set_name("index");
+  index.set_data_type(TensorProto_DataType_INT64);
+  index.add_dims(1);
+  index.add_int64_data(1);
+  graph.AddInitializedTensor(index);
+
+  TensorProto minus_one;
+  minus_one.set_name("minus_one");
+  minus_one.set_data_type(TensorProto_DataType_INT64);
+  minus_one.add_dims(1);
+  minus_one.add_int64_data(-1);
+  graph.AddInitializedTensor(minus_one);
+
+  TypeProto x_type = MakeTensorType(TensorProto_DataType_FLOAT, {-1, 2});
+  TypeProto w_type = MakeTensorType(TensorProto_DataType_FLOAT, {3, 2});
+  TypeProto wt_type = MakeTensorType(TensorProto_DataType_FLOAT, {2, 3});
+  TypeProto y_type = MakeTensorType(TensorProto_DataType_FLOAT, {-1, 3});
+  TypeProto k_type = MakeTensorType(TensorProto_DataType_INT64, {3});
+  TypeProto c_type = MakeTensorType(TensorProto_DataType_FLOAT, {3});
+  TypeProto shape_type = MakeTensorType(TensorProto_DataType_INT64, {2});
+  TypeProto dim_type = MakeTensorType(TensorProto_DataType_INT64, {1});
+
+  auto& x = graph.GetOrCreateNodeArg("X", &x_type);
+  auto& w_arg = graph.GetOrCreateNodeArg("W", &w_type);
+  auto& wt = graph.GetOrCreateNodeArg("WT", &wt_type);
+  auto& y = graph.GetOrCreateNodeArg("Y", &y_type);
+  auto& k_arg = graph.GetOrCreateNodeArg("K", &k_type);
+  auto& c = graph.GetOrCreateNodeArg("C", &c_type);
+  auto& z = graph.GetOrCreateNodeArg("Z", &y_type);
+  auto& s = graph.GetOrCreateNodeArg("S", &shape_type);
+  auto& index_arg = graph.GetOrCreateNodeArg("index", &dim_type);
+  auto& cols = graph.GetOrCreateNodeArg("cols", &dim_type);
+  auto& minus_one_arg = graph.GetOrCreateNodeArg("minus_one", &dim_type);
+  auto& new_shape = graph.GetOrCreateNodeArg("new_shape", &shape_type);
+  auto& r = graph.GetOrCreateNodeArg("R", &y_type);
+
+  graph.AddNode("transpose", "Transpose", "", {&w_arg}, {&wt});
+  graph.AddNode("matmul", "MatMul", "", {&x, &wt}, {&y});
+  auto& cast = graph.AddNode("cast", "Cast", "", {&k_arg}, {&c});
+  cast.AddAttribute("to", static_cast<int64_t>(TensorProto_DataType_FLOAT));
+  graph.AddNode("add", "Add", "", {&y, &c}, {&z});
+  graph.AddNode("shape", "Shape", "", {&wt}, {&s});
+  auto& gather = graph.AddNode("gather", "Gather", "", {&s, &index_arg}, {&cols});
+  gather.AddAttribute("axis", static_cast<int64_t>(0));
+  auto& concat = graph.AddNode("concat", "Concat", "", {&minus_one_arg, &cols}, {&new_shape});
+  concat.AddAttribute("axis", static_cast<int64_t>(0));
+  graph.AddNode("reshape", "Reshape", "", {&z, &new_shape}, {&r});
+}
+
+// The graph built by BuildModel lists every initializer as a graph input, like models before IR version 4 do.
+// Removing them from the inputs makes them constants that can be folded.
+static ModelProto BuildModelProto(bool initializers_are_inputs) {
+  onnxruntime::Model model("test");
+  BuildModel(model.MainGraph());
+  ORT_ENFORCE(model.MainGraph().Resolve().IsOK());
+
+  ModelProto model_proto = model.ToProto();
+  if (!initializers_are_inputs) {
+    auto* graph_proto = model_proto.mutable_graph();
+    std::vector<ValueInfoProto> inputs;
+    for (const auto& input : graph_proto->input()) {
+      bool is_initializer = std::any_of(graph_proto->initializer().begin(), graph_proto->initializer().end(),
+                                        [&input](const TensorProto& t) { return t.name() == input.name(); });
+      if (!is_initializer) {
+        inputs.push_back(input);
+      }
+    }
+    graph_proto->clear_input();
+    for (const auto& input : inputs) {
+      *graph_proto->add_input() = input;
+    }
+  }
+  return model_proto;
+}
+
+TEST(ConstantFoldingTest, FoldInitializerChains) {
+  std::shared_ptr<onnxruntime::Model> model;
+  ASSERT_TRUE(onnxruntime::Model::Load(BuildModelProto(false), model).IsOK());
+  onnxruntime::Graph& graph = model->MainGraph();
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  bool modified = false;
+  auto status = ConstantFolding().Apply(graph, modified);
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+  ASSERT_TRUE(modified);
+
+  std::map<std::string, int> op_counts;
+  for (const auto& node : graph.Nodes()) {
+    op_counts[node.OpType()]++;
+  }
+  EXPECT_EQ(op_counts, (std::map<std::string, int>{{"MatMul", 1}, {"Add", 1}, {"Reshape", 1}}));
+
+  const TensorProto* folded;
+  ASSERT_TRUE(graph.GetInitializedTensor("WT", folded));
+  ASSERT_TRUE(graph.GetInitializedTensor("C", folded));
+  ASSERT_TRUE(graph.GetInitializedTensor("new_shape", folded));
+  ASSERT_EQ(folded->dims_size(), 1);
+  EXPECT_EQ(folded->dims(0), 2);
+  // folded nodes store their result as raw data, so unpack rather than reading int64_data
+  std::vector<int64_t> new_shape(2);
+  ASSERT_TRUE(utils::TensorUtils::UnpackTensor(*folded, new_shape.data(), 2).IsOK());
+  EXPECT_EQ(new_shape, (std::vector<int64_t>{-1, 3}));
+
+  // folding again finds nothing left to do
+  modified = false;
+  ASSERT_TRUE(ConstantFolding().Apply(graph, modified).IsOK());
+  EXPECT_FALSE(modified);
+}
+
+TEST(ConstantFoldingTest, RunFoldedModel) {
+  std::stringstream s;
+  BuildModelProto(false).SerializeToOstream(&s);
+
+  SessionOptions so;
+  so.session_logid = "ConstantFoldingTest.RunFoldedModel";
+  InferenceSession session{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(session.Load(s).IsOK());
+  ASSERT_TRUE(session.RegisterGraphTransformer(std::make_unique<ConstantFolding>()).IsOK());
+  auto status = session.Initialize();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  MLValue x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {2, 2}, {1.0f, 0.0f, 0.0f, 1.0f},
+                       &x);
+  std::vector<MLValue> fetches;
+  status = session.Run({{"X", x}}, {"R"}, &fetches);
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  // X is the identity, so R is the transpose of W plus the cast of K
+  const Tensor& r = fetches[0].Get<Tensor>();
+  ASSERT_EQ(r.Shape(), TensorShape({2, 3}));
+  EXPECT_EQ(std::vector<float>(r.Data<float>(), r.Data<float>() + 6),
+            (std::vector<float>{11.0f, 23.0f, 35.0f, 12.0f, 24.0f, 36.0f}));
+}
+
+TEST(ConstantFoldingTest, InitializersThatAreInputsAreNotFolded) {
+  {
+    std::shared_ptr<onnxruntime::Model> model;
+    ASSERT_TRUE(onnxruntime::Model::Load(BuildModelProto(true), model).IsOK());
+    onnxruntime::Graph& graph = model->MainGraph();
+    ASSERT_TRUE(graph.Resolve().IsOK());
+
+    bool modified = false;
+    ASSERT_TRUE(ConstantFolding().Apply(graph, modified).IsOK());
+
+    // only the Shape of the transpose, whose shape is static, is folded
+    const TensorProto* folded;
+    EXPECT_FALSE(graph.GetInitializedTensor("WT", folded));
+    EXPECT_FALSE(graph.GetInitializedTensor("C", folded));
+  }
+
+  std::stringstream s;
+  BuildModelProto(true).SerializeToOstream(&s);
+
+  SessionOptions so;
+  so.session_logid = "ConstantFoldingTest.InitializersThatAreInputsAreNotFolded";
+  InferenceSession session{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(session.Load(s).IsOK());
+  ASSERT_TRUE(session.RegisterGraphTransformer(std::make_unique<ConstantFolding>()).IsOK());
+  auto status = session.Initialize();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  auto allocator = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  MLValue x;
+  CreateMLValue<float>(allocator, {2, 2}, {1.0f, 0.0f, 0.0f, 1.0f}, &x);
+  MLValue k;
+  CreateMLValue<int64_t>(allocator, {3}, {100, 200, 300}, &k);
+  std::vector<MLValue> fetches;
+  status = session.Run({{"X", x}, {"K", k}}, {"R"}, &fetches);
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  // the fed K replaces the default value of the initializer
+  const Tensor& r = fetches[0].Get<Tensor>();
+  ASSERT_EQ(r.Shape(), TensorShape({2, 3}));
+  EXPECT_EQ(std::vector<float>(r.Data<float>(), r.Data<float>() + 6),
+            (std::vector<float>{101.0f, 203.0f, 305.0f, 102.0f, 204.0f, 306.0f}));
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -45,7 +45,7 @@ class MulFP16Kernel final : public OpKernel {
     auto X_Data = X->Data<MLFloat16>();
     auto W_Data = W->Data<MLFloat16>();
 
-    auto& shape = X->Shape().GetDims();
+    const auto& shape = X->Shape().GetDims();
     auto* Y = p_context->Output(0, shape);
     auto* Y_Data = Y->MutableData<MLFloat16>();
 
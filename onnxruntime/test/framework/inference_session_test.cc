@@ -4,17 +4,24 @@
 #include "core/session/inference_session.h"
 
 #include <algorithm>
+#include <condition_variable>
 #include <functional>
 #include <iterator>
+#include <mutex>
 #include <thread>
 #include <fstream>
+#include <sstream>
 
 #include "core/common/logging/logging.h"
 #include "core/common/profiler.h"
+#include "core/framework/bfc_arena.h"
 #include "core/framework/execution_provider.h"
+#include "core/framework/execution_providers.h"
+#include "core/framework/kernel_registry_manager.h"
 #include "core/framework/kernel_registry.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/session_state.h"
+#include "core/framework/session_state_initializer.h"
 #include "core/graph/graph_viewer.h"
 #include "core/framework/compute_capability.h"
 #include "core/graph/model.h"
@@ -23,6 +30,7 @@
 #include "core/providers/cpu/math/element_wise_ops.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/session/IOBinding.h"
+#include "core/session/run_context.h"
 #include "test/capturing_sink.h"
 #include "test/test_environment.h"
 #include "test/providers/provider_test_utils.h"
@@ -324,6 +332,225 @@ TEST(InferenceSessionTests, DisableCPUArena) {
   RunModel(session_object, run_options);
 }
 
+#ifndef USE_JEMALLOC
+TEST(InferenceSessionTests, CPUArenaThreadCache) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.CPUArenaThreadCache";
+
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+  auto cpu_provider = std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
+  auto arena = std::dynamic_pointer_cast<BFCArena>(cpu_provider->GetAllocator(0, OrtMemTypeDefault));
+  ASSERT_TRUE(arena != nullptr);
+  ASSERT_TRUE(session_object.RegisterExecutionProvider(std::move(cpu_provider)).IsOK());
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  RunOptions run_options;
+  run_options.run_tag = "one session/one tag";
+  for (int i = 0; i < 4; ++i) {
+    RunModel(session_object, run_options);
+  }
+
+  // the output of each Run is freed on this thread, so the next Run allocates it from the thread cache
+  AllocatorStats stats;
+  arena->GetStats(&stats);
+  EXPECT_GE(stats.num_thread_cache_hits, 3);
+}
+#endif
+
+TEST(InferenceSessionTests, MmapModelLoading) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.MmapModelLoading";
+  so.enable_mmap_model_loading = true;
+
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  RunOptions run_options;
+  run_options.run_tag = "InferenceSessionTests.MmapModelLoading";
+  RunModel(session_object, run_options);
+}
+
+// The external data starts at an offset into its file so the location entries are all exercised.
+static const size_t kExternalDataOffset = 64;
+
+// Saves a model computing Y = X * W where W is an initializer with external data at data_location, which is
+// relative to the directory of the model. If data_path isn't empty, the external data file is written there.
+static void SaveModelWithExternalData(const std::string& model_path, const std::string& data_location,
+                                      const std::string& data_path) {
+  const std::vector<float> weights = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+
+  Model model("ModelWithExternalData");
+  auto& graph = model.MainGraph();
+
+  onnx::TensorProto tensor_proto;
+  tensor_proto.add_dims(3);
+  tensor_proto.add_dims(2);
+  tensor_proto.set_data_type(TensorProto_DataType_FLOAT);
+  tensor_proto.set_name("W");
+  tensor_proto.set_data_location(TensorProto_DataLocation_EXTERNAL);
+  auto* entry = tensor_proto.add_external_data();
+  entry->set_key("location");
+  entry->set_value(data_location);
+  entry = tensor_proto.add_external_data();
+  entry->set_key("offset");
+  entry->set_value(std::to_string(kExternalDataOffset));
+  entry = tensor_proto.add_external_data();
+  entry->set_key("length");
+  entry->set_value(std::to_string(weights.size() * sizeof(float)));
+
+  graph.AddInitializedTensor(tensor_proto);
+
+  TypeProto float_3x2;
+  float_3x2.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_3x2.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  float_3x2.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &float_3x2);
+  auto& w = graph.GetOrCreateNodeArg("W", &float_3x2);
+  auto& y = graph.GetOrCreateNodeArg("Y", &float_3x2);
+  graph.AddNode("mul", "Mul", "Multiply by the external weights", {&x, &w}, {&y});
+
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  std::ofstream model_file(model_path, std::ios::binary);
+  ASSERT_TRUE(model.ToProto().SerializeToOstream(&model_file));
+
+  if (!data_path.empty()) {
+    std::ofstream data_file(data_path, std::ios::binary);
+    const std::vector<char> padding(kExternalDataOffset, 0);
+    data_file.write(padding.data(), padding.size());
+    data_file.write(reinterpret_cast<const char*>(weights.data()), weights.size() * sizeof(float));
+    ASSERT_TRUE(data_file.good());
+  }
+}
+
+#ifdef __linux__
+// Returns the path of the file mapped at address according to /proc/self/maps, or an empty string if there is none.
+static std::string GetMappedFilePath(const void* address) {
+  const auto value = reinterpret_cast<uintptr_t>(address);
+  std::ifstream maps("/proc/self/maps");
+  std::string line;
+  while (std::getline(maps, line)) {
+    std::istringstream fields(line);
+    std::string range, perms, offset, device, inode, path;
+    fields >> range >> perms >> offset >> device >> inode >> path;
+    const auto dash = range.find('-');
+    const auto begin = static_cast<uintptr_t>(std::stoull(range.substr(0, dash), nullptr, 16));
+    const auto end = static_cast<uintptr_t>(std::stoull(range.substr(dash + 1), nullptr, 16));
+    if (value >= begin && value < end) {
+      return path;
+    }
+  }
+  return std::string();
+}
+#endif
+
+TEST(InferenceSessionTests, MmapModelLoadingWithExternalData) {
+  const std::string model_path = "mmap_model_loading_with_external_data.onnx";
+  const std::string data_path = "mmap_model_loading_with_external_data.bin";
+  SaveModelWithExternalData(model_path, data_path, data_path);
+
+  for (bool enable_mmap_model_loading : {false, true}) {
+    SessionOptions so;
+    so.session_logid = "InferenceSessionTests.MmapModelLoadingWithExternalData";
+    so.enable_mmap_model_loading = enable_mmap_model_loading;
+
+    InferenceSession session_object{so, &DefaultLoggingManager()};
+    auto status = session_object.Load(model_path);
+    ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+    status = session_object.Initialize();
+    ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+    // the external weights are the same as the input, so the output is the same as the one of mul_1.pb
+    RunOptions run_options;
+    run_options.run_tag = so.session_logid;
+    RunModel(session_object, run_options);
+  }
+
+  std::remove(model_path.c_str());
+  std::remove(data_path.c_str());
+}
+
+TEST(InferenceSessionTests, MmapModelLoadingUsesExternalDataInPlace) {
+  const std::string model_path = "mmap_model_loading_in_place.onnx";
+  const std::string data_path = "mmap_model_loading_in_place.bin";
+  SaveModelWithExternalData(model_path, data_path, data_path);
+
+  std::shared_ptr<Model> model;
+  auto status = Model::LoadFromMappedFile(model_path, model);
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  ExecutionProviders execution_providers;
+  CPUExecutionProviderInfo epi{false};
+  status = execution_providers.Add(kCpuExecutionProvider, std::make_unique<CPUExecutionProvider>(epi));
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+  KernelRegistryManager kernel_registry_manager;
+  kernel_registry_manager.RegisterKernels(execution_providers);
+
+  // the graph isn't partitioned by a session, so assign the nodes to the CPU provider directly
+  for (auto& node : model->MainGraph().Nodes()) {
+    node.SetExecutionProviderType(kCpuExecutionProvider);
+  }
+
+  SessionState session_state{execution_providers};
+  SessionStateInitializer initializer{model->MainGraph(), session_state, execution_providers,
+                                      kernel_registry_manager, logging::LoggingManager::DefaultLogger()};
+  status = initializer.CreatePlan({}, true);
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+  std::map<OrtAllocatorInfo, BufferUniquePtr> weights_buffers;
+  status = initializer.InitializeAndSave(true, weights_buffers, std::string(), true);
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  int mlvalue_index;
+  ASSERT_TRUE(session_state.GetMLValueNameIdxMap().GetIdx("W", mlvalue_index).IsOK());
+  const auto& weights = session_state.GetInitializedTensors().at(mlvalue_index).Get<Tensor>();
+  const float* data = weights.Data<float>();
+  const std::vector<float> found(data, data + weights.Shape().Size());
+  ASSERT_EQ(std::vector<float>({1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}), found);
+
+#ifdef __linux__
+  // the whole tensor points into the mapping of the external data file instead of a copy
+  for (const float* element : {data, data + weights.Shape().Size() - 1}) {
+    const std::string mapped_file_path = GetMappedFilePath(element);
+    ASSERT_GE(mapped_file_path.size(), data_path.size());
+    EXPECT_EQ(data_path, mapped_file_path.substr(mapped_file_path.size() - data_path.size()));
+  }
+#endif
+
+  std::remove(model_path.c_str());
+  std::remove(data_path.c_str());
+}
+
+TEST(InferenceSessionTests, ExternalDataOutsideModelDirectoryIsRejected) {
+  const std::string model_path = "external_data_outside_model_directory.onnx";
+
+  for (const char* location : {"../weights.bin", "data/../../weights.bin", "/weights.bin", "\\weights.bin",
+                               "C:/weights.bin"}) {
+    SaveModelWithExternalData(model_path, location, std::string());
+
+    for (bool enable_mmap_model_loading : {false, true}) {
+      SessionOptions so;
+      so.session_logid = "InferenceSessionTests.ExternalDataOutsideModelDirectoryIsRejected";
+      so.enable_mmap_model_loading = enable_mmap_model_loading;
+
+      InferenceSession session_object{so, &DefaultLoggingManager()};
+      auto status = session_object.Load(model_path);
+      ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+      status = session_object.Initialize();
+      ASSERT_FALSE(status.IsOK()) << location;
+      EXPECT_NE(status.ErrorMessage().find("has external data outside of the model directory"), std::string::npos)
+          << status.ErrorMessage();
+    }
+  }
+
+  std::remove(model_path.c_str());
+}
+
 #ifdef ORT_RUN_EXTERNAL_ONNX_TESTS
 static bool Compare(const InputDefList& f_arg, const InputDefList& s_arg) {
   if (f_arg.size() != s_arg.size()) {
@@ -726,6 +953,151 @@ TEST(InferenceSessionTests, TestIOBindingReuse) {
   }
 }
 
+TEST(InferenceSessionTests, TestRunContextReuse) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TestRunContextReuse";
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  std::unique_ptr<RunContext> run_context;
+  ASSERT_FALSE(session_object.NewRunContext({"X"}, {"foo"}, &run_context).IsOK());
+  ASSERT_TRUE(session_object.NewRunContext({"X"}, {"Y"}, &run_context).IsOK());
+
+  RunOptions run_options;
+  // run repeatedly with the same and with different shapes, and with a preallocated output
+  std::vector<std::vector<int64_t>> dims{{3, 2}, {3, 2}, {2, 2}, {3, 2}};
+  for (size_t i = 0; i < dims.size(); ++i) {
+    std::vector<float> values;
+    std::vector<float> expected_values;
+    for (int64_t j = 0; j < dims[i][0] * dims[i][1]; ++j) {
+      float value = static_cast<float>(i + j);
+      values.push_back(value);
+      expected_values.push_back(value * value);
+    }
+
+    MLValue ml_value;
+    CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), dims[i], values, &ml_value);
+
+    std::vector<MLValue> fetches;
+    if (i == dims.size() - 1) {
+      fetches.resize(1);
+      CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), dims[i], values,
+                           &fetches[0]);
+    }
+
+    auto st = session_object.Run(run_options, *run_context, {ml_value}, &fetches);
+    ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+    VerifyOutputs(fetches, dims[i], expected_values);
+  }
+}
+
+TEST(InferenceSessionTests, TestRunAsync) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TestRunAsync";
+  so.async_run_thread_pool_size = 2;
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+
+  // not initialized yet
+  std::vector<MLValue> fetches;
+  ASSERT_FALSE(session_object.RunAsync(nullptr, {}, {"Y"}, &fetches).get().IsOK());
+
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  std::vector<int64_t> dims_mul_x = {3, 2};
+  std::vector<float> values_mul_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  MLValue ml_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), dims_mul_x, values_mul_x,
+                       &ml_value);
+  NameMLValMap feeds;
+  feeds.insert(std::make_pair("X", ml_value));
+  std::vector<float> expected_values_mul_y = {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f};
+
+  // queue more requests than there are threads, and wait for all the callbacks
+  constexpr int kNumRequests = 32;
+  std::mutex mutex;
+  std::condition_variable cv;
+  int num_completed = 0;
+  int num_succeeded = 0;
+  for (int i = 0; i < kNumRequests; ++i) {
+    auto st = session_object.RunAsync(nullptr, feeds, {"Y"},
+                                      [&](const common::Status& status, std::vector<MLValue>& outputs) {
+                                        bool ok = status.IsOK() && outputs.size() == 1;
+                                        if (ok) {
+                                          const auto& rtensor = outputs[0].Get<Tensor>();
+                                          ok = std::equal(expected_values_mul_y.begin(), expected_values_mul_y.end(),
+                                                          rtensor.Data<float>());
+                                        }
+                                        std::lock_guard<std::mutex> lock(mutex);
+                                        ++num_completed;
+                                        num_succeeded += ok ? 1 : 0;
+                                        cv.notify_all();
+                                      });
+    ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+  }
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&]() { return num_completed == kNumRequests; });
+  }
+  EXPECT_EQ(num_succeeded, kNumRequests);
+
+  // future, and errors of the run are reported through it
+  auto future = session_object.RunAsync(nullptr, feeds, {"Y"}, &fetches);
+  ASSERT_TRUE(future.get().IsOK());
+  VerifyOutputs(fetches, dims_mul_x, expected_values_mul_y);
+
+  std::vector<MLValue> bad_fetches;
+  EXPECT_FALSE(session_object.RunAsync(nullptr, feeds, {"foo"}, &bad_fetches).get().IsOK());
+}
+
+TEST(InferenceSessionTests, TestRunAsyncNeverRunsOnCaller) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TestRunAsyncNeverRunsOnCaller";
+  so.async_run_thread_pool_size = 1;
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  std::vector<int64_t> dims_mul_x = {3, 2};
+  std::vector<float> values_mul_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  MLValue ml_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), dims_mul_x, values_mul_x,
+                       &ml_value);
+  NameMLValMap feeds;
+  feeds.insert(std::make_pair("X", ml_value));
+
+  // the first callback blocks the only worker until every request is queued, so the queue holds more requests
+  // than a thread pool queue can. none of them may run on this thread.
+  constexpr int kNumRequests = 4096;
+  const std::thread::id caller_id = std::this_thread::get_id();
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool all_queued = false;
+  int num_completed = 0;
+  int num_on_caller = 0;
+  for (int i = 0; i < kNumRequests; ++i) {
+    auto st = session_object.RunAsync(nullptr, feeds, {"Y"},
+                                      [&, i](const common::Status& /*status*/, std::vector<MLValue>& /*outputs*/) {
+                                        std::unique_lock<std::mutex> lock(mutex);
+                                        if (i == 0) {
+                                          cv.wait(lock, [&]() { return all_queued; });
+                                        }
+                                        ++num_completed;
+                                        num_on_caller += std::this_thread::get_id() == caller_id ? 1 : 0;
+                                        cv.notify_all();
+                                      });
+    ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+  }
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    all_queued = true;
+    cv.notify_all();
+    cv.wait(lock, [&]() { return num_completed == kNumRequests; });
+  }
+  EXPECT_EQ(num_on_caller, 0);
+}
+
 TEST(InferenceSessionTests, InvalidInputTypeOfTensorElement) {
   SessionOptions so;
 
@@ -141,7 +141,7 @@ class OptionalOpKernel : public OpKernel {
     const auto* W = context->Input<Tensor>(1);
 
     auto* X_Data = X->Data<T>();
-    auto& shape = X->Shape().GetDims();
+    const auto& shape = X->Shape().GetDims();
     auto* Y = context->Output(0, shape);
     auto* Y_Data = Y->MutableData<T>();
     size_t size = 1;
@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/mem_pattern_cache.h"
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+static std::vector<TensorShape> Shapes(std::initializer_list<std::vector<int64_t>> dims) {
+  std::vector<TensorShape> shapes;
+  for (const auto& d : dims) {
+    shapes.emplace_back(d);
+  }
+  return shapes;
+}
+
+TEST(MemoryPatternCacheTest, ExactShapes) {
+  MemoryPatternCache cache(4, false);
+
+  EXPECT_EQ(cache.Find(Shapes({{1, 3}})), nullptr);
+  cache.Insert(Shapes({{1, 3}}), std::make_unique<MemoryPatternGroup>());
+  EXPECT_NE(cache.Find(Shapes({{1, 3}})), nullptr);
+
+  // different shapes, including ones with the same dims split differently between the inputs
+  EXPECT_EQ(cache.Find(Shapes({{3, 1}})), nullptr);
+  EXPECT_EQ(cache.Find(Shapes({{1, 2}})), nullptr);
+  EXPECT_EQ(cache.Find(Shapes({{1}, {3}})), nullptr);
+
+  auto stats = cache.GetStats();
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 4);
+  EXPECT_EQ(stats.num_entries, 1u);
+}
+
+TEST(MemoryPatternCacheTest, ShapeBucketing) {
+  MemoryPatternCache cache(4, true);
+
+  cache.Insert(Shapes({{1, 100}}), std::make_unique<MemoryPatternGroup>());
+  auto pattern_100 = cache.Find(Shapes({{1, 100}}));
+  ASSERT_NE(pattern_100, nullptr);
+
+  // smaller shapes in the same bucket reuse the pattern
+  EXPECT_EQ(cache.Find(Shapes({{1, 65}})), pattern_100);
+  EXPECT_EQ(cache.Find(Shapes({{1, 99}})), pattern_100);
+
+  // a larger shape in the same bucket misses, and its pattern replaces the entry
+  EXPECT_EQ(cache.Find(Shapes({{1, 120}})), nullptr);
+  cache.Insert(Shapes({{1, 120}}), std::make_unique<MemoryPatternGroup>());
+  auto pattern_120 = cache.Find(Shapes({{1, 80}}));
+  ASSERT_NE(pattern_120, nullptr);
+  EXPECT_NE(pattern_120, pattern_100);
+
+  // a smaller pattern doesn't replace the larger one
+  cache.Insert(Shapes({{1, 70}}), std::make_unique<MemoryPatternGroup>());
+  EXPECT_EQ(cache.Find(Shapes({{1, 128}})), nullptr);
+  EXPECT_EQ(cache.Find(Shapes({{1, 120}})), pattern_120);
+
+  // different bucket
+  EXPECT_EQ(cache.Find(Shapes({{1, 129}})), nullptr);
+
+  auto stats = cache.GetStats();
+  EXPECT_EQ(stats.hits, 5);
+  EXPECT_EQ(stats.misses, 3);
+  EXPECT_EQ(stats.num_entries, 1u);
+}
+
+TEST(MemoryPatternCacheTest, LeastRecentlyUsedIsEvicted) {
+  MemoryPatternCache cache(2, false);
+
+  cache.Insert(Shapes({{1}}), std::make_unique<MemoryPatternGroup>());
+  cache.Insert(Shapes({{2}}), std::make_unique<MemoryPatternGroup>());
+  auto pattern_1 = cache.Find(Shapes({{1}}));
+  ASSERT_NE(pattern_1, nullptr);
+
+  // {2} is the least recently used now
+  cache.Insert(Shapes({{3}}), std::make_unique<MemoryPatternGroup>());
+  EXPECT_EQ(cache.Find(Shapes({{2}})), nullptr);
+  EXPECT_EQ(cache.Find(Shapes({{1}})), pattern_1);
+  EXPECT_NE(cache.Find(Shapes({{3}})), nullptr);
+
+  auto stats = cache.GetStats();
+  EXPECT_EQ(stats.evictions, 1);
+  EXPECT_EQ(stats.num_entries, 2u);
+
+  // a pattern in use stays valid after it is evicted
+  cache.SetCapacity(0);
+  EXPECT_EQ(cache.GetStats().num_entries, 0u);
+  EXPECT_EQ(pattern_1.use_count(), 1);
+
+  cache.Insert(Shapes({{1}}), std::make_unique<MemoryPatternGroup>());
+  EXPECT_EQ(cache.Find(Shapes({{1}})), nullptr);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
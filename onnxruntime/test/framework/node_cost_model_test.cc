@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/node_cost_model.h"
+
+#include <vector>
+#include "core/graph/graph_viewer.h"
+#include "core/graph/model.h"
+#include "gtest/gtest.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+static TypeProto FloatTensor(const std::vector<int64_t>& dims) {
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  for (auto dim : dims) {
+    type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+  }
+  return type;
+}
+
+// X -> Conv -> Relu -> Y1 is the critical path, X -> Identity -> Y2 is a cheap branch next to it.
+class NodeCostModelTest : public ::testing::Test {
+ protected:
+  NodeCostModelTest() {
+    std::unordered_map<std::string, int> domain_to_version;
+    domain_to_version[kOnnxDomain] = 7;
+    model_ = std::make_unique<Model>("cost_model", false, ModelMetaData(), IOnnxRuntimeOpSchemaRegistryList(),
+                                     domain_to_version);
+    Graph& graph = model_->MainGraph();
+
+    auto x_type = FloatTensor({1, 3, 32, 32});
+    auto w_type = FloatTensor({16, 3, 3, 3});
+    auto conv_type = FloatTensor({1, 16, 30, 30});
+
+    auto& x = graph.GetOrCreateNodeArg("X", &x_type);
+    auto& w = graph.GetOrCreateNodeArg("W", &w_type);
+    auto& conv_out = graph.GetOrCreateNodeArg("conv_out", &conv_type);
+    auto& y1 = graph.GetOrCreateNodeArg("Y1", &conv_type);
+    auto& y2 = graph.GetOrCreateNodeArg("Y2", &x_type);
+
+    conv_ = graph.AddNode("conv", "Conv", "", {&x, &w}, {&conv_out}).Index();
+    relu_ = graph.AddNode("relu", "Relu", "", {&conv_out}, {&y1}).Index();
+    identity_ = graph.AddNode("identity", "Identity", "", {&x}, {&y2}).Index();
+
+    auto status = graph.Resolve();
+    EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+    graph_viewer_ = std::make_unique<GraphViewer>(graph);
+  }
+
+  std::unique_ptr<Model> model_;
+  std::unique_ptr<GraphViewer> graph_viewer_;
+  NodeIndex conv_, relu_, identity_;
+};
+
+TEST_F(NodeCostModelTest, EstimateCost) {
+  // 2 * output elements * C * kH * kW
+  EXPECT_DOUBLE_EQ(NodeCostModel::EstimateCost(*graph_viewer_->GetNode(conv_)), 2.0 * (16 * 30 * 30) * (3 * 3 * 3));
+  EXPECT_DOUBLE_EQ(NodeCostModel::EstimateCost(*graph_viewer_->GetNode(relu_)), 16 * 30 * 30);
+  // bytes copied
+  EXPECT_DOUBLE_EQ(NodeCostModel::EstimateCost(*graph_viewer_->GetNode(identity_)), 3 * 32 * 32 * sizeof(float));
+}
+
+TEST_F(NodeCostModelTest, CriticalPathHasHighestPriority) {
+  NodeCostModel cost_model(*graph_viewer_);
+  auto levels = cost_model.GetPriorityLevels(8);
+
+  EXPECT_EQ((*levels)[conv_], 7);
+  EXPECT_GT((*levels)[conv_], (*levels)[relu_]);
+  EXPECT_GT((*levels)[conv_], (*levels)[identity_]);
+}
+
+TEST_F(NodeCostModelTest, MeasuredTimesUpdatePriorities) {
+  NodeCostModel cost_model(*graph_viewer_);
+  EXPECT_GT((*cost_model.GetPriorityLevels(8))[conv_], (*cost_model.GetPriorityLevels(8))[identity_]);
+
+  // the Identity turns out to be far more expensive than estimated
+  cost_model.RecordExecutionTime(conv_, 1000);
+  cost_model.RecordExecutionTime(relu_, 100);
+  cost_model.RecordExecutionTime(identity_, 1000000);
+
+  std::shared_ptr<const std::vector<int>> levels;
+  for (int i = 0; i < NodeCostModel::kRecomputeInterval; ++i) {
+    levels = cost_model.GetPriorityLevels(8);
+  }
+
+  EXPECT_EQ((*levels)[identity_], 7);
+  EXPECT_GT((*levels)[identity_], (*levels)[conv_]);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,117 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/request_batcher.h"
+
+#include <sstream>
+#include <thread>
+
+#include "core/graph/model.h"
+#include "test/test_environment.h"
+#include "test_utils.h"
+#include "gtest/gtest.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+// Y = X * X, with X of shape {batch_dim, "C"}
+static void LoadSquareModel(InferenceSession& session, bool symbolic_batch_dim) {
+  onnxruntime::Model model("test");
+  onnxruntime::Graph& graph = model.MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto* shape = tensor_float.mutable_tensor_type()->mutable_shape();
+  if (symbolic_batch_dim) {
+    shape->add_dim()->set_dim_param("N");
+  } else {
+    shape->add_dim()->set_dim_value(1);
+  }
+  shape->add_dim()->set_dim_param("C");
+
+  auto& input_arg = graph.GetOrCreateNodeArg("X", &tensor_float);
+  auto& output_arg = graph.GetOrCreateNodeArg("Y", &tensor_float);
+  graph.AddNode("node1", "Mul", "Mul", {&input_arg, &input_arg}, {&output_arg});
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  std::stringstream s;
+  model.ToProto().SerializeToOstream(&s);
+  ASSERT_TRUE(session.Load(s).IsOK());
+  ASSERT_TRUE(session.Initialize().IsOK());
+}
+
+TEST(RequestBatcherTest, FixedBatchDimension) {
+  SessionOptions so;
+  InferenceSession session{so, &DefaultLoggingManager()};
+  LoadSquareModel(session, false);
+
+  std::unique_ptr<RequestBatcher> batcher;
+  EXPECT_FALSE(RequestBatcher::Create(session, {"Y"}, RequestBatcherOptions(), &batcher).IsOK());
+}
+
+TEST(RequestBatcherTest, ConcurrentRequests) {
+  SessionOptions so;
+  InferenceSession session{so, &DefaultLoggingManager()};
+  LoadSquareModel(session, true);
+
+  std::unique_ptr<RequestBatcher> batcher;
+  EXPECT_FALSE(RequestBatcher::Create(session, {"foo"}, RequestBatcherOptions(), &batcher).IsOK());
+
+  RequestBatcherOptions options;
+  options.max_batch_size = 8;
+  options.max_wait = std::chrono::milliseconds(10);
+  ASSERT_TRUE(RequestBatcher::Create(session, {"Y"}, options, &batcher).IsOK());
+
+  // requests of 1 to 3 rows, some with a different number of columns so they can't join every batch
+  constexpr int kNumRequests = 24;
+  std::vector<int> failures(kNumRequests, 0);
+  std::vector<std::thread> threads;
+  for (int r = 0; r < kNumRequests; ++r) {
+    threads.emplace_back([&, r]() {
+      const int64_t rows = 1 + r % 3;
+      const int64_t cols = r % 4 == 0 ? 3 : 2;
+      std::vector<float> values;
+      for (int64_t i = 0; i < rows * cols; ++i) {
+        values.push_back(static_cast<float>(r + i));
+      }
+
+      MLValue x;
+      CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {rows, cols}, values, &x);
+      std::vector<MLValue> fetches;
+      auto status = batcher->Run({{"X", x}}, &fetches);
+      if (!status.IsOK() || fetches.size() != 1) {
+        failures[r] = 1;
+        return;
+      }
+
+      const Tensor& y = fetches[0].Get<Tensor>();
+      if (y.Shape() != TensorShape({rows, cols})) {
+        failures[r] = 1;
+        return;
+      }
+      for (int64_t i = 0; i < rows * cols; ++i) {
+        if (y.Data<float>()[i] != values[i] * values[i]) {
+          failures[r] = 1;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(std::vector<int>(kNumRequests, 0), failures);
+
+  // invalid requests are rejected before they are queued
+  MLValue x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {1, 2}, {1.f, 2.f}, &x);
+  std::vector<MLValue> fetches;
+  EXPECT_FALSE(batcher->Run({{"W", x}}, &fetches).IsOK());
+  EXPECT_FALSE(batcher->Run({{"X", x}, {"W", x}}, &fetches).IsOK());
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -8,6 +8,7 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include <numeric>
 #include <sstream>
 
 namespace onnxruntime {
@@ -216,5 +217,52 @@ TEST(TensorTest, Int64PtrConstructor) {
   EXPECT_THAT(shape.GetDims(), testing::ElementsAre(2, 3));
 }
 
+TEST(TensorTest, TensorShapeCopyAndMove) {
+  // one shape that fits in the inline storage and one that needs a heap buffer
+  std::vector<int64_t> small_dims{1, 2, 3};
+  std::vector<int64_t> large_dims(TensorShape::kMaxInlineDims + 2);
+  std::iota(large_dims.begin(), large_dims.end(), 1);
+
+  for (const auto& dims : {small_dims, large_dims}) {
+    const TensorShape shape(dims);
+    EXPECT_EQ(shape.GetDims(), dims);
+
+    TensorShape copy(shape);
+    EXPECT_EQ(copy, shape);
+    EXPECT_NE(copy.GetDims().data(), shape.GetDims().data());
+    copy[0] = 42;
+    EXPECT_EQ(shape[0], dims[0]);
+
+    TensorShape moved(std::move(copy));
+    EXPECT_EQ(moved[0], 42);
+    EXPECT_EQ(moved.NumDimensions(), dims.size());
+    EXPECT_EQ(copy.NumDimensions(), 0u);
+
+    // assign across the inline/heap boundary in both directions
+    TensorShape assigned(small_dims);
+    assigned = shape;
+    EXPECT_EQ(assigned, shape);
+    assigned = TensorShape(large_dims);
+    EXPECT_EQ(assigned.GetDims(), large_dims);
+    assigned = TensorShape(small_dims);
+    EXPECT_EQ(assigned.GetDims(), small_dims);
+  }
+}
+
+TEST(TensorTest, TensorShapeView) {
+  TensorShape shape({2, 3, 4});
+  TensorShapeView view = shape.GetDims();
+  EXPECT_EQ(view.size(), 3u);
+  EXPECT_EQ(view.data(), &shape[0]);
+  EXPECT_EQ(view.front(), 2);
+  EXPECT_EQ(view.back(), 4);
+  EXPECT_THROW(view.at(3), std::out_of_range);
+
+  std::vector<int64_t> dims = view;
+  EXPECT_EQ(dims, std::vector<int64_t>({2, 3, 4}));
+  EXPECT_EQ(TensorShape(view), shape);
+  EXPECT_EQ(shape.Slice(1).GetDims(), std::vector<int64_t>({3, 4}));
+}
+
 }  // namespace test
 }  // namespace onnxruntime
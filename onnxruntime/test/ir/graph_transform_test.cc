@@ -11,6 +11,9 @@
 #include "core/graph/conv_mul_fusion.h"
 #include "core/graph/conv_add_fusion.h"
 #include "core/graph/conv_activation_fusion.h"
+#include "core/graph/elementwise_fusion.h"
+#include "core/graph/gemm_activation_fusion.h"
+#include "core/graph/matmul_add_fusion.h"
 #include "core/platform/env.h"
 
 #include "test/capturing_sink.h"
@@ -194,5 +197,149 @@ TEST(GraphTransformationTests, FuseConvAddMul3D) {
   ASSERT_TRUE(session_object.Initialize().IsOK());
 }
 
+TEST(GraphTransformationTests, FuseElementwise) {
+  onnxruntime::Model model("test");
+  onnxruntime::Graph& graph = model.MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  TypeProto row_float;
+  row_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  row_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+
+  // Y = Sigmoid(X * S + X) - X * S, Z = Exp(S) + X
+  // X * S is used twice, so it stays a separate node. Exp(S) is broadcast by its consumer, so it isn't fused either.
+  auto& x = graph.GetOrCreateNodeArg("X", &tensor_float);
+  auto& s = graph.GetOrCreateNodeArg("S", &row_float);
+  auto& t1 = graph.GetOrCreateNodeArg("T1", &tensor_float);
+  auto& t2 = graph.GetOrCreateNodeArg("T2", &tensor_float);
+  auto& t3 = graph.GetOrCreateNodeArg("T3", &tensor_float);
+  auto& t4 = graph.GetOrCreateNodeArg("T4", &row_float);
+  auto& y = graph.GetOrCreateNodeArg("Y", &tensor_float);
+  auto& z = graph.GetOrCreateNodeArg("Z", &tensor_float);
+  graph.AddNode("mul", "Mul", "", {&x, &s}, {&t1});
+  graph.AddNode("add", "Add", "", {&t1, &x}, {&t2});
+  graph.AddNode("sigmoid", "Sigmoid", "", {&t2}, {&t3});
+  graph.AddNode("sub", "Sub", "", {&t3, &t1}, {&y});
+  graph.AddNode("exp", "Exp", "", {&s}, {&t4});
+  graph.AddNode("add2", "Add", "", {&t4, &x}, {&z});
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  bool modified = false;
+  ASSERT_TRUE(ElementwiseFusion().Apply(graph, modified).IsOK());
+  ASSERT_TRUE(modified);
+
+  std::map<std::string, int> op_counts;
+  const Node* fused = nullptr;
+  for (const auto& node : graph.Nodes()) {
+    op_counts[node.OpType()]++;
+    if (node.OpType() == "FusedElementwise") {
+      fused = &node;
+    }
+  }
+  EXPECT_EQ(op_counts, (std::map<std::string, int>{{"Mul", 1}, {"FusedElementwise", 1}, {"Exp", 1}, {"Add", 1}}));
+  ASSERT_NE(fused, nullptr);
+
+  // inputs are T1 and X, ops are evaluated in topological order
+  ASSERT_EQ(fused->InputDefs().size(), 2u);
+  EXPECT_EQ(fused->InputDefs()[0]->Name(), "T1");
+  EXPECT_EQ(fused->InputDefs()[1]->Name(), "X");
+  EXPECT_EQ(fused->OutputDefs()[0]->Name(), "Y");
+  const auto& ops = fused->GetAttributes().at("ops").strings();
+  EXPECT_EQ(std::vector<std::string>(ops.begin(), ops.end()), (std::vector<std::string>{"Add", "Sigmoid", "Sub"}));
+  const auto& operands = fused->GetAttributes().at("operands").ints();
+  EXPECT_EQ(std::vector<int64_t>(operands.begin(), operands.end()), (std::vector<int64_t>{0, 1, 2, 3, 0}));
+
+  // the fused model can be loaded and initialized
+  std::stringstream model_stream;
+  model.ToProto().SerializeToOstream(&model_stream);
+  SessionOptions so;
+  so.session_logid = "GraphTransformationTests.FuseElementwise";
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(session_object.Load(model_stream).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+}
+
+// MatMul is since-version 1 up to opset 8, and since-version 9 after
+static void FuseMatMulAddActivation(int opset) {
+  onnxruntime::Model model("test", false, ModelMetaData(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, opset}});
+  onnxruntime::Graph& graph = model.MainGraph();
+
+  auto make_type = [](std::vector<int64_t> dims) {
+    TypeProto type;
+    type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    for (auto dim : dims) {
+      auto* shape_dim = type.mutable_tensor_type()->mutable_shape()->add_dim();
+      if (dim < 0) {
+        shape_dim->set_dim_param("N");
+      } else {
+        shape_dim->set_dim_value(dim);
+      }
+    }
+    return type;
+  };
+  TypeProto x_type = make_type({-1, 4}), w_type = make_type({4, 5}), b_type = make_type({5}),
+            y_type = make_type({-1, 5}), x3_type = make_type({2, -1, 4}), y3_type = make_type({2, -1, 5});
+
+  // Y = Relu(X * W + B) is fused into a single FusedGemm. Z = Tanh(X3 * W + B) is left alone as X3 is 3-D.
+  auto& x = graph.GetOrCreateNodeArg("X", &x_type);
+  auto& x3 = graph.GetOrCreateNodeArg("X3", &x3_type);
+  auto& w = graph.GetOrCreateNodeArg("W", &w_type);
+  auto& b = graph.GetOrCreateNodeArg("B", &b_type);
+  auto& t1 = graph.GetOrCreateNodeArg("T1", &y_type);
+  auto& t2 = graph.GetOrCreateNodeArg("T2", &y_type);
+  auto& t3 = graph.GetOrCreateNodeArg("T3", &y3_type);
+  auto& t4 = graph.GetOrCreateNodeArg("T4", &y3_type);
+  auto& y = graph.GetOrCreateNodeArg("Y", &y_type);
+  auto& z = graph.GetOrCreateNodeArg("Z", &y3_type);
+  graph.AddNode("matmul", "MatMul", "", {&x, &w}, {&t1});
+  graph.AddNode("add", "Add", "", {&b, &t1}, {&t2});
+  graph.AddNode("relu", "Relu", "", {&t2}, {&y});
+  graph.AddNode("matmul3", "MatMul", "", {&x3, &w}, {&t3});
+  graph.AddNode("add3", "Add", "", {&t3, &b}, {&t4});
+  graph.AddNode("tanh3", "Tanh", "", {&t4}, {&z});
+  ASSERT_TRUE(graph.Resolve().IsOK());
+
+  bool modified = false;
+  ASSERT_TRUE(MatMulAddFusion().Apply(graph, modified).IsOK());
+  ASSERT_TRUE(modified);
+  ASSERT_TRUE(GemmActivationFusion().Apply(graph, modified).IsOK());
+
+  std::map<std::string, int> op_counts;
+  const Node* fused = nullptr;
+  for (const auto& node : graph.Nodes()) {
+    op_counts[node.OpType()]++;
+    if (node.OpType() == "FusedGemm") {
+      fused = &node;
+    }
+  }
+  EXPECT_EQ(op_counts, (std::map<std::string, int>{{"FusedGemm", 1}, {"MatMul", 1}, {"Add", 1}, {"Tanh", 1}}));
+  ASSERT_NE(fused, nullptr);
+
+  ASSERT_EQ(fused->InputDefs().size(), 3u);
+  EXPECT_EQ(fused->InputDefs()[0]->Name(), "X");
+  EXPECT_EQ(fused->InputDefs()[1]->Name(), "W");
+  EXPECT_EQ(fused->InputDefs()[2]->Name(), "B");
+  EXPECT_EQ(fused->OutputDefs()[0]->Name(), "Y");
+  EXPECT_EQ(fused->GetAttributes().at("activation").s(), "Relu");
+
+  // the fused model can be loaded and initialized
+  std::stringstream model_stream;
+  model.ToProto().SerializeToOstream(&model_stream);
+  SessionOptions so;
+  so.session_logid = "GraphTransformationTests.FuseMatMulAddActivation";
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(session_object.Load(model_stream).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+}
+
+TEST(GraphTransformationTests, FuseMatMulAddActivation) {
+  FuseMatMulAddActivation(8);
+  FuseMatMulAddActivation(9);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
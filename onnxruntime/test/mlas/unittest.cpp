@@ -16,10 +16,20 @@ Abstract:
 
 #include <stdio.h>
 #include <memory.h>
+#include <math.h>
 #include <algorithm>
 #include <limits>
+#include <atomic>
+#include <thread>
+#include <vector>
 #include <mlas.h>
 
+//
+// The QGEMM tests select each kernel through the platform structure.
+//
+
+#include <mlasi.h>
+
 #if defined(_WIN32)
 #include <windows.h>
 #else
@@ -108,6 +118,58 @@ private:
     float* _GuardAddress;
 };
 
+//
+// Simple thread pool used to exercise the threaded code paths of MLAS. A
+// thread is started for each iteration beyond the first, which is executed
+// on the calling thread.
+//
+
+class MlasTestThreadPool : public MLAS_THREADPOOL
+{
+public:
+    MlasTestThreadPool(int32_t ThreadCount) : _ThreadCount(ThreadCount)
+    {
+    }
+
+    int32_t GetMaximumThreadCount(void) override
+    {
+        return _ThreadCount;
+    }
+
+    void ExecuteThreaded(PMLAS_THREADED_ROUTINE ThreadedRoutine, void* Context, int32_t Iterations) override
+    {
+        std::atomic<int32_t> NextIndex(0);
+
+        auto Worker = [&]() {
+            for (int32_t Index = NextIndex++; Index < Iterations; Index = NextIndex++) {
+                ThreadedRoutine(Context, Index);
+            }
+        };
+
+        std::vector<std::thread> Threads;
+
+        for (int32_t tid = 1; tid < std::min(Iterations, _ThreadCount); tid++) {
+            Threads.emplace_back(Worker);
+        }
+
+        Worker();
+
+        for (auto& Thread : Threads) {
+            Thread.join();
+        }
+    }
+
+private:
+    int32_t _ThreadCount;
+};
+
+//
+// Thread pool supplied to the routines under test, or nullptr to use the
+// platform default threading support.
+//
+
+MLAS_THREADPOOL* TestThreadPool = nullptr;
+
 void
 ReferenceSgemm(
     CBLAS_TRANSPOSE TransA,
@@ -240,7 +302,7 @@ TrialSgemm(
         CReference[f] = -0.5f;
     }
 
-    MlasSgemm(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+    MlasSgemm(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, TestThreadPool);
     ReferenceSgemm(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, CReference, ldc);
 
     for (size_t f = 0; f < M * N; f++) {
@@ -251,6 +313,88 @@ TrialSgemm(
     }
 }
 
+void
+TrialPackedSgemm(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    float* CReference,
+    size_t ldc
+    )
+{
+    for (size_t f = 0; f < M * N; f++) {
+        C[f] = -0.5f;
+        CReference[f] = -0.5f;
+    }
+
+    std::vector<unsigned char> PackedB(MlasSgemmPackBSize(N, K));
+
+    MlasSgemmPackB(TransB, N, K, B, ldb, PackedB.data());
+    MlasSgemm(TransA, M, N, K, alpha, A, lda, PackedB.data(), beta, C, ldc, TestThreadPool);
+    ReferenceSgemm(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, CReference, ldc);
+
+    for (size_t f = 0; f < M * N; f++) {
+        // Sensitive to comparing positive/negative zero.
+        if (C[f] != CReference[f]) {
+            printf("mismatch packed TransA=%d, TransB=%d, M=%zd, N=%zd, K=%zd, alpha=%f, beta=%f!\n", TransA, TransB, M, N, K, alpha, beta);
+        }
+    }
+}
+
+void
+TrialSgemmStridedBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    size_t StrideA,
+    const float* B,
+    size_t ldb,
+    size_t StrideB,
+    float beta,
+    size_t ldc,
+    size_t BatchCount
+    )
+{
+    //
+    // The columns past N of each matrix C must be left untouched.
+    //
+
+    const size_t StrideC = M * ldc;
+
+    std::vector<float> C(StrideC * BatchCount, -0.5f);
+    std::vector<float> CReference(StrideC * BatchCount, -0.5f);
+
+    MlasSgemmStridedBatch(TransA, TransB, M, N, K, alpha, A, lda, StrideA, B, ldb, StrideB,
+        beta, C.data(), ldc, StrideC, BatchCount, TestThreadPool);
+
+    for (size_t batch = 0; batch < BatchCount; batch++) {
+        ReferenceSgemm(TransA, TransB, M, N, K, alpha, A + batch * StrideA, lda,
+            B + batch * StrideB, ldb, beta, CReference.data() + batch * StrideC, ldc);
+    }
+
+    for (size_t f = 0; f < StrideC * BatchCount; f++) {
+        // Sensitive to comparing positive/negative zero.
+        if (C[f] != CReference[f]) {
+            printf("mismatch strided batch TransA=%d, TransB=%d, M=%zd, N=%zd, K=%zd, alpha=%f, beta=%f, BatchCount=%zd!\n", TransA, TransB, M, N, K, alpha, beta, BatchCount);
+            break;
+        }
+    }
+}
+
 void
 TrialSgemm(
     size_t M,
@@ -273,6 +417,11 @@ TrialSgemm(
     TrialSgemm(CblasNoTrans, CblasTrans, M, N, K, alpha, A, K, B, K, beta, C, CReference, N);
     TrialSgemm(CblasTrans, CblasNoTrans, M, N, K, alpha, A, M, B, N, beta, C, CReference, N);
     TrialSgemm(CblasTrans, CblasTrans, M, N, K, alpha, A, M, B, K, beta, C, CReference, N);
+
+    TrialPackedSgemm(CblasNoTrans, CblasNoTrans, M, N, K, alpha, A, K, B, N, beta, C, CReference, N);
+    TrialPackedSgemm(CblasNoTrans, CblasTrans, M, N, K, alpha, A, K, B, K, beta, C, CReference, N);
+    TrialPackedSgemm(CblasTrans, CblasNoTrans, M, N, K, alpha, A, M, B, N, beta, C, CReference, N);
+    TrialPackedSgemm(CblasTrans, CblasTrans, M, N, K, alpha, A, M, B, K, beta, C, CReference, N);
 }
 
 void
@@ -287,6 +436,41 @@ ExecuteSgemmTests(
     MatrixGuardBuffer BufferC(MaximumDimension * MaximumDimension, false);
     MatrixGuardBuffer BufferCReference(MaximumDimension * MaximumDimension, false);
 
+    // Batches of small matrices, including broadcasting one of the inputs.
+    for (size_t BatchCount : { 1, 3, 16, 40 }) {
+        for (size_t M : { 1, 7, 16, 33 }) {
+            for (size_t N : { 1, 9, 32, 70 }) {
+                for (size_t K : { 1, 5, 32 }) {
+                    const float* A = BufferA.GetBuffer(M * K * BatchCount);
+                    const float* B = BufferB.GetBuffer(K * N * BatchCount);
+
+                    TrialSgemmStridedBatch(CblasNoTrans, CblasNoTrans, M, N, K, 1.0f, A, K, M * K, B, N, K * N, 0.0f, N, BatchCount);
+                    TrialSgemmStridedBatch(CblasNoTrans, CblasTrans, M, N, K, 1.0f, A, K, M * K, B, K, K * N, 0.0f, N, BatchCount);
+                    TrialSgemmStridedBatch(CblasTrans, CblasNoTrans, M, N, K, 0.5f, A, M, M * K, B, N, 0, 1.0f, N, BatchCount);
+                    TrialSgemmStridedBatch(CblasTrans, CblasTrans, M, N, K, 1.0f, A, M, 0, B, K, K * N, -0.5f, N, BatchCount);
+                }
+            }
+        }
+    }
+
+    // Batches with fewer items than threads, so that each SGEMM operation is
+    // also divided into tiles, with padded rows of matrix C.
+    for (size_t BatchCount : { 1, 2, 3 }) {
+        for (size_t M : { 24, 96, 300 }) {
+            for (size_t N : { 40, 130, 300 }) {
+                const size_t K = 64;
+                const size_t ldc = N + 3;
+                const float* A = BufferA.GetBuffer(M * K * BatchCount);
+                const float* B = BufferB.GetBuffer(K * N * BatchCount);
+
+                TrialSgemmStridedBatch(CblasNoTrans, CblasNoTrans, M, N, K, 1.0f, A, K, M * K, B, N, K * N, 0.0f, ldc, BatchCount);
+                TrialSgemmStridedBatch(CblasNoTrans, CblasTrans, M, N, K, -1.0f, A, K, M * K, B, K, K * N, 0.5f, ldc, BatchCount);
+                TrialSgemmStridedBatch(CblasTrans, CblasNoTrans, M, N, K, 0.5f, A, M, M * K, B, N, 0, 1.0f, ldc, BatchCount);
+                TrialSgemmStridedBatch(CblasTrans, CblasTrans, M, N, K, 1.0f, A, M, 0, B, K, K * N, -0.5f, ldc, BatchCount);
+            }
+        }
+    }
+
     // Trial balloons.
     for (size_t b = 1; b < 16; b++) {
         TrialSgemm(b, b, b, 1.0f, BufferA, BufferB, 0.0f, BufferC, BufferCReference);
@@ -439,7 +623,7 @@ ReferenceConv2D(
             }
 
             MlasSgemm(CblasNoTrans, CblasNoTrans, FilterCount, OutputSize, K, 1.0f,
-                filter, K, Im2Col, OutputSize, 0.0f, Output, OutputSize);
+                filter, K, Im2Col, OutputSize, 0.0f, Output, OutputSize, nullptr);
 
             //
             // Apply the bias.
@@ -512,7 +696,8 @@ TrialConv2D(
                     StrideShape,
                     OutputShape,
                     FilterCount,
-                    &WorkingBufferSize);
+                    &WorkingBufferSize,
+                    TestThreadPool);
 
     size_t OutputHeight = size_t(OutputHeight64);
     size_t OutputWidth = size_t(OutputWidth64);
@@ -545,7 +730,8 @@ TrialConv2D(
              Filter,
              Bias,
              BufferWorking.GetBuffer(WorkingBufferSize),
-             Output);
+             Output,
+             TestThreadPool);
 
     ReferenceConv2D(BatchCount,
                     GroupCount,
@@ -562,7 +748,33 @@ TrialConv2D(
                     Bias,
                     OutputReference);
 
-    if (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0) {
+    //
+    // The Winograd algorithm does not produce results that are bitwise exact,
+    // so compare against a tolerance scaled by the largest possible magnitude
+    // of the products.
+    //
+
+    bool Mismatch;
+
+    if (Parameters.Algorithm == MlasConvAlgorithmWinograd) {
+
+        const float Tolerance = 1e-6f * float(InputChannels * KernelSize) * 23.0f * 23.0f;
+
+        Mismatch = false;
+
+        for (size_t i = 0; i < OutputBufferElements; i++) {
+            if (fabsf(Output[i] - OutputReference[i]) > Tolerance) {
+                Mismatch = true;
+                break;
+            }
+        }
+
+    } else {
+
+        Mismatch = (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0);
+    }
+
+    if (Mismatch) {
         printf("mismatch: batch=%zd,group=%zd,input(%zd,%zd,%zd),filter=%zd,kernel(%zd,%zd)!!!\n",
             BatchCount, GroupCount, InputChannels, InputHeight, InputWidth, FilterCount,
             KernelHeight, KernelWidth);
@@ -597,6 +809,33 @@ ExecuteConvTests(
         TrialConv2D(b, 1, 64, 11, 11, 128, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1);
     }
 
+    for (unsigned i = 2; i <= 20; i++) {
+        TrialConv2D(1, 1, 8, i, i + 3, 8, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
+        TrialConv2D(1, 1, 32, i, 2 * i + 1, 16, 3, 3, 1, 0, 0, 1, 1, 1, 1, 1);
+        TrialConv2D(3, 2, 16, i, i, 24, 3, 3, 0, 0, 0, 0, 1, 1, 1, 1);
+        TrialConv2D(2, 1, 64, i, i, 64, 3, 3, 2, 2, 2, 2, 1, 1, 1, 1);
+        TrialConv2D(16, 1, 8, i, i, 12, 3, 3, 0, 1, 1, 0, 1, 1, 1, 1);
+    }
+
+    //
+    // Wide layers where a transformed F(4x4,3x3) tile or any transformed tile
+    // exceeds the Winograd working buffer target.
+    //
+
+    TrialConv2D(1, 1, 8000, 24, 24, 8, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
+    TrialConv2D(1, 1, 16400, 24, 24, 8, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
+
+    for (unsigned k = 1; k <= 5; k += 2) {
+        for (unsigned p = 0; p <= 2; p++) {
+            for (unsigned d = 1; d <= 2; d++) {
+                for (unsigned s = 1; s <= 2; s++) {
+                    TrialConv2D(1, 32, 1, 17, 31, 1, k, k, p, p, p, p, d, d, s, s);
+                    TrialConv2D(3, 7, 1, 1, 9, 1, 1, k, 0, p, 0, p, 1, d, 1, s);
+                }
+            }
+        }
+    }
+
     for (unsigned ic = 0; ic < _countof(cs); ic++) {
         for (unsigned ih = 0; ih < _countof(is); ih++) {
             for (unsigned iw = 0; iw < _countof(is); iw++) {
@@ -971,7 +1210,7 @@ TrialPool2D(
     float* Output = BufferOutput.GetBuffer(OutputBufferElements);
     float* OutputReference = BufferOutputReference.GetBuffer(OutputBufferElements);
 
-    MlasPool(MlasMaximumPooling, 2, InputShape, KernelShape, Padding, StrideShape, OutputShape, Input, Output);
+    MlasPool(MlasMaximumPooling, 2, InputShape, KernelShape, Padding, StrideShape, OutputShape, Input, Output, TestThreadPool);
     ReferenceMaximumPool2D(InputShape, KernelShape, Padding, StrideShape, Input, OutputReference);
 
     if (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0) {
@@ -979,7 +1218,7 @@ TrialPool2D(
             InputChannels, InputHeight, InputWidth, KernelHeight, KernelWidth);
     }
 
-    MlasPool(MlasAveragePoolingExcludePad, 2, InputShape, KernelShape, Padding, StrideShape, OutputShape, Input, Output);
+    MlasPool(MlasAveragePoolingExcludePad, 2, InputShape, KernelShape, Padding, StrideShape, OutputShape, Input, Output, TestThreadPool);
     ReferenceAveragePool2D(InputShape, KernelShape, Padding, StrideShape, Input, OutputReference, false);
 
     if (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0) {
@@ -987,7 +1226,7 @@ TrialPool2D(
             InputChannels, InputHeight, InputWidth, KernelHeight, KernelWidth);
     }
 
-    MlasPool(MlasAveragePoolingIncludePad, 2, InputShape, KernelShape, Padding, StrideShape, OutputShape, Input, Output);
+    MlasPool(MlasAveragePoolingIncludePad, 2, InputShape, KernelShape, Padding, StrideShape, OutputShape, Input, Output, TestThreadPool);
     ReferenceAveragePool2D(InputShape, KernelShape, Padding, StrideShape, Input, OutputReference, true);
 
     if (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0) {
@@ -1038,7 +1277,7 @@ TrialPool3D(
     float* Output = BufferOutput.GetBuffer(OutputBufferElements);
     float* OutputReference = BufferOutputReference.GetBuffer(OutputBufferElements);
 
-    MlasPool(MlasMaximumPooling, 3, InputShape, KernelShape, Padding, StrideShape, OutputShape, Input, Output);
+    MlasPool(MlasMaximumPooling, 3, InputShape, KernelShape, Padding, StrideShape, OutputShape, Input, Output, TestThreadPool);
     ReferenceMaximumPool3D(InputShape, KernelShape, Padding, StrideShape, Input, OutputReference);
 
     if (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0) {
@@ -1046,7 +1285,7 @@ TrialPool3D(
             InputChannels, InputDepth, InputHeight, InputWidth, KernelDepth, KernelHeight, KernelWidth);
     }
 
-    MlasPool(MlasAveragePoolingExcludePad, 3, InputShape, KernelShape, Padding, StrideShape, OutputShape, Input, Output);
+    MlasPool(MlasAveragePoolingExcludePad, 3, InputShape, KernelShape, Padding, StrideShape, OutputShape, Input, Output, TestThreadPool);
     ReferenceAveragePool3D(InputShape, KernelShape, Padding, StrideShape, Input, OutputReference, false);
 
     if (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0) {
@@ -1054,7 +1293,7 @@ TrialPool3D(
             InputChannels, InputDepth, InputHeight, InputWidth, KernelDepth, KernelHeight, KernelWidth);
     }
 
-    MlasPool(MlasAveragePoolingIncludePad, 3, InputShape, KernelShape, Padding, StrideShape, OutputShape, Input, Output);
+    MlasPool(MlasAveragePoolingIncludePad, 3, InputShape, KernelShape, Padding, StrideShape, OutputShape, Input, Output, TestThreadPool);
     ReferenceAveragePool3D(InputShape, KernelShape, Padding, StrideShape, Input, OutputReference, true);
 
     if (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0) {
@@ -1148,6 +1387,171 @@ ExecutePool3DTests(
     }
 }
 
+template<typename BType>
+void
+ReferenceQgemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const BType* B,
+    size_t ldb,
+    BType offb,
+    int32_t* C,
+    size_t ldc
+    )
+{
+    for (size_t m = 0; m < M; m++) {
+
+        for (size_t n = 0; n < N; n++) {
+
+            int32_t sum = 0;
+
+            for (size_t k = 0; k < K; k++) {
+                sum += (int32_t(A[m * lda + k]) - int32_t(offa)) * (int32_t(B[k * ldb + n]) - int32_t(offb));
+            }
+
+            C[m * ldc + n] = sum;
+        }
+    }
+}
+
+const char* QgemmKernelName = "MlasQgemmKernel";
+
+template<typename BType>
+void
+TrialQgemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    uint8_t offa,
+    BType offb
+    )
+{
+    std::vector<uint8_t> A(M * K);
+    std::vector<BType> B(K * N);
+
+    for (size_t i = 0; i < A.size(); i++) {
+        A[i] = uint8_t((i * 37 + 11) % 256);
+    }
+    for (size_t i = 0; i < B.size(); i++) {
+        B[i] = BType((i * 53 + 7) % 256);
+    }
+
+    std::vector<int32_t> C(M * N, -1);
+    std::vector<int32_t> CReference(M * N, -1);
+
+    MlasQgemm(M, N, K, A.data(), K, offa, B.data(), N, offb, C.data(), N, nullptr, TestThreadPool);
+    ReferenceQgemm(M, N, K, A.data(), K, offa, B.data(), N, offb, CReference.data(), N);
+
+    for (size_t f = 0; f < M * N; f++) {
+        if (C[f] != CReference[f]) {
+            printf("mismatch qgemm %s M=%zd, N=%zd, K=%zd, offa=%d, offb=%d!\n", QgemmKernelName, M, N, K, int(offa), int(offb));
+            break;
+        }
+    }
+
+    //
+    // Repeat with the requantization of the output, using a scale for each
+    // row and a bias.
+    //
+
+    std::vector<int32_t> Bias(M);
+    std::vector<float> Scale(M);
+
+    for (size_t m = 0; m < M; m++) {
+        Bias[m] = int32_t(m * 101) - 500;
+        Scale[m] = 1.0f / float(K * 64 + m + 1);
+    }
+
+    MLAS_REQUANTIZE_PARAMETERS Requantize;
+    std::vector<uint8_t> Output(M * N);
+    std::vector<uint8_t> OutputReference(M * N);
+
+    Requantize.Output = Output.data();
+    Requantize.ldo = N;
+    Requantize.Bias = Bias.data();
+    Requantize.Scale = Scale.data();
+    Requantize.PerRowScale = true;
+    Requantize.ZeroPoint = 128;
+
+    MlasQgemm(M, N, K, A.data(), K, offa, B.data(), N, offb, C.data(), N, &Requantize, TestThreadPool);
+    MlasRequantizeOutput(CReference.data(), N, OutputReference.data(), N, Bias.data(), Scale.data(), true, 128, M, N);
+
+    if (Output != OutputReference) {
+        printf("mismatch requantized qgemm %s M=%zd, N=%zd, K=%zd, offa=%d, offb=%d!\n", QgemmKernelName, M, N, K, int(offa), int(offb));
+    }
+}
+
+void
+ExecuteQgemmKernelTests(
+    void
+    )
+{
+    for (size_t M : { 1, 3, 4, 16, 17, 40 }) {
+        for (size_t N : { 1, 15, 16, 33, 130, 300 }) {
+            for (size_t K : { 1, 2, 7, 64, 255, 257, 600 }) {
+                TrialQgemm<uint8_t>(M, N, K, 0, 0);
+                TrialQgemm<uint8_t>(M, N, K, 131, 255);
+                TrialQgemm<int8_t>(M, N, K, 0, 0);
+                TrialQgemm<int8_t>(M, N, K, 17, -128);
+            }
+        }
+    }
+
+    TrialQgemm<uint8_t>(0, 16, 16, 0, 0);
+    TrialQgemm<int8_t>(16, 16, 0, 0, 0);
+}
+
+void
+ExecuteQgemmTests(
+    void
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+
+    //
+    // Run the tests once for each kernel supported by the processor. The
+    // platform selects the most capable kernel, so the kernels ranked below
+    // the selected kernel are also supported.
+    //
+
+    struct {
+        PMLAS_QGEMM_KERNEL_ROUTINE KernelRoutine;
+        const char* KernelName;
+    } Kernels[] = {
+        { MlasQgemmKernel, "MlasQgemmKernel" },
+        { MlasQgemmKernelAvx2, "MlasQgemmKernelAvx2" },
+#if defined(MLAS_HAS_QGEMM_AVX512VNNI)
+        { MlasQgemmKernelAvx512Vnni, "MlasQgemmKernelAvx512Vnni" },
+#endif
+    };
+
+    const PMLAS_QGEMM_KERNEL_ROUTINE PlatformKernelRoutine = MlasPlatform.QgemmKernelRoutine;
+
+    for (const auto& Kernel : Kernels) {
+
+        MlasPlatform.QgemmKernelRoutine = Kernel.KernelRoutine;
+        QgemmKernelName = Kernel.KernelName;
+
+        ExecuteQgemmKernelTests();
+
+        if (Kernel.KernelRoutine == PlatformKernelRoutine) {
+            break;
+        }
+    }
+
+    MlasPlatform.QgemmKernelRoutine = PlatformKernelRoutine;
+
+#else
+
+    ExecuteQgemmKernelTests();
+
+#endif
+}
+
 #if 0
 #if defined(_WIN32)
 
@@ -1186,7 +1590,7 @@ EvaluateThreadingPerformance(
                 DWORD start = GetTickCount();
                 DWORD stop;
                 do {
-                    MlasSgemm(CblasNoTrans, CblasNoTrans, M, N, K, 1.0f, A, K, B, N, 0.0f, C, N);
+                    MlasSgemm(CblasNoTrans, CblasNoTrans, M, N, K, 1.0f, A, K, B, N, 0.0f, C, N, nullptr);
                     stop = GetTickCount();
                     NumberIterations++;
                 } while ((stop - start) <= 5000);
@@ -1206,7 +1610,7 @@ EvaluateThreadingPerformance(
 
                     start = GetTickCount();
                     for (size_t iters = 0; iters < NumberIterations; iters++) {
-                        MlasSgemm(CblasNoTrans, CblasNoTrans, M, N, K, 1.0f, A, K, B, N, 0.0f, C, N);
+                        MlasSgemm(CblasNoTrans, CblasNoTrans, M, N, K, 1.0f, A, K, B, N, 0.0f, C, N, nullptr);
                         stop = GetTickCount();
                         if ((stop - start) > 20000) {
                             break;
@@ -1234,11 +1638,26 @@ main(
     void
     )
 {
-//    ExecuteSgemmTests();
+    ExecuteSgemmTests();
+    ExecuteQgemmTests();
     ExecuteConvTests();
 //    ExecutePool2DTests();
 //    ExecutePool3DTests();
 //    EvaluateThreadingPerformance();
 
+    //
+    // Repeat the tests using a caller supplied thread pool.
+    //
+
+    MlasTestThreadPool ThreadPool(4);
+
+    TestThreadPool = &ThreadPool;
+
+    ExecuteSgemmTests();
+    ExecuteQgemmTests();
+    ExecuteConvTests();
+//    ExecutePool2DTests();
+//    ExecutePool3DTests();
+
     return 0;
 }
@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+#include <core/graph/onnx_protobuf.h>
+#include <core/graph/model.h>
+#include <core/framework/allocator.h>
+#include <core/framework/tensor.h>
+#include <core/session/inference_session.h>
+#include <sstream>
+
+using namespace onnxruntime;
+
+// Builds a graph with 'width' independent chains of 'depth' Identity nodes on a single element tensor, so the
+// kernel cost is negligible and the run time is dominated by the executor's per-node scheduling overhead.
+static std::string CreateIdentityGraph(int width, int depth) {
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[onnxruntime::kOnnxDomain] = 7;
+  Model model("scheduling", false, ModelMetaData(), IOnnxRuntimeOpSchemaRegistryList(), domain_to_version);
+  Graph& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  auto& input = graph.GetOrCreateNodeArg("X", &tensor_float);
+  for (int w = 0; w < width; ++w) {
+    NodeArg* prev = &input;
+    for (int d = 0; d < depth; ++d) {
+      std::string name = "chain" + std::to_string(w) + "_" + std::to_string(d);
+      auto& output = graph.GetOrCreateNodeArg(name, &tensor_float);
+      graph.AddNode(name, "Identity", "", {prev}, {&output});
+      prev = &output;
+    }
+  }
+
+  if (!graph.Resolve().IsOK()) {
+    abort();
+  }
+
+  std::string serialized;
+  model.ToProto().SerializeToString(&serialized);
+  return serialized;
+}
+
+static void BM_ParallelExecutorScheduling(benchmark::State& state) {
+  const int width = static_cast<int>(state.range(0));
+  const int depth = static_cast<int>(state.range(1));
+
+  SessionOptions so;
+  so.enable_sequential_execution = false;
+  so.session_logid = "BM_ParallelExecutorScheduling";
+  InferenceSession session{so};
+  std::istringstream model_stream(CreateIdentityGraph(width, depth));
+  auto st = session.Load(model_stream);
+  if (st.IsOK()) st = session.Initialize();
+  if (!st.IsOK()) {
+    state.SkipWithError(st.ErrorMessage().c_str());
+    return;
+  }
+
+  AllocatorPtr allocator = std::make_shared<CPUAllocator>();
+  float input_value = 1.0f;
+  MLValue input;
+  input.Init(new Tensor(DataTypeImpl::GetType<float>(), TensorShape(std::vector<int64_t>{1}), &input_value, allocator->Info()),
+             DataTypeImpl::GetType<Tensor>(), DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+  NameMLValMap feeds{{"X", input}};
+
+  std::vector<std::string> output_names;
+  for (int w = 0; w < width; ++w) {
+    output_names.push_back("chain" + std::to_string(w) + "_" + std::to_string(depth - 1));
+  }
+
+  for (auto _ : state) {
+    std::vector<MLValue> fetches;
+    st = session.Run(feeds, output_names, &fetches);
+    if (!st.IsOK()) {
+      state.SkipWithError(st.ErrorMessage().c_str());
+      break;
+    }
+  }
+
+  // items_per_second is the number of nodes executed per second, i.e. the inverse of the per-node overhead.
+  state.SetItemsProcessed(state.iterations() * width * depth);
+}
+
+BENCHMARK(BM_ParallelExecutorScheduling)
+    ->Args({1, 1000})
+    ->Args({16, 64})
+    ->Args({256, 4})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
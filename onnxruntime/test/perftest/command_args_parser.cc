@@ -34,12 +34,15 @@ namespace perftest {
       "\t-s: Show statistics result, like P75, P90.\n"
       "\t-v: Show verbose information.\n"
       "\t-x: Use parallel executor, default (without -x): sequential executor.\n"
+      "\t-b [max_batch_size]: Send requests from concurrent threads and batch them together, up to max_batch_size rows.\n"
+      "\t-c [concurrent_requests]: Specifies the number of threads sending requests with -b. Default:8.\n"
+      "\t-w [max_batch_wait_us]: Specifies how long a request waits for others to join its batch with -b. Default:1000.\n"
       "\t-h: help\n");
 }
 
 /*static*/ bool CommandLineParser::ParseArguments(PerformanceTestConfig& test_config, int argc, char* argv[]) {
   int ch;
-  while ((ch = getopt(argc, argv, "m:e:r:t:p:xvhs")) != -1) {
+  while ((ch = getopt(argc, argv, "m:e:r:t:p:b:c:w:xvhs")) != -1) {
     switch (ch) {
       case 'm':
         if (!strcmp(optarg, "duration")) {
@@ -87,6 +90,21 @@ namespace perftest {
       case 'x':
         test_config.run_config.enable_sequential_execution = false;
         break;
+      case 'b':
+        test_config.run_config.max_batch_size = strtol(optarg, nullptr, 10);
+        if (test_config.run_config.max_batch_size <= 0) {
+          return false;
+        }
+        break;
+      case 'c':
+        test_config.run_config.concurrent_requests = static_cast<size_t>(strtol(optarg, nullptr, 10));
+        if (test_config.run_config.concurrent_requests == 0) {
+          return false;
+        }
+        break;
+      case 'w':
+        test_config.run_config.max_batch_wait_us = static_cast<size_t>(strtol(optarg, nullptr, 10));
+        break;
       case '?':
       case 'h':
       default:
@@ -3,6 +3,9 @@
 
 #include "performance_runner.h"
 #include "TestCase.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
 #include <experimental/filesystem>
 #ifdef _MSC_VER
 #include <filesystem>
@@ -29,15 +32,19 @@ Status PerformanceRunner::Run() {
     session_object_->StartProfiling(performance_test_config_.run_config.profile_file);
 
   std::unique_ptr<utils::ICPUUsage> p_ICPUUsage = utils::CreateICPUUsage();
-  switch (performance_test_config_.run_config.test_mode) {
-    case TestMode::kFixDurationMode:
-      ORT_RETURN_IF_ERROR(RunFixDuration());
-      break;
-    case TestMode::KFixRepeatedTimesMode:
-      ORT_RETURN_IF_ERROR(RunRepeatedTimes());
-      break;
-    default:
-      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
+  if (batcher_) {
+    ORT_RETURN_IF_ERROR(RunBatching());
+  } else {
+    switch (performance_test_config_.run_config.test_mode) {
+      case TestMode::kFixDurationMode:
+        ORT_RETURN_IF_ERROR(RunFixDuration());
+        break;
+      case TestMode::KFixRepeatedTimesMode:
+        ORT_RETURN_IF_ERROR(RunRepeatedTimes());
+        break;
+      default:
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
+    }
   }
   performance_result_.average_CPU_usage = p_ICPUUsage->GetUsage();
   performance_result_.peak_workingset_size = utils::GetPeakWorkingSetSize();
@@ -45,12 +52,74 @@ Status PerformanceRunner::Run() {
   if (!performance_test_config_.run_config.profile_file.empty())
     session_object_->EndProfiling();
 
+  if (batcher_) {
+    // the requests overlap, so report the latency of each request and the throughput separately
+    double total_latency = 0;
+    for (double time_cost : performance_result_.time_costs) {
+      total_latency += time_cost;
+    }
+    std::cout << "Total time cost:" << performance_result_.total_time_cost << std::endl
+              << "Total requests:" << performance_result_.time_costs.size() << std::endl
+              << "Throughput:" << performance_result_.time_costs.size() / performance_result_.total_time_cost << " requests/s" << std::endl
+              << "Average latency:" << total_latency / performance_result_.time_costs.size() * 1000 << " ms" << std::endl;
+    return Status::OK();
+  }
+
   std::cout << "Total time cost:" << performance_result_.total_time_cost << std::endl
             << "Total iterations:" << performance_result_.time_costs.size() << std::endl
             << "Average time cost:" << performance_result_.total_time_cost / performance_result_.time_costs.size() * 1000 << " ms" << std::endl;
   return Status::OK();
 }
 
+Status PerformanceRunner::RunBatching() {
+  const RunConfig& run_config = performance_test_config_.run_config;
+  const bool fix_duration = run_config.test_mode == TestMode::kFixDurationMode;
+
+  std::mutex mutex;
+  Status status;  // first error of a request. GUARDED_BY(mutex)
+  std::atomic<size_t> num_requests{0};
+  auto start = std::chrono::high_resolution_clock::now();
+
+  auto send_requests = [&]() {
+    for (;;) {
+      auto request_start = std::chrono::high_resolution_clock::now();
+      if (fix_duration ? std::chrono::duration<double>(request_start - start).count() >= run_config.duration_in_seconds
+                       : num_requests++ >= run_config.repeated_times) {
+        return;
+      }
+
+      std::vector<MLValue> fetches;
+      Status request_status = batcher_->Run(feeds_, &fetches);
+      std::chrono::duration<double> duration_seconds = std::chrono::high_resolution_clock::now() - request_start;
+
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!request_status.IsOK()) {
+        if (status.IsOK()) {
+          status = request_status;
+        }
+        return;
+      }
+      performance_result_.time_costs.emplace_back(duration_seconds.count());
+      if (run_config.f_verbose) {
+        std::cout << "request:" << performance_result_.time_costs.size() << ","
+                  << "time_cost:" << performance_result_.time_costs.back() << std::endl;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < run_config.concurrent_requests; ++i) {
+    threads.emplace_back(send_requests);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::chrono::duration<double> total_seconds = std::chrono::high_resolution_clock::now() - start;
+  performance_result_.total_time_cost = total_seconds.count();
+  return status;
+}
+
 bool PerformanceRunner::Initialize() {
   path model_path(performance_test_config_.model_info.model_file_path);
   if (model_path.extension() != ".onnx") {
@@ -117,10 +186,26 @@ bool PerformanceRunner::Initialize() {
   }
 
   std::vector<MLValue> output_mlvalues(outputs.second->size());
+  std::vector<std::string> output_names;
   for (size_t i_output = 0; i_output < outputs.second->size(); ++i_output) {
     auto output = outputs.second->at(i_output);
     if (!output) continue;
     io_binding_->BindOutput(output->Name(), output_mlvalues[i_output]);
+    output_names.push_back(output->Name());
+  }
+
+  if (performance_test_config_.run_config.max_batch_size > 0) {
+    RequestBatcherOptions batcher_options;
+    batcher_options.max_batch_size = performance_test_config_.run_config.max_batch_size;
+    batcher_options.max_wait = std::chrono::microseconds(performance_test_config_.run_config.max_batch_wait_us);
+    status = RequestBatcher::Create(*session_object_, output_names, batcher_options, &batcher_);
+    if (!status.IsOK()) {
+      LOGF_DEFAULT(ERROR, "Failed to create the request batcher, TestCaseName:%s, ErrorMessage:%s",
+                   test_case->GetTestCaseName().c_str(),
+                   status.ErrorMessage().c_str());
+      return false;
+    }
+    feeds_ = feeds;
   }
 
   return true;
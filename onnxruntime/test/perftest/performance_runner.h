@@ -17,6 +17,7 @@
 #include <core/session/inference_session.h>
 #include <core/platform/env.h>
 #include <core/session/IOBinding.h>
+#include <core/session/request_batcher.h>
 
 #include "test_configuration.h"
 
@@ -110,12 +111,19 @@ class PerformanceRunner {
     return Status::OK();
   }
 
+  // send requests from concurrent threads through the batcher, for the duration or number of requests of the test mode
+  Status RunBatching();
+
  private:
   PerformanceResult performance_result_;
   PerformanceTestConfig performance_test_config_;
 
   std::shared_ptr<::onnxruntime::InferenceSession> session_object_;
   std::unique_ptr<IOBinding> io_binding_;
+
+  // set in batching mode
+  std::unique_ptr<RequestBatcher> batcher_;
+  NameMLValMap feeds_;
 };
 }  // namespace perftest
 }  // namespace onnxruntime
@@ -41,6 +41,11 @@ struct RunConfig {
   bool f_dump_statistics{false};
   bool f_verbose{false};
   bool enable_sequential_execution{true};
+  // batch concurrent requests with a RequestBatcher if greater than 0.
+  int64_t max_batch_size{0};
+  size_t max_batch_wait_us{1000};
+  // number of threads sending requests in batching mode.
+  size_t concurrent_requests{8};
 };
 
 struct PerformanceTestConfig {
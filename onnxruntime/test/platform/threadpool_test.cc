@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/platform/threadpool.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(ThreadPoolTest, ParallelForVisitsEveryIndexOnce) {
+  concurrency::ThreadPool tp("test", 4);
+  std::vector<std::atomic<int>> counts(1000);
+  for (auto& count : counts) count = 0;
+
+  tp.ParallelFor(static_cast<int32_t>(counts.size()), [&counts](int32_t i) { ++counts[i]; });
+
+  for (auto& count : counts) {
+    EXPECT_EQ(count, 1);
+  }
+}
+
+TEST(ThreadPoolTest, NestedParallelFor) {
+  concurrency::ThreadPool tp("test", 2);
+  std::atomic<int64_t> sum{0};
+
+  // inner loops are issued from worker threads, which must not deadlock when the pool is saturated
+  tp.ParallelFor(16, [&tp, &sum](int32_t i) {
+    tp.ParallelFor(16, [i, &sum](int32_t j) { sum += i * 16 + j; });
+  });
+
+  EXPECT_EQ(sum, 256 * 255 / 2);
+}
+
+TEST(ThreadPoolTest, ParallelForRange) {
+  concurrency::ThreadPool tp("test", 3);
+  std::vector<int> values(101, 0);
+
+  tp.ParallelForRange(0, static_cast<int64_t>(values.size()), 7, [&values](int64_t begin, int64_t end) {
+    EXPECT_LE(end - begin, 7);
+    for (int64_t i = begin; i < end; ++i) values[i] = static_cast<int>(i);
+  });
+
+  for (size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(values[i], static_cast<int>(i));
+  }
+}
+
+TEST(ThreadPoolTest, ParallelForPropagatesException) {
+  concurrency::ThreadPool tp("test", 2);
+  std::atomic<int> completed{0};
+
+  EXPECT_THROW(tp.ParallelFor(8, [&completed](int32_t i) {
+    if (i == 3) throw std::runtime_error("failure");
+    ++completed;
+  }),
+               std::runtime_error);
+
+  // all other iterations still run to completion before the exception is rethrown
+  EXPECT_EQ(completed, 7);
+}
+
+TEST(ThreadPoolTest, ExecuteThreaded) {
+  concurrency::ThreadPool tp("test", 2);
+  std::vector<int> values(10, 0);
+
+  MLAS_THREADPOOL* mlas_pool = &tp;
+  EXPECT_EQ(mlas_pool->GetMaximumThreadCount(), 3);
+  mlas_pool->ExecuteThreaded([](void* context, int32_t index) { static_cast<int*>(context)[index] = index + 1; },
+                             values.data(), static_cast<int32_t>(values.size()));
+
+  for (size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(values[i], static_cast<int>(i) + 1);
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
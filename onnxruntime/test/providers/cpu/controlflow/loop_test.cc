@@ -360,6 +360,99 @@ TEST(Loop, ExitDueToMaxIterations) {
           {});
 }
 
+// loop carried variables with a known shape alternate between two buffers instead of being allocated in every
+// iteration. test that other outputs that share those buffers are not affected when the buffers are reused.
+TEST(Loop, LoopCarriedVarsWithKnownShape) {
+  auto create_subgraph = [](const RunOptions&) {
+    Model model("Loop carried vars subgraph");
+    auto& graph = model.MainGraph();
+
+    std::vector<NodeArg*> inputs;
+    std::vector<NodeArg*> outputs;
+
+    /* Inputs: iter_num, cond_in, loop carried state variables.
+
+         iter_num_in    cond_in          loop_var_0_in          [outer_scope_0]  loop_var_1_in
+           (unused)        |          /        |        \            |           (unused)
+                       [Identity] [Identity] [Identity]  [Add]-------/
+                           |          |          |         |
+                        cond_out  loop_var_1_out loop_out_0 loop_var_0_out
+    */
+
+    TypeProto int64_scalar;
+    int64_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+    int64_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto bool_scalar;
+    bool_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+    bool_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto float_scalar;
+    float_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    float_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto float_vector;
+    float_vector.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    float_vector.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+
+    // graph inputs
+    auto& iter_num_in = graph.GetOrCreateNodeArg("iter_num_in", &int64_scalar);
+    auto& cond_in = graph.GetOrCreateNodeArg("cond_in", &bool_scalar);
+    auto& loop_var_0_in = graph.GetOrCreateNodeArg("loop_var_0_in", &float_vector);
+    auto& loop_var_1_in = graph.GetOrCreateNodeArg("loop_var_1_in", &float_vector);
+
+    auto& outer_scope_0 = graph.GetOrCreateNodeArg("outer_scope_0", &float_scalar);
+    graph.AddOuterScopeNodeArg("outer_scope_0");
+
+    // graph outputs
+    auto& cond_out = graph.GetOrCreateNodeArg("cond_out", &bool_scalar);
+    auto& loop_var_0_out = graph.GetOrCreateNodeArg("loop_var_0_out", &float_vector);
+    auto& loop_var_1_out = graph.GetOrCreateNodeArg("loop_var_1_out", &float_vector);
+    auto& loop_out_0 = graph.GetOrCreateNodeArg("loop_out_0", &float_vector);
+
+    inputs = {&cond_in};
+    outputs = {&cond_out};
+    graph.AddNode("cond_in_identity", "Identity", "Forward cond_in to cond_out", inputs, outputs);
+
+    inputs = {&loop_var_0_in, &outer_scope_0};
+    outputs = {&loop_var_0_out};
+    graph.AddNode("add", "Add", "Add outer_scope_0 to loop_var_0_in", inputs, outputs);
+
+    inputs = {&loop_var_0_in};
+    outputs = {&loop_var_1_out};
+    graph.AddNode("loop_var_1_identity", "Identity", "Forward loop_var_0_in to loop_var_1_out", inputs, outputs);
+
+    outputs = {&loop_out_0};
+    graph.AddNode("loop_out_0_identity", "Identity", "Forward loop_var_0_in to loop_out_0", inputs, outputs);
+
+    graph.SetInputOrder({&iter_num_in, &cond_in, &loop_var_0_in, &loop_var_1_in});
+    graph.SetOutputOrder({&cond_out, &loop_var_0_out, &loop_var_1_out, &loop_out_0});
+
+    auto status = graph.Resolve();
+    EXPECT_EQ(status, Status::OK());
+
+    return graph.ToGraphProto();
+  };
+
+  LoopOpTester test{{}, create_subgraph};
+
+  test.AddInput<int64_t>("M", {1}, {4});
+  test.AddInput<bool>("cond", {1}, {true});
+  test.AddInput<float>("loop_var_0_orig", {4}, {1.f, 2.f, 3.f, 4.f});
+  test.AddInput<float>("loop_var_1_orig", {4}, {0.f, 0.f, 0.f, 0.f});
+
+  // kOuterNodeAddValue is added to loop_var_0 in each iteration.
+  // loop_var_1 and loop_out_0 get the value of loop_var_0 at the start of the iteration.
+  test.AddOutput<float>("loop_var_0_final", {4}, {13.f, 14.f, 15.f, 16.f});
+  test.AddOutput<float>("loop_var_1_final", {4}, {10.f, 11.f, 12.f, 13.f});
+  test.AddOutput<float>("loop_out_0_final", {4, 4}, {1.f, 2.f, 3.f, 4.f,
+                                                     4.f, 5.f, 6.f, 7.f,
+                                                     7.f, 8.f, 9.f, 10.f,
+                                                     10.f, 11.f, 12.f, 13.f});
+
+  test.Run();
+}
+
 TEST(Loop, InfiniteLoopTermination) {
   auto create_subgraph = [](const RunOptions&) {
     Model model("Infinite Loop subgraph");
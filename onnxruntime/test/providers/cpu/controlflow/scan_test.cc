@@ -543,6 +543,60 @@ TEST(Scan, MixedSequenceLensReverse) {
           iteration_count_out, output_0, output_1, output_2, output_3);
 }
 
+// enough batch entries for them to be processed in parallel, with each worker handling several of them
+static void LargeBatchMixedSequenceLens(const RunOptions& options = {}) {
+  const int64_t batch_size = 16;
+  const int64_t max_sequence_len = 3;
+  const int64_t input_size = 2;
+
+  std::vector<int64_t> sequence_lens;
+  std::vector<float> iteration_count_in;
+  std::vector<float> iteration_count_out;
+  std::vector<float> input_0, input_1;
+  std::vector<float> output_0, output_1, output_2, output_3;
+
+  float output_adjust = options.include_outer_scope_add ? kOuterNodeAddValue : 0.f;
+
+  for (int64_t b = 0; b < batch_size; ++b) {
+    const int64_t sequence_len = b % max_sequence_len + 1;
+    sequence_lens.push_back(sequence_len);
+
+    // iteration_count_in + 1 for each item in the sequence
+    iteration_count_in.push_back(b * 10.f);
+    iteration_count_out.push_back(b * 10.f + sequence_len);
+
+    for (int64_t seq_no = 0; seq_no < max_sequence_len; ++seq_no) {
+      float value = b * 100.f + seq_no * 10.f;
+      input_0.insert(input_0.end(), {value + 1.f, value + 2.f});
+      input_1.insert(input_1.end(), {value + 3.f, value + 4.f});
+
+      // the outputs past the end of a short sequence are zeroed
+      bool in_sequence = seq_no < sequence_len;
+      output_0.push_back(in_sequence ? value + 1.f + output_adjust : 0.f);
+      output_1.push_back(in_sequence ? value + 2.f + output_adjust : 0.f);
+      output_2.push_back(in_sequence ? value + 3.f + output_adjust : 0.f);
+      output_3.push_back(in_sequence ? value + 4.f + output_adjust : 0.f);
+    }
+  }
+
+  RunTest("LargeBatchMixedSequenceLens", batch_size, max_sequence_len, input_size,
+          nullptr, &sequence_lens,
+          iteration_count_in, input_0, input_1,
+          iteration_count_out, output_0, output_1, output_2, output_3,
+          options);
+}
+
+TEST(Scan, LargeBatchMixedSequenceLens) {
+  LargeBatchMixedSequenceLens();
+}
+
+TEST(Scan, LargeBatchMixedSequenceLensOuterScopeAccess) {
+  RunOptions options{};
+  options.include_outer_scope_add = true;
+
+  LargeBatchMixedSequenceLens(options);
+}
+
 TEST(Scan, ShortSequenceTwoInBatchOneLoopStateVarReverseFirstInput) {
   const int64_t batch_size = 2;
   const int64_t sequence_len = 2;
@@ -691,7 +745,7 @@ TEST(Scan, MixedTypeInputs) {
 
 // create a subgraph that will have unknown dimensions in both the loop state variable and output
 // after shape inferencing.
-TEST(Scan, UnknownDimInSubgraphOutput) {
+static void UnknownDimInSubgraphOutput(int64_t batch_size) {
   Model model("ScanBody");
   auto& graph = model.MainGraph();
 
@@ -722,7 +776,7 @@ TEST(Scan, UnknownDimInSubgraphOutput) {
   // Construct and run scan test
   ScanOpTester test;
 
-  int64_t batch_size = 1, sequence_len = 3, input_size = 1;
+  int64_t sequence_len = 3, input_size = 1;
   std::vector<int64_t> seq_shape{batch_size, sequence_len, input_size};
   std::vector<int64_t> state_shape{batch_size, input_size};
 
@@ -736,14 +790,33 @@ TEST(Scan, UnknownDimInSubgraphOutput) {
   // Note that we cross the values over in the subgraph, so the symbolic dimension in
   // initial_state_1 affects scan_out_1, and the symbolic dimension in scan_input_1 affects state_out_1.
   test.AddShapeToTensorData(true, 1);  // add shape and symbolic dim in dim 1 for initial_state_1
-  test.AddInput<float>("initial_state_1", state_shape, {0.0});
+  // each batch entry starts at b * 10 so we can tell them apart
+  std::vector<float> initial_state, scan_input, final_state, scan_output;
+  for (int64_t b = 0; b < batch_size; ++b) {
+    float start = b * 10.f;
+    initial_state.push_back(start);
+    scan_input.insert(scan_input.end(), {start + 1.f, start + 2.f, start + 3.f});
+    final_state.push_back(start + 3.f);
+    scan_output.insert(scan_output.end(), {start, start + 1.f, start + 2.f});
+  }
+
+  test.AddInput<float>("initial_state_1", state_shape, initial_state);
   test.AddShapeToTensorData(true, 2);  // add shape and symbolic dim in dim 2 for scan_input_1
-  test.AddInput<float>("scan_input_1", seq_shape, {1.0, 2.0, 3.0});
+  test.AddInput<float>("scan_input_1", seq_shape, scan_input);
 
-  test.AddOutput<float>("final_state_1", state_shape, {3.0});
-  test.AddOutput<float>("scan_output_1", seq_shape, {0.0, 1.0, 2.0});
+  test.AddOutput<float>("final_state_1", state_shape, final_state);
+  test.AddOutput<float>("scan_output_1", seq_shape, scan_output);
 
   test.Run();
 }
+
+TEST(Scan, UnknownDimInSubgraphOutput) {
+  UnknownDimInSubgraphOutput(1);
+}
+
+// the first batch entry is needed to discover the output shape before the remaining entries can be processed
+TEST(Scan, UnknownDimInSubgraphOutputLargeBatch) {
+  UnknownDimInSubgraphOutput(8);
+}
 }  // namespace test
 }  // namespace onnxruntime
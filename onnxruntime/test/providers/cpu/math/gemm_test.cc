@@ -66,6 +66,32 @@ TEST(MathOpTest, GemmTrans) {
   test.Run();
 }
 
+TEST(MathOpTest, GemmTransInitializerB) {
+  // B is a constant initializer, so it is packed when the kernel is created
+  OpTester test("Gemm");
+
+  test.AddAttribute("transA", (int64_t)1);
+  test.AddAttribute("transB", (int64_t)1);
+  test.AddAttribute("alpha", 1.0f);
+  test.AddAttribute("beta", 1.0f);
+
+  test.AddInput<float>("A", {4, 2},
+                       {1.0f, -1.0f,
+                        2.0f, -2.0f,
+                        3.0f, -3.0f,
+                        4.0f, -4.0f});
+  test.AddInput<float>("B", {3, 4},
+                       {1.0f, 1.0f, 1.0f, 1.0f,
+                        2.0f, 2.0f, 2.0f, 2.0f,
+                        1.0f, 0.0f, 1.0f, 0.0f},
+                       true);
+  test.AddInput<float>("C", {3}, std::vector<float>(3, 1.0f));
+  test.AddOutput<float>("Y", {2, 3},
+                        {11.0f, 21.0f, 5.0f,
+                         -9.0f, -19.0f, -3.0f});
+  test.Run();
+}
+
 TEST(MathOpTest, GemmAlphaBeta) {
   OpTester test("Gemm");
 
@@ -59,16 +59,21 @@ TEST(MathOpTest, MatMul) {
        {1, 3, 4},
        {2, 2, 4},
        {20, 23, 26, 29, 56, 68, 80, 92, 92, 113, 134, 155, 128, 158, 188, 218}},
+      {"test 3D batch",
+       {2, 2, 2},
+       {2, 2, 2},
+       {2, 2, 2},
+       {2, 3, 6, 11, 46, 55, 66, 79}},
   };
 
   for (auto t : testcases) {
     OpTester test("MatMul");
 
-    int64_t size0 = TensorShape::ReinterpretBaseType(t.input0_dims).SizeHelper(0, t.input0_dims.size());
+    int64_t size0 = TensorShape(t.input0_dims).Size();
     std::vector<float> input0_vals(vals.cbegin(), vals.cbegin() + size0);
     test.AddInput<float>("A", t.input0_dims, input0_vals);
 
-    int64_t size1 = TensorShape::ReinterpretBaseType(t.input1_dims).SizeHelper(0, t.input1_dims.size());
+    int64_t size1 = TensorShape(t.input1_dims).Size();
     std::vector<float> input1_vals(vals.cbegin(), vals.cbegin() + size1);
     test.AddInput<float>("B", t.input1_dims, input1_vals);
 
@@ -77,5 +82,26 @@ TEST(MathOpTest, MatMul) {
   }
 }
 
+TEST(MathOpTest, MatMulInitializerB) {
+  // B is a constant initializer, so it is packed when the kernel is created
+  OpTester test("MatMul");
+
+  test.AddInput<float>("A", {2, 2, 3}, {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f, 11.0f});
+  test.AddInput<float>("B", {3, 4}, {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f, 11.0f}, true);
+  test.AddOutput<float>("Y", {2, 2, 4},
+                        {20, 23, 26, 29, 56, 68, 80, 92, 92, 113, 134, 155, 128, 158, 188, 218});
+  test.Run();
+}
+
+TEST(MathOpTest, MatMulZeroBatch) {
+  // the broadcast batch dimension is zero, so there are no matrices to multiply
+  OpTester test("MatMul");
+
+  test.AddInput<float>("A", {0, 2, 3}, {});
+  test.AddInput<float>("B", {0, 3, 4}, {});
+  test.AddOutput<float>("Y", {0, 2, 4}, {});
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kCudaExecutionProvider});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,317 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(MLOpTest, LinearClassifierMulticlass) {
+  OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> coefficients = {-0.22562418f, 0.34188559f, 0.68346153f, -0.68051993f, -0.1975279f, 0.03748541f};
+  std::vector<int64_t> classes = {1, 2, 3};
+  int64_t multi_class = 0;
+  std::vector<float> X = {1.f, 0.f, 3.f, 44.f, 23.f, 11.3f};
+
+  //three estimates, for 3 points each, so 9 predictions
+  std::vector<float> predictions = {-4.14164229f, 1.1092185f, -0.06021539f, 10.45007543f, -27.46673545f, 1.19408663f, -5.24206713f, 8.45549693f, -3.98224414f};
+  std::vector<float> intercepts = {-3.91601811f, 0.42575697f, 0.13731251f};
+  std::vector<int64_t> predicted_class = {2, 1, 2};
+
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("classlabels_ints", classes);
+  test.AddAttribute("multi_class", multi_class);
+
+  test.AddInput<float>("X", {3, 2}, X);
+  test.AddOutput<int64_t>("Y", {3}, predicted_class);
+  test.AddOutput<float>("Z", {3, 3}, predictions);
+
+  test.Run();
+}
+
+TEST(MLOpTest, LinearClassifierMulticlassProb) {
+  OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> coefficients = {-0.22562418f, 0.34188559f, 0.68346153f, -0.68051993f, -0.1975279f, 0.03748541f};
+  std::vector<int64_t> classes = {1, 2, 3};
+  std::vector<float> X = {1.f, 0.f, 3.f, 44.f, 23.f, 11.3f};
+
+  //three estimates, for 3 points each, so 9 predictions
+  std::vector<float> predictions = {-4.14164229f, 1.1092185f, -0.06021539f, 10.45007543f, -27.46673545f, 1.19408663f, -5.24206713f, 8.45549693f, -3.98224414f};
+  std::vector<float> intercepts = {-3.91601811f, 0.42575697f, 0.13731251f};
+  std::vector<int64_t> predicted_class = {2, 1, 2};
+
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("classlabels_ints", classes);
+
+  test.AddInput<float>("X", {3, 2}, X);
+  test.AddOutput<int64_t>("Y", {3}, predicted_class);
+  test.AddOutput<float>("Z", {3, 3}, predictions);
+  test.SetOutputAbsErr("Z", 0.00001f);
+  test.Run();
+}
+
+TEST(MLOpTest, LinearClassifierMulticlassProbSigmoid) {
+  OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> coefficients = {-0.22562418f, 0.34188559f, 0.68346153f, -0.68051993f, -0.1975279f, 0.03748541f};
+  std::vector<int64_t> classes = {1, 2, 3};
+  std::vector<float> X = {1.f, 0.f, 3.f, 44.f, 23.f, 11.3f};
+
+  //three estimates, for 3 points each, so 9 predictions
+  std::vector<float> predictions = {0.015647972f, 0.751983387f, 0.484950699f, 0.999971055f, 1.17855E-12f, 0.767471158f, 0.005261482f, 0.999787317f, 0.018302525f};
+  std::vector<float> intercepts = {-3.91601811f, 0.42575697f, 0.13731251f};
+  std::vector<int64_t> predicted_class = {2, 1, 2};
+
+  std::string trans("LOGISTIC");
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("classlabels_ints", classes);
+  test.AddAttribute("post_transform", trans);
+
+  test.AddInput<float>("X", {3, 2}, X);
+  test.AddOutput<int64_t>("Y", {3}, predicted_class);
+  test.AddOutput<float>("Z", {3, 3}, predictions);
+  test.SetOutputAbsErr("Z", 0.0001f);
+  test.Run();
+}
+
+TEST(MLOpTest, LinearClassifierBinary) {
+  OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> coefficients = {0.00085401f, -0.00314063f};
+  std::vector<float> X = {1.f, 0.f, 3.f, 44.f, 23.f, 11.3f};
+  std::vector<float> intercepts = {0.03930598f};
+  std::vector<int64_t> predicted_class = {1, 0, 1};
+  std::vector<float> scores = {0.0401599929f, -0.0963197052f, 0.0234590918f};
+
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("intercepts", intercepts);
+
+  test.AddInput<float>("X", {3, 2}, X);
+  test.AddOutput<int64_t>("Y", {3}, predicted_class);
+  test.AddOutput<float>("Z", {3, 1}, scores);
+  test.Run();
+}
+
+TEST(MLOpTest, LinearClassifierBinaryWithLabels) {
+  OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> coefficients = {0.00085401f, -0.00314063f};
+  std::vector<float> X = {1.f, 0.f, 3.f, 44.f, 23.f, 11.3f};
+  std::vector<float> intercepts = {0.03930598f};
+  std::vector<std::string> labels = {"not_so_good", "pretty_good"};
+  std::vector<std::string> predicted_class = {"pretty_good", "not_so_good", "pretty_good"};
+  std::vector<float> scores = {0.959840000f, 0.0401599929f, 1.09631968f, -0.0963197052f, 0.976540923f, 0.0234590918f};
+
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("classlabels_strings", labels);
+
+  test.AddInput<float>("X", {3, 2}, X);
+  test.AddOutput<std::string>("Y", {3}, predicted_class);
+  test.AddOutput<float>("Z", {3, 2}, scores);
+  test.Run();
+}
+
+TEST(MLOpTest, LinearClassifierMulticlassInt64Input) {
+  OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> coefficients = {-0.22562418f, 0.34188559f, 0.68346153f, -0.68051993f, -0.1975279f, 0.03748541f};
+  std::vector<int64_t> classes = {1, 2, 3};
+  int64_t multi_class = 0;
+  std::vector<int64_t> X = {1, 0, 3, 44, 23, 11};
+
+  //three estimates, for 3 points each, so 9 predictions
+  std::vector<float> predictions = {-4.14164229f, 1.1092185f, -0.06021539f, 10.45007543f, -27.46673545f, 1.19408663f, -5.3446321487426758f, 8.6596536636352539f, -3.9934897422790527};
+  std::vector<float> intercepts = {-3.91601811f, 0.42575697f, 0.13731251f};
+  std::vector<int64_t> predicted_class = {2, 1, 2};
+
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("classlabels_ints", classes);
+  test.AddAttribute("multi_class", multi_class);
+
+  test.AddInput<int64_t>("X", {3, 2}, X);
+  test.AddOutput<int64_t>("Y", {3}, predicted_class);
+  test.AddOutput<float>("Z", {3, 3}, predictions);
+
+  test.Run();
+}
+
+TEST(MLOpTest, LinearClassifierMulticlassSoftmax) {
+  OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> coefficients = {-0.22562418f, 0.34188559f, 0.68346153f, -0.68051993f, -0.1975279f, 0.03748541f};
+  std::vector<int64_t> classes = {1, 2, 3};
+  std::vector<float> X = {1.f, 0.f, 3.f, 44.f, 23.f, 11.3f};
+
+  std::vector<float> predictions = {0.00398469397f, 0.760002182f, 0.236013124f, 0.999904471f, 3.41111896e-17f, 9.55286846e-05f, 1.12517821e-06f, 0.999994909f, 3.9660255e-06f};
+  std::vector<float> intercepts = {-3.91601811f, 0.42575697f, 0.13731251f};
+  std::vector<int64_t> predicted_class = {2, 1, 2};
+
+  std::string trans("SOFTMAX");
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("classlabels_ints", classes);
+  test.AddAttribute("post_transform", trans);
+
+  test.AddInput<float>("X", {3, 2}, X);
+  test.AddOutput<int64_t>("Y", {3}, predicted_class);
+  test.AddOutput<float>("Z", {3, 3}, predictions);
+  test.SetOutputAbsErr("Z", 0.00001f);
+  test.Run();
+}
+
+TEST(MLOpTest, LinearClassifierMulticlassSoftmaxZero) {
+  OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
+
+  // every row has one score of exactly zero, which SOFTMAX_ZERO leaves out of the sum
+  std::vector<float> coefficients = {1.f, 0.f, 0.f, 1.f, 1.f, 1.f};
+  std::vector<float> intercepts = {0.f, 0.f, 0.f};
+  std::vector<std::string> classes = {"a", "b", "c"};
+  std::vector<float> X = {0.f, 2.f, 1.f, -1.f};
+
+  std::vector<float> predictions = {0.f, 0.5f, 0.5f, 0.880797078f, 0.119202922f, 0.f};
+  std::vector<std::string> predicted_class = {"b", "a"};
+
+  std::string trans("SOFTMAX_ZERO");
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("classlabels_strings", classes);
+  test.AddAttribute("post_transform", trans);
+
+  test.AddInput<float>("X", {2, 2}, X);
+  test.AddOutput<std::string>("Y", {2}, predicted_class);
+  test.AddOutput<float>("Z", {2, 3}, predictions);
+  test.SetOutputAbsErr("Z", 0.00001f);
+  test.Run();
+}
+
+TEST(MLOpTest, LinearClassifierMulticlassDoubleInput) {
+  OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> coefficients = {-0.22562418f, 0.34188559f, 0.68346153f, -0.68051993f, -0.1975279f, 0.03748541f};
+  std::vector<int64_t> classes = {1, 2, 3};
+  std::vector<double> X = {1., 0., 3., 44., 23., 11.3};
+
+  std::vector<float> predictions = {-4.14164229f, 1.1092185f, -0.06021539f, 10.45007543f, -27.46673545f, 1.19408663f, -5.24206713f, 8.45549693f, -3.98224414f};
+  std::vector<float> intercepts = {-3.91601811f, 0.42575697f, 0.13731251f};
+  std::vector<int64_t> predicted_class = {2, 1, 2};
+
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("classlabels_ints", classes);
+
+  test.AddInput<double>("X", {3, 2}, X);
+  test.AddOutput<int64_t>("Y", {3}, predicted_class);
+  test.AddOutput<float>("Z", {3, 3}, predictions);
+  test.Run();
+}
+
+TEST(MLOpTest, LinearClassifierMulticlassManyRows) {
+  OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
+
+  // enough rows for the labels and scores to be split across several threads
+  const int64_t N = 1000;
+  std::vector<float> coefficients = {1.f, 0.f, 0.f, 1.f, -1.f, -1.f};
+  std::vector<float> intercepts = {0.f, 0.f, 0.f};
+  std::vector<int64_t> classes = {10, 20, 30};
+
+  std::vector<float> X;
+  std::vector<float> predictions;
+  std::vector<int64_t> predicted_class;
+  for (int64_t i = 0; i < N; i++) {
+    const float x0 = static_cast<float>(i % 7) - 3.f;
+    const float x1 = static_cast<float>(i % 5) - 2.f;
+    X.push_back(x0);
+    X.push_back(x1);
+    const float scores[] = {x0, x1, -x0 - x1};
+    int64_t maxclass = 0;
+    for (int64_t j = 1; j < 3; j++) {
+      if (scores[j] > scores[maxclass])
+        maxclass = j;
+    }
+    predictions.insert(predictions.end(), scores, scores + 3);
+    predicted_class.push_back(classes[maxclass]);
+  }
+
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("classlabels_ints", classes);
+
+  test.AddInput<float>("X", {N, 2}, X);
+  test.AddOutput<int64_t>("Y", {N}, predicted_class);
+  test.AddOutput<float>("Z", {N, 3}, predictions);
+  test.Run();
+}
+
+TEST(MLOpTest, LinearClassifierBinaryWithIntLabels) {
+  OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> coefficients = {0.00085401f, -0.00314063f};
+  std::vector<float> X = {1.f, 0.f, 3.f, 44.f, 23.f, 11.3f};
+  std::vector<float> intercepts = {0.03930598f};
+  std::vector<int64_t> labels = {-1, 1};
+  std::vector<int64_t> predicted_class = {1, -1, 1};
+  std::vector<float> scores = {0.959840000f, 0.0401599929f, 1.09631968f, -0.0963197052f, 0.976540923f, 0.0234590918f};
+
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("classlabels_ints", labels);
+
+  test.AddInput<float>("X", {3, 2}, X);
+  test.AddOutput<int64_t>("Y", {3}, predicted_class);
+  test.AddOutput<float>("Z", {3, 2}, scores);
+  test.Run();
+}
+
+TEST(MLOpTest, LinearClassifierBinaryWithLabelsProbit) {
+  OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
+
+  // scores of 0.4, 0.5 and 0.6, so both the score and its complement are valid probabilities
+  std::vector<float> coefficients = {0.1f, 0.2f};
+  std::vector<float> X = {1.f, 0.f, 0.f, 1.f, 1.f, 1.f};
+  std::vector<float> intercepts = {0.3f};
+  std::vector<std::string> labels = {"no", "yes"};
+  std::vector<std::string> predicted_class = {"yes", "yes", "yes"};
+  std::vector<float> scores = {0.253352850f, -0.253352850f, 0.f, 0.f, -0.253352850f, 0.253352850f};
+
+  std::string trans("PROBIT");
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("classlabels_strings", labels);
+  test.AddAttribute("post_transform", trans);
+
+  test.AddInput<float>("X", {3, 2}, X);
+  test.AddOutput<std::string>("Y", {3}, predicted_class);
+  test.AddOutput<float>("Z", {3, 2}, scores);
+  test.SetOutputAbsErr("Z", 0.0001f);
+  test.Run();
+}
+
+TEST(MLOpTest, LinearClassifierTooManyFeatures) {
+  OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
+
+  // the coefficients only cover two features for each class
+  std::vector<float> coefficients = {-0.22562418f, 0.34188559f, 0.68346153f, -0.68051993f, -0.1975279f, 0.03748541f};
+  std::vector<float> intercepts = {-3.91601811f, 0.42575697f, 0.13731251f};
+  std::vector<int64_t> classes = {1, 2, 3};
+  std::vector<float> X = {1.f, 0.f, 2.f, 3.f, 44.f, 5.f};
+
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("classlabels_ints", classes);
+
+  test.AddInput<float>("X", {2, 3}, X);
+  test.AddOutput<int64_t>("Y", {2}, {0, 0});
+  test.AddOutput<float>("Z", {2, 3}, {0.f, 0.f, 0.f, 0.f, 0.f, 0.f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "Input has more features than there are coefficients for each class.");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
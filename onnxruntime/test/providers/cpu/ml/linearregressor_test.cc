@@ -66,5 +66,21 @@ TEST(MLOpTest, LinearRegressorMultiTarget) {
   test.Run();
 }
 
+TEST(MLOpTest, LinearRegressorMultiTargetSoftmax) {
+  OpTester test("LinearRegressor", 1, onnxruntime::kMLDomain);
+  std::vector<float> coefficients = {1.00000000f, -2.49500920e-17f, -9.00000000f, -1.99600736e-16f};
+  std::vector<float> intercepts = {2.22044605e-16f, 41.0000000f};
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("coefficients", coefficients);
+  int64_t targets = 2;
+  test.AddAttribute("targets", targets);
+  test.AddAttribute("post_transform", std::string("SOFTMAX"));
+
+  // softmax of {1, 32}, {3, 14} and {23, -166}
+  test.AddInput<float>("X", {3, 2}, {1.f, 0.f, 3.f, 44.f, 23.f, 11.3f});
+  test.AddOutput<float>("Y", {3, 2}, {3.44247711e-14f, 1.0f, 1.67014218e-05f, 0.999983299f, 1.0f, 0.0f});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -115,5 +115,236 @@ TEST(MLOpTest, SVMClassifierSVCProbabilities) {
   test.Run();
 }
 
+// runs the multiclass SVC model of SVMClassifierMulticlassSVC with the given kernel on an input of type T
+template <typename T>
+static void RunMulticlassSVC(const std::string& kernel_type, const std::vector<float>& kernel_params,
+                             const std::vector<T>& X, const std::vector<int64_t>& predictions,
+                             const std::vector<float>& scores) {
+  OpTester test("SVMClassifier", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> dual_coefficients = {1.14360327f, 1.95968249f, -1.175683f, -1.92760275f, -1.32575698f, -1.32575698f, 0.66332785f, 0.66242913f, 0.53120854f, 0.53510444f, -1.06631298f, -1.06631298f, 0.66332785f, 0.66242913f, 0.53120854f, 0.53510444f, 1.f, -1.f};
+  std::vector<float> support_vectors = {0.f, 0.5f, 32.f, 2.f, 2.9f, -32.f, 1.f, 1.5f, 1.f, 3.f, 13.3f, -11.f, 12.f, 12.9f, -312.f, 43.f, 413.3f, -114.f};
+  std::vector<int64_t> classes = {0, 1, 2, 3};
+  std::vector<int64_t> vectors_per_class = {2, 2, 1, 1};
+  std::vector<float> rho = {0.5279583f, 0.32605162f, 0.32605162f, 0.06663721f, 0.06663721f, 0.f};
+
+  test.AddAttribute("kernel_type", kernel_type);
+  test.AddAttribute("coefficients", dual_coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("vectors_per_class", vectors_per_class);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", kernel_params);
+  test.AddAttribute("classlabels_ints", classes);
+
+  const int64_t N = static_cast<int64_t>(predictions.size());
+  test.AddInput<T>("X", {N, 3}, X);
+  test.AddOutput<int64_t>("Y", {N}, predictions);
+  test.AddOutput<float>("Z", {N, 6}, scores);
+
+  test.Run();
+}
+
+TEST(MLOpTest, SVMClassifierMulticlassSVCSigmoidKernel) {
+  std::vector<float> X = {1.f, 0.f, 0.4f, -1.f, 0.5f, 1.f, 0.5f, -1.f, 2.f, -2.f, 1.f, 0.3f, 0.1f, 0.2f, -0.1f};
+  std::vector<int64_t> predictions = {0, 3, 0, 3, 3};
+  std::vector<float> scores = {
+      0.469779993f, 1.49437306f, 0.371496423f, 0.997211728f, 0.0940764248f, -0.846970186f,
+      0.372757276f, 1.76396372f, -0.264843158f, 1.19947739f, -0.432302141f, -1.53030073f,
+      0.571458572f, 1.73110994f, 1.73110727f, 1.06613647f, 1.06613432f, -2.01098249e-06f,
+      0.35809416f, 1.43194455f, -0.866617409f, 0.980347441f, -0.868397457f, -1.73377323f,
+      0.489016605f, -0.0953598716f, -0.58959638f, -0.253798239f, -0.651315139f, -0.372795706f};
+
+  RunMulticlassSVC<float>("SIGMOID", {0.01f, 0.1f, 3.f}, X, predictions, scores);
+}
+
+TEST(MLOpTest, SVMClassifierMulticlassSVCDoubleInput) {
+  std::vector<double> X = {1., 0., 0.4, 3., 44., -3., 12., 12.9, -312., 23., 11.3, -222., 23., 11.3, -222., 23., 3311.3, -222., 23., 11.3, -222., 43., 413.3, -114.};
+  std::vector<int64_t> predictions = {1, 1, 2, 0, 0, 0, 0, 3};
+  std::vector<float> scores = {
+      -0.956958294f, 0.799815655f, 0.799815655f, 0.988598406f, 0.988598406f, 0,
+      -0.159782529f, 0.407864451f, 0.407864451f, 0.347750872f, 0.347750872f, 0,
+      0.527958274f, -0.999705434f, 0.326051623f, -0.999675810f, 0.0666372105f, 1.00000000f,
+      0.527958274f, 0.325695992f, 0.326051623f, 0.0663511604f, 0.0666372105f, 0.000268258271f,
+      0.527958274f, 0.325695992f, 0.326051623f, 0.0663511604f, 0.0666372105f, 0.000268258271f,
+      0.527958274f, 0.326051623f, 0.326051623f, 0.0666372105f, 0.0666372105f, 0,
+      0.527958274f, 0.325695992f, 0.326051623f, 0.0663511604f, 0.0666372105f, 0.000268258271f,
+      0.527958274f, 0.326051623f, -0.999705434f, 0.0666372105f, -0.999675810f, -1.00000000f};
+
+  RunMulticlassSVC<double>("RBF", {0.001f, 0.f, 3.f}, X, predictions, scores);
+}
+
+// the inputs of SVMClassifierMulticlassSVC rounded to integers, some of them still close to a support vector
+static const std::vector<int64_t> svc_int_predictions = {1, 1, 2, 0, 0, 0, 0, 3};
+static const std::vector<float> svc_int_scores = {
+    -0.961759904f, 0.799678562f, 0.799678562f, 0.991788727f, 0.991788727f, 0,
+    -0.159782601f, 0.407864448f, 0.407864448f, 0.347750893f, 0.347750893f, 0,
+    0.5279583f, -0.999692102f, 0.32605162f, -0.999665107f, 0.06663721f, 0.99999f,
+    0.5279583f, 0.325696348f, 0.32605162f, 0.0663514628f, 0.06663721f, 0.00026797684f,
+    0.5279583f, 0.325696348f, 0.32605162f, 0.0663514628f, 0.06663721f, 0.00026797684f,
+    0.5279583f, 0.32605162f, 0.32605162f, 0.06663721f, 0.06663721f, 0,
+    0.5279583f, 0.325696348f, 0.32605162f, 0.0663514628f, 0.06663721f, 0.00026797684f,
+    0.5279583f, 0.32605162f, -0.999586047f, 0.06663721f, -0.999579806f, -0.999910004f};
+
+TEST(MLOpTest, SVMClassifierMulticlassSVCInt64Input) {
+  std::vector<int64_t> X = {1, 0, 0, 3, 44, -3, 12, 13, -312, 23, 11, -222, 23, 11, -222, 23, 3311, -222, 23, 11, -222, 43, 413, -114};
+  RunMulticlassSVC<int64_t>("RBF", {0.001f, 0.f, 3.f}, X, svc_int_predictions, svc_int_scores);
+}
+
+TEST(MLOpTest, SVMClassifierMulticlassSVCInt32Input) {
+  std::vector<int32_t> X = {1, 0, 0, 3, 44, -3, 12, 13, -312, 23, 11, -222, 23, 11, -222, 23, 3311, -222, 23, 11, -222, 43, 413, -114};
+  RunMulticlassSVC<int32_t>("RBF", {0.001f, 0.f, 3.f}, X, svc_int_predictions, svc_int_scores);
+}
+
+TEST(MLOpTest, SVMClassifierMulticlassSVCManyRows) {
+  // more rows than the kernel values of one SGEMM batch can hold, so the input is processed in several batches
+  std::vector<float> X = {1.f, 0.0f, 0.4f, 3.0f, 44.0f, -3.f, 12.0f, 12.9f, -312.f, 23.0f, 11.3f, -222.f, 23.0f, 11.3f, -222.f, 23.0f, 3311.3f, -222.f, 23.0f, 11.3f, -222.f, 43.0f, 413.3f, -114.f};
+  std::vector<int64_t> predictions = {1, 1, 2, 0, 0, 0, 0, 3};
+  std::vector<float> scores = {
+      -0.956958294f, 0.799815655f, 0.799815655f, 0.988598406f, 0.988598406f, 0,
+      -0.159782529f, 0.407864451f, 0.407864451f, 0.347750872f, 0.347750872f, 0,
+      0.527958274f, -0.999705434f, 0.326051623f, -0.999675810f, 0.0666372105f, 1.00000000f,
+      0.527958274f, 0.325695992f, 0.326051623f, 0.0663511604f, 0.0666372105f, 0.000268258271f,
+      0.527958274f, 0.325695992f, 0.326051623f, 0.0663511604f, 0.0666372105f, 0.000268258271f,
+      0.527958274f, 0.326051623f, 0.326051623f, 0.0666372105f, 0.0666372105f, 0,
+      0.527958274f, 0.325695992f, 0.326051623f, 0.0663511604f, 0.0666372105f, 0.000268258271f,
+      0.527958274f, 0.326051623f, -0.999705434f, 0.0666372105f, -0.999675810f, -1.00000000f};
+
+  const int repeats = 25000;
+  std::vector<float> all_X;
+  std::vector<int64_t> all_predictions;
+  std::vector<float> all_scores;
+  for (int i = 0; i < repeats; i++) {
+    all_X.insert(all_X.end(), X.begin(), X.end());
+    all_predictions.insert(all_predictions.end(), predictions.begin(), predictions.end());
+    all_scores.insert(all_scores.end(), scores.begin(), scores.end());
+  }
+
+  RunMulticlassSVC<float>("RBF", {0.001f, 0.f, 3.f}, all_X, all_predictions, all_scores);
+}
+
+TEST(MLOpTest, SVMClassifierBinarySVC) {
+  OpTester test("SVMClassifier", 1, onnxruntime::kMLDomain);
+
+  // the score is x0 - x1 + 0.5, and Z holds 1 - score and score
+  std::vector<float> coefficients = {1.f, -1.f};
+  std::vector<float> support_vectors = {1.f, 0.f, 0.f, 1.f};
+  std::vector<int64_t> vectors_per_class = {1, 1};
+  std::vector<float> rho = {0.5f};
+  std::vector<float> kernel_params = {0.001f, 0.f, 3.f};  //gamma, coef0, degree
+  std::vector<std::string> classes = {"neg", "pos"};
+
+  // the label follows the sign of the score
+  std::vector<float> X = {1.f, 0.f, 0.f, 1.f, 2.f, 0.5f};
+  std::vector<std::string> predictions = {"pos", "neg", "pos"};
+  std::vector<float> scores = {-0.5f, 1.5f, 1.5f, -0.5f, -1.f, 2.f};
+
+  test.AddAttribute("kernel_type", std::string("LINEAR"));
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("vectors_per_class", vectors_per_class);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", kernel_params);
+  test.AddAttribute("classlabels_strings", classes);
+
+  test.AddInput<float>("X", {3, 2}, X);
+  test.AddOutput<std::string>("Y", {3}, predictions);
+  test.AddOutput<float>("Z", {3, 2}, scores);
+
+  test.Run();
+}
+
+TEST(MLOpTest, SVMClassifierBinarySVCInt64Labels) {
+  OpTester test("SVMClassifier", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> coefficients = {1.f, -1.f};
+  std::vector<float> support_vectors = {1.f, 0.f, 0.f, 1.f};
+  std::vector<int64_t> vectors_per_class = {1, 1};
+  std::vector<float> rho = {0.5f};
+  std::vector<float> kernel_params = {0.001f, 0.f, 3.f};  //gamma, coef0, degree
+  std::vector<int64_t> classes = {7, 9};
+
+  std::vector<float> X = {1.f, 0.f, 0.f, 1.f, 2.f, 0.5f};
+  std::vector<int64_t> predictions = {9, 7, 9};
+  std::vector<float> scores = {-0.5f, 1.5f, 1.5f, -0.5f, -1.f, 2.f};
+
+  test.AddAttribute("kernel_type", std::string("LINEAR"));
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("vectors_per_class", vectors_per_class);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", kernel_params);
+  test.AddAttribute("classlabels_ints", classes);
+
+  test.AddInput<float>("X", {3, 2}, X);
+  test.AddOutput<int64_t>("Y", {3}, predictions);
+  test.AddOutput<float>("Z", {3, 2}, scores);
+
+  test.Run();
+}
+
+TEST(MLOpTest, SVMClassifierBinarySVCRBFLargeInputs) {
+  OpTester test("SVMClassifier", 1, onnxruntime::kMLDomain);
+
+  // raw features far from the origin and close to the support vectors, where expanding the squared distance as
+  // ||x||^2 + ||sv||^2 - 2 x.sv cancels to zero in single precision. the squared distance to the other support
+  // vector is 0.375, so the score is +/-(1 - exp(-0.375)).
+  std::vector<float> coefficients = {1.f, -1.f};
+  std::vector<float> support_vectors = {1000.5f, 2000.25f, 1499.75f, 1000.f, 2000.f, 1500.f};
+  std::vector<int64_t> vectors_per_class = {1, 1};
+  std::vector<float> rho = {0.f};
+  std::vector<float> kernel_params = {1.f, 0.f, 3.f};  //gamma, coef0, degree
+  std::vector<std::string> classes = {"neg", "pos"};
+
+  std::vector<float> X = {1000.f, 2000.f, 1500.f, 1000.5f, 2000.25f, 1499.75f};
+  std::vector<std::string> predictions = {"neg", "pos"};
+  std::vector<float> scores = {1.31271072f, -0.31271072f, 0.68728928f, 0.31271072f};
+
+  test.AddAttribute("kernel_type", std::string("RBF"));
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("vectors_per_class", vectors_per_class);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", kernel_params);
+  test.AddAttribute("classlabels_strings", classes);
+
+  test.AddInput<float>("X", {2, 3}, X);
+  test.AddOutput<std::string>("Y", {2}, predictions);
+  test.AddOutput<float>("Z", {2, 2}, scores);
+
+  test.Run();
+}
+
+TEST(MLOpTest, SVMClassifierBinarySVCProbit) {
+  OpTester test("SVMClassifier", 1, onnxruntime::kMLDomain);
+
+  // scores of 0.6, 0.5 and 0.3, so both the score and its complement are valid probabilities
+  std::vector<float> coefficients = {1.f, -1.f};
+  std::vector<float> support_vectors = {1.f, 0.f, 0.f, 1.f};
+  std::vector<int64_t> vectors_per_class = {1, 1};
+  std::vector<float> rho = {0.5f};
+  std::vector<float> kernel_params = {0.001f, 0.f, 3.f};  //gamma, coef0, degree
+  std::vector<std::string> classes = {"neg", "pos"};
+
+  std::vector<float> X = {0.1f, 0.f, 0.f, 0.f, 0.f, 0.2f};
+  std::vector<std::string> predictions = {"pos", "pos", "pos"};
+  std::vector<float> scores = {-0.253352850f, 0.253352850f, 0.f, 0.f, 0.524445433f, -0.524445433f};
+
+  test.AddAttribute("kernel_type", std::string("LINEAR"));
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("vectors_per_class", vectors_per_class);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", kernel_params);
+  test.AddAttribute("classlabels_strings", classes);
+  test.AddAttribute("post_transform", std::string("PROBIT"));
+
+  test.AddInput<float>("X", {3, 2}, X);
+  test.AddOutput<std::string>("Y", {3}, predictions);
+  test.AddOutput<float>("Z", {3, 2}, scores);
+  test.SetOutputAbsErr("Z", 0.0001f);
+
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
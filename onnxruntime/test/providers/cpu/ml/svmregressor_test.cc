@@ -104,5 +104,89 @@ TEST(MLOpTest, SVMRegressorLinear) {
   test.Run();
 }
 
+TEST(MLOpTest, SVMRegressorSVCSigmoidKernel) {
+  OpTester test("SVMRegressor", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> dual_coefficients = {-1.54236563f, 0.53485162f, -1.5170623f, 0.69771864f, 1.82685767f};
+  std::vector<float> support_vectors = {0.f, 0.5f, 32.f, 1.f, 1.5f, 1.f, 2.f, 2.9f, -32.f, 12.f, 12.9f, -312.f, 43.f, 413.3f, -114.f};
+  std::vector<float> rho = {1.96292297f};
+  std::vector<float> kernel_params = {0.01f, 0.1f, 3.f};  //gamma, coef0, degree
+
+  std::vector<float> X = {1.f, 0.f, 0.4f, -1.f, 0.5f, 1.f, 0.5f, -1.f, 2.f, -2.f, 1.f, 0.3f, 0.1f, 0.2f, -0.1f};
+  std::vector<float> predictions = {1.28561112f, 2.0229605f, -0.699222378f, 3.02303819f, 3.44659553f};
+
+  test.AddAttribute("kernel_type", std::string("SIGMOID"));
+  test.AddAttribute("coefficients", dual_coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", kernel_params);
+  test.AddAttribute("n_supports", static_cast<int64_t>(5));
+
+  test.AddInput<float>("X", {5, 3}, X);
+  test.AddOutput<float>("Y", {5, 1}, predictions);
+
+  test.Run();
+}
+
+TEST(MLOpTest, SVMRegressorSVCRBFLargeInputs) {
+  OpTester test("SVMRegressor", 1, onnxruntime::kMLDomain);
+
+  // raw features far from the origin and close to the support vector, with squared distances of 0.375, 0 and 1.
+  // expanding the squared distance as ||x||^2 + ||sv||^2 - 2 x.sv cancels to zero in single precision.
+  std::vector<float> dual_coefficients = {1.f};
+  std::vector<float> support_vectors = {1000.5f, 2000.25f, 1499.75f};
+  std::vector<float> rho = {0.f};
+  std::vector<float> kernel_params = {1.f, 0.f, 3.f};  //gamma, coef0, degree
+
+  std::vector<float> X = {1000.f, 2000.f, 1500.f, 1000.5f, 2000.25f, 1499.75f, 1000.5f, 2000.25f, 1500.75f};
+  std::vector<float> predictions = {0.68728928f, 1.f, 0.36787944f};
+
+  test.AddAttribute("kernel_type", std::string("RBF"));
+  test.AddAttribute("coefficients", dual_coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", kernel_params);
+  test.AddAttribute("n_supports", static_cast<int64_t>(1));
+
+  test.AddInput<float>("X", {3, 3}, X);
+  test.AddOutput<float>("Y", {3, 1}, predictions);
+
+  test.Run();
+}
+
+TEST(MLOpTest, SVMRegressorSVCManyRows) {
+  OpTester test("SVMRegressor", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> dual_coefficients = {-1.54236563f, 0.53485162f, -1.5170623f, 0.69771864f, 1.82685767f};
+  std::vector<float> support_vectors = {0.f, 0.5f, 32.f, 1.f, 1.5f, 1.f, 2.f, 2.9f, -32.f, 12.f, 12.9f, -312.f, 43.f, 413.3f, -114.f};
+  std::vector<float> rho = {1.96292297f};
+  std::vector<float> kernel_params = {0.001f, 0.f, 3.f};  //gamma, coef0, degree
+
+  // the inputs of SVMRegressorSVC, repeated for more rows than the kernel values of one SGEMM batch can hold
+  std::vector<float> X = {1.f, 0.0f, 0.4f, 3.0f, 44.0f, -3.f, 12.0f, 12.9f, -312.f, 23.0f, 11.3f, -222.f, 23.0f, 11.3f, -222.f, 23.0f, 3311.3f, -222.f, 23.0f, 11.3f, -222.f, 43.0f, 413.3f, -114.f};
+  std::vector<float> predictions = {1.40283655f, 1.86065906f, 2.66064161f, 1.96311014f, 1.96311014f, 1.96292297f, 1.96311014f, 3.78978065f};
+
+  const int repeats = 30000;
+  std::vector<float> all_X;
+  std::vector<float> all_predictions;
+  for (int i = 0; i < repeats; i++) {
+    all_X.insert(all_X.end(), X.begin(), X.end());
+    all_predictions.insert(all_predictions.end(), predictions.begin(), predictions.end());
+  }
+  const int64_t N = static_cast<int64_t>(all_predictions.size());
+
+  test.AddAttribute("kernel_type", std::string("RBF"));
+  test.AddAttribute("coefficients", dual_coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", kernel_params);
+  test.AddAttribute("n_supports", static_cast<int64_t>(5));
+
+  test.AddInput<float>("X", {N, 3}, all_X);
+  test.AddOutput<float>("Y", {N, 1}, all_predictions);
+
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <cmath>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -151,5 +154,137 @@ TEST(MLOpTest, TreeEnsembleClassifierBinary) {
   test.Run();
 }
 
+// Evaluates a three class ensemble of small trees over enough rows to be split into blocks. Tree t compares
+// with branch_modes[t % branch_modes.size()], so a single mode exercises the traversal specialized for it and
+// several modes the generic one. The expected outputs are computed by walking the trees directly.
+static void RunTreeEnsembleClassifierRowsTest(const std::vector<std::string>& branch_modes,
+                                              const std::string& post_transform) {
+  const int64_t num_trees = 24, num_rows = 300, num_features = 3, num_classes = 3;
+
+  // every tree is node 0 ? (node 1 ? leaf 3 : leaf 4) : leaf 2
+  std::vector<int64_t> lefts, rights, treeids, nodeids, featureids;
+  std::vector<float> thresholds;
+  std::vector<std::string> modes;
+  std::vector<int64_t> class_treeids, class_nodeids, class_ids;
+  std::vector<float> class_weights;
+  for (int64_t t = 0; t < num_trees; ++t) {
+    const std::string& mode = branch_modes[t % branch_modes.size()];
+    treeids.insert(treeids.end(), {t, t, t, t, t});
+    nodeids.insert(nodeids.end(), {0, 1, 2, 3, 4});
+    lefts.insert(lefts.end(), {1, 3, -1, -1, -1});
+    rights.insert(rights.end(), {2, 4, -1, -1, -1});
+    featureids.insert(featureids.end(), {t % num_features, (t + 1) % num_features, -2, -2, -2});
+    thresholds.insert(thresholds.end(),
+                      {static_cast<float>(t % 9 - 4), static_cast<float>(t % 5 - 2), -2.f, -2.f, -2.f});
+    modes.insert(modes.end(), {mode, mode, "LEAF", "LEAF", "LEAF"});
+    for (int64_t leaf = 2; leaf <= 4; ++leaf) {
+      for (int64_t c = 0; c < num_classes; ++c) {
+        class_treeids.push_back(t);
+        class_nodeids.push_back(leaf);
+        class_ids.push_back(c);
+        class_weights.push_back(0.25f * static_cast<float>((t + leaf * (c + 1)) % 7));
+      }
+    }
+  }
+
+  auto take_true = [](const std::string& mode, float val, float threshold) {
+    if (mode == "BRANCH_LEQ") return val <= threshold;
+    if (mode == "BRANCH_LT") return val < threshold;
+    if (mode == "BRANCH_GTE") return val >= threshold;
+    if (mode == "BRANCH_GT") return val > threshold;
+    if (mode == "BRANCH_EQ") return val == threshold;
+    return val != threshold;
+  };
+
+  // integer features, so that the thresholds are hit exactly by some rows
+  std::vector<float> X(num_rows * num_features);
+  std::vector<int64_t> results(num_rows);
+  std::vector<float> scores(num_rows * num_classes, 0.f);
+  for (int64_t i = 0; i < num_rows; ++i) {
+    float* x = X.data() + i * num_features;
+    for (int64_t f = 0; f < num_features; ++f) {
+      x[f] = static_cast<float>((i * 7 + f * 3) % 11 - 5);
+    }
+
+    float* row_scores = scores.data() + i * num_classes;
+    for (int64_t t = 0; t < num_trees; ++t) {
+      const std::string& mode = branch_modes[t % branch_modes.size()];
+      int64_t leaf = 2;
+      if (take_true(mode, x[featureids[t * 5]], thresholds[t * 5])) {
+        leaf = take_true(mode, x[featureids[t * 5 + 1]], thresholds[t * 5 + 1]) ? 3 : 4;
+      }
+      for (int64_t c = 0; c < num_classes; ++c) {
+        row_scores[c] += class_weights[(t * 3 + leaf - 2) * num_classes + c];
+      }
+    }
+
+    // the first class with the highest score wins, before the post transform
+    results[i] = 0;
+    for (int64_t c = 1; c < num_classes; ++c) {
+      if (row_scores[c] > row_scores[results[i]]) {
+        results[i] = c;
+      }
+    }
+
+    if (post_transform == "LOGISTIC") {
+      for (int64_t c = 0; c < num_classes; ++c) {
+        row_scores[c] = 1.f / (1.f + std::exp(-row_scores[c]));
+      }
+    } else if (post_transform == "SOFTMAX") {
+      const float max_score = *std::max_element(row_scores, row_scores + num_classes);
+      float sum = 0.f;
+      for (int64_t c = 0; c < num_classes; ++c) {
+        row_scores[c] = std::exp(row_scores[c] - max_score);
+        sum += row_scores[c];
+      }
+      for (int64_t c = 0; c < num_classes; ++c) {
+        row_scores[c] /= sum;
+      }
+    }
+  }
+
+  OpTester test("TreeEnsembleClassifier", 1, onnxruntime::kMLDomain);
+  test.AddAttribute("nodes_truenodeids", lefts);
+  test.AddAttribute("nodes_falsenodeids", rights);
+  test.AddAttribute("nodes_treeids", treeids);
+  test.AddAttribute("nodes_nodeids", nodeids);
+  test.AddAttribute("nodes_featureids", featureids);
+  test.AddAttribute("nodes_values", thresholds);
+  test.AddAttribute("nodes_modes", modes);
+  test.AddAttribute("class_treeids", class_treeids);
+  test.AddAttribute("class_nodeids", class_nodeids);
+  test.AddAttribute("class_ids", class_ids);
+  test.AddAttribute("class_weights", class_weights);
+  test.AddAttribute("classlabels_int64s", std::vector<int64_t>{0, 1, 2});
+  test.AddAttribute("post_transform", post_transform);
+
+  test.AddInput<float>("X", {num_rows, num_features}, X);
+  test.AddOutput<int64_t>("Y", {num_rows}, results);
+  test.AddOutput<float>("Z", {num_rows, num_classes}, scores);
+  test.Run();
+}
+
+TEST(MLOpTest, TreeEnsembleClassifierBranchModes) {
+  for (const char* mode : {"BRANCH_LEQ", "BRANCH_LT", "BRANCH_GTE", "BRANCH_GT", "BRANCH_EQ", "BRANCH_NEQ"}) {
+    SCOPED_TRACE(mode);
+    RunTreeEnsembleClassifierRowsTest({mode}, "NONE");
+  }
+}
+
+TEST(MLOpTest, TreeEnsembleClassifierMixedBranchModes) {
+  RunTreeEnsembleClassifierRowsTest({"BRANCH_LEQ", "BRANCH_LT", "BRANCH_GTE", "BRANCH_GT", "BRANCH_EQ", "BRANCH_NEQ"},
+                                    "NONE");
+}
+
+TEST(MLOpTest, TreeEnsembleClassifierSoftmax) {
+  RunTreeEnsembleClassifierRowsTest({"BRANCH_LEQ"}, "SOFTMAX");
+  RunTreeEnsembleClassifierRowsTest({"BRANCH_GT", "BRANCH_EQ"}, "SOFTMAX");
+}
+
+TEST(MLOpTest, TreeEnsembleClassifierLogistic) {
+  RunTreeEnsembleClassifierRowsTest({"BRANCH_LEQ"}, "LOGISTIC");
+  RunTreeEnsembleClassifierRowsTest({"BRANCH_LT", "BRANCH_NEQ"}, "LOGISTIC");
+}
+
 }  // namespace test
 }  // namespace onnxruntime
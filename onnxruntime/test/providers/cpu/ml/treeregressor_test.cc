@@ -50,5 +50,58 @@ TEST(MLOpTest, TreeRegressorMultiTarget) {
   test.Run();
 }
 
+TEST(MLOpTest, TreeRegressorManyTreesAndRows) {
+  // stumps evaluated over enough rows and trees to be split into blocks
+  const int64_t num_trees = 40, num_rows = 200, num_features = 3;
+  std::vector<int64_t> lefts, rights, treeids, nodeids, featureids;
+  std::vector<float> thresholds;
+  std::vector<std::string> modes;
+  std::vector<int64_t> target_treeids, target_nodeids, target_ids;
+  std::vector<float> target_weights;
+  for (int64_t t = 0; t < num_trees; ++t) {
+    treeids.insert(treeids.end(), {t, t, t});
+    nodeids.insert(nodeids.end(), {0, 1, 2});
+    lefts.insert(lefts.end(), {1, -1, -1});
+    rights.insert(rights.end(), {2, -1, -1});
+    featureids.insert(featureids.end(), {t % num_features, -2, -2});
+    thresholds.insert(thresholds.end(), {static_cast<float>(t % 7), -2.f, -2.f});
+    modes.insert(modes.end(), {"BRANCH_LEQ", "LEAF", "LEAF"});
+    target_treeids.insert(target_treeids.end(), {t, t});
+    target_nodeids.insert(target_nodeids.end(), {1, 2});
+    target_ids.insert(target_ids.end(), {0, 0});
+    target_weights.insert(target_weights.end(), {1.f, static_cast<float>(t)});
+  }
+
+  std::vector<float> X(num_rows * num_features);
+  std::vector<float> results(num_rows, 0.f);
+  for (int64_t i = 0; i < num_rows; ++i) {
+    for (int64_t f = 0; f < num_features; ++f) {
+      X[i * num_features + f] = static_cast<float>((i * 3 + f * 5) % 9);
+    }
+    for (int64_t t = 0; t < num_trees; ++t) {
+      bool take_true = X[i * num_features + t % num_features] <= static_cast<float>(t % 7);
+      results[i] += take_true ? 1.f : static_cast<float>(t);
+    }
+  }
+
+  OpTester test("TreeEnsembleRegressor", 1, onnxruntime::kMLDomain);
+  test.AddAttribute("nodes_truenodeids", lefts);
+  test.AddAttribute("nodes_falsenodeids", rights);
+  test.AddAttribute("nodes_treeids", treeids);
+  test.AddAttribute("nodes_nodeids", nodeids);
+  test.AddAttribute("nodes_featureids", featureids);
+  test.AddAttribute("nodes_values", thresholds);
+  test.AddAttribute("nodes_modes", modes);
+  test.AddAttribute("target_treeids", target_treeids);
+  test.AddAttribute("target_nodeids", target_nodeids);
+  test.AddAttribute("target_ids", target_ids);
+  test.AddAttribute("target_weights", target_weights);
+  test.AddAttribute("n_targets", (int64_t)1);
+  test.AddAttribute("aggregate_function", "SUM");
+  test.AddInput<float>("X", {num_rows, num_features}, X);
+  test.AddOutput<float>("Y", {num_rows, 1}, results);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -696,6 +696,49 @@ TEST(ReductionOpTest, ReduceSum_axes02) {
   test.Run();
 }
 
+TEST(ReductionOpTest, ReduceSum_all_but_channel) {
+  // N, H and W of NCHW, reduced without moving the data
+  const int64_t N = 2, C = 3, HW = 20;
+  std::vector<float> data(N * C * HW);
+  std::vector<float> expected(C, 0.0f);
+  for (int64_t n = 0; n < N; ++n) {
+    for (int64_t c = 0; c < C; ++c) {
+      for (int64_t i = 0; i < HW; ++i) {
+        float value = static_cast<float>((n * 7 + c * 3 + i) % 11);
+        data[(n * C + c) * HW + i] = value;
+        expected[c] += value;
+      }
+    }
+  }
+
+  OpTester test("ReduceSum");
+  test.AddAttribute("axes", std::vector<int64_t>{0, 2, 3});
+  test.AddAttribute("keepdims", (int64_t)1);
+  test.AddInput<float>("data", {N, C, 4, 5}, data);
+  test.AddOutput<float>("reduced", {1, C, 1, 1}, expected);
+  test.Run();
+}
+
+TEST(ReductionOpTest, ReduceMax_leading_axis_wide) {
+  // the kept axis is innermost and wider than one block of columns
+  const int64_t rows = 3, cols = 300;
+  std::vector<float> data(rows * cols);
+  std::vector<float> expected(cols);
+  for (int64_t c = 0; c < cols; ++c) {
+    for (int64_t r = 0; r < rows; ++r) {
+      data[r * cols + c] = static_cast<float>((c * 5 + r * 13) % 17);
+    }
+    expected[c] = std::max({data[c], data[cols + c], data[2 * cols + c]});
+  }
+
+  OpTester test("ReduceMax");
+  test.AddAttribute("axes", std::vector<int64_t>{0});
+  test.AddAttribute("keepdims", (int64_t)0);
+  test.AddInput<float>("data", {rows, cols}, data);
+  test.AddOutput<float>("reduced", {cols}, expected);
+  test.Run();
+}
+
 TEST(ReductionOpTest, ReduceSum_int32) {
   OpTester test("ReduceSum");
   test.AddAttribute("axes", std::vector<int64_t>{0, 2});
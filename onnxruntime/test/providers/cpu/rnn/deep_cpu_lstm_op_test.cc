@@ -45,7 +45,8 @@ static void RunLstmTest(const std::vector<float>& X_data,
                         // copy the following vectors as we may modify them
                         std::vector<string> activations = {},
                         std::vector<float> activation_alphas = {},
-                        std::vector<float> activation_betas = {}) {
+                        std::vector<float> activation_betas = {},
+                        bool weights_are_initializers = false) {
   OpTester test("LSTM");
 
   int num_directions = (direction == "bidirectional") ? 2 : 1;
@@ -75,8 +76,8 @@ static void RunLstmTest(const std::vector<float>& X_data,
   std::vector<int64_t> R_dims = {num_directions, 4 * hidden_size, hidden_size};
 
   test.AddInput<float>("X", X_dims, X_data);
-  test.AddInput<float>("W", W_dims, W_data);
-  test.AddInput<float>("R", R_dims, R_data);
+  test.AddInput<float>("W", W_dims, W_data, weights_are_initializers);
+  test.AddInput<float>("R", R_dims, R_data, weights_are_initializers);
 
   if (B_data) {
     std::vector<int64_t> B_dims = {num_directions, 8 * hidden_size};
@@ -252,6 +253,64 @@ TEST(LSTMTest, BidirectionalSimpleWeightsNoBiasTwoRows) {
   SimpleWeightsNoBiasTwoRows("bidirectional", Y_data, Y_h_data, Y_c_data);
 }
 
+// different weights for each direction, so the packed W and R of one direction can't be used for the other
+TEST(LSTMTest, BidirectionalDifferentWeightsPerDirection) {
+  int64_t seq_length = 2;
+  int batch_size = 2;
+  int64_t input_size = 1;
+  int64_t hidden_size = 3;
+
+  std::vector<float> X_data{1.f, 2.f, 10.f, 11.f};
+
+  std::vector<float> W_data{
+      0.1f, 0.2f, 0.3f, 0.4f,
+      1.f, 2.f, 3.f, 4.f,
+      10.f, 11.f, 12.f, 13.f,
+
+      0.3f, -0.2f, 0.1f, 0.5f,
+      0.4f, -0.3f, 0.2f, 0.1f,
+      0.6f, -0.4f, 0.3f, 0.2f};
+
+  std::vector<float> R_data(4 * hidden_size * hidden_size, 0.1f);
+  R_data.resize(2 * 4 * hidden_size * hidden_size, -0.05f);
+
+  std::vector<float> Y_data{
+      0.28828835f, 0.36581863f, 0.45679406f,
+      0.34526032f, 0.47220859f, 0.55850911f,
+
+      -0.39463101f, 0.12460593f, 0.22616748f,
+      -0.56332788f, 0.19263403f, 0.23865788f,
+
+      0.84196719f, 0.89402526f, 0.91073048f,
+      0.85882828f, 0.90703777f, 0.92382452f,
+
+      -0.73570081f, 0.11593683f, 0.028805567f,
+      -0.7430802f, 0.097950036f, 0.022207973f};
+
+  std::vector<float> Y_h_data{
+      0.84196719f, 0.89402526f, 0.91073048f,
+      0.85882828f, 0.90703777f, 0.92382452f,
+
+      -0.39463101f, 0.12460593f, 0.22616748f,
+      -0.56332788f, 0.19263403f, 0.23865788f};
+
+  std::vector<float> Y_c_data{
+      1.2773115f, 1.4418104f, 1.5317904f,
+      1.3249796f, 1.510631f, 1.6145154f,
+
+      -0.73648671f, 0.20867704f, 0.57987258f,
+      -1.0062571f, 0.28392706f, 0.79314211f};
+
+  // W and R as initializers are packed when the kernel is created
+  for (bool weights_are_initializers : {false, true}) {
+    RunLstmTest(X_data, W_data, R_data, Y_data, Y_h_data, Y_c_data,
+                input_size, batch_size, hidden_size, seq_length,
+                nullptr, nullptr, nullptr, nullptr, nullptr, "bidirectional", 9999.f,
+                /*output_sequence*/ true, /*input_forget*/ false, {}, {}, {},
+                weights_are_initializers);
+  }
+}
+
 TEST(LSTMTest, MixedSequenceLengths) {
   // we don't have numpy output for this, but by testing twice and swapping which batch is smaller
   // we can largely verify the behaviour by comparing to ForwardSimpleWeightsNoBiasTwoRows output.
@@ -637,6 +696,23 @@ class LstmOpContext2x1x2x2 {
                                      activation_func_names_,
                                      activation_alphas_,
                                      activation_betas_);
+
+    // and with W and R as initializers that are packed when the kernel is created
+    ::onnxruntime::test::RunLstmTest(X, input_weights_, recurrent_weights_,
+                                     expected_Y, expected_Y_h, expected_Y_c,
+                                     input_size_, batch_size, hidden_size_, seq_length,
+                                     use_bias ? &bias_ : nullptr,
+                                     use_peepholes ? &peephole_weights_ : nullptr,
+                                     initial_h, initial_c,
+                                     sequence_lens,
+                                     direction_,
+                                     clip,
+                                     /*output_sequence*/ true,
+                                     input_forget,
+                                     activation_func_names_,
+                                     activation_alphas_,
+                                     activation_betas_,
+                                     /*weights_are_initializers*/ true);
   }
 
  private:
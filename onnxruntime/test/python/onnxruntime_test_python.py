@@ -5,6 +5,7 @@
 import unittest
 import os
 import sys
+import threading
 import numpy as np
 import onnxruntime as onnxrt
 from onnxruntime.capi._pybind_state import onnxruntime_ostream_redirect
@@ -57,6 +58,57 @@ class TestInferenceSession(unittest.TestCase):
         output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
         np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
 
+    def testRunModelNonContiguousInput(self):
+        sess = onnxrt.InferenceSession(self.get_name("mul_1.pb"))
+        x = np.array([[1.0, 3.0, 5.0], [2.0, 4.0, 6.0]], dtype=np.float32).T
+        self.assertFalse(x.flags['C_CONTIGUOUS'])
+        res = sess.run(["Y"], {"X": x})
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+        np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
+
+    def testOutputOutlivesSession(self):
+        sess = onnxrt.InferenceSession(self.get_name("mul_1.pb"))
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        res = sess.run(["Y"], {"X": x})
+        del sess
+        res[0][0, 0] = 2.0
+        output_expected = np.array([[2.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+        np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
+        # the input is not modified by the run nor by the output
+        np.testing.assert_allclose(np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32), x)
+
+    def testInitializerOutputIsNotShared(self):
+        # Y = X + W where the initializer W is also a graph output
+        for enable_mem_pattern in [True, False]:
+            so = onnxrt.SessionOptions()
+            so.enable_mem_pattern = enable_mem_pattern
+            sess = onnxrt.InferenceSession(self.get_name("initializer_output.pb"), sess_options=so)
+            x = np.array([10.0, 20.0], dtype=np.float32)
+            y, w = sess.run(["Y", "W"], {"X": x})
+            np.testing.assert_allclose(np.array([1.0, 2.0], dtype=np.float32), w)
+            w[0] = 100.0
+            y[0] = 100.0
+            y, w = sess.run(["Y", "W"], {"X": x})
+            np.testing.assert_allclose(np.array([1.0, 2.0], dtype=np.float32), w)
+            np.testing.assert_allclose(np.array([11.0, 22.0], dtype=np.float32), y)
+
+    def testRunModelMultipleThreads(self):
+        sess = onnxrt.InferenceSession(self.get_name("mul_1.pb"))
+        results = [None] * 4
+
+        def run(index):
+            x = np.full((3, 2), index, dtype=np.float32)
+            for _ in range(100):
+                results[index] = sess.run(["Y"], {"X": x})[0]
+
+        threads = [threading.Thread(target=run, args=(i,)) for i in range(len(results))]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        for i, res in enumerate(results):
+            np.testing.assert_allclose(np.full((3, 2), i * i, dtype=np.float32), res)
+
     def testRunModel2(self):
         sess = onnxrt.InferenceSession(self.get_name("matmul_1.pb"))
         x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
@@ -7,6 +7,9 @@
 #include <vector>
 #include <iostream>
 #include <atomic>
+#include <chrono>
+#include <future>
+#include <string>
 #include <gtest/gtest.h>
 #include "test_allocator.h"
 #include "test_fixture.h"
@@ -129,6 +132,91 @@ INSTANTIATE_TEST_CASE_P(CApiTestWithProviders,
                         CApiTestWithProvider,
                         ::testing::Values(0, 1, 2, 3, 4));
 
+struct AsyncRunResult {
+  std::promise<void> done;
+  std::vector<int64_t> dims_y;
+  std::vector<float> values_y;
+  OrtErrorCode error_code = ORT_OK;
+  std::string error_message;
+};
+
+static void ORT_API_CALL AsyncRunCallback(void* user_data, OrtValue** output, size_t output_names_len,
+                                          OrtStatus* status) {
+  auto* result = static_cast<AsyncRunResult*>(user_data);
+  if (status != nullptr) {
+    result->error_code = OrtGetErrorCode(status);
+    result->error_message = OrtGetErrorMessage(status);
+    OrtReleaseStatus(status);
+  } else if (output_names_len == 1) {
+    std::unique_ptr<OrtTensorTypeAndShapeInfo> shape_info;
+    {
+      OrtTensorTypeAndShapeInfo* shape_info_ptr;
+      ORT_THROW_ON_ERROR(OrtGetTensorShapeAndType(output[0], &shape_info_ptr));
+      shape_info.reset(shape_info_ptr);
+    }
+    result->dims_y.resize(OrtGetNumOfDimensions(shape_info.get()));
+    OrtGetDimensions(shape_info.get(), result->dims_y.data(), result->dims_y.size());
+    size_t total_len = static_cast<size_t>(OrtGetTensorShapeElementCount(shape_info.get()));
+    float* f;
+    ORT_THROW_ON_ERROR(OrtGetTensorMutableData(output[0], (void**)&f));
+    result->values_y.assign(f, f + total_len);
+    OrtReleaseValue(output[0]);
+  }
+  result->done.set_value();
+}
+
+TEST_F(CApiTest, run_async) {
+  SessionOptionsWrapper sf(env);
+  // 0 uses the number of hardware threads
+  sf.SetSessionAsyncRunThreadPoolSize(0);
+  std::unique_ptr<OrtSession, decltype(&OrtReleaseSession)> inference_session(sf.OrtCreateInferenceSession(MODEL_URI), OrtReleaseSession);
+  std::unique_ptr<OrtAllocator> default_allocator(MockedOrtAllocator::Create());
+
+  std::vector<float> values_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  std::unique_ptr<OrtValue, decltype(&OrtReleaseValue)> value_x(
+      OrtCreateTensorAsOrtValue(default_allocator.get(), {3, 2}, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT), OrtReleaseValue);
+  void* raw_data;
+  ORT_THROW_ON_ERROR(OrtGetTensorMutableData(value_x.get(), &raw_data));
+  memcpy(raw_data, values_x.data(), values_x.size() * sizeof(values_x[0]));
+  const OrtValue* inputs[] = {value_x.get()};
+  const char* output_names[] = {"Y"};
+
+  {
+    const char* input_names[] = {"X"};
+    AsyncRunResult result;
+    auto done = result.done.get_future();
+    ORT_THROW_ON_ERROR(OrtRunInferenceAsync(inference_session.get(), nullptr, input_names, inputs, 1,
+                                            output_names, 1, AsyncRunCallback, &result));
+    ASSERT_EQ(std::future_status::ready, done.wait_for(std::chrono::seconds(30)));
+    ASSERT_EQ(ORT_OK, result.error_code) << result.error_message;
+    ASSERT_EQ(std::vector<int64_t>({3, 2}), result.dims_y);
+    ASSERT_EQ(std::vector<float>({1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f}), result.values_y);
+  }
+
+  // errors of the run are passed to the callback
+  {
+    const char* input_names[] = {"unknown"};
+    AsyncRunResult result;
+    auto done = result.done.get_future();
+    ORT_THROW_ON_ERROR(OrtRunInferenceAsync(inference_session.get(), nullptr, input_names, inputs, 1,
+                                            output_names, 1, AsyncRunCallback, &result));
+    ASSERT_EQ(std::future_status::ready, done.wait_for(std::chrono::seconds(30)));
+    ASSERT_EQ(ORT_INVALID_ARGUMENT, result.error_code);
+    ASSERT_NE(std::string::npos, result.error_message.find("Invalid Feed Input Names")) << result.error_message;
+    ASSERT_TRUE(result.values_y.empty());
+  }
+
+  // a NULL callback is rejected before the run is queued
+  {
+    const char* input_names[] = {"X"};
+    OrtStatus* status = OrtRunInferenceAsync(inference_session.get(), nullptr, input_names, inputs, 1,
+                                             output_names, 1, nullptr, nullptr);
+    ASSERT_NE(nullptr, status);
+    ASSERT_EQ(ORT_INVALID_ARGUMENT, OrtGetErrorCode(status));
+    OrtReleaseStatus(status);
+  }
+}
+
 #ifndef _WIN32
 //doesn't work, failed in type comparison
 TEST_F(CApiTest, DISABLED_custom_op) {
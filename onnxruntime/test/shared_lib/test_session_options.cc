@@ -10,3 +10,11 @@ TEST_F(CApiTest, session_options) {
   std::unique_ptr<OrtSessionOptions> options(OrtCreateSessionOptions());
   ASSERT_NE(options, nullptr);
 }
+
+TEST_F(CApiTest, async_run_thread_pool_size) {
+  std::unique_ptr<OrtSessionOptions> options(OrtCreateSessionOptions());
+  ASSERT_EQ(0, OrtSetSessionAsyncRunThreadPoolSize(options.get(), 2));
+  // 0 uses the number of hardware threads
+  ASSERT_EQ(0, OrtSetSessionAsyncRunThreadPoolSize(options.get(), 0));
+  ASSERT_EQ(-1, OrtSetSessionAsyncRunThreadPoolSize(options.get(), -1));
+}